@@ -21,3 +21,4 @@ export ASAN_OPTIONS
 
 # Run unit tests
 ./build/unit-tests-nlsr $(ut_log_args)
+./build/unit-tests-allocations $(ut_log_args)
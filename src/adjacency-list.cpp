@@ -35,10 +35,6 @@ AdjacencyList::AdjacencyList()
 {
 }
 
-AdjacencyList::~AdjacencyList()
-{
-}
-
 int32_t
 AdjacencyList::insert(Adjacent& adjacent)
 {
@@ -37,7 +37,6 @@ public:
   typedef std::list<Adjacent>::iterator iterator;
 
   AdjacencyList();
-  ~AdjacencyList();
 
   /*! \brief Inserts an adjacency into the list.
 
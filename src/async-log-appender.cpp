@@ -0,0 +1,199 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2017,  The University of Memphis,
+ *                           Regents of the University of California
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+
+#include "async-log-appender.hpp"
+
+#include <log4cxx/level.h>
+#include <log4cxx/helpers/transcoder.h>
+
+#include <pthread.h>
+
+#include <sstream>
+
+namespace nlsr {
+
+const size_t AsyncLogAppender::DEFAULT_CAPACITY = 8192;
+
+namespace {
+
+// Counts the fork()s in the history of this process. A writer thread
+// belongs to the generation it was started in; the threads of earlier
+// generations did not survive the fork.
+std::atomic<uint64_t> forkGeneration(1);
+
+void
+afterForkInChild()
+{
+  forkGeneration.fetch_add(1, std::memory_order_release);
+}
+
+} // anonymous namespace
+
+AsyncLogAppender::AsyncLogAppender(const log4cxx::AppenderPtr& appender, size_t capacity)
+  : m_appender(appender)
+  , m_events(capacity)
+  , m_nDroppedEvents(0)
+  , m_hasEvents(false)
+  , m_wakeUp(new WakeUp)
+  , m_writerForkGeneration(0)
+  , m_shouldStop(false)
+  , m_isClosed(false)
+{
+  static std::once_flag isAtForkRegistered;
+  std::call_once(isAtForkRegistered, [] {
+      pthread_atfork(nullptr, nullptr, &afterForkInChild);
+    });
+}
+
+AsyncLogAppender::~AsyncLogAppender()
+{
+  close();
+}
+
+void
+AsyncLogAppender::doAppend(const log4cxx::spi::LoggingEventPtr& event, log4cxx::helpers::Pool& pool)
+{
+  // Unlike AppenderSkeleton::doAppend, take no lock; the wrapped
+  // appender applies its own threshold and filters on the writer thread.
+  append(event, pool);
+}
+
+void
+AsyncLogAppender::append(const log4cxx::spi::LoggingEventPtr& event, log4cxx::helpers::Pool& pool)
+{
+  if (m_isClosed.load(std::memory_order_acquire)) {
+    return;
+  }
+
+  log4cxx::spi::LoggingEventPtr queuedEvent(event);
+  if (!m_events.tryPush(queuedEvent)) {
+    m_nDroppedEvents.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  startWriterIfNeeded();
+
+  // Only the first event after the writer emptied the queue wakes it.
+  if (!m_hasEvents.exchange(true, std::memory_order_acq_rel)) {
+    wakeWriter();
+  }
+}
+
+void
+AsyncLogAppender::startWriterIfNeeded()
+{
+  uint64_t generation = forkGeneration.load(std::memory_order_acquire);
+  uint64_t writerGeneration = m_writerForkGeneration.load(std::memory_order_relaxed);
+
+  if (writerGeneration == generation ||
+      !m_writerForkGeneration.compare_exchange_strong(writerGeneration, generation)) {
+    return;
+  }
+
+  // A writer from before a fork() does not exist in this process, so its
+  // std::thread can be neither joined nor destroyed. It may have held
+  // the mutex at the fork(), so the wake-up is replaced as well.
+  if (m_writer != nullptr) {
+    m_writer.release();
+    m_wakeUp.release();
+    m_wakeUp.reset(new WakeUp);
+  }
+  m_writer.reset(new std::thread(&AsyncLogAppender::runWriter, this));
+}
+
+void
+AsyncLogAppender::runWriter()
+{
+  log4cxx::helpers::Pool pool;
+  WakeUp& wakeUp = *m_wakeUp;
+
+  while (!m_shouldStop.load(std::memory_order_acquire)) {
+    // Clear the flag before emptying the queue, so that an event queued
+    // after the queue was found empty wakes the writer again.
+    m_hasEvents.exchange(false, std::memory_order_acq_rel);
+    writeQueuedEvents(pool);
+
+    std::unique_lock<std::mutex> lock(wakeUp.mutex);
+    wakeUp.condition.wait(lock, [this] {
+        return m_hasEvents.load(std::memory_order_acquire) ||
+               m_shouldStop.load(std::memory_order_acquire);
+      });
+  }
+}
+
+void
+AsyncLogAppender::wakeWriter()
+{
+  // Notifying under the mutex means the writer cannot miss the wake-up
+  // between checking for events and going to sleep.
+  std::lock_guard<std::mutex> lock(m_wakeUp->mutex);
+  m_wakeUp->condition.notify_one();
+}
+
+size_t
+AsyncLogAppender::writeQueuedEvents(log4cxx::helpers::Pool& pool)
+{
+  size_t nWritten = 0;
+
+  log4cxx::spi::LoggingEventPtr event;
+  while (m_events.tryPop(event)) {
+    m_appender->doAppend(event, pool);
+    ++nWritten;
+  }
+
+  uint64_t nDropped = m_nDroppedEvents.exchange(0, std::memory_order_relaxed);
+  if (nDropped > 0) {
+    std::ostringstream os;
+    os << "Dropped " << nDropped << " log events because the log queue was full";
+    LOG4CXX_DECODE_CHAR(message, os.str());
+
+    log4cxx::spi::LoggingEventPtr dropped(
+      new log4cxx::spi::LoggingEvent(LOG4CXX_STR("AsyncLogAppender"), log4cxx::Level::getWarn(),
+                                     message, LOG4CXX_LOCATION));
+    m_appender->doAppend(dropped, pool);
+  }
+
+  return nWritten;
+}
+
+void
+AsyncLogAppender::close()
+{
+  if (m_isClosed.exchange(true)) {
+    return;
+  }
+
+  m_shouldStop.store(true, std::memory_order_release);
+  if (m_writer != nullptr) {
+    if (m_writerForkGeneration.load() == forkGeneration.load()) {
+      wakeWriter();
+      m_writer->join();
+    }
+    else {
+      m_writer.release();
+    }
+  }
+
+  log4cxx::helpers::Pool pool;
+  writeQueuedEvents(pool);
+  m_appender->close();
+}
+
+} // namespace nlsr
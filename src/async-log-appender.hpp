@@ -0,0 +1,122 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2017,  The University of Memphis,
+ *                           Regents of the University of California
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+
+#ifndef NLSR_ASYNC_LOG_APPENDER_HPP
+#define NLSR_ASYNC_LOG_APPENDER_HPP
+
+#include "utility/lock-free-ring-buffer.hpp"
+
+#include <log4cxx/appenderskeleton.h>
+#include <log4cxx/spi/loggingevent.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace nlsr {
+
+/*! \brief An appender that passes logging events to another appender on a
+    writer thread.
+
+  Appending an event only pushes it into a lock-free ring buffer, so
+  the layout formatting and the file I/O of the wrapped appender are
+  done off the event loop. If the ring buffer is full the event is
+  dropped, and the writer logs how many events were dropped once it
+  catches up.
+
+  The writer thread sleeps on a condition variable while the queue is
+  empty. An append wakes it only when the queue stops being empty, so
+  an idle NLSR does not wake the writer at all.
+
+  The writer thread is started by the first event, and again by the
+  first event after a fork(), since NLSR forks to daemonize after its
+  loggers are set up.
+ */
+class AsyncLogAppender : public log4cxx::AppenderSkeleton
+{
+public:
+  explicit
+  AsyncLogAppender(const log4cxx::AppenderPtr& appender, size_t capacity = DEFAULT_CAPACITY);
+
+  ~AsyncLogAppender();
+
+  void
+  doAppend(const log4cxx::spi::LoggingEventPtr& event, log4cxx::helpers::Pool& pool) override;
+
+  /*! \brief Writes the events that are still queued, then closes the wrapped appender.
+   */
+  void
+  close() override;
+
+  bool
+  requiresLayout() const override
+  {
+    return false;
+  }
+
+protected:
+  void
+  append(const log4cxx::spi::LoggingEventPtr& event, log4cxx::helpers::Pool& pool) override;
+
+private:
+  void
+  startWriterIfNeeded();
+
+  void
+  runWriter();
+
+  void
+  wakeWriter();
+
+  /*! \brief Writes out the queued events.
+    \return The number of events written.
+   */
+  size_t
+  writeQueuedEvents(log4cxx::helpers::Pool& pool);
+
+public:
+  static const size_t DEFAULT_CAPACITY;
+
+private:
+  log4cxx::AppenderPtr m_appender;
+  util::LockFreeRingBuffer<log4cxx::spi::LoggingEventPtr> m_events;
+  std::atomic<uint64_t> m_nDroppedEvents;
+  // Whether events have been queued since the writer last emptied the queue
+  std::atomic<bool> m_hasEvents;
+
+  struct WakeUp
+  {
+    std::mutex mutex;
+    std::condition_variable condition;
+  };
+
+  std::unique_ptr<WakeUp> m_wakeUp;
+  std::unique_ptr<std::thread> m_writer;
+  std::atomic<uint64_t> m_writerForkGeneration;
+  std::atomic<bool> m_shouldStop;
+  std::atomic<bool> m_isClosed;
+};
+
+} // namespace nlsr
+
+#endif // NLSR_ASYNC_LOG_APPENDER_HPP
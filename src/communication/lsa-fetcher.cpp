@@ -0,0 +1,376 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2017,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "lsa-fetcher.hpp"
+#include "conf-parameter.hpp"
+#include "logger.hpp"
+#include "lsa.hpp"
+#include "validator.hpp"
+
+#include <ndn-cxx/util/segment-fetcher.hpp>
+
+#include <algorithm>
+#include <limits>
+#include <sstream>
+
+namespace nlsr {
+
+INIT_LOGGER("LsaFetcher");
+
+const double LsaFetcher::INITIAL_WINDOW = 4;
+const ndn::time::milliseconds LsaFetcher::MIN_RTO = ndn::time::milliseconds(200);
+
+LsaFetcher::LsaFetcher(ndn::Face& face, Validator& validator, ndn::Scheduler& scheduler,
+                       const ConfParameter& confParam,
+                       const FetchedCallback& onFetched, const SentCallback& onSent,
+                       const FailedCallback& onFailed)
+  : m_face(face)
+  , m_validator(validator)
+  , m_scheduler(scheduler)
+  , m_confParam(confParam)
+  , m_onFetched(onFetched)
+  , m_onSent(onSent)
+  , m_onFailed(onFailed)
+  , m_nOutstanding(0)
+  , m_window(INITIAL_WINDOW)
+  , m_windowThreshold(std::numeric_limits<double>::max())
+  , m_lastWindowDecrease(ndn::time::steady_clock::TimePoint::min())
+  , m_nFetched(0)
+  , m_nDeduplicated(0)
+  , m_nRetransmitted(0)
+  , m_totalFetchLatency(0)
+  , m_maxFetchLatency(0)
+{
+}
+
+void
+LsaFetcher::fetch(const ndn::Name& interestName,
+                  const ndn::time::steady_clock::TimePoint& deadline)
+{
+  ndn::Name lsaName = interestName.getPrefix(-1);
+  uint64_t seqNo = interestName[-1].toNumber();
+
+  auto it = m_requests.find(lsaName);
+  if (it != m_requests.end()) {
+    Request& request = it->second;
+    if (seqNo <= request.seqNo) {
+      NLSR_LOG_TRACE("Already fetching " << lsaName << " seq. no. " << request.seqNo);
+      ++m_nDeduplicated;
+      return;
+    }
+
+    // Any fetch of the older sequence number still outstanding is left
+    // to finish, and its LSA is dropped
+    request.seqNo = seqNo;
+    request.nRetransmissions = 0;
+    request.deadline = deadline;
+    request.requestTime = ndn::time::steady_clock::now();
+    if (request.isQueued) {
+      NLSR_LOG_TRACE("Replacing queued fetch of " << lsaName << " with seq. no. " << seqNo);
+      ++m_nDeduplicated;
+    }
+    else {
+      enqueue(lsaName, request, false);
+    }
+  }
+  else {
+    Lsa::Type lsaType;
+    std::istringstream(lsaName[-1].toUri()) >> lsaType;
+
+    ndn::time::steady_clock::TimePoint now = ndn::time::steady_clock::now();
+    Request request{seqNo, lsaType != Lsa::Type::NAME, false, 0, deadline, now, now};
+    enqueue(lsaName, m_requests.emplace(lsaName, request).first->second, false);
+  }
+
+  sendFetches();
+}
+
+size_t
+LsaFetcher::getWindow() const
+{
+  uint32_t maxWindow = m_confParam.getLsaFetchWindow();
+  if (maxWindow == 0) {
+    return std::numeric_limits<size_t>::max();
+  }
+  return std::min<size_t>(static_cast<size_t>(m_window), maxWindow);
+}
+
+ndn::time::milliseconds
+LsaFetcher::getMeanFetchLatency() const
+{
+  if (m_nFetched == 0) {
+    return ndn::time::milliseconds::zero();
+  }
+  return ndn::time::duration_cast<ndn::time::milliseconds>(m_totalFetchLatency / m_nFetched);
+}
+
+ndn::time::milliseconds
+LsaFetcher::getRto(const ndn::Name& originRouter) const
+{
+  auto it = m_rttEstimators.find(originRouter);
+  if (it == m_rttEstimators.end()) {
+    return m_confParam.getLsaInterestLifetime();
+  }
+  return ndn::time::duration_cast<ndn::time::milliseconds>(it->second.rto);
+}
+
+void
+LsaFetcher::enqueue(const ndn::Name& lsaName, Request& request, bool atFront)
+{
+  std::deque<ndn::Name>& queue = request.isHighPriority ? m_highPriorityQueue :
+                                                          m_lowPriorityQueue;
+  if (atFront) {
+    queue.push_front(lsaName);
+  }
+  else {
+    queue.push_back(lsaName);
+  }
+  request.isQueued = true;
+}
+
+void
+LsaFetcher::sendFetches()
+{
+  size_t window = getWindow();
+
+  while (m_nOutstanding < window) {
+    std::deque<ndn::Name>& queue = !m_highPriorityQueue.empty() ? m_highPriorityQueue :
+                                                                  m_lowPriorityQueue;
+    if (queue.empty()) {
+      break;
+    }
+
+    ndn::Name lsaName = std::move(queue.front());
+    queue.pop_front();
+
+    Request& request = m_requests.at(lsaName);
+    request.isQueued = false;
+    sendFetch(lsaName, request);
+  }
+
+  if (getQueueSize() > 0) {
+    NLSR_LOG_TRACE("LSA fetches outstanding: " << m_nOutstanding << " queued: " << getQueueSize()
+                   << " window: " << window);
+  }
+}
+
+void
+LsaFetcher::sendFetch(const ndn::Name& lsaName, Request& request)
+{
+  ndn::Name interestName(lsaName);
+  interestName.appendNumber(request.seqNo);
+
+  ndn::time::milliseconds lifetime = ndn::time::duration_cast<ndn::time::milliseconds>(
+                                       getRttEstimator(lsaName).rto);
+
+  ndn::Interest interest(interestName);
+  interest.setInterestLifetime(lifetime);
+
+  NLSR_LOG_DEBUG("Fetching Data for LSA: " << interestName << " Seq number: " << request.seqNo
+                 << " lifetime: " << lifetime);
+  request.sendTime = ndn::time::steady_clock::now();
+  ++m_nOutstanding;
+
+  std::shared_ptr<ndn::util::SegmentFetcher> fetcher =
+    ndn::util::SegmentFetcher::fetch(m_face, interest, m_validator,
+                                     std::bind(&LsaFetcher::afterFetch, this, _1, interestName),
+                                     std::bind(&LsaFetcher::onFetchError, this, _1, _2,
+                                               interestName));
+  fetcher->afterSegmentReceived.connect(std::bind(&LsaFetcher::afterSegmentReceived, this, _1,
+                                                  interestName));
+  m_onSent(interestName);
+}
+
+LsaFetcher::RttEstimator&
+LsaFetcher::getRttEstimator(const ndn::Name& lsaName)
+{
+  ndn::Name originRouter = lsaName.getPrefix(-1);
+
+  auto it = m_rttEstimators.find(originRouter);
+  if (it == m_rttEstimators.end()) {
+    ndn::time::nanoseconds maxRto = m_confParam.getLsaInterestLifetime();
+    it = m_rttEstimators.emplace(originRouter, RttEstimator{false, ndn::time::nanoseconds::zero(),
+                                                            ndn::time::nanoseconds::zero(),
+                                                            maxRto}).first;
+  }
+  return it->second;
+}
+
+void
+LsaFetcher::afterFetch(const ndn::ConstBufferPtr& content, const ndn::Name& interestName)
+{
+  if (m_nOutstanding > 0) {
+    --m_nOutstanding;
+  }
+
+  ndn::Name lsaName = interestName.getPrefix(-1);
+  uint64_t seqNo = interestName[-1].toNumber();
+
+  auto it = m_requests.find(lsaName);
+  if (it != m_requests.end() && it->second.seqNo == seqNo) {
+    Request& request = it->second;
+    ndn::time::steady_clock::TimePoint now = ndn::time::steady_clock::now();
+
+    ndn::time::nanoseconds latency = now - request.requestTime;
+    m_totalFetchLatency += latency;
+    m_maxFetchLatency = std::max(m_maxFetchLatency,
+                                 ndn::time::duration_cast<ndn::time::milliseconds>(latency));
+    ++m_nFetched;
+    NLSR_LOG_DEBUG("Fetched LSA: " << interestName << " in "
+                   << ndn::time::duration_cast<ndn::time::milliseconds>(latency)
+                   << " (" << request.nRetransmissions << " retransmissions)");
+    fetchLatencySignal(latency);
+
+    m_requests.erase(it);
+
+    // Additive increase, after growing quickly up to the last window that timed out
+    if (m_window < m_windowThreshold) {
+      m_window += 1;
+    }
+    else {
+      m_window += 1 / m_window;
+    }
+    uint32_t maxWindow = m_confParam.getLsaFetchWindow();
+    if (maxWindow != 0) {
+      m_window = std::min<double>(m_window, maxWindow);
+    }
+
+    m_onFetched(content, interestName);
+  }
+
+  sendFetches();
+}
+
+void
+LsaFetcher::afterSegmentReceived(const ndn::Data& data, const ndn::Name& interestName)
+{
+  // Only the first segment is timed: the Interests for the others are
+  // sent after it arrives, and the fetch completes only once every
+  // segment has been validated
+  const ndn::Name::Component& segment = data.getName()[-1];
+  if (!segment.isSegment() || segment.toSegment() != 0) {
+    return;
+  }
+
+  ndn::Name lsaName = interestName.getPrefix(-1);
+  uint64_t seqNo = interestName[-1].toNumber();
+
+  auto it = m_requests.find(lsaName);
+  if (it == m_requests.end() || it->second.seqNo != seqNo) {
+    return;
+  }
+
+  // Only fetches that were not retransmitted give an unambiguous RTT (Karn)
+  Request& request = it->second;
+  if (request.nRetransmissions > 0) {
+    return;
+  }
+
+  RttEstimator& estimator = getRttEstimator(lsaName);
+  ndn::time::nanoseconds rtt = ndn::time::steady_clock::now() - request.sendTime;
+  if (!estimator.hasSample) {
+    estimator.srtt = rtt;
+    estimator.rttVar = rtt / 2;
+    estimator.hasSample = true;
+  }
+  else {
+    ndn::time::nanoseconds error = estimator.srtt > rtt ? estimator.srtt - rtt :
+                                                          rtt - estimator.srtt;
+    estimator.rttVar = (estimator.rttVar * 3 + error) / 4;
+    estimator.srtt = (estimator.srtt * 7 + rtt) / 8;
+  }
+  ndn::time::nanoseconds maxRto = m_confParam.getLsaInterestLifetime();
+  estimator.rto = std::min(std::max<ndn::time::nanoseconds>(estimator.srtt + 4 * estimator.rttVar,
+                                                            MIN_RTO),
+                           maxRto);
+}
+
+void
+LsaFetcher::onFetchError(uint32_t errorCode, const std::string& msg,
+                         const ndn::Name& interestName)
+{
+  NLSR_LOG_DEBUG("Failed to fetch LSA: " << interestName << ", Error code: " << errorCode
+                 << ", Message: " << msg);
+
+  if (m_nOutstanding > 0) {
+    --m_nOutstanding;
+  }
+
+  ndn::Name lsaName = interestName.getPrefix(-1);
+  uint64_t seqNo = interestName[-1].toNumber();
+
+  auto it = m_requests.find(lsaName);
+  if (it == m_requests.end() || it->second.seqNo != seqNo || it->second.isQueued) {
+    // A newer sequence number is wanted
+    sendFetches();
+    return;
+  }
+
+  Request& request = it->second;
+  if (ndn::time::steady_clock::now() >= request.deadline) {
+    NLSR_LOG_DEBUG("Giving up on fetching LSA: " << interestName);
+    m_requests.erase(it);
+    m_onFailed(interestName);
+    sendFetches();
+    return;
+  }
+
+  ++request.nRetransmissions;
+  ++m_nRetransmitted;
+  m_onFailed(interestName);
+
+  if (errorCode == ndn::util::SegmentFetcher::ErrorCode::INTEREST_TIMEOUT) {
+    RttEstimator& estimator = getRttEstimator(lsaName);
+    ndn::time::nanoseconds maxRto = m_confParam.getLsaInterestLifetime();
+    estimator.rto = std::min<ndn::time::nanoseconds>(2 * estimator.rto, maxRto);
+
+    if (request.sendTime > m_lastWindowDecrease) {
+      m_windowThreshold = std::max(m_window / 2, 1.0);
+      m_window = m_windowThreshold;
+      m_lastWindowDecrease = ndn::time::steady_clock::now();
+      NLSR_LOG_DEBUG("LSA fetch window decreased to " << m_window);
+    }
+
+    // At least the Interest lifetime has elapsed, so it is safe to
+    // retransmit as soon as there is room in the window
+    enqueue(lsaName, request, true);
+  }
+  else {
+    // Otherwise, delay the retransmission to prevent the potential for
+    // constant Interest flooding
+    m_scheduler.scheduleEvent(m_confParam.getLsaInterestLifetime(),
+                              std::bind(&LsaFetcher::retry, this, lsaName, seqNo));
+  }
+
+  sendFetches();
+}
+
+void
+LsaFetcher::retry(const ndn::Name& lsaName, uint64_t seqNo)
+{
+  auto it = m_requests.find(lsaName);
+  if (it != m_requests.end() && it->second.seqNo == seqNo && !it->second.isQueued) {
+    enqueue(lsaName, it->second, true);
+    sendFetches();
+  }
+}
+
+} // namespace nlsr
@@ -0,0 +1,238 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2017,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NLSR_LSA_FETCHER_HPP
+#define NLSR_LSA_FETCHER_HPP
+
+#include "common.hpp"
+#include "signals.hpp"
+#include "test-access-control.hpp"
+
+#include <ndn-cxx/face.hpp>
+#include <ndn-cxx/util/scheduler.hpp>
+#include <ndn-cxx/util/time.hpp>
+
+#include <boost/noncopyable.hpp>
+
+#include <deque>
+#include <map>
+
+namespace nlsr {
+
+class ConfParameter;
+class Validator;
+
+/*! \brief Fetches the LSAs that sync announces, a window at a time.
+
+  Fetches are queued rather than started straight away, and at most a
+  window of them are outstanding at once. The window starts small and
+  grows as fetches succeed, up to lsa-fetch-window, and is halved when
+  a fetch times out. Adjacency and coordinate LSAs are fetched before
+  name LSAs, since the routing table depends on them.
+
+  Only the highest sequence number announced for an LSA is fetched: a
+  request for one that is already wanted is dropped, and a request for
+  a newer one replaces it.
+
+  The InterestLifetime of a fetch is a retransmission timeout computed
+  from the round-trip times measured to the origin router (RFC 6298),
+  each up to the arrival of the first segment of an LSA, and is at most
+  lsa-interest-lifetime. It doubles each time a fetch from that router
+  times out.
+ */
+class LsaFetcher : boost::noncopyable
+{
+public:
+  typedef std::function<void(const ndn::ConstBufferPtr& content,
+                             const ndn::Name& interestName)> FetchedCallback;
+  typedef std::function<void(const ndn::Name& interestName)> SentCallback;
+  typedef std::function<void(const ndn::Name& interestName)> FailedCallback;
+
+  /*!
+    \param onFetched Called with the content of each LSA fetched.
+    \param onSent Called each time an Interest for an LSA is sent.
+    \param onFailed Called each time a fetch fails, before it is retried.
+   */
+  LsaFetcher(ndn::Face& face, Validator& validator, ndn::Scheduler& scheduler,
+             const ConfParameter& confParam,
+             const FetchedCallback& onFetched, const SentCallback& onSent,
+             const FailedCallback& onFailed);
+
+  /*! \brief Queues the fetch of an LSA.
+
+    \param interestName The name of the LSA in the format:
+           /<network>/NLSR/LSA/<site>/%C1.Router/<router>/<lsa-type>/<seqNo>
+    \param deadline Failed fetches are retried until this time.
+   */
+  void
+  fetch(const ndn::Name& interestName, const ndn::time::steady_clock::TimePoint& deadline);
+
+  /*! \brief Returns whether an LSA is queued, being fetched, or waiting to be retried.
+    \param lsaName The name of the LSA without its sequence number.
+   */
+  bool
+  isFetching(const ndn::Name& lsaName) const
+  {
+    return m_requests.count(lsaName) > 0;
+  }
+
+  /*! \brief Returns the number of fetches waiting for room in the window. */
+  size_t
+  getQueueSize() const
+  {
+    return m_highPriorityQueue.size() + m_lowPriorityQueue.size();
+  }
+
+  size_t
+  getNOutstanding() const
+  {
+    return m_nOutstanding;
+  }
+
+  /*! \brief Returns the number of fetches that may be outstanding at once. */
+  size_t
+  getWindow() const;
+
+  uint64_t
+  getNFetched() const
+  {
+    return m_nFetched;
+  }
+
+  /*! \brief Returns the number of requests dropped or merged into a wanted fetch. */
+  uint64_t
+  getNDeduplicated() const
+  {
+    return m_nDeduplicated;
+  }
+
+  uint64_t
+  getNRetransmitted() const
+  {
+    return m_nRetransmitted;
+  }
+
+  /*! \brief Returns the mean time from an LSA being requested to it being fetched. */
+  ndn::time::milliseconds
+  getMeanFetchLatency() const;
+
+  ndn::time::milliseconds
+  getMaxFetchLatency() const
+  {
+    return m_maxFetchLatency;
+  }
+
+  /*! \brief Returns the retransmission timeout of fetches from a router.
+    \param originRouter The LSA name without the LSA type, e.g.
+           /<network>/NLSR/LSA/<site>/%C1.Router/<router>
+   */
+  ndn::time::milliseconds
+  getRto(const ndn::Name& originRouter) const;
+
+public:
+  /*! Emitted with the time from an LSA being requested to it being fetched. */
+  DurationSignal<LsaFetcher> fetchLatencySignal;
+
+PUBLIC_WITH_TESTS_ELSE_PRIVATE:
+  void
+  afterFetch(const ndn::ConstBufferPtr& content, const ndn::Name& interestName);
+
+  /*! \brief Takes an RTT sample when the first segment of an LSA arrives. */
+  void
+  afterSegmentReceived(const ndn::Data& data, const ndn::Name& interestName);
+
+  void
+  onFetchError(uint32_t errorCode, const std::string& msg, const ndn::Name& interestName);
+
+private:
+  struct Request
+  {
+    uint64_t seqNo;
+    bool isHighPriority;
+    bool isQueued;
+    uint32_t nRetransmissions;
+    ndn::time::steady_clock::TimePoint deadline;
+    ndn::time::steady_clock::TimePoint requestTime;
+    ndn::time::steady_clock::TimePoint sendTime;
+  };
+
+  struct RttEstimator
+  {
+    bool hasSample;
+    ndn::time::nanoseconds srtt;
+    ndn::time::nanoseconds rttVar;
+    ndn::time::nanoseconds rto;
+  };
+
+  void
+  enqueue(const ndn::Name& lsaName, Request& request, bool atFront);
+
+  /*! \brief Sends queued fetches while there is room in the window. */
+  void
+  sendFetches();
+
+  void
+  sendFetch(const ndn::Name& lsaName, Request& request);
+
+  /*! \brief Returns the estimator of the router that an LSA comes from. */
+  RttEstimator&
+  getRttEstimator(const ndn::Name& lsaName);
+
+  /*! \brief Requeues a failed fetch, if the LSA is still wanted. */
+  void
+  retry(const ndn::Name& lsaName, uint64_t seqNo);
+
+private:
+  ndn::Face& m_face;
+  Validator& m_validator;
+  ndn::Scheduler& m_scheduler;
+  const ConfParameter& m_confParam;
+  FetchedCallback m_onFetched;
+  SentCallback m_onSent;
+  FailedCallback m_onFailed;
+
+  // The wanted fetches, by LSA name without the sequence number
+  std::map<ndn::Name, Request> m_requests;
+  std::deque<ndn::Name> m_highPriorityQueue;
+  std::deque<ndn::Name> m_lowPriorityQueue;
+  size_t m_nOutstanding;
+
+  // The congestion window, and the size it grows quickly up to
+  double m_window;
+  double m_windowThreshold;
+  // Timeouts of fetches sent before the window last shrank don't shrink it again
+  ndn::time::steady_clock::TimePoint m_lastWindowDecrease;
+
+  std::map<ndn::Name, RttEstimator> m_rttEstimators;
+
+  uint64_t m_nFetched;
+  uint64_t m_nDeduplicated;
+  uint64_t m_nRetransmitted;
+  ndn::time::nanoseconds m_totalFetchLatency;
+  ndn::time::milliseconds m_maxFetchLatency;
+
+  static const double INITIAL_WINDOW;
+  static const ndn::time::milliseconds MIN_RTO;
+};
+
+} // namespace nlsr
+
+#endif // NLSR_LSA_FETCHER_HPP
@@ -26,6 +26,8 @@
 #include "utility/name-helper.hpp"
 #include "logger.hpp"
 
+#include <algorithm>
+
 namespace nlsr {
 
 INIT_LOGGER("SyncLogicHandler");
@@ -43,12 +45,21 @@ public:
   }
 };
 
-SyncLogicHandler::SyncLogicHandler(ndn::Face& face, const IsLsaNew& isLsaNew, ConfParameter& conf)
+SyncLogicHandler::SyncLogicHandler(ndn::Face& face, ndn::Scheduler& scheduler,
+                                   const IsLsaNew& isLsaNew, ConfParameter& conf)
   : onNewLsa(ndn::make_unique<OnNewLsa>())
+  , afterBatch(ndn::make_unique<AfterSyncBatch>())
   , m_syncFace(face)
   , m_isLsaNew(isLsaNew)
   , m_confParam(conf)
+  , m_scheduler(scheduler)
+  , m_nUpdatesCoalesced(0)
+{
+}
+
+SyncLogicHandler::~SyncLogicHandler()
 {
+  m_scheduler.cancelEvent(m_processBatchEvent);
 }
 
 void
@@ -86,6 +97,8 @@ SyncLogicHandler::onChronoSyncUpdate(const std::vector<chronosync::MissingDataIn
 {
   NLSR_LOG_DEBUG("Received ChronoSync update event");
 
+  bool isNewBatch = m_batch.empty();
+
   for (size_t i = 0; i < v.size(); i++){
     ndn::Name updateName = v[i].session.getPrefix(-1);
 
@@ -96,7 +109,7 @@ SyncLogicHandler::onChronoSyncUpdate(const std::vector<chronosync::MissingDataIn
 
     if (nlsrPosition < 0 || lsaPosition < 0) {
       NLSR_LOG_WARN("Received malformed sync update");
-      return;
+      break;
     }
 
     ndn::Name networkName = updateName.getSubName(1, nlsrPosition-1);
@@ -105,8 +118,55 @@ SyncLogicHandler::onChronoSyncUpdate(const std::vector<chronosync::MissingDataIn
     ndn::Name originRouter = networkName;
     originRouter.append(routerName);
 
-    processUpdateFromSync(originRouter, updateName, v[i].high);
+    Lsa::Type lsaType;
+    std::istringstream(updateName.get(updateName.size()-1).toUri()) >> lsaType;
+
+    // Only the newest update for an LSA is worth fetching
+    auto it = m_batch.find(updateName);
+    if (it == m_batch.end()) {
+      m_batch.emplace(updateName, Update{originRouter, lsaType, v[i].high});
+    }
+    else {
+      NLSR_LOG_TRACE("Coalescing update for " << updateName);
+      it->second.seqNo = std::max(it->second.seqNo, v[i].high);
+      ++m_nUpdatesCoalesced;
+    }
   }
+
+  if (m_batch.empty()) {
+    return;
+  }
+
+  if (m_confParam.getSyncBatchWindow() == 0) {
+    processBatch();
+  }
+  else if (isNewBatch) {
+    m_processBatchEvent =
+      m_scheduler.scheduleEvent(ndn::time::milliseconds(m_confParam.getSyncBatchWindow()),
+                                std::bind(&SyncLogicHandler::processBatch, this));
+  }
+}
+
+void
+SyncLogicHandler::processBatch()
+{
+  std::map<ndn::Name, Update> batch;
+  batch.swap(m_batch);
+
+  NLSR_LOG_DEBUG("Processing batch of " << batch.size() << " sync updates");
+
+  for (const auto& update : batch) {
+    if (update.second.lsaType != Lsa::Type::NAME) {
+      processUpdateFromSync(update.second.originRouter, update.first, update.second.seqNo);
+    }
+  }
+  for (const auto& update : batch) {
+    if (update.second.lsaType == Lsa::Type::NAME) {
+      processUpdateFromSync(update.second.originRouter, update.first, update.second.seqNo);
+    }
+  }
+
+  (*afterBatch)();
 }
 
 void
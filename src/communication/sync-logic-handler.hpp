@@ -27,10 +27,13 @@
 #include "lsa.hpp"
 
 #include <ndn-cxx/face.hpp>
+#include <ndn-cxx/util/scheduler.hpp>
 #include <ndn-cxx/util/signal.hpp>
 #include <ChronoSync/socket.hpp>
 #include <boost/throw_exception.hpp>
 
+#include <map>
+
 class InterestManager;
 
 namespace nlsr {
@@ -61,19 +64,33 @@ public:
     }
   };
 
-  SyncLogicHandler(ndn::Face& face, const IsLsaNew& isLsaNew, ConfParameter& conf);
+  SyncLogicHandler(ndn::Face& face, ndn::Scheduler& scheduler, const IsLsaNew& isLsaNew,
+                   ConfParameter& conf);
+
+  ~SyncLogicHandler();
 
   /*! \brief Hook function to call whenever sync detects new data.
    *
    * This function packages the sync information into discrete updates
-   * and passes those off to another function, processUpdateFromSync.
-   * \sa processUpdateFromSync
+   * and adds them to the current batch. The batch is processed
+   * sync-batch-window milliseconds after its first update, or at the
+   * end of this call if the window is 0.
+   * \sa processBatch
    *
    * \param v A container with the new information sync has received
    */
   void
   onChronoSyncUpdate(const std::vector<chronosync::MissingDataInfo>& v);
 
+  /*! \brief Returns the number of updates that were superseded by a
+   * newer one for the same LSA in the same batch.
+   */
+  uint64_t
+  getNUpdatesCoalesced() const
+  {
+    return m_nUpdatesCoalesced;
+  }
+
   /*! \brief Instruct ChronoSync to publish an update.
    *
    * This function instructs sync to push an update into the network,
@@ -102,6 +119,14 @@ PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   buildUpdatePrefix();
 
 private:
+  /*! \brief Passes the updates in the current batch on to processUpdateFromSync.
+   *
+   * Adjacency and coordinate LSAs are handed on before name LSAs,
+   * since the routing table depends on them.
+   */
+  void
+  processBatch();
+
   /*! \brief Determine which kind of LSA was updated and fetch it.
    *
    * Checks that the received update is not from us, which can happen,
@@ -125,6 +150,9 @@ private:
 
 public:
   std::unique_ptr<OnNewLsa> onNewLsa;
+  /*! Emitted once onNewLsa has been emitted for each update in a batch.
+   */
+  std::unique_ptr<AfterSyncBatch> afterBatch;
 
 private:
   ndn::Face& m_syncFace;
@@ -132,6 +160,19 @@ private:
   ndn::Name m_syncPrefix;
   IsLsaNew m_isLsaNew;
   const ConfParameter& m_confParam;
+  ndn::Scheduler& m_scheduler;
+
+  struct Update
+  {
+    ndn::Name originRouter;
+    Lsa::Type lsaType;
+    uint64_t seqNo;
+  };
+
+  // The updates in the current batch, by update name, i.e. per router and LSA type
+  std::map<ndn::Name, Update> m_batch;
+  ndn::EventId m_processBatchEvent;
+  uint64_t m_nUpdatesCoalesced;
 
 PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   ndn::Name m_nameLsaUserPrefix;
@@ -287,6 +287,43 @@ ConfFileProcessor::processConfSectionGeneral(const ConfigSection& section)
     return false;
   }
 
+  // lsa-fetch-window
+  ConfigurationVariable<uint32_t> lsaFetchWindow("lsa-fetch-window",
+                                                 std::bind(&ConfParameter::setLsaFetchWindow,
+                                                 &m_nlsr.getConfParameter(), _1));
+  lsaFetchWindow.setMinAndMaxValue(LSA_FETCH_WINDOW_MIN, LSA_FETCH_WINDOW_MAX);
+  lsaFetchWindow.setOptional(LSA_FETCH_WINDOW_DEFAULT);
+
+  if (!lsaFetchWindow.parseFromConfigSection(section)) {
+    return false;
+  }
+
+  // sync-batch-window
+  ConfigurationVariable<uint32_t> syncBatchWindow("sync-batch-window",
+                                                  std::bind(&ConfParameter::setSyncBatchWindow,
+                                                  &m_nlsr.getConfParameter(), _1));
+  syncBatchWindow.setMinAndMaxValue(SYNC_BATCH_WINDOW_MIN, SYNC_BATCH_WINDOW_MAX);
+  syncBatchWindow.setOptional(SYNC_BATCH_WINDOW_DEFAULT);
+
+  if (!syncBatchWindow.parseFromConfigSection(section)) {
+    return false;
+  }
+
+  // lsa-content-format
+  std::string lsaContentFormat = section.get<std::string>("lsa-content-format", "text");
+
+  if (boost::iequals(lsaContentFormat, "text")) {
+    m_nlsr.getConfParameter().setLsaContentFormat(LSA_CONTENT_FORMAT_TEXT);
+  }
+  else if (boost::iequals(lsaContentFormat, "tlv")) {
+    m_nlsr.getConfParameter().setLsaContentFormat(LSA_CONTENT_FORMAT_TLV);
+  }
+  else {
+    std::cerr << "Wrong value for lsa-content-format." << std::endl;
+    std::cerr << "Allowed value: text, tlv" << std::endl;
+    return false;
+  }
+
   // log-level
   std::string logLevel = section.get<std::string>("log-level", "INFO");
 
@@ -609,6 +646,52 @@ ConfFileProcessor::processConfSectionFib(const ConfigSection& section)
     return false;
   }
 
+  // routing-calc-initial-wait
+  ConfigurationVariable<uint32_t> routingCalcInitialWait("routing-calc-initial-wait",
+                                                         std::bind(&ConfParameter::setRoutingCalcInitialWait,
+                                                         &m_nlsr.getConfParameter(), _1));
+  routingCalcInitialWait.setMinAndMaxValue(ROUTING_CALC_INITIAL_WAIT_MIN,
+                                           ROUTING_CALC_INITIAL_WAIT_MAX);
+  routingCalcInitialWait.setOptional(ROUTING_CALC_INITIAL_WAIT_DEFAULT);
+
+  if (!routingCalcInitialWait.parseFromConfigSection(section)) {
+    return false;
+  }
+
+  // routing-calc-secondary-wait
+  ConfigurationVariable<uint32_t> routingCalcSecondaryWait("routing-calc-secondary-wait",
+                                                           std::bind(&ConfParameter::setRoutingCalcSecondaryWait,
+                                                           &m_nlsr.getConfParameter(), _1));
+  routingCalcSecondaryWait.setMinAndMaxValue(ROUTING_CALC_SECONDARY_WAIT_MIN,
+                                             ROUTING_CALC_SECONDARY_WAIT_MAX);
+  routingCalcSecondaryWait.setOptional(ROUTING_CALC_SECONDARY_WAIT_DEFAULT);
+
+  if (!routingCalcSecondaryWait.parseFromConfigSection(section)) {
+    return false;
+  }
+
+  // routing-calc-threads
+  ConfigurationVariable<uint32_t> routingCalcThreads("routing-calc-threads",
+                                                     std::bind(&ConfParameter::setRoutingCalcThreads,
+                                                     &m_nlsr.getConfParameter(), _1));
+  routingCalcThreads.setMinAndMaxValue(ROUTING_CALC_THREADS_MIN, ROUTING_CALC_THREADS_MAX);
+  routingCalcThreads.setOptional(ROUTING_CALC_THREADS_DEFAULT);
+
+  if (!routingCalcThreads.parseFromConfigSection(section)) {
+    return false;
+  }
+
+  // rib-command-window
+  ConfigurationVariable<uint32_t> ribCommandWindow("rib-command-window",
+                                                   std::bind(&ConfParameter::setRibCommandWindow,
+                                                   &m_nlsr.getConfParameter(), _1));
+  ribCommandWindow.setMinAndMaxValue(RIB_COMMAND_WINDOW_MIN, RIB_COMMAND_WINDOW_MAX);
+  ribCommandWindow.setOptional(RIB_COMMAND_WINDOW_DEFAULT);
+
+  if (!ribCommandWindow.parseFromConfigSection(section)) {
+    return false;
+  }
+
   return true;
 }
 
@@ -43,6 +43,10 @@ ConfParameter::writeLog()
   NLSR_LOG_INFO("LSA refresh time: " << m_lsaRefreshTime);
   NLSR_LOG_INFO("FIB Entry refresh time: " << m_lsaRefreshTime * 2);
   NLSR_LOG_INFO("LSA Interest lifetime: " << getLsaInterestLifetime());
+  NLSR_LOG_INFO("LSA fetch window: " << m_lsaFetchWindow);
+  NLSR_LOG_INFO("Sync batch window: " << m_syncBatchWindow);
+  NLSR_LOG_INFO("LSA content format: "
+                << (m_lsaContentFormat == LSA_CONTENT_FORMAT_TLV ? "tlv" : "text"));
   NLSR_LOG_INFO("Router dead interval: " << getRouterDeadInterval());
   NLSR_LOG_INFO("Max Faces Per Prefix: " << m_maxFacesPerPrefix);
   NLSR_LOG_INFO("Hyperbolic Routing: " << m_hyperbolicState);
@@ -58,6 +62,10 @@ ConfParameter::writeLog()
   NLSR_LOG_INFO("Adjacency LSA build interval:  " << m_adjLsaBuildInterval);
   NLSR_LOG_INFO("First Hello Interest interval: " << m_firstHelloInterval);
   NLSR_LOG_INFO("Routing calculation interval:  " << m_routingCalcInterval);
+  NLSR_LOG_INFO("Routing calculation initial wait (ms):   " << m_routingCalcInitialWait);
+  NLSR_LOG_INFO("Routing calculation secondary wait (ms): " << m_routingCalcSecondaryWait);
+  NLSR_LOG_INFO("Routing calculation threads:   " << m_routingCalcThreads);
+  NLSR_LOG_INFO("RIB command window:            " << m_ribCommandWindow);
 }
 
 } // namespace nlsr
@@ -44,6 +44,23 @@ enum {
   LSA_INTEREST_LIFETIME_MAX = 60
 };
 
+enum {
+  LSA_FETCH_WINDOW_MIN = 0,
+  LSA_FETCH_WINDOW_DEFAULT = 64,
+  LSA_FETCH_WINDOW_MAX = 100000
+};
+
+enum {
+  SYNC_BATCH_WINDOW_MIN = 0,
+  SYNC_BATCH_WINDOW_DEFAULT = 50,
+  SYNC_BATCH_WINDOW_MAX = 5000
+};
+
+enum LsaContentFormat {
+  LSA_CONTENT_FORMAT_TEXT = 0,
+  LSA_CONTENT_FORMAT_TLV = 1
+};
+
 enum {
   ADJ_LSA_BUILD_INTERVAL_MIN = 0,
   ADJ_LSA_BUILD_INTERVAL_DEFAULT = 5,
@@ -62,6 +79,30 @@ enum {
   ROUTING_CALC_INTERVAL_MAX = 15
 };
 
+enum {
+  ROUTING_CALC_INITIAL_WAIT_MIN = 0,
+  ROUTING_CALC_INITIAL_WAIT_DEFAULT = 50,
+  ROUTING_CALC_INITIAL_WAIT_MAX = 15000
+};
+
+enum {
+  ROUTING_CALC_SECONDARY_WAIT_MIN = 0,
+  ROUTING_CALC_SECONDARY_WAIT_DEFAULT = 200,
+  ROUTING_CALC_SECONDARY_WAIT_MAX = 15000
+};
+
+enum {
+  ROUTING_CALC_THREADS_MIN = 0,
+  ROUTING_CALC_THREADS_DEFAULT = 0,
+  ROUTING_CALC_THREADS_MAX = 64
+};
+
+enum {
+  RIB_COMMAND_WINDOW_MIN = 0,
+  RIB_COMMAND_WINDOW_DEFAULT = 128,
+  RIB_COMMAND_WINDOW_MAX = 100000
+};
+
 
 enum {
   FACE_DATASET_FETCH_TRIES_MIN = 1,
@@ -126,8 +167,15 @@ public:
     , m_adjLsaBuildInterval(ADJ_LSA_BUILD_INTERVAL_DEFAULT)
     , m_firstHelloInterval(FIRST_HELLO_INTERVAL_DEFAULT)
     , m_routingCalcInterval(ROUTING_CALC_INTERVAL_DEFAULT)
+    , m_routingCalcInitialWait(ROUTING_CALC_INITIAL_WAIT_DEFAULT)
+    , m_routingCalcSecondaryWait(ROUTING_CALC_SECONDARY_WAIT_DEFAULT)
+    , m_routingCalcThreads(ROUTING_CALC_THREADS_DEFAULT)
+    , m_ribCommandWindow(RIB_COMMAND_WINDOW_DEFAULT)
     , m_faceDatasetFetchInterval(ndn::time::seconds(static_cast<int>(FACE_DATASET_FETCH_INTERVAL_DEFAULT)))
     , m_lsaInterestLifetime(ndn::time::seconds(static_cast<int>(LSA_INTEREST_LIFETIME_DEFAULT)))
+    , m_lsaFetchWindow(LSA_FETCH_WINDOW_DEFAULT)
+    , m_syncBatchWindow(SYNC_BATCH_WINDOW_DEFAULT)
+    , m_lsaContentFormat(LSA_CONTENT_FORMAT_TEXT)
     , m_routerDeadInterval(2 * LSA_REFRESH_TIME_DEFAULT)
     , m_logLevel("INFO")
     , m_interestRetryNumber(HELLO_RETRIES_DEFAULT)
@@ -237,6 +285,42 @@ public:
     return m_lsaInterestLifetime;
   }
 
+  void
+  setLsaFetchWindow(uint32_t window)
+  {
+    m_lsaFetchWindow = window;
+  }
+
+  uint32_t
+  getLsaFetchWindow() const
+  {
+    return m_lsaFetchWindow;
+  }
+
+  void
+  setSyncBatchWindow(uint32_t window)
+  {
+    m_syncBatchWindow = window;
+  }
+
+  uint32_t
+  getSyncBatchWindow() const
+  {
+    return m_syncBatchWindow;
+  }
+
+  void
+  setLsaContentFormat(LsaContentFormat format)
+  {
+    m_lsaContentFormat = format;
+  }
+
+  LsaContentFormat
+  getLsaContentFormat() const
+  {
+    return m_lsaContentFormat;
+  }
+
   void
   setAdjLsaBuildInterval(uint32_t interval)
   {
@@ -273,6 +357,54 @@ public:
     return m_routingCalcInterval;
   }
 
+  void
+  setRoutingCalcInitialWait(uint32_t wait)
+  {
+    m_routingCalcInitialWait = wait;
+  }
+
+  uint32_t
+  getRoutingCalcInitialWait() const
+  {
+    return m_routingCalcInitialWait;
+  }
+
+  void
+  setRoutingCalcSecondaryWait(uint32_t wait)
+  {
+    m_routingCalcSecondaryWait = wait;
+  }
+
+  uint32_t
+  getRoutingCalcSecondaryWait() const
+  {
+    return m_routingCalcSecondaryWait;
+  }
+
+  void
+  setRoutingCalcThreads(uint32_t nThreads)
+  {
+    m_routingCalcThreads = nThreads;
+  }
+
+  uint32_t
+  getRoutingCalcThreads() const
+  {
+    return m_routingCalcThreads;
+  }
+
+  void
+  setRibCommandWindow(uint32_t window)
+  {
+    m_ribCommandWindow = window;
+  }
+
+  uint32_t
+  getRibCommandWindow() const
+  {
+    return m_ribCommandWindow;
+  }
+
   void
   setRouterDeadInterval(uint32_t rdt)
   {
@@ -473,11 +605,18 @@ private:
   uint32_t m_adjLsaBuildInterval;
   uint32_t m_firstHelloInterval;
   uint32_t m_routingCalcInterval;
+  uint32_t m_routingCalcInitialWait;
+  uint32_t m_routingCalcSecondaryWait;
+  uint32_t m_routingCalcThreads;
+  uint32_t m_ribCommandWindow;
 
   uint32_t m_faceDatasetFetchTries;
   ndn::time::seconds m_faceDatasetFetchInterval;
 
   ndn::time::seconds m_lsaInterestLifetime;
+  uint32_t m_lsaFetchWindow;
+  uint32_t m_syncBatchWindow;
+  LsaContentFormat m_lsaContentFormat;
   uint32_t  m_routerDeadInterval;
   std::string m_logLevel;
 
@@ -61,8 +61,8 @@ HelloProtocol::expressInterest(const ndn::Name& interestName, uint32_t seconds)
 void
 HelloProtocol::sendScheduledInterest(uint32_t seconds)
 {
-  std::list<Adjacent> adjList = m_nlsr.getAdjacencyList().getAdjList();
-  for (std::list<Adjacent>::iterator it = adjList.begin(); it != adjList.end();
+  const std::list<Adjacent>& adjList = m_nlsr.getAdjacencyList().getAdjList();
+  for (std::list<Adjacent>::const_iterator it = adjList.begin(); it != adjList.end();
        ++it) {
     // If this adjacency has a Face, just proceed as usual.
     if((*it).getFaceId() != 0) {
@@ -213,7 +213,8 @@ HelloProtocol::onContentValidated(const std::shared_ptr<const ndn::Data>& data)
     // change in Adjacency list
     if ((oldStatus - newStatus) != 0) {
       if (m_nlsr.getConfParameter().getHyperbolicState() == HYPERBOLIC_STATE_ON) {
-        m_nlsr.getRoutingTable().scheduleRoutingTableCalculation(m_nlsr);
+        m_nlsr.getLsdb().scheduleRoutingTableCalculation(
+          m_nlsr.getConfParameter().getRouterPrefix());
       }
       else {
         m_nlsr.getLsdb().scheduleAdjLsaBuild();
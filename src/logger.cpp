@@ -19,8 +19,10 @@
  **/
 
 #include "logger.hpp"
+#include "async-log-appender.hpp"
 
 #include <log4cxx/logger.h>
+#include <log4cxx/logmanager.h>
 #include <log4cxx/basicconfigurator.h>
 #include <log4cxx/xml/domconfigurator.h>
 #include <log4cxx/propertyconfigurator.h>
@@ -64,7 +66,9 @@ INIT_LOGGERS(const std::string& logDir, const std::string& logLevel)
   log4cxx::helpers::Pool p;
   rollingFileAppender->activateOptions(p);
 
-  log4cxx::BasicConfigurator::configure(log4cxx::AppenderPtr(rollingFileAppender));
+  // Format and write the log on a thread of its own, off the event loop.
+  log4cxx::AppenderPtr appender(new nlsr::AsyncLogAppender(log4cxx::AppenderPtr(rollingFileAppender)));
+  log4cxx::BasicConfigurator::configure(appender);
 
   if (boost::iequals(logLevel, "none")) {
     log4cxx::Logger::getRootLogger()->setLevel(log4cxx::Level::getOff());
@@ -84,3 +88,9 @@ isValidLogLevel(const std::string& logLevel)
          boost::iequals(logLevel, "warn")  || boost::iequals(logLevel, "error") ||
          boost::iequals(logLevel, "none");
 }
+
+void
+SHUTDOWN_LOGGERS()
+{
+  log4cxx::LogManager::shutdown();
+}
@@ -30,29 +30,88 @@
 #ifndef NLSR_LOGGER_HPP
 #define NLSR_LOGGER_HPP
 
+#include "config.hpp"
+
 #include <log4cxx/logger.h>
 
+#define NLSR_LOG_LEVEL_TRACE 0
+#define NLSR_LOG_LEVEL_DEBUG 1
+#define NLSR_LOG_LEVEL_INFO  2
+#define NLSR_LOG_LEVEL_WARN  3
+#define NLSR_LOG_LEVEL_ERROR 4
+
+/*! \brief The lowest level of log statement that is compiled in.
+ *
+ * Log statements below this level expand to dead code, so their
+ * arguments are never evaluated, whatever the runtime log level
+ * is. It is set with "./waf configure --min-log-level=LEVEL".
+ */
+#ifndef NLSR_MIN_LOG_LEVEL
+#define NLSR_MIN_LOG_LEVEL NLSR_LOG_LEVEL_TRACE
+#endif // NLSR_MIN_LOG_LEVEL
+
+// The message is still type-checked, so that variables used only for
+// logging do not become unused.
+#define NLSR_LOG_DISABLED(x) \
+  do { \
+    if (false) { \
+      ::log4cxx::helpers::MessageBuffer oss_; \
+      oss_ << x; \
+    } \
+  } while (false)
+
 #define INIT_LOGGER(name) \
   static log4cxx::LoggerPtr staticModuleLogger = log4cxx::Logger::getLogger(name)
 
+#if NLSR_MIN_LOG_LEVEL <= NLSR_LOG_LEVEL_TRACE
 #define NLSR_LOG_TRACE(x) \
   LOG4CXX_TRACE(staticModuleLogger, x)
+#else
+#define NLSR_LOG_TRACE(x) NLSR_LOG_DISABLED(x)
+#endif
 
+#if NLSR_MIN_LOG_LEVEL <= NLSR_LOG_LEVEL_DEBUG
 #define NLSR_LOG_DEBUG(x) \
   LOG4CXX_DEBUG(staticModuleLogger, x)
+#else
+#define NLSR_LOG_DEBUG(x) NLSR_LOG_DISABLED(x)
+#endif
 
+#if NLSR_MIN_LOG_LEVEL <= NLSR_LOG_LEVEL_INFO
 #define NLSR_LOG_INFO(x) \
   LOG4CXX_INFO(staticModuleLogger, x)
+#else
+#define NLSR_LOG_INFO(x) NLSR_LOG_DISABLED(x)
+#endif
 
+#if NLSR_MIN_LOG_LEVEL <= NLSR_LOG_LEVEL_WARN
 #define NLSR_LOG_WARN(x) \
   LOG4CXX_WARN(staticModuleLogger, x)
+#else
+#define NLSR_LOG_WARN(x) NLSR_LOG_DISABLED(x)
+#endif
 
+#if NLSR_MIN_LOG_LEVEL <= NLSR_LOG_LEVEL_ERROR
 #define NLSR_LOG_ERROR(x) \
   LOG4CXX_ERROR(staticModuleLogger, x)
+#else
+#define NLSR_LOG_ERROR(x) NLSR_LOG_DISABLED(x)
+#endif
 
 #define NLSR_LOG_FATAL(x) \
   LOG4CXX_FATAL(staticModuleLogger, x);
 
+/*! \brief Whether DEBUG statements of this module would be logged.
+ *
+ * Use this to skip building expensive dumps, such as whole tables,
+ * that are logged over many statements.
+ */
+#define NLSR_LOG_IS_DEBUG_ENABLED() \
+  (NLSR_MIN_LOG_LEVEL <= NLSR_LOG_LEVEL_DEBUG && staticModuleLogger->isDebugEnabled())
+
+#define NLSR_LOG_IS_TRACE_ENABLED() \
+  (NLSR_MIN_LOG_LEVEL <= NLSR_LOG_LEVEL_TRACE && staticModuleLogger->isTraceEnabled())
+
 void
 INIT_LOGGERS(const std::string& logDir, const std::string& logLevel);
 
@@ -62,4 +121,12 @@ INIT_LOG4CXX(const std::string& log4cxxConfPath);
 bool
 isValidLogLevel(const std::string& logLevel);
 
+/*! \brief Flushes and closes all appenders.
+ *
+ * Call this before exiting, so that the events still queued in an
+ * asynchronous appender are written.
+ */
+void
+SHUTDOWN_LOGGERS();
+
 #endif // NLSR_LOGGER_HPP
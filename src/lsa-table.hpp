@@ -0,0 +1,123 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2017,  The University of Memphis,
+ *                           Regents of the University of California
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NLSR_LSA_TABLE_HPP
+#define NLSR_LSA_TABLE_HPP
+
+#include <list>
+#include <unordered_map>
+#include <ndn-cxx/name.hpp>
+
+namespace nlsr {
+
+/*! \brief The LSAs of one type in the LSDB, indexed by their key.
+
+  The LSAs are stored in a list, so pointers to them stay valid until
+  they are erased, and they are iterated over in the order they were
+  inserted. A hash index from the key of each LSA to its place in the
+  list makes find, insert and erase O(1) on average.
+ */
+template<typename T>
+class LsaTable
+{
+public:
+  typedef std::list<T> Container;
+
+  /*! \brief Returns the LSA with the given key, or nullptr if there is none. */
+  T*
+  find(const ndn::Name& key)
+  {
+    auto it = m_index.find(key);
+    if (it == m_index.end()) {
+      return nullptr;
+    }
+    return &*it->second;
+  }
+
+  bool
+  contains(const ndn::Name& key) const
+  {
+    return m_index.count(key) > 0;
+  }
+
+  /*! \brief Adds a copy of an LSA, unless there already is one with the same key.
+    \return Whether the LSA was added.
+   */
+  bool
+  insert(const T& lsa)
+  {
+    ndn::Name key = lsa.getKey();
+    if (m_index.count(key) > 0) {
+      return false;
+    }
+    m_index.emplace(std::move(key), m_lsas.insert(m_lsas.end(), lsa));
+    return true;
+  }
+
+  /*! \brief Moves an LSA into the table, unless there already is one with the same key.
+    \return Whether the LSA was added.
+   */
+  bool
+  insert(T&& lsa)
+  {
+    ndn::Name key = lsa.getKey();
+    if (m_index.count(key) > 0) {
+      return false;
+    }
+    m_index.emplace(std::move(key), m_lsas.insert(m_lsas.end(), std::move(lsa)));
+    return true;
+  }
+
+  /*! \brief Removes the LSA with the given key.
+    \return Whether there was such an LSA.
+   */
+  bool
+  erase(const ndn::Name& key)
+  {
+    auto it = m_index.find(key);
+    if (it == m_index.end()) {
+      return false;
+    }
+    m_lsas.erase(it->second);
+    m_index.erase(it);
+    return true;
+  }
+
+  size_t
+  size() const
+  {
+    return m_lsas.size();
+  }
+
+  /*! \brief Returns all the LSAs, in the order they were inserted. */
+  const Container&
+  getLsas() const
+  {
+    return m_lsas;
+  }
+
+private:
+  Container m_lsas;
+  std::unordered_map<ndn::Name, typename Container::iterator> m_index;
+};
+
+} // namespace nlsr
+
+#endif // NLSR_LSA_TABLE_HPP
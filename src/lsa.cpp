@@ -24,6 +24,9 @@
 #include "name-prefix-list.hpp"
 #include "adjacent.hpp"
 #include "logger.hpp"
+#include "tlv/adjacency-lsa.hpp"
+#include "tlv/coordinate-lsa.hpp"
+#include "tlv/name-lsa.hpp"
 
 #include <string>
 #include <iostream>
@@ -32,11 +35,14 @@
 #include <cmath>
 #include <limits>
 #include <boost/algorithm/string.hpp>
+#include <ndn-cxx/encoding/block-helpers.hpp>
 
 namespace nlsr {
 
 INIT_LOGGER("Lsa");
 
+const uint64_t Lsa::CONTENT_VERSION = 1;
+
 std::string
 Lsa::getData() const
 {
@@ -65,6 +71,91 @@ Lsa::deserializeCommon(boost::tokenizer<boost::char_separator<char>>::iterator&
   return true;
 }
 
+tlv::LsaInfo
+Lsa::makeContentLsaInfo() const
+{
+  tlv::LsaInfo lsaInfo;
+  lsaInfo.setOriginRouter(m_origRouter);
+  lsaInfo.setSequenceNumber(m_lsSeqNo);
+  lsaInfo.setExpirationTime(m_expirationTimePoint);
+  return lsaInfo;
+}
+
+void
+Lsa::wireDecodeLsaInfo(const tlv::LsaInfo& lsaInfo)
+{
+  if (lsaInfo.getOriginRouter().empty()) {
+    BOOST_THROW_EXCEPTION(tlv::LsaInfo::Error("Empty OriginRouter"));
+  }
+  if (!lsaInfo.hasExpirationTime()) {
+    BOOST_THROW_EXCEPTION(tlv::LsaInfo::Error("Missing required ExpirationTime field"));
+  }
+
+  m_origRouter = lsaInfo.getOriginRouter();
+  m_lsSeqNo = lsaInfo.getSequenceNumber();
+  m_expirationTimePoint = lsaInfo.getExpirationTime();
+}
+
+bool
+Lsa::decodeContent(const uint8_t* buffer, size_t size) noexcept
+{
+  return decodeContent(ndn::makeBinaryBlock(ndn::tlv::Content, buffer, size));
+}
+
+ndn::ConstBufferPtr
+Lsa::encodeContent(LsaContentFormat format) const
+{
+  if (format == LSA_CONTENT_FORMAT_TEXT) {
+    std::string text = serialize();
+    return std::make_shared<ndn::Buffer>(text.data(), text.size());
+  }
+
+  ndn::Block content(tlv::LsaContent);
+  content.push_back(ndn::makeNonNegativeIntegerBlock(tlv::LsaContentVersion, CONTENT_VERSION));
+  content.push_back(wireEncode());
+  content.encode();
+  return std::make_shared<ndn::Buffer>(content.wire(), content.size());
+}
+
+bool
+Lsa::decodeContent(const ndn::Block& content) noexcept
+{
+  if (content.value_size() == 0) {
+    return false;
+  }
+
+  bool isOk = false;
+  ndn::Block versioned;
+  std::tie(isOk, versioned) =
+    ndn::Block::fromBuffer(content.getBuffer(), content.value_begin() - content.getBuffer()->begin());
+
+  if (!isOk || versioned.type() != tlv::LsaContent || versioned.size() != content.value_size()) {
+    return deserialize(std::string(content.value_begin(), content.value_end()));
+  }
+
+  try {
+    versioned.parse();
+    const ndn::Block::element_container& elements = versioned.elements();
+    if (elements.size() != 2 || elements[0].type() != tlv::LsaContentVersion) {
+      NLSR_LOG_ERROR("LsaContent does not start with its LsaContentVersion");
+      return false;
+    }
+
+    uint64_t version = ndn::readNonNegativeInteger(elements[0]);
+    if (version != CONTENT_VERSION) {
+      NLSR_LOG_ERROR("Cannot decode LSA content of unknown version " << version);
+      return false;
+    }
+
+    wireDecode(elements[1]);
+  }
+  catch (const std::exception& e) {
+    NLSR_LOG_ERROR("Could not decode from content: " << e.what());
+    return false;
+  }
+  return true;
+}
+
 NameLsa::NameLsa(const ndn::Name& origR, uint32_t lsn,
                  const ndn::time::system_clock::TimePoint& lt,
                  NamePrefixList& npl)
@@ -114,6 +205,26 @@ NameLsa::deserialize(const std::string& content) noexcept
   return true;
 }
 
+ndn::Block
+NameLsa::wireEncode() const
+{
+  tlv::NameLsa tlvLsa;
+  tlvLsa.setLsaInfo(makeContentLsaInfo());
+  for (const auto& namePair : m_npl) {
+    tlvLsa.addName(std::get<NamePrefixList::NamePairIndex::NAME>(namePair));
+  }
+  return tlvLsa.wireEncode();
+}
+
+void
+NameLsa::wireDecode(const ndn::Block& wire)
+{
+  tlv::NameLsa tlvLsa(wire);
+  wireDecodeLsaInfo(tlvLsa.getLsaInfo());
+  std::vector<ndn::Name> names(tlvLsa.begin(), tlvLsa.end());
+  m_npl = NamePrefixList(std::move(names));
+}
+
 bool
 NameLsa::isEqualContent(const NameLsa& other) const
 {
@@ -190,6 +301,25 @@ CoordinateLsa::deserialize(const std::string& content) noexcept
   return true;
 }
 
+ndn::Block
+CoordinateLsa::wireEncode() const
+{
+  tlv::CoordinateLsa tlvLsa;
+  tlvLsa.setLsaInfo(makeContentLsaInfo());
+  tlvLsa.setHyperbolicRadius(m_corRad);
+  tlvLsa.setHyperbolicAngle(m_angles);
+  return tlvLsa.wireEncode();
+}
+
+void
+CoordinateLsa::wireDecode(const ndn::Block& wire)
+{
+  tlv::CoordinateLsa tlvLsa(wire);
+  wireDecodeLsaInfo(tlvLsa.getLsaInfo());
+  m_corRad = tlvLsa.getHyperbolicRadius();
+  m_angles = tlvLsa.getHyperbolicAngle();
+}
+
 void
 CoordinateLsa::writeLog() const
 {
@@ -204,10 +334,9 @@ AdjLsa::AdjLsa(const ndn::Name& origR, uint32_t lsn,
   m_lsSeqNo = lsn;
   m_expirationTimePoint = lt;
   m_noLink = nl;
-  std::list<Adjacent> al = adl.getAdjList();
-  for (std::list<Adjacent>::iterator it = al.begin(); it != al.end(); it++) {
-    if (it->getStatus() == Adjacent::STATUS_ACTIVE) {
-      addAdjacent((*it));
+  for (const Adjacent& adjacent : adl.getAdjList()) {
+    if (adjacent.getStatus() == Adjacent::STATUS_ACTIVE) {
+      addAdjacent(adjacent);
     }
   }
 }
@@ -260,6 +389,33 @@ AdjLsa::deserialize(const std::string& content) noexcept
   return true;
 }
 
+ndn::Block
+AdjLsa::wireEncode() const
+{
+  tlv::AdjacencyLsa tlvLsa;
+  tlvLsa.setLsaInfo(makeContentLsaInfo());
+  for (const Adjacent& adjacent : m_adl.getAdjList()) {
+    tlv::Adjacency tlvAdjacency;
+    tlvAdjacency.setName(adjacent.getName());
+    tlvAdjacency.setUri(adjacent.getFaceUri().toString());
+    tlvAdjacency.setCost(adjacent.getLinkCost());
+    tlvLsa.addAdjacency(tlvAdjacency);
+  }
+  return tlvLsa.wireEncode();
+}
+
+void
+AdjLsa::wireDecode(const ndn::Block& wire)
+{
+  tlv::AdjacencyLsa tlvLsa(wire);
+  wireDecodeLsaInfo(tlvLsa.getLsaInfo());
+  for (const tlv::Adjacency& tlvAdjacency : tlvLsa) {
+    Adjacent adjacent(tlvAdjacency.getName(), ndn::util::FaceUri(tlvAdjacency.getUri()),
+                      tlvAdjacency.getCost(), Adjacent::STATUS_INACTIVE, 0, 0);
+    addAdjacent(adjacent);
+  }
+}
+
 void
 AdjLsa::addNptEntries(Nlsr& pnlsr)
 {
@@ -22,12 +22,15 @@
 #ifndef NLSR_LSA_HPP
 #define NLSR_LSA_HPP
 
+#include "conf-parameter.hpp"
 #include "name-prefix-list.hpp"
 #include "adjacent.hpp"
 #include "adjacency-list.hpp"
+#include "utility/timer-wheel.hpp"
 
 #include <boost/cstdint.hpp>
-#include <ndn-cxx/util/scheduler.hpp>
+#include <ndn-cxx/encoding/block.hpp>
+#include <ndn-cxx/encoding/buffer.hpp>
 #include <ndn-cxx/util/time.hpp>
 #include <boost/tokenizer.hpp>
 
@@ -35,6 +38,10 @@ namespace nlsr {
 
 class Nlsr;
 
+namespace tlv {
+class LsaInfo;
+} // namespace tlv
+
 class Lsa
 {
 public:
@@ -97,12 +104,12 @@ public:
   }
 
   void
-  setExpiringEventId(const ndn::EventId leei)
+  setExpiringEventId(const util::TimerWheel::TimerId& leei)
   {
     m_expiringEventId = leei;
   }
 
-  ndn::EventId
+  const util::TimerWheel::TimerId&
   getExpiringEventId() const
   {
     return m_expiringEventId;
@@ -128,9 +135,56 @@ public:
   virtual bool
   deserialize(const std::string& content) noexcept = 0;
 
+  /*! \brief Encodes this LSA as the content of LSA Data.
+
+    The encoding is the TLV block that the LSDB Status Dataset uses for
+    this type of LSA, with the absolute ExpirationTime in its LsaInfo.
+   */
+  virtual ndn::Block
+  wireEncode() const = 0;
+
+  /*! \brief Populates this LSA from its TLV encoding.
+    \throw ndn::tlv::Error The block is not a valid encoding of this type of LSA.
+   */
+  virtual void
+  wireDecode(const ndn::Block& wire) = 0;
+
+  /*! \brief Encodes this LSA as the content of LSA Data.
+    \param format The format to publish the LSA in.
+
+    The text format is the serialize() string, and carries no version.
+    The TLV format is an LsaContent element, which holds the
+    LsaContentVersion of the encoding followed by wireEncode().
+   */
+  ndn::ConstBufferPtr
+  encodeContent(LsaContentFormat format) const;
+
+  /*! \brief Populates this LSA from the content of LSA Data.
+
+    Content that is an LsaContent element is decoded as the version it
+    names, and is rejected if this router does not know that version.
+    Any other content is the unversioned text format, which is what
+    routers that predate the versioned format send.
+   */
+  bool
+  decodeContent(const uint8_t* buffer, size_t size) noexcept;
+
+  /*! \brief Populates this LSA from the Content element of LSA Data.
+
+    Unlike the overload above, the decoded LSA shares the buffer of
+    the content instead of copying it.
+   */
+  bool
+  decodeContent(const ndn::Block& content) noexcept;
+
   virtual void
   writeLog() const = 0;
 
+public:
+  /*! \brief The LsaContentVersion of the TLV format that this router sends and reads.
+   */
+  static const uint64_t CONTENT_VERSION;
+
 protected:
   /*! Get data common to all LSA types.
 
@@ -148,11 +202,21 @@ protected:
   bool
   deserializeCommon(boost::tokenizer<boost::char_separator<char>>::iterator& iterator);
 
+  /*! \brief Makes the LsaInfo of the TLV encoding of this LSA.
+   */
+  tlv::LsaInfo
+  makeContentLsaInfo() const;
+
+  /*! \brief Populates the data common to all LSA types from the LsaInfo of a TLV encoding.
+   */
+  void
+  wireDecodeLsaInfo(const tlv::LsaInfo& lsaInfo);
+
 protected:
   ndn::Name m_origRouter;
   uint32_t m_lsSeqNo;
   ndn::time::system_clock::TimePoint m_expirationTimePoint;
-  ndn::EventId m_expiringEventId;
+  util::TimerWheel::TimerId m_expiringEventId;
 };
 
 class NameLsa: public Lsa
@@ -222,6 +286,12 @@ public:
   std::string
   serialize() const override;
 
+  ndn::Block
+  wireEncode() const override;
+
+  void
+  wireDecode(const ndn::Block& wire) override;
+
 private:
   NamePrefixList m_npl;
 
@@ -319,6 +389,12 @@ public:
   std::string
   serialize() const override;
 
+  ndn::Block
+  wireEncode() const override;
+
+  void
+  wireDecode(const ndn::Block& wire) override;
+
 private:
   uint32_t m_noLink;
   AdjacencyList m_adl;
@@ -394,6 +470,12 @@ public:
   std::string
   serialize() const override;
 
+  ndn::Block
+  wireEncode() const override;
+
+  void
+  wireDecode(const ndn::Block& wire) override;
+
 private:
   double m_corRad;
   std::vector<double> m_angles;
@@ -0,0 +1,89 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2017,  The University of Memphis,
+ *                           Regents of the University of California
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+
+#include "lsdb-change-log.hpp"
+
+#include <ndn-cxx/util/random.hpp>
+
+namespace nlsr {
+
+const size_t LsdbChangeLog::DEFAULT_CAPACITY = 1024;
+
+std::ostream&
+operator<<(std::ostream& os, const LsdbChange::Kind& kind)
+{
+  switch (kind) {
+  case LsdbChange::Kind::INSTALLED:
+    return os << "INSTALLED";
+  case LsdbChange::Kind::UPDATED:
+    return os << "UPDATED";
+  case LsdbChange::Kind::REMOVED:
+    return os << "REMOVED";
+  default:
+    return os << "UNKNOWN";
+  }
+}
+
+std::ostream&
+operator<<(std::ostream& os, const LsdbChange& change)
+{
+  os << "LsdbChange(" << change.epoch << ", " << change.sequenceNumber << ", " << change.kind << ", "
+     << change.lsaType << ", " << change.originRouter << ", "
+     << change.lsaSequenceNumber << ")";
+  return os;
+}
+
+LsdbChangeLog::LsdbChangeLog(size_t capacity)
+  : m_capacity(capacity)
+  , m_epoch(ndn::random::generateWord64())
+  , m_lastSequenceNumber(0)
+{
+}
+
+void
+LsdbChangeLog::record(LsdbChange::Kind kind, const Lsa& lsa)
+{
+  if (m_changes.size() == m_capacity) {
+    m_changes.pop_front();
+  }
+
+  m_changes.push_back({m_epoch, ++m_lastSequenceNumber, kind, lsa.getType(), lsa.getOrigRouter(),
+                       lsa.getLsSeqNo()});
+}
+
+LsdbChangeLog::Changes::const_iterator
+LsdbChangeLog::findAfter(uint64_t epoch, uint64_t sequenceNumber) const
+{
+  if (epoch != m_epoch) {
+    return m_changes.begin();
+  }
+  if (sequenceNumber >= m_lastSequenceNumber) {
+    return m_changes.end();
+  }
+  if (m_changes.empty() || sequenceNumber < m_changes.front().sequenceNumber) {
+    return m_changes.begin();
+  }
+
+  // The sequence numbers of the changes kept are consecutive
+  return m_changes.begin() + (sequenceNumber + 1 - m_changes.front().sequenceNumber);
+}
+
+} // namespace nlsr
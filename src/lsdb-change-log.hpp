@@ -0,0 +1,133 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2017,  The University of Memphis,
+ *                           Regents of the University of California
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+
+#ifndef NLSR_LSDB_CHANGE_LOG_HPP
+#define NLSR_LSDB_CHANGE_LOG_HPP
+
+#include "lsa.hpp"
+
+#include <deque>
+#include <iostream>
+#include <boost/cstdint.hpp>
+#include <ndn-cxx/name.hpp>
+
+namespace nlsr {
+
+/*! \brief A change to an LSA in the LSDB.
+ */
+struct LsdbChange
+{
+  enum class Kind {
+    INSTALLED,
+    UPDATED,
+    REMOVED
+  };
+
+  // Differs each time NLSR starts, and so tells the changes made since
+  // then apart from those made before, which were numbered from 1 too
+  uint64_t epoch;
+  // Numbers the changes to the LSDB in the order they were made, from 1
+  uint64_t sequenceNumber;
+  Kind kind;
+  Lsa::Type lsaType;
+  ndn::Name originRouter;
+  // The sequence number of the LSA after the change
+  uint64_t lsaSequenceNumber;
+};
+
+std::ostream&
+operator<<(std::ostream& os, const LsdbChange::Kind& kind);
+
+std::ostream&
+operator<<(std::ostream& os, const LsdbChange& change);
+
+/*! \brief The most recent changes to the LSDB.
+
+  The changes are numbered consecutively, so a consumer that remembers
+  the last change it has seen can ask for only the ones after it. Only
+  the last few changes are kept. A consumer that has fallen further
+  behind finds a gap in the sequence numbers, and has to read the
+  whole LSDB again. So does a consumer that finds the epoch of the
+  changes is not the one it saw before, because NLSR has restarted.
+ */
+class LsdbChangeLog
+{
+public:
+  typedef std::deque<LsdbChange> Changes;
+
+  explicit
+  LsdbChangeLog(size_t capacity = DEFAULT_CAPACITY);
+
+  /*! \brief Records a change to an LSA, giving it the next sequence number.
+    \param kind What happened to the LSA.
+    \param lsa The LSA as it is after the change.
+   */
+  void
+  record(LsdbChange::Kind kind, const Lsa& lsa);
+
+  /*! \brief Returns the epoch of the changes, which is chosen at random
+      when the log is created.
+   */
+  uint64_t
+  getEpoch() const
+  {
+    return m_epoch;
+  }
+
+  /*! \brief Returns the sequence number of the last change, or 0 if
+      there has been none.
+   */
+  uint64_t
+  getLastSequenceNumber() const
+  {
+    return m_lastSequenceNumber;
+  }
+
+  /*! \brief Returns the first change kept after a change seen before.
+    \param epoch The epoch of the change seen.
+    \param sequenceNumber The sequence number of the change seen.
+
+    This is the first change kept if that change is already later than
+    sequenceNumber + 1, and the end if there has been no change since.
+    A change of another epoch was seen before NLSR restarted, so all the
+    changes kept are returned.
+   */
+  Changes::const_iterator
+  findAfter(uint64_t epoch, uint64_t sequenceNumber) const;
+
+  const Changes&
+  getChanges() const
+  {
+    return m_changes;
+  }
+
+  static const size_t DEFAULT_CAPACITY;
+
+private:
+  size_t m_capacity;
+  const uint64_t m_epoch;
+  uint64_t m_lastSequenceNumber;
+  Changes m_changes;
+};
+
+} // namespace nlsr
+
+#endif // NLSR_LSDB_CHANGE_LOG_HPP
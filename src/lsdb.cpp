@@ -27,7 +27,7 @@
 #include "utility/name-helper.hpp"
 
 #include <ndn-cxx/security/signing-helpers.hpp>
-#include <ndn-cxx/util/segment-fetcher.hpp>
+#include <ndn-cxx/util/random.hpp>
 
 namespace nlsr {
 
@@ -39,33 +39,34 @@ public:
   LsaContentPublisher(ndn::Face& face,
                       ndn::KeyChain& keyChain,
                       const ndn::time::milliseconds& freshnessPeriod,
-                      const std::string& content)
+                      ndn::ConstBufferPtr content)
     : SegmentPublisher(face, keyChain, freshnessPeriod)
-    , m_content(content)
+    , m_content(std::move(content))
   {
   }
 
   virtual size_t
   generate(ndn::EncodingBuffer& outBuffer) {
     size_t totalLength = 0;
-    totalLength += outBuffer.prependByteArray(reinterpret_cast<const uint8_t*>(m_content.c_str()),
-                                              m_content.size());
+    totalLength += outBuffer.prependByteArray(m_content->data(), m_content->size());
     return totalLength;
   }
 
 private:
-  const std::string m_content;
+  const ndn::ConstBufferPtr m_content;
 };
 
 const ndn::Name::Component Lsdb::NAME_COMPONENT = ndn::Name::Component("lsdb");
 const ndn::time::seconds Lsdb::GRACE_PERIOD = ndn::time::seconds(10);
+const ndn::time::milliseconds Lsdb::LSA_TIMER_TICK = ndn::time::seconds(1);
 const ndn::time::steady_clock::TimePoint Lsdb::DEFAULT_LSA_RETRIEVAL_DEADLINE =
   ndn::time::steady_clock::TimePoint::min();
 
 Lsdb::Lsdb(Nlsr& nlsr, ndn::Scheduler& scheduler)
   : m_nlsr(nlsr)
   , m_scheduler(scheduler)
-  , m_sync(m_nlsr.getNlsrFace(),
+  , m_lsaTimers(m_scheduler, LSA_TIMER_TICK)
+  , m_sync(m_nlsr.getNlsrFace(), m_scheduler,
            [this] (const ndn::Name& routerName, const Lsa::Type& lsaType,
                    const uint64_t& sequenceNumber) {
              return isLsaNew(routerName, lsaType, sequenceNumber);
@@ -73,49 +74,35 @@ Lsdb::Lsdb(Nlsr& nlsr, ndn::Scheduler& scheduler)
   , m_lsaRefreshTime(0)
   , m_adjLsaBuildInterval(ADJ_LSA_BUILD_INTERVAL_DEFAULT)
   , m_sequencingManager()
+  , m_lsaFetcher(m_nlsr.getNlsrFace(), m_nlsr.getValidator(), m_scheduler,
+                 m_nlsr.getConfParameter(),
+                 [this] (const ndn::ConstBufferPtr& content, const ndn::Name& interestName) {
+                   afterFetchLsa(content, interestName);
+                   afterSyncFetch(interestName.getPrefix(-1));
+                 },
+                 std::bind(&Lsdb::afterSendLsaInterest, this, _1),
+                 [this] (const ndn::Name& interestName) {
+                   afterSyncFetch(interestName.getPrefix(-1));
+                 })
+  , m_isSyncHoldActive(false)
+  , m_isSyncBatchOpen(false)
+  , m_isRoutingCalcHeld(false)
   , m_onNewLsaConnection(m_sync.onNewLsa->connect(
       [this] (const ndn::Name& updateName, const uint64_t& sequenceNumber) {
         ndn::Name lsaInterest{updateName};
         lsaInterest.appendNumber(sequenceNumber);
-        expressInterest(lsaInterest, 0);
-      }))
-{
-}
+        expressInterest(lsaInterest);
 
-void
-Lsdb::onFetchLsaError(uint32_t errorCode,
-                      const std::string& msg,
-                      ndn::Name& interestName,
-                      uint32_t retransmitNo,
-                      const ndn::time::steady_clock::TimePoint& deadline,
-                      ndn::Name lsaName,
-                      uint64_t seqNo)
+        if (m_lsaFetcher.isFetching(updateName)) {
+          beforeSyncFetch(updateName);
+        }
+      }))
+  , m_afterSyncBatchConnection(m_sync.afterBatch->connect([this] { afterSyncBatch(); }))
 {
-  NLSR_LOG_DEBUG("Failed to fetch LSA: " << lsaName << ", Error code: " << errorCode
-                                                << ", Message: " << msg);
-
-  if (ndn::time::steady_clock::now() < deadline) {
-    SequenceNumberMap::const_iterator it = m_highestSeqNo.find(lsaName);
-
-    if (it != m_highestSeqNo.end() && it->second == seqNo) {
-      // If the SegmentFetcher failed due to an Interest timeout, it is safe to re-express
-      // immediately since at the least the LSA Interest lifetime has elapsed.
-      // Otherwise, it is necessary to delay the Interest re-expression to prevent
-      // the potential for constant Interest flooding.
-      ndn::time::seconds delay = m_nlsr.getConfParameter().getLsaInterestLifetime();
-
-      if (errorCode == ndn::util::SegmentFetcher::ErrorCode::INTEREST_TIMEOUT) {
-        delay = ndn::time::seconds(0);
-      }
-
-      m_scheduler.scheduleEvent(delay, std::bind(&Lsdb::expressInterest, this,
-                                                 interestName, retransmitNo + 1, deadline));
-    }
-  }
 }
 
 void
-Lsdb::afterFetchLsa(const ndn::ConstBufferPtr& bufferPtr, ndn::Name& interestName)
+Lsdb::afterFetchLsa(const ndn::ConstBufferPtr& bufferPtr, const ndn::Name& interestName)
 {
   std::shared_ptr<ndn::Data> data = std::make_shared<ndn::Data>(ndn::Name(interestName));
   data->setContent(bufferPtr);
@@ -140,20 +127,9 @@ Lsdb::afterFetchLsa(const ndn::ConstBufferPtr& bufferPtr, ndn::Name& interestNam
 }
 
 void
-Lsdb::cancelScheduleLsaExpiringEvent(ndn::EventId eid)
+Lsdb::cancelScheduleLsaExpiringEvent(const util::TimerWheel::TimerId& eid)
 {
-  m_scheduler.cancelEvent(eid);
-}
-
-  /*! \brief Compares if a name LSA is the same as the one specified by key
-
-    \param nlsa1 A name LSA object
-    \param key A key of an originating router to compare to nlsa1
-   */
-static bool
-nameLsaCompareByKey(const NameLsa& nlsa1, const ndn::Name& key)
-{
-  return nlsa1.getKey() == key;
+  m_lsaTimers.cancel(eid);
 }
 
 bool
@@ -168,19 +144,13 @@ Lsdb::buildAndInstallOwnNameLsa()
   m_sequencingManager.writeSeqNoToFile();
   m_sync.publishRoutingUpdate(Lsa::Type::NAME, m_sequencingManager.getNameLsaSeq());
 
-  return installNameLsa(nameLsa);
+  return installNameLsa(std::move(nameLsa));
 }
 
 NameLsa*
 Lsdb::findNameLsa(const ndn::Name& key)
 {
-  std::list<NameLsa>::iterator it = std::find_if(m_nameLsdb.begin(),
-                                                 m_nameLsdb.end(),
-                                                 std::bind(nameLsaCompareByKey, _1, key));
-  if (it != m_nameLsdb.end()) {
-    return &(*it);
-  }
-  return 0;
+  return m_nameLsdb.find(key);
 }
 
 bool
@@ -200,47 +170,52 @@ Lsdb::isNameLsaNew(const ndn::Name& key, uint64_t seqNo)
   return true;
 }
 
-ndn::EventId
+util::TimerWheel::TimerId
 Lsdb::scheduleNameLsaExpiration(const ndn::Name& key, int seqNo,
                                 const ndn::time::seconds& expTime)
 {
-  return m_scheduler.scheduleEvent(expTime + GRACE_PERIOD,
-                                   std::bind(&Lsdb::expireOrRefreshNameLsa, this, key, seqNo));
+  return m_lsaTimers.schedule(expTime + GRACE_PERIOD,
+                              std::bind(&Lsdb::expireOrRefreshNameLsa, this, key, seqNo));
 }
 
 bool
-Lsdb::installNameLsa(NameLsa& nlsa)
+Lsdb::installNameLsa(NameLsa nlsa)
 {
-  ndn::time::seconds timeToExpire = m_lsaRefreshTime;
-  NameLsa* chkNameLsa = findNameLsa(nlsa.getKey());
+  ndn::time::seconds timeToExpire = getJitteredLsaRefreshTime();
+  const ndn::Name& routerPrefix = m_nlsr.getConfParameter().getRouterPrefix();
+  const ndn::Name key = nlsa.getKey();
+  NameLsa* chkNameLsa = findNameLsa(key);
+  // Send the FIB changes of all the advertised prefixes together
+  Fib::Batch fibBatch(m_nlsr.getFib());
   // Determines if the name LSA is new or not.
   if (chkNameLsa == 0) {
-    addNameLsa(nlsa);
+    addNameLsa(std::move(nlsa));
+    NameLsa& lsa = *findNameLsa(key);
+    m_changeLog.record(LsdbChange::Kind::INSTALLED, lsa);
     NLSR_LOG_DEBUG("New Name LSA");
     NLSR_LOG_DEBUG("Adding Name Lsa");
-    nlsa.writeLog();
+    lsa.writeLog();
 
-    if (nlsa.getOrigRouter() != m_nlsr.getConfParameter().getRouterPrefix()) {
+    if (lsa.getOrigRouter() != routerPrefix) {
       // If this name LSA is from another router, add the advertised
       // prefixes to the NPT.
-      m_nlsr.getNamePrefixTable().addEntry(nlsa.getOrigRouter(),
-                                           nlsa.getOrigRouter());
-      std::list<ndn::Name> nameList = nlsa.getNpl().getNames();
-      for (std::list<ndn::Name>::iterator it = nameList.begin(); it != nameList.end();
-           it++) {
-        if ((*it) != m_nlsr.getConfParameter().getRouterPrefix()) {
-          m_nlsr.getNamePrefixTable().addEntry((*it), nlsa.getOrigRouter());
+      m_nlsr.getNamePrefixTable().addEntry(lsa.getOrigRouter(),
+                                           lsa.getOrigRouter());
+      for (const auto& namePair : lsa.getNpl()) {
+        const ndn::Name& name = std::get<NamePrefixList::NamePairIndex::NAME>(namePair);
+        if (name != routerPrefix) {
+          m_nlsr.getNamePrefixTable().addEntry(name, lsa.getOrigRouter());
         }
       }
     }
-    if (nlsa.getOrigRouter() != m_nlsr.getConfParameter().getRouterPrefix()) {
-      ndn::time::system_clock::Duration duration = nlsa.getExpirationTimePoint() -
+    if (lsa.getOrigRouter() != routerPrefix) {
+      ndn::time::system_clock::Duration duration = lsa.getExpirationTimePoint() -
                                                    ndn::time::system_clock::now();
       timeToExpire = ndn::time::duration_cast<ndn::time::seconds>(duration);
     }
-    nlsa.setExpiringEventId(scheduleNameLsaExpiration(nlsa.getKey(),
-                                                      nlsa.getLsSeqNo(),
-                                                      timeToExpire));
+    lsa.setExpiringEventId(scheduleNameLsaExpiration(key,
+                                                     lsa.getLsSeqNo(),
+                                                     timeToExpire));
   }
   // Else this is a known name LSA, so we are updating it.
   else {
@@ -249,50 +224,62 @@ Lsdb::installNameLsa(NameLsa& nlsa)
       NLSR_LOG_DEBUG("Deleting Name Lsa");
       chkNameLsa->writeLog();
       chkNameLsa->setLsSeqNo(nlsa.getLsSeqNo());
+      m_changeLog.record(LsdbChange::Kind::UPDATED, *chkNameLsa);
       chkNameLsa->setExpirationTimePoint(nlsa.getExpirationTimePoint());
       chkNameLsa->getNpl().sort();
       nlsa.getNpl().sort();
-      // Obtain the set difference of the current and the incoming
-      // name prefix sets, and add those.
-      std::list<ndn::Name> newNames = nlsa.getNpl().getNames();
-      std::list<ndn::Name> oldNames = chkNameLsa->getNpl().getNames();
-      std::list<ndn::Name> namesToAdd;
-      std::set_difference(newNames.begin(), newNames.end(), oldNames.begin(), oldNames.end(),
-                          std::inserter(namesToAdd, namesToAdd.begin()));
-      for (std::list<ndn::Name>::iterator it = namesToAdd.begin();
-           it != namesToAdd.end(); ++it) {
-        chkNameLsa->addName((*it));
-        if (nlsa.getOrigRouter() != m_nlsr.getConfParameter().getRouterPrefix()) {
-          if ((*it) != m_nlsr.getConfParameter().getRouterPrefix()) {
-            m_nlsr.getNamePrefixTable().addEntry((*it), nlsa.getOrigRouter());
-          }
+      // Walk the current and the incoming name prefix sets together,
+      // adding the names that are new and removing those that are no
+      // longer being advertised.
+      bool isOtherRouter = nlsa.getOrigRouter() != routerPrefix;
+      NamePrefixList::const_iterator oldIt = chkNameLsa->getNpl().begin();
+      NamePrefixList::const_iterator oldEnd = chkNameLsa->getNpl().end();
+      NamePrefixList::const_iterator newIt = nlsa.getNpl().begin();
+      NamePrefixList::const_iterator newEnd = nlsa.getNpl().end();
+      while (oldIt != oldEnd || newIt != newEnd) {
+        // Negative if the current name is not advertised anymore,
+        // positive if the incoming name is new.
+        int order = 0;
+        if (newIt == newEnd) {
+          order = -1;
+        }
+        else if (oldIt == oldEnd) {
+          order = 1;
+        }
+        else {
+          order = std::get<NamePrefixList::NamePairIndex::NAME>(*oldIt)
+                    .compare(std::get<NamePrefixList::NamePairIndex::NAME>(*newIt));
         }
-      }
-
-      chkNameLsa->getNpl().sort();
 
-      // Also remove any names that are no longer being advertised.
-      std::list<ndn::Name> namesToRemove;
-      std::set_difference(oldNames.begin(), oldNames.end(), newNames.begin(), newNames.end(),
-                          std::inserter(namesToRemove, namesToRemove.begin()));
-      for (std::list<ndn::Name>::iterator it = namesToRemove.begin();
-           it != namesToRemove.end(); ++it) {
-        NLSR_LOG_DEBUG("Removing name LSA no longer advertised: " << (*it).toUri());
-        chkNameLsa->removeName((*it));
-        if (nlsa.getOrigRouter() != m_nlsr.getConfParameter().getRouterPrefix()) {
-          if ((*it) != m_nlsr.getConfParameter().getRouterPrefix()) {
-            m_nlsr.getNamePrefixTable().removeEntry((*it), nlsa.getOrigRouter());
+        if (order > 0) {
+          const ndn::Name& name = std::get<NamePrefixList::NamePairIndex::NAME>(*newIt++);
+          if (isOtherRouter && name != routerPrefix) {
+            m_nlsr.getNamePrefixTable().addEntry(name, nlsa.getOrigRouter());
+          }
+        }
+        else if (order < 0) {
+          const ndn::Name& name = std::get<NamePrefixList::NamePairIndex::NAME>(*oldIt++);
+          NLSR_LOG_DEBUG("Removing name LSA no longer advertised: " << name);
+          if (isOtherRouter && name != routerPrefix) {
+            m_nlsr.getNamePrefixTable().removeEntry(name, nlsa.getOrigRouter());
           }
         }
+        else {
+          ++oldIt;
+          ++newIt;
+        }
       }
+      // Both lists are sorted, so the incoming one can simply replace
+      // the current one.
+      chkNameLsa->getNpl() = std::move(nlsa.getNpl());
 
-      if (nlsa.getOrigRouter() != m_nlsr.getConfParameter().getRouterPrefix()) {
+      if (isOtherRouter) {
         ndn::time::system_clock::Duration duration = nlsa.getExpirationTimePoint() -
                                                      ndn::time::system_clock::now();
         timeToExpire = ndn::time::duration_cast<ndn::time::seconds>(duration);
       }
       cancelScheduleLsaExpiringEvent(chkNameLsa->getExpiringEventId());
-      chkNameLsa->setExpiringEventId(scheduleNameLsaExpiration(nlsa.getKey(),
+      chkNameLsa->setExpiringEventId(scheduleNameLsaExpiration(key,
                                                                nlsa.getLsSeqNo(),
                                                                timeToExpire));
       NLSR_LOG_DEBUG("Adding Name Lsa");
@@ -303,41 +290,36 @@ Lsdb::installNameLsa(NameLsa& nlsa)
 }
 
 bool
-Lsdb::addNameLsa(NameLsa& nlsa)
+Lsdb::addNameLsa(NameLsa&& nlsa)
 {
-  std::list<NameLsa>::iterator it = std::find_if(m_nameLsdb.begin(),
-                                                 m_nameLsdb.end(),
-                                                 std::bind(nameLsaCompareByKey, _1,
-                                                      nlsa.getKey()));
-  if (it == m_nameLsdb.end()) {
-    m_nameLsdb.push_back(nlsa);
-    return true;
-  }
-  return false;
+  return m_nameLsdb.insert(std::move(nlsa));
 }
 
 bool
 Lsdb::removeNameLsa(const ndn::Name& key)
 {
-  std::list<NameLsa>::iterator it = std::find_if(m_nameLsdb.begin(),
-                                                 m_nameLsdb.end(),
-                                                 std::bind(nameLsaCompareByKey, _1, key));
-  if (it != m_nameLsdb.end()) {
+  NameLsa* lsa = m_nameLsdb.find(key);
+  if (lsa != nullptr) {
+    Fib::Batch fibBatch(m_nlsr.getFib());
     NLSR_LOG_DEBUG("Deleting Name Lsa");
-    (*it).writeLog();
+    lsa->writeLog();
     // If the requested name LSA is not ours, we also need to remove
     // its entries from the NPT.
-    if ((*it).getOrigRouter() !=
+    if (lsa->getOrigRouter() !=
         m_nlsr.getConfParameter().getRouterPrefix()) {
-      m_nlsr.getNamePrefixTable().removeEntry((*it).getOrigRouter(),
-                                              (*it).getOrigRouter());
-      for (const auto& name : it->getNpl().getNames()) {
+      m_nlsr.getNamePrefixTable().removeEntry(lsa->getOrigRouter(),
+                                              lsa->getOrigRouter());
+      for (const auto& namePair : lsa->getNpl()) {
+        const ndn::Name& name = std::get<NamePrefixList::NamePairIndex::NAME>(namePair);
         if (name != m_nlsr.getConfParameter().getRouterPrefix()) {
-          m_nlsr.getNamePrefixTable().removeEntry(name, it->getOrigRouter());
+          m_nlsr.getNamePrefixTable().removeEntry(name, lsa->getOrigRouter());
         }
       }
     }
-    m_nameLsdb.erase(it);
+    cancelScheduleLsaExpiringEvent(lsa->getExpiringEventId());
+    m_changeLog.record(LsdbChange::Kind::REMOVED, *lsa);
+    m_nameLsdb.erase(key);
+    m_lsaSegmentCache.erase(key);
     return true;
   }
   return false;
@@ -346,43 +328,30 @@ Lsdb::removeNameLsa(const ndn::Name& key)
 bool
 Lsdb::doesNameLsaExist(const ndn::Name& key)
 {
-  std::list<NameLsa>::iterator it = std::find_if(m_nameLsdb.begin(),
-                                                 m_nameLsdb.end(),
-                                                 std::bind(nameLsaCompareByKey, _1, key));
-  if (it == m_nameLsdb.end()) {
-    return false;
-  }
-  return true;
+  return m_nameLsdb.contains(key);
 }
 
 void
 Lsdb::writeNameLsdbLog()
 {
+  if (!NLSR_LOG_IS_DEBUG_ENABLED()) {
+    return;
+  }
+
   NLSR_LOG_DEBUG("---------------Name LSDB-------------------");
-  for (std::list<NameLsa>::iterator it = m_nameLsdb.begin();
-       it != m_nameLsdb.end() ; it++) {
-    (*it).writeLog();
+  for (const NameLsa& lsa : m_nameLsdb.getLsas()) {
+    lsa.writeLog();
   }
 }
 
 const std::list<NameLsa>&
 Lsdb::getNameLsdb() const
 {
-  return m_nameLsdb;
+  return m_nameLsdb.getLsas();
 }
 
 // Cor LSA and LSDB related Functions start here
 
-/*! \brief Compares whether an LSA object is the same as a key.
-  \param clsa The cor. LSA to check the identity of.
-  \param key The key of the publishing router to check against.
-*/
-static bool
-corLsaCompareByKey(const CoordinateLsa& clsa, const ndn::Name& key)
-{
-  return clsa.getKey() == key;
-}
-
 bool
 Lsdb::buildAndInstallOwnCoordinateLsa()
 {
@@ -399,7 +368,7 @@ Lsdb::buildAndInstallOwnCoordinateLsa()
     m_sync.publishRoutingUpdate(Lsa::Type::COORDINATE, m_sequencingManager.getCorLsaSeq());
   }
 
-  installCoordinateLsa(corLsa);
+  installCoordinateLsa(std::move(corLsa));
 
   return true;
 }
@@ -407,13 +376,7 @@ Lsdb::buildAndInstallOwnCoordinateLsa()
 CoordinateLsa*
 Lsdb::findCoordinateLsa(const ndn::Name& key)
 {
-  std::list<CoordinateLsa>::iterator it = std::find_if(m_corLsdb.begin(),
-                                                       m_corLsdb.end(),
-                                                       std::bind(corLsaCompareByKey, _1, key));
-  if (it != m_corLsdb.end()) {
-    return &(*it);
-  }
-  return 0;
+  return m_corLsdb.find(key);
 }
 
 bool
@@ -437,43 +400,47 @@ Lsdb::isCoordinateLsaNew(const ndn::Name& key, uint64_t seqNo)
   // \param key The name of the router that published the LSA.
   // \param seqNo the seq. no. associated with the LSA to check.
   // \param expTime How long to wait before triggering the event.
-ndn::EventId
+util::TimerWheel::TimerId
 Lsdb::scheduleCoordinateLsaExpiration(const ndn::Name& key, int seqNo,
                                       const ndn::time::seconds& expTime)
 {
-  return m_scheduler.scheduleEvent(expTime + GRACE_PERIOD,
-                                   std::bind(&Lsdb::expireOrRefreshCoordinateLsa,
-                                             this, key, seqNo));
+  return m_lsaTimers.schedule(expTime + GRACE_PERIOD,
+                              std::bind(&Lsdb::expireOrRefreshCoordinateLsa,
+                                        this, key, seqNo));
 }
 
 bool
-Lsdb::installCoordinateLsa(CoordinateLsa& clsa)
+Lsdb::installCoordinateLsa(CoordinateLsa clsa)
 {
-  ndn::time::seconds timeToExpire = m_lsaRefreshTime;
-  CoordinateLsa* chkCorLsa = findCoordinateLsa(clsa.getKey());
+  ndn::time::seconds timeToExpire = getJitteredLsaRefreshTime();
+  const ndn::Name key = clsa.getKey();
+  CoordinateLsa* chkCorLsa = findCoordinateLsa(key);
   // Checking whether the LSA is new or not.
   if (chkCorLsa == 0) {
     NLSR_LOG_DEBUG("New Coordinate LSA. Adding to LSDB");
     NLSR_LOG_DEBUG("Adding Coordinate Lsa");
     clsa.writeLog();
-    addCoordinateLsa(clsa);
+    addCoordinateLsa(std::move(clsa));
+    CoordinateLsa& lsa = *findCoordinateLsa(key);
+    m_changeLog.record(LsdbChange::Kind::INSTALLED, lsa);
+    m_coordinateCache.insert(lsa.getOrigRouter(), lsa.getCorRadius(), lsa.getCorTheta());
 
     // Register the LSA's origin router prefix
-    if (clsa.getOrigRouter() != m_nlsr.getConfParameter().getRouterPrefix()) {
-      m_nlsr.getNamePrefixTable().addEntry(clsa.getOrigRouter(),
-                                           clsa.getOrigRouter());
+    if (lsa.getOrigRouter() != m_nlsr.getConfParameter().getRouterPrefix()) {
+      m_nlsr.getNamePrefixTable().addEntry(lsa.getOrigRouter(),
+                                           lsa.getOrigRouter());
     }
     if (m_nlsr.getConfParameter().getHyperbolicState() != HYPERBOLIC_STATE_OFF) {
-      m_nlsr.getRoutingTable().scheduleRoutingTableCalculation(m_nlsr);
+      scheduleRoutingTableCalculation(lsa.getOrigRouter());
     }
     // Set the expiration time for the new LSA.
-    if (clsa.getOrigRouter() != m_nlsr.getConfParameter().getRouterPrefix()) {
-      ndn::time::system_clock::Duration duration = clsa.getExpirationTimePoint() -
+    if (lsa.getOrigRouter() != m_nlsr.getConfParameter().getRouterPrefix()) {
+      ndn::time::system_clock::Duration duration = lsa.getExpirationTimePoint() -
                                                    ndn::time::system_clock::now();
       timeToExpire = ndn::time::duration_cast<ndn::time::seconds>(duration);
     }
-    scheduleCoordinateLsaExpiration(clsa.getKey(),
-                                    clsa.getLsSeqNo(), timeToExpire);
+    lsa.setExpiringEventId(scheduleCoordinateLsaExpiration(key,
+                                                           lsa.getLsSeqNo(), timeToExpire));
   }
   // We are just updating this LSA.
   else {
@@ -482,13 +449,16 @@ Lsdb::installCoordinateLsa(CoordinateLsa& clsa)
       NLSR_LOG_DEBUG("Deleting Coordinate Lsa");
       chkCorLsa->writeLog();
       chkCorLsa->setLsSeqNo(clsa.getLsSeqNo());
+      m_changeLog.record(LsdbChange::Kind::UPDATED, *chkCorLsa);
       chkCorLsa->setExpirationTimePoint(clsa.getExpirationTimePoint());
       // If the new LSA contains new routing information, update the LSDB with it.
       if (!chkCorLsa->isEqualContent(clsa)) {
         chkCorLsa->setCorRadius(clsa.getCorRadius());
         chkCorLsa->setCorTheta(clsa.getCorTheta());
+        m_coordinateCache.insert(chkCorLsa->getOrigRouter(), chkCorLsa->getCorRadius(),
+                                 chkCorLsa->getCorTheta());
         if (m_nlsr.getConfParameter().getHyperbolicState() >= HYPERBOLIC_STATE_ON) {
-          m_nlsr.getRoutingTable().scheduleRoutingTableCalculation(m_nlsr);
+          scheduleRoutingTableCalculation(chkCorLsa->getOrigRouter());
         }
       }
       // If this is an LSA from another router, refresh its expiration time.
@@ -509,35 +479,28 @@ Lsdb::installCoordinateLsa(CoordinateLsa& clsa)
 }
 
 bool
-Lsdb::addCoordinateLsa(CoordinateLsa& clsa)
+Lsdb::addCoordinateLsa(CoordinateLsa&& clsa)
 {
-  std::list<CoordinateLsa>::iterator it = std::find_if(m_corLsdb.begin(),
-                                                       m_corLsdb.end(),
-                                                       std::bind(corLsaCompareByKey, _1,
-                                                                 clsa.getKey()));
-  if (it == m_corLsdb.end()) {
-    m_corLsdb.push_back(clsa);
-    return true;
-  }
-  return false;
+  return m_corLsdb.insert(std::move(clsa));
 }
 
 bool
 Lsdb::removeCoordinateLsa(const ndn::Name& key)
 {
-  std::list<CoordinateLsa>::iterator it = std::find_if(m_corLsdb.begin(),
-                                                       m_corLsdb.end(),
-                                                       std::bind(corLsaCompareByKey,
-                                                                 _1, key));
-  if (it != m_corLsdb.end()) {
+  CoordinateLsa* lsa = m_corLsdb.find(key);
+  if (lsa != nullptr) {
     NLSR_LOG_DEBUG("Deleting Coordinate Lsa");
-    it->writeLog();
+    lsa->writeLog();
 
-    if (it->getOrigRouter() != m_nlsr.getConfParameter().getRouterPrefix()) {
-      m_nlsr.getNamePrefixTable().removeEntry(it->getOrigRouter(), it->getOrigRouter());
+    if (lsa->getOrigRouter() != m_nlsr.getConfParameter().getRouterPrefix()) {
+      m_nlsr.getNamePrefixTable().removeEntry(lsa->getOrigRouter(), lsa->getOrigRouter());
     }
 
-    m_corLsdb.erase(it);
+    m_coordinateCache.erase(lsa->getOrigRouter());
+    cancelScheduleLsaExpiringEvent(lsa->getExpiringEventId());
+    m_changeLog.record(LsdbChange::Kind::REMOVED, *lsa);
+    m_corLsdb.erase(key);
+    m_lsaSegmentCache.erase(key);
     return true;
   }
   return false;
@@ -546,44 +509,30 @@ Lsdb::removeCoordinateLsa(const ndn::Name& key)
 bool
 Lsdb::doesCoordinateLsaExist(const ndn::Name& key)
 {
-  std::list<CoordinateLsa>::iterator it = std::find_if(m_corLsdb.begin(),
-                                                       m_corLsdb.end(),
-                                                       std::bind(corLsaCompareByKey,
-                                                                 _1, key));
-  if (it == m_corLsdb.end()) {
-    return false;
-  }
-  return true;
+  return m_corLsdb.contains(key);
 }
 
 void
 Lsdb::writeCorLsdbLog()
 {
+  if (!NLSR_LOG_IS_DEBUG_ENABLED()) {
+    return;
+  }
+
   NLSR_LOG_DEBUG("---------------Cor LSDB-------------------");
-  for (std::list<CoordinateLsa>::iterator it = m_corLsdb.begin();
-       it != m_corLsdb.end() ; it++) {
-    (*it).writeLog();
+  for (const CoordinateLsa& lsa : m_corLsdb.getLsas()) {
+    lsa.writeLog();
   }
 }
 
 const std::list<CoordinateLsa>&
 Lsdb::getCoordinateLsdb() const
 {
-  return m_corLsdb;
+  return m_corLsdb.getLsas();
 }
 
 // Adj LSA and LSDB related function starts here
 
-  /*! \brief Returns whether an adj. LSA object is from some router.
-    \param alsa The adj. LSA object.
-    \param key The router name that you want to compare the LSA with.
-   */
-static bool
-adjLsaCompareByKey(AdjLsa& alsa, const ndn::Name& key)
-{
-  return alsa.getKey() == key;
-}
-
 void
 Lsdb::scheduleAdjLsaBuild()
 {
@@ -632,7 +581,7 @@ Lsdb::buildAdjLsa()
 
         removeAdjLsa(key);
         // Recompute routing table after removal
-        m_nlsr.getRoutingTable().scheduleRoutingTableCalculation(m_nlsr);
+        scheduleRoutingTableCalculation(m_nlsr.getConfParameter().getRouterPrefix());
       }
       // In the case that during building the adj LSA, the FIB has to
       // wait on an Interest response, the number of scheduled adj LSA
@@ -653,29 +602,15 @@ Lsdb::buildAdjLsa()
 }
 
 bool
-Lsdb::addAdjLsa(AdjLsa& alsa)
+Lsdb::addAdjLsa(AdjLsa&& alsa)
 {
-  std::list<AdjLsa>::iterator it = std::find_if(m_adjLsdb.begin(),
-                                                m_adjLsdb.end(),
-                                                std::bind(adjLsaCompareByKey, _1,
-                                                     alsa.getKey()));
-  if (it == m_adjLsdb.end()) {
-    m_adjLsdb.push_back(alsa);
-    return true;
-  }
-  return false;
+  return m_adjLsdb.insert(std::move(alsa));
 }
 
 AdjLsa*
 Lsdb::findAdjLsa(const ndn::Name& key)
 {
-  std::list<AdjLsa>::iterator it = std::find_if(m_adjLsdb.begin(),
-                                                m_adjLsdb.end(),
-                                                std::bind(adjLsaCompareByKey, _1, key));
-  if (it != m_adjLsdb.end()) {
-    return &(*it);
-  }
-  return 0;
+  return m_adjLsdb.find(key);
 }
 
 bool
@@ -695,35 +630,39 @@ Lsdb::isAdjLsaNew(const ndn::Name& key, uint64_t seqNo)
   return true;
 }
 
-ndn::EventId
+util::TimerWheel::TimerId
 Lsdb::scheduleAdjLsaExpiration(const ndn::Name& key, int seqNo,
                                const ndn::time::seconds& expTime)
 {
-  return m_scheduler.scheduleEvent(expTime + GRACE_PERIOD,
-                                   std::bind(&Lsdb::expireOrRefreshAdjLsa, this, key, seqNo));
+  return m_lsaTimers.schedule(expTime + GRACE_PERIOD,
+                              std::bind(&Lsdb::expireOrRefreshAdjLsa, this, key, seqNo));
 }
 
 bool
-Lsdb::installAdjLsa(AdjLsa& alsa)
+Lsdb::installAdjLsa(AdjLsa alsa)
 {
-  ndn::time::seconds timeToExpire = m_lsaRefreshTime;
-  AdjLsa* chkAdjLsa = findAdjLsa(alsa.getKey());
+  ndn::time::seconds timeToExpire = getJitteredLsaRefreshTime();
+  const ndn::Name key = alsa.getKey();
+  AdjLsa* chkAdjLsa = findAdjLsa(key);
   // If this adj. LSA is not in the LSDB already
   if (chkAdjLsa == 0) {
     NLSR_LOG_DEBUG("New Adj LSA. Adding to LSDB");
     NLSR_LOG_DEBUG("Adding Adj Lsa");
     alsa.writeLog();
-    addAdjLsa(alsa);
+    addAdjLsa(std::move(alsa));
+    AdjLsa& lsa = *findAdjLsa(key);
+    m_changeLog.record(LsdbChange::Kind::INSTALLED, lsa);
+    afterAdjLsaChange(lsa.getOrigRouter(), lsa.getAdl());
     // Add any new name prefixes to the NPT
-    alsa.addNptEntries(m_nlsr);
-    m_nlsr.getRoutingTable().scheduleRoutingTableCalculation(m_nlsr);
-    if (alsa.getOrigRouter() != m_nlsr.getConfParameter().getRouterPrefix()) {
-      ndn::time::system_clock::Duration duration = alsa.getExpirationTimePoint() -
+    lsa.addNptEntries(m_nlsr);
+    scheduleRoutingTableCalculation(lsa.getOrigRouter());
+    if (lsa.getOrigRouter() != m_nlsr.getConfParameter().getRouterPrefix()) {
+      ndn::time::system_clock::Duration duration = lsa.getExpirationTimePoint() -
                                                    ndn::time::system_clock::now();
       timeToExpire = ndn::time::duration_cast<ndn::time::seconds>(duration);
     }
-    scheduleAdjLsaExpiration(alsa.getKey(),
-                             alsa.getLsSeqNo(), timeToExpire);
+    lsa.setExpiringEventId(scheduleAdjLsaExpiration(key,
+                                                    lsa.getLsSeqNo(), timeToExpire));
   }
   else {
     if (chkAdjLsa->getLsSeqNo() < alsa.getLsSeqNo()) {
@@ -731,15 +670,16 @@ Lsdb::installAdjLsa(AdjLsa& alsa)
       NLSR_LOG_DEBUG("Deleting Adj Lsa");
       chkAdjLsa->writeLog();
       chkAdjLsa->setLsSeqNo(alsa.getLsSeqNo());
+      m_changeLog.record(LsdbChange::Kind::UPDATED, *chkAdjLsa);
       chkAdjLsa->setExpirationTimePoint(alsa.getExpirationTimePoint());
       // If the new adj LSA has new content, update the contents of
       // the LSDB entry. Additionally, since we've changed the
       // contents of the LSDB, we have to schedule a routing
       // calculation.
       if (!chkAdjLsa->isEqualContent(alsa)) {
-        chkAdjLsa->getAdl().reset();
-        chkAdjLsa->getAdl().addAdjacents(alsa.getAdl());
-        m_nlsr.getRoutingTable().scheduleRoutingTableCalculation(m_nlsr);
+        chkAdjLsa->getAdl() = std::move(alsa.getAdl());
+        afterAdjLsaChange(chkAdjLsa->getOrigRouter(), chkAdjLsa->getAdl());
+        scheduleRoutingTableCalculation(chkAdjLsa->getOrigRouter());
       }
       if (alsa.getOrigRouter() != m_nlsr.getConfParameter().getRouterPrefix()) {
         ndn::time::system_clock::Duration duration = alsa.getExpirationTimePoint() -
@@ -773,20 +713,22 @@ Lsdb::buildAndInstallOwnAdjLsa()
     m_sync.publishRoutingUpdate(Lsa::Type::ADJACENCY, m_sequencingManager.getAdjLsaSeq());
   }
 
-  return installAdjLsa(adjLsa);
+  return installAdjLsa(std::move(adjLsa));
 }
 
 bool
 Lsdb::removeAdjLsa(const ndn::Name& key)
 {
-  std::list<AdjLsa>::iterator it = std::find_if(m_adjLsdb.begin(),
-                                                m_adjLsdb.end(),
-                                                std::bind(adjLsaCompareByKey, _1, key));
-  if (it != m_adjLsdb.end()) {
+  AdjLsa* lsa = m_adjLsdb.find(key);
+  if (lsa != nullptr) {
     NLSR_LOG_DEBUG("Deleting Adj Lsa");
-    (*it).writeLog();
-    (*it).removeNptEntries(m_nlsr);
-    m_adjLsdb.erase(it);
+    lsa->writeLog();
+    lsa->removeNptEntries(m_nlsr);
+    afterAdjLsaChange(lsa->getOrigRouter(), AdjacencyList());
+    cancelScheduleLsaExpiringEvent(lsa->getExpiringEventId());
+    m_changeLog.record(LsdbChange::Kind::REMOVED, *lsa);
+    m_adjLsdb.erase(key);
+    m_lsaSegmentCache.erase(key);
     return true;
   }
   return false;
@@ -795,19 +737,13 @@ Lsdb::removeAdjLsa(const ndn::Name& key)
 bool
 Lsdb::doesAdjLsaExist(const ndn::Name& key)
 {
-  std::list<AdjLsa>::iterator it = std::find_if(m_adjLsdb.begin(),
-                                                m_adjLsdb.end(),
-                                                std::bind(adjLsaCompareByKey, _1, key));
-  if (it == m_adjLsdb.end()) {
-    return false;
-  }
-  return true;
+  return m_adjLsdb.contains(key);
 }
 
 const std::list<AdjLsa>&
 Lsdb::getAdjLsdb() const
 {
-  return m_adjLsdb;
+  return m_adjLsdb.getLsas();
 }
 
 void
@@ -845,6 +781,7 @@ Lsdb::expireOrRefreshNameLsa(const ndn::Name& lsaKey, uint64_t seqNo)
         NLSR_LOG_DEBUG("Deleting Name Lsa");
         chkNameLsa->writeLog();
         chkNameLsa->setLsSeqNo(chkNameLsa->getLsSeqNo() + 1);
+        m_changeLog.record(LsdbChange::Kind::UPDATED, *chkNameLsa);
         m_sequencingManager.setNameLsaSeq(chkNameLsa->getLsSeqNo());
         chkNameLsa->setExpirationTimePoint(getLsaExpirationTimePoint());
         NLSR_LOG_DEBUG("Adding Name Lsa");
@@ -852,7 +789,7 @@ Lsdb::expireOrRefreshNameLsa(const ndn::Name& lsaKey, uint64_t seqNo)
         // schedule refreshing event again
         chkNameLsa->setExpiringEventId(scheduleNameLsaExpiration(chkNameLsa->getKey(),
                                                                  chkNameLsa->getLsSeqNo(),
-                                                                 m_lsaRefreshTime));
+                                                                 getJitteredLsaRefreshTime()));
         m_sequencingManager.writeSeqNoToFile();
         m_sync.publishRoutingUpdate(Lsa::Type::NAME, m_sequencingManager.getNameLsaSeq());
       }
@@ -889,6 +826,7 @@ Lsdb::expireOrRefreshAdjLsa(const ndn::Name& lsaKey, uint64_t seqNo)
         NLSR_LOG_DEBUG("Deleting Adj Lsa");
         chkAdjLsa->writeLog();
         chkAdjLsa->setLsSeqNo(chkAdjLsa->getLsSeqNo() + 1);
+        m_changeLog.record(LsdbChange::Kind::UPDATED, *chkAdjLsa);
         m_sequencingManager.setAdjLsaSeq(chkAdjLsa->getLsSeqNo());
         chkAdjLsa->setExpirationTimePoint(getLsaExpirationTimePoint());
         NLSR_LOG_DEBUG("Adding Adj Lsa");
@@ -896,7 +834,7 @@ Lsdb::expireOrRefreshAdjLsa(const ndn::Name& lsaKey, uint64_t seqNo)
         // schedule refreshing event again
         chkAdjLsa->setExpiringEventId(scheduleAdjLsaExpiration(chkAdjLsa->getKey(),
                                                                chkAdjLsa->getLsSeqNo(),
-                                                               m_lsaRefreshTime));
+                                                               getJitteredLsaRefreshTime()));
         m_sequencingManager.writeSeqNoToFile();
         m_sync.publishRoutingUpdate(Lsa::Type::ADJACENCY, m_sequencingManager.getAdjLsaSeq());
       }
@@ -907,7 +845,7 @@ Lsdb::expireOrRefreshAdjLsa(const ndn::Name& lsaKey, uint64_t seqNo)
       }
       // We have changed the contents of the LSDB, so we have to
       // schedule a routing calculation
-      m_nlsr.getRoutingTable().scheduleRoutingTableCalculation(m_nlsr);
+      scheduleRoutingTableCalculation(lsaKey.getPrefix(-1));
     }
   }
 }
@@ -936,6 +874,7 @@ Lsdb::expireOrRefreshCoordinateLsa(const ndn::Name& lsaKey,
         NLSR_LOG_DEBUG("Deleting Coordinate Lsa");
         chkCorLsa->writeLog();
         chkCorLsa->setLsSeqNo(chkCorLsa->getLsSeqNo() + 1);
+        m_changeLog.record(LsdbChange::Kind::UPDATED, *chkCorLsa);
         if (m_nlsr.getConfParameter().getHyperbolicState() != HYPERBOLIC_STATE_OFF) {
           m_sequencingManager.setCorLsaSeq(chkCorLsa->getLsSeqNo());
         }
@@ -947,7 +886,7 @@ Lsdb::expireOrRefreshCoordinateLsa(const ndn::Name& lsaKey,
         chkCorLsa->setExpiringEventId(scheduleCoordinateLsaExpiration(
                                         chkCorLsa->getKey(),
                                         chkCorLsa->getLsSeqNo(),
-                                        m_lsaRefreshTime));
+                                        getJitteredLsaRefreshTime()));
         // Only sync coordinate LSAs if link-state routing is disabled
         if (m_nlsr.getConfParameter().getHyperbolicState() != HYPERBOLIC_STATE_OFF) {
           m_sequencingManager.writeSeqNoToFile();
@@ -960,19 +899,16 @@ Lsdb::expireOrRefreshCoordinateLsa(const ndn::Name& lsaKey,
         removeCoordinateLsa(lsaKey);
       }
       if (m_nlsr.getConfParameter().getHyperbolicState() == HYPERBOLIC_STATE_ON) {
-        m_nlsr.getRoutingTable().scheduleRoutingTableCalculation(m_nlsr);
+        scheduleRoutingTableCalculation(lsaKey.getPrefix(-1));
       }
     }
   }
 }
 
 void
-Lsdb::expressInterest(const ndn::Name& interestName, uint32_t timeoutCount,
+Lsdb::expressInterest(const ndn::Name& interestName,
                       ndn::time::steady_clock::TimePoint deadline)
 {
-  // increment SENT_LSA_INTEREST
-  lsaIncrementSignal(Statistics::PacketType::SENT_LSA_INTEREST);
-
   if (deadline == DEFAULT_LSA_RETRIEVAL_DEADLINE) {
     deadline = ndn::time::steady_clock::now() + ndn::time::seconds(static_cast<int>(LSA_REFRESH_TIME_MAX));
   }
@@ -994,15 +930,91 @@ Lsdb::expressInterest(const ndn::Name& interestName, uint32_t timeoutCount,
     return;
   }
 
-  ndn::Interest interest(interestName);
-  interest.setInterestLifetime(m_nlsr.getConfParameter().getLsaInterestLifetime());
+  m_lsaFetcher.fetch(interestName, deadline);
+}
+
+void
+Lsdb::beforeSyncFetch(const ndn::Name& lsaName)
+{
+  if (!m_isSyncHoldActive) {
+    NLSR_LOG_DEBUG("Holding back routing table calculation and FIB updates"
+                   " until the LSAs announced by sync are fetched");
+    m_isSyncHoldActive = true;
+    m_isSyncBatchOpen = true;
+    m_nlsr.getFib().beginBatch();
+    m_syncHoldTimeoutEvent =
+      m_scheduler.scheduleEvent(m_nlsr.getConfParameter().getLsaInterestLifetime(), [this] {
+          NLSR_LOG_DEBUG("Gave up waiting for the LSAs announced by sync");
+          releaseSyncHold();
+        });
+  }
+  else if (!m_isSyncBatchOpen) {
+    // Announced by a later batch, so it does not extend the hold
+    return;
+  }
+  m_syncFetches.insert(lsaName);
+}
+
+void
+Lsdb::afterSyncFetch(const ndn::Name& lsaName)
+{
+  if (m_syncFetches.erase(lsaName) == 0 || !m_syncFetches.empty() || m_isSyncBatchOpen) {
+    return;
+  }
+
+  NLSR_LOG_DEBUG("Fetched the LSAs announced by sync");
+  releaseSyncHold();
+}
+
+void
+Lsdb::afterSyncBatch()
+{
+  m_isSyncBatchOpen = false;
+  if (m_isSyncHoldActive && m_syncFetches.empty()) {
+    releaseSyncHold();
+  }
+}
+
+void
+Lsdb::releaseSyncHold()
+{
+  if (!m_isSyncHoldActive) {
+    return;
+  }
+
+  m_isSyncHoldActive = false;
+  m_isSyncBatchOpen = false;
+  m_syncFetches.clear();
+  m_scheduler.cancelEvent(m_syncHoldTimeoutEvent);
+
+  if (m_isRoutingCalcHeld) {
+    m_isRoutingCalcHeld = false;
+    m_nlsr.getRoutingTable().scheduleRoutingTableCalculation(m_nlsr);
+  }
+  m_nlsr.getFib().endBatch();
+}
+
+void
+Lsdb::scheduleRoutingTableCalculation(const ndn::Name& originRouter)
+{
+  if (!m_isSyncHoldActive) {
+    m_nlsr.getRoutingTable().scheduleRoutingTableCalculation(m_nlsr);
+    return;
+  }
+
+  m_isRoutingCalcHeld = true;
+  if (originRouter == m_nlsr.getConfParameter().getRouterPrefix()) {
+    NLSR_LOG_DEBUG("This router's adjacencies changed, so releasing the held routing work");
+    releaseSyncHold();
+  }
+}
+
+void
+Lsdb::afterSendLsaInterest(const ndn::Name& interestName)
+{
+  // increment SENT_LSA_INTEREST
+  lsaIncrementSignal(Statistics::PacketType::SENT_LSA_INTEREST);
 
-  NLSR_LOG_DEBUG("Fetching Data for LSA: " << interestName << " Seq number: " << seqNo);
-  ndn::util::SegmentFetcher::fetch(m_nlsr.getNlsrFace(), interest,
-                                   m_nlsr.getValidator(),
-                                   std::bind(&Lsdb::afterFetchLsa, this, _1, interestName),
-                                   std::bind(&Lsdb::onFetchLsaError, this, _1, _2, interestName,
-                                             timeoutCount, deadline, lsaName, seqNo));
   // increment a specific SENT_LSA_INTEREST
   Lsa::Type lsaType;
   std::istringstream(interestName[-2].toUri()) >> lsaType;
@@ -1030,23 +1042,33 @@ Lsdb::processInterest(const ndn::Name& name, const ndn::Interest& interest)
   const ndn::Name& interestName(interest.getName());
   NLSR_LOG_DEBUG("Interest received for LSA: " << interestName);
 
+  // An Interest for a later segment of an LSA names the version and
+  // segment after the sequence number of the LSA.
+  bool isSegmentInterest = interestName.size() >= 2 && interestName[-1].isSegment() &&
+                           interestName[-2].isVersion();
+  const ndn::Name lsaName = isSegmentInterest ? interestName.getPrefix(-2) : interestName;
+
   std::string chkString("LSA");
-  int32_t lsaPosition = util::getNameComponentPosition(interest.getName(), chkString);
+  int32_t lsaPosition = util::getNameComponentPosition(lsaName, chkString);
 
   if (lsaPosition >= 0) {
 
     // Forms the name of the router that the Interest packet came from.
     ndn::Name originRouter = m_nlsr.getConfParameter().getNetwork();
-    originRouter.append(interestName.getSubName(lsaPosition + 1,
-                                                interest.getName().size() - lsaPosition - 3));
+    originRouter.append(lsaName.getSubName(lsaPosition + 1,
+                                           lsaName.size() - lsaPosition - 3));
 
-    uint64_t seqNo = interestName[-1].toNumber();
+    uint64_t seqNo = lsaName[-1].toNumber();
     NLSR_LOG_DEBUG("LSA sequence number from interest: " << seqNo);
 
     Lsa::Type interestedLsType;
-    std::istringstream(interestName[-2].toUri()) >> interestedLsType;
+    std::istringstream(lsaName[-2].toUri()) >> interestedLsType;
 
-    if (interestedLsType == Lsa::Type::NAME) {
+    if (isSegmentInterest) {
+      putLsaSegment(interest, originRouter.append(std::to_string(interestedLsType)),
+                    interestedLsType, seqNo);
+    }
+    else if (interestedLsType == Lsa::Type::NAME) {
       processInterestForNameLsa(interest, originRouter.append(std::to_string(interestedLsType)),
                                 seqNo);
     }
@@ -1065,20 +1087,105 @@ Lsdb::processInterest(const ndn::Name& name, const ndn::Interest& interest)
   }
 }
 
-  // \brief Sends LSA data.
+  // \brief Sends the first segment of LSA data.
   // \param interest The Interest that warranted the data.
-  // \param content The data that the Interest was seeking.
+  // \param lsa The LSA that the Interest was seeking.
+  //
+  // The encoded LSA is kept, and its later segments are signed and sent
+  // only when they are asked for. Other Interests for the same version
+  // of the LSA are answered without signing again.
 void
-Lsdb::putLsaData(const ndn::Interest& interest, const std::string& content)
+Lsdb::putLsaData(const ndn::Interest& interest, const Lsa& lsa)
+{
+  LsaSegmentCache::Publisher* publisher =
+    m_lsaSegmentCache.find(lsa.getKey(), lsa.getLsSeqNo(), interest.getName());
+
+  if (publisher != nullptr) {
+    NLSR_LOG_DEBUG("Sending cached data for interest (" << interest << ")");
+  }
+  else {
+    NLSR_LOG_DEBUG("Sending requested data for interest (" << interest
+               << ") to be published and added to face.");
+    publisher = prepareLsaSegments(lsa, interest.getName());
+  }
+  m_nlsr.getNlsrFace().put(*publisher->getSegment(0));
+}
+
+  // \brief Sends a later segment of LSA data.
+  // \param interest The Interest that names the segment.
+  // \param lsaKey The LSA that the segment belongs to.
+  // \param lsaType The type of the LSA.
+  // \param seqNo The sequence number of the LSA named by the Interest.
+  //
+  // If the segments of the LSA are no longer cached, they are prepared
+  // again from the LSDB, as long as it still has the version named.
+  // Nothing is sent otherwise.
+void
+Lsdb::putLsaSegment(const ndn::Interest& interest, const ndn::Name& lsaKey,
+                    Lsa::Type lsaType, uint64_t seqNo)
+{
+  const ndn::Name& interestName = interest.getName();
+  const ndn::Name versionedPrefix = interestName.getPrefix(-1);
+
+  LsaSegmentCache::Publisher* publisher =
+    m_lsaSegmentCache.findVersion(lsaKey, versionedPrefix);
+
+  if (publisher == nullptr && versionedPrefix[-1].toVersion() == seqNo) {
+    const Lsa* lsa = nullptr;
+    switch (lsaType) {
+    case Lsa::Type::NAME:
+      lsa = findNameLsa(lsaKey);
+      break;
+    case Lsa::Type::ADJACENCY:
+      lsa = findAdjLsa(lsaKey);
+      break;
+    case Lsa::Type::COORDINATE:
+      lsa = findCoordinateLsa(lsaKey);
+      break;
+    default:
+      break;
+    }
+
+    if (lsa != nullptr && lsa->getLsSeqNo() == seqNo) {
+      NLSR_LOG_DEBUG("Preparing the segments of " << lsaKey << " again");
+      publisher = prepareLsaSegments(*lsa, versionedPrefix.getPrefix(-1));
+    }
+  }
+
+  std::shared_ptr<ndn::Data> data;
+  if (publisher != nullptr) {
+    data = publisher->getSegment(interestName[-1].toSegment());
+  }
+
+  if (data == nullptr) {
+    NLSR_LOG_TRACE(interest << " does not name a segment being served");
+    return;
+  }
+
+  NLSR_LOG_DEBUG("Sending segment for interest (" << interest << ")");
+  m_nlsr.getNlsrFace().put(*data);
+}
+
+  // \brief Prepares the segments of an LSA, and caches them.
+  // \param lsa The LSA to serve.
+  // \param prefix The name the LSA is served under.
+  //
+  // The version of the segments is the sequence number of the LSA, so
+  // the same segments are named whenever they are prepared.
+LsaSegmentCache::Publisher*
+Lsdb::prepareLsaSegments(const Lsa& lsa, const ndn::Name& prefix)
 {
-  LsaContentPublisher publisher(m_nlsr.getNlsrFace(),
-                                m_nlsr.getKeyChain(),
-                                m_lsaRefreshTime,
-                                content);
-  NLSR_LOG_DEBUG("Sending requested data ( " << content << ")  for interest (" << interest
-             << ") to be published and added to face.");
-  publisher.publish(interest.getName(),
-                    ndn::security::signingByCertificate(m_nlsr.getDefaultCertName()));
+  auto publisher = std::make_shared<LsaContentPublisher>(m_nlsr.getNlsrFace(),
+                                                         m_nlsr.getKeyChain(),
+                                                         m_lsaRefreshTime,
+                                                         lsa.encodeContent(
+                                                           m_nlsr.getConfParameter().getLsaContentFormat()));
+  publisher->prepareSegments(ndn::Name(prefix).appendVersion(lsa.getLsSeqNo()),
+                             ndn::security::signingByCertificate(m_nlsr.getDefaultCertName()));
+
+  LsaSegmentCache::Publisher* prepared = publisher.get();
+  m_lsaSegmentCache.insert(lsa.getKey(), lsa.getLsSeqNo(), prefix, std::move(publisher));
+  return prepared;
 }
 
   // \brief Finds and sends a requested name LSA.
@@ -1097,8 +1204,7 @@ Lsdb::processInterestForNameLsa(const ndn::Interest& interest,
   NameLsa*  nameLsa = m_nlsr.getLsdb().findNameLsa(lsaKey);
   if (nameLsa != 0) {
     if (nameLsa->getLsSeqNo() == seqNo) {
-      std::string content = nameLsa->serialize();
-      putLsaData(interest,content);
+      putLsaData(interest, *nameLsa);
       // increment SENT_NAME_LSA_DATA
       lsaIncrementSignal(Statistics::PacketType::SENT_NAME_LSA_DATA);
     }
@@ -1131,8 +1237,7 @@ Lsdb::processInterestForAdjacencyLsa(const ndn::Interest& interest,
   AdjLsa* adjLsa = m_nlsr.getLsdb().findAdjLsa(lsaKey);
   if (adjLsa != 0) {
     if (adjLsa->getLsSeqNo() == seqNo) {
-      std::string content = adjLsa->serialize();
-      putLsaData(interest,content);
+      putLsaData(interest, *adjLsa);
       // increment SENT_ADJ_LSA_DATA
       lsaIncrementSignal(Statistics::PacketType::SENT_ADJ_LSA_DATA);
     }
@@ -1165,8 +1270,7 @@ Lsdb::processInterestForCoordinateLsa(const ndn::Interest& interest,
   CoordinateLsa* corLsa = m_nlsr.getLsdb().findCoordinateLsa(lsaKey);
   if (corLsa != 0) {
     if (corLsa->getLsSeqNo() == seqNo) {
-      std::string content = corLsa->serialize();
-      putLsaData(interest,content);
+      putLsaData(interest, *corLsa);
       // increment SENT_COORD_LSA_DATA
       lsaIncrementSignal(Statistics::PacketType::SENT_COORD_LSA_DATA);
     }
@@ -1195,8 +1299,7 @@ Lsdb::onContentValidated(const std::shared_ptr<const ndn::Data>& data)
     originRouter.append(dataName.getSubName(lsaPosition + 1, dataName.size() - lsaPosition - 3));
 
     uint64_t seqNo = dataName[-1].toNumber();
-    std::string dataContent(reinterpret_cast<const char*>(data->getContent().value()),
-                            data->getContent().value_size());
+    const ndn::Block& dataContent = data->getContent();
 
     Lsa::Type interestedLsType;
     std::istringstream(dataName[-2].toUri()) >> interestedLsType;
@@ -1224,14 +1327,14 @@ Lsdb::onContentValidated(const std::shared_ptr<const ndn::Data>& data)
 
 void
 Lsdb::processContentNameLsa(const ndn::Name& lsaKey,
-                            uint64_t lsSeqNo, std::string& dataContent)
+                            uint64_t lsSeqNo, const ndn::Block& dataContent)
 {
   // increment RCV_NAME_LSA_DATA
   lsaIncrementSignal(Statistics::PacketType::RCV_NAME_LSA_DATA);
   if (isNameLsaNew(lsaKey, lsSeqNo)) {
     NameLsa nameLsa;
-    if (nameLsa.deserialize(dataContent)) {
-      installNameLsa(nameLsa);
+    if (nameLsa.decodeContent(dataContent)) {
+      installNameLsa(std::move(nameLsa));
     }
     else {
       NLSR_LOG_DEBUG("LSA data decoding error :(");
@@ -1241,14 +1344,14 @@ Lsdb::processContentNameLsa(const ndn::Name& lsaKey,
 
 void
 Lsdb::processContentAdjacencyLsa(const ndn::Name& lsaKey,
-                                 uint64_t lsSeqNo, std::string& dataContent)
+                                 uint64_t lsSeqNo, const ndn::Block& dataContent)
 {
   // increment RCV_ADJ_LSA_DATA
   lsaIncrementSignal(Statistics::PacketType::RCV_ADJ_LSA_DATA);
   if (isAdjLsaNew(lsaKey, lsSeqNo)) {
     AdjLsa adjLsa;
-    if (adjLsa.deserialize(dataContent)) {
-      installAdjLsa(adjLsa);
+    if (adjLsa.decodeContent(dataContent)) {
+      installAdjLsa(std::move(adjLsa));
     }
     else {
       NLSR_LOG_DEBUG("LSA data decoding error :(");
@@ -1258,14 +1361,14 @@ Lsdb::processContentAdjacencyLsa(const ndn::Name& lsaKey,
 
 void
 Lsdb::processContentCoordinateLsa(const ndn::Name& lsaKey,
-                                  uint64_t lsSeqNo, std::string& dataContent)
+                                  uint64_t lsSeqNo, const ndn::Block& dataContent)
 {
   // increment RCV_COORD_LSA_DATA
   lsaIncrementSignal(Statistics::PacketType::RCV_COORD_LSA_DATA);
   if (isCoordinateLsaNew(lsaKey, lsSeqNo)) {
     CoordinateLsa corLsa;
-    if (corLsa.deserialize(dataContent)) {
-      installCoordinateLsa(corLsa);
+    if (corLsa.decodeContent(dataContent)) {
+      installCoordinateLsa(std::move(corLsa));
     }
     else {
       NLSR_LOG_DEBUG("LSA data decoding error :(");
@@ -1282,13 +1385,30 @@ Lsdb::getLsaExpirationTimePoint()
   return expirationTimePoint;
 }
 
+ndn::time::seconds
+Lsdb::getJitteredLsaRefreshTime()
+{
+  // Refreshing early is always safe, since our LSAs are valid for the
+  // router dead interval, which is longer than the refresh time.
+  uint32_t maxJitter = static_cast<uint32_t>(m_lsaRefreshTime.count() / 10);
+  if (maxJitter == 0) {
+    return m_lsaRefreshTime;
+  }
+
+  uint32_t jitter = ndn::random::generateWord32() % (maxJitter + 1);
+  return m_lsaRefreshTime - ndn::time::seconds(jitter);
+}
+
 void
 Lsdb::writeAdjLsdbLog()
 {
+  if (!NLSR_LOG_IS_DEBUG_ENABLED()) {
+    return;
+  }
+
   NLSR_LOG_DEBUG("---------------Adj LSDB-------------------");
-  for (std::list<AdjLsa>::iterator it = m_adjLsdb.begin();
-       it != m_adjLsdb.end() ; it++) {
-    (*it).writeLog();
+  for (const AdjLsa& lsa : m_adjLsdb.getLsas()) {
+    lsa.writeLog();
   }
 }
 
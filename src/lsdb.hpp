@@ -24,14 +24,22 @@
 
 #include "conf-parameter.hpp"
 #include "lsa.hpp"
+#include "lsa-table.hpp"
+#include "lsdb-change-log.hpp"
 #include "sequencing-manager.hpp"
+#include "signals.hpp"
 #include "test-access-control.hpp"
+#include "communication/lsa-fetcher.hpp"
 #include "communication/sync-logic-handler.hpp"
+#include "publisher/lsa-segment-cache.hpp"
+#include "route/coordinate-cache.hpp"
 #include "statistics.hpp"
+#include "utility/timer-wheel.hpp"
 
 #include <ndn-cxx/security/key-chain.hpp>
 #include <ndn-cxx/util/signal.hpp>
 #include <ndn-cxx/util/time.hpp>
+#include <set>
 #include <utility>
 #include <boost/cstdint.hpp>
 
@@ -69,10 +77,11 @@ public:
   findNameLsa(const ndn::Name& key);
 
   /*! \brief Installs a name LSA into the LSDB
-    \param nlsa The name LSA to install into the LSDB.
+    \param nlsa The name LSA to install into the LSDB. Pass an rvalue
+    to have it moved, rather than copied, into the LSDB.
   */
   bool
-  installNameLsa(NameLsa& nlsa);
+  installNameLsa(NameLsa nlsa);
 
   /*! \brief Remove a name LSA from the LSDB.
     \param key The name of the router that published the LSA to remove.
@@ -108,10 +117,11 @@ public:
   findCoordinateLsa(const ndn::Name& key);
 
   /*! \brief Installs a cor. LSA into the LSDB.
-    \param clsa The cor. LSA to install.
+    \param clsa The cor. LSA to install. Pass an rvalue to have it
+    moved, rather than copied, into the LSDB.
   */
   bool
-  installCoordinateLsa(CoordinateLsa& clsa);
+  installCoordinateLsa(CoordinateLsa clsa);
 
   /*! \brief Removes a cor. LSA from the LSDB.
     \param key The name of the router that published the LSA to remove.
@@ -136,12 +146,32 @@ public:
   const std::list<CoordinateLsa>&
   getCoordinateLsdb() const;
 
+  /*! \brief Returns the coordinates of the routers in the cor. LSDB,
+    prepared for hyperbolic distance calculations.
+   */
+  const CoordinateCache&
+  getCoordinateCache() const
+  {
+    return m_coordinateCache;
+  }
+
   //function related to Adj LSDB
 
   /*! \brief Schedules a build of this router's LSA. */
   void
   scheduleAdjLsaBuild();
 
+  /*! \brief Schedules a routing table calculation after a change to the
+    LSAs or adjacencies of a router.
+
+    A change to another router's LSA waits while the LSAs announced by
+    a sync batch are fetched. A change at this router is never held
+    back, and releases any routing work that is being held.
+    \param originRouter The router whose LSAs or adjacencies changed.
+   */
+  void
+  scheduleRoutingTableCalculation(const ndn::Name& originRouter);
+
   /*! \brief Wrapper event to build and install an adj. LSA for this router. */
   bool
   buildAndInstallOwnAdjLsa();
@@ -163,10 +193,11 @@ public:
   isAdjLsaNew(const ndn::Name& key, uint64_t seqNo);
 
   /*! \brief Installs an adj. LSA into the LSDB.
-    \param alsa The adj. LSA to add to the LSDB.
+    \param alsa The adj. LSA to add to the LSDB. Pass an rvalue to
+    have it moved, rather than copied, into the LSDB.
   */
   bool
-  installAdjLsa(AdjLsa& alsa);
+  installAdjLsa(AdjLsa alsa);
 
   /*! \brief Finds an adj. LSA in the LSDB.
     \param key The name of the publishing router whose LSA to find.
@@ -204,19 +235,49 @@ public:
   void
   setThisRouterPrefix(std::string trp);
 
+  /*! \brief Fetches an LSA, unless a newer one is known.
+    \param interestName The name of the LSA, ending with its sequence number.
+    \param deadline Failed fetches are retried until this time.
+    \sa LsaFetcher
+   */
   void
-  expressInterest(const ndn::Name& interestName, uint32_t timeoutCount,
+  expressInterest(const ndn::Name& interestName,
                   ndn::time::steady_clock::TimePoint deadline = DEFAULT_LSA_RETRIEVAL_DEADLINE);
 
+  LsaFetcher&
+  getLsaFetcher()
+  {
+    return m_lsaFetcher;
+  }
+
   void
   processInterest(const ndn::Name& name, const ndn::Interest& interest);
 
+  /*! \brief Returns the generation of the LSDB.
+
+    The generation changes whenever an LSA is installed, updated,
+    refreshed or removed, so anything derived from the contents of the
+    LSDB stays valid for as long as the generation is the same. It is
+    the sequence number of the last change in the change log.
+   */
+  uint64_t
+  getGeneration() const
+  {
+    return m_changeLog.getLastSequenceNumber();
+  }
+
+  const LsdbChangeLog&
+  getChangeLog() const
+  {
+    return m_changeLog;
+  }
+
 private:
   /* \brief Add a name LSA to the LSDB if it isn't already there.
      \param nlsa The candidade name LSA.
   */
   bool
-  addNameLsa(NameLsa& nlsa);
+  addNameLsa(NameLsa&& nlsa);
 
   /*! \brief Returns whether the LSDB contains some LSA.
     \param key The name of the publishing router whose LSA to check for.
@@ -228,7 +289,7 @@ private:
     \param clsa The candidate cor. LSA.
   */
   bool
-  addCoordinateLsa(CoordinateLsa& clsa);
+  addCoordinateLsa(CoordinateLsa&& clsa);
 
   /*! \brief Returns whether a cor. LSA is in the LSDB.
     \param key The name of the router that published the queried LSA.
@@ -250,7 +311,7 @@ private:
     \param alsa The candidate adj. LSA to add to the LSDB.
   */
   bool
-  addAdjLsa(AdjLsa& alsa);
+  addAdjLsa(AdjLsa&& alsa);
 
   /*! \brief Returns whether the LSDB contains an LSA.
     \param key The name of a router whose LSA to check for in the LSDB.
@@ -258,12 +319,12 @@ private:
   bool
   doesAdjLsaExist(const ndn::Name& key);
 
-  /*! \brief Schedules a refresh/expire event in the scheduler.
+  /*! \brief Schedules a refresh/expire event in the LSA timer wheel.
     \param key The name of the router that published the LSA.
     \param seqNo The seq. no. associated with the LSA.
     \param expTime How many seconds to wait before triggering the event.
    */
-  ndn::EventId
+  util::TimerWheel::TimerId
   scheduleNameLsaExpiration(const ndn::Name& key, int seqNo,
                             const ndn::time::seconds& expTime);
 
@@ -280,7 +341,7 @@ PUBLIC_WITH_TESTS_ELSE_PRIVATE:
     \param seqNo The sequence number of the LSA to check.
     \param expTime The number of seconds to wait before triggering the event.
   */
-  ndn::EventId
+  util::TimerWheel::TimerId
   scheduleAdjLsaExpiration(const ndn::Name& key, int seqNo,
                            const ndn::time::seconds& expTime);
 
@@ -289,7 +350,7 @@ private:
   void
   expireOrRefreshAdjLsa(const ndn::Name& lsaKey, uint64_t seqNo);
 
-  ndn::EventId
+  util::TimerWheel::TimerId
   scheduleCoordinateLsaExpiration(const ndn::Name& key, int seqNo,
                                   const ndn::time::seconds& expTime);
 
@@ -300,7 +361,14 @@ private:
 private:
 
   void
-  putLsaData(const ndn::Interest& interest, const std::string& content);
+  putLsaData(const ndn::Interest& interest, const Lsa& lsa);
+
+  void
+  putLsaSegment(const ndn::Interest& interest, const ndn::Name& lsaKey,
+                Lsa::Type lsaType, uint64_t seqNo);
+
+  LsaSegmentCache::Publisher*
+  prepareLsaSegments(const Lsa& lsa, const ndn::Name& prefix);
 
   void
   processInterestForNameLsa(const ndn::Interest& interest,
@@ -321,71 +389,102 @@ private:
 
   void
   processContentNameLsa(const ndn::Name& lsaKey,
-                        uint64_t lsSeqNo, std::string& dataContent);
+                        uint64_t lsSeqNo, const ndn::Block& dataContent);
 
   void
   processContentAdjacencyLsa(const ndn::Name& lsaKey,
-                             uint64_t lsSeqNo, std::string& dataContent);
+                             uint64_t lsSeqNo, const ndn::Block& dataContent);
 
   void
   processContentCoordinateLsa(const ndn::Name& lsaKey,
-                              uint64_t lsSeqNo, std::string& dataContent);
+                              uint64_t lsSeqNo, const ndn::Block& dataContent);
 
 PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   /*!
-     \brief Error callback when SegmentFetcher fails to return an LSA
-
-     In all error cases, a reattempt to fetch the LSA will be made.
+     \brief Success callback when SegmentFetcher returns a valid LSA
 
-     Segment validation can fail either because the packet does not have a
-     valid signature (fatal) or because some of the certificates in the trust chain
-     could not be fetched (non-fatal).
+     \param interestName The base Interest used to fetch the LSA in the format:
+            /<network>/NLSR/LSA/<site>/%C1.Router/<router>/<lsa-type>/<seqNo>
+   */
+  void
+  afterFetchLsa(const ndn::ConstBufferPtr& data, const ndn::Name& interestName);
 
-     Currently, the library does not provide clear indication (besides a plain-text message
-     in the error callback) of the reason for the failure nor the segment that failed
-     to be validated, thus we will continue to try to fetch the LSA until the deadline
-     is reached.
+private:
+  /*! \brief Counts an Interest sent by the LSA fetcher in the statistics. */
+  void
+  afterSendLsaInterest(const ndn::Name& interestName);
+
+  /*! \brief Holds back routing table calculation and FIB updates until
+    an LSA announced by sync has been fetched.
+
+    The LSAs that one sync batch announces are fetched together. Once
+    each of them has been fetched, or has failed to be fetched once,
+    the routing table is calculated once and the FIB updates of all of
+    them are sent together. LSAs announced by later batches do not
+    extend the hold, and it ends after at most one LSA Interest
+    lifetime, so that routing work cannot starve under churn.
+    \param lsaName The name of the LSA without its sequence number.
    */
   void
-  onFetchLsaError(uint32_t errorCode,
-                  const std::string& msg,
-                  ndn::Name& interestName,
-                  uint32_t retransmitNo,
-                  const ndn::time::steady_clock::TimePoint& deadline,
-                  ndn::Name lsaName,
-                  uint64_t seqNo);
+  beforeSyncFetch(const ndn::Name& lsaName);
 
-  /*!
-     \brief Success callback when SegmentFetcher returns a valid LSA
+  void
+  afterSyncFetch(const ndn::Name& lsaName);
 
-     \param interestName The base Interest used to fetch the LSA in the format:
-            /<network>/NLSR/LSA/<site>/%C1.Router/<router>/<lsa-type>/<seqNo>
-   */
+  /*! \brief Stops adding the LSAs that sync announces to the current hold. */
+  void
+  afterSyncBatch();
+
+  /*! \brief Schedules any held routing table calculation and sends the held FIB updates. */
   void
-  afterFetchLsa(const ndn::ConstBufferPtr& data, ndn::Name& interestName);
+  releaseSyncHold();
 
 private:
   ndn::time::system_clock::TimePoint
   getLsaExpirationTimePoint();
 
-  /*! \brief Cancels an event in the event scheduler. */
+  /*! \brief Returns the time to wait before refreshing one of our own LSAs.
+
+    The LSA refresh time is shortened by a random amount of up to a
+    tenth, so that routers started together do not keep refreshing
+    their LSAs at the same moment.
+   */
+  ndn::time::seconds
+  getJitteredLsaRefreshTime();
+
+  /*! \brief Cancels an event in the LSA timer wheel. */
   void
-  cancelScheduleLsaExpiringEvent(ndn::EventId eid);
+  cancelScheduleLsaExpiringEvent(const util::TimerWheel::TimerId& eid);
 
 public:
   static const ndn::Name::Component NAME_COMPONENT;
 
   ndn::util::signal::Signal<Lsdb, Statistics::PacketType> lsaIncrementSignal;
 
+  /*! Emitted with the origin router and its adjacencies whenever an
+    adj. LSA is added, changes content, or is removed. The adjacencies
+    are empty if the LSA was removed.
+   */
+  AfterAdjLsaChange afterAdjLsaChange;
+
 private:
   Nlsr& m_nlsr;
   ndn::Scheduler& m_scheduler;
+  // Drives the expiration and refresh of all the LSAs
+  util::TimerWheel m_lsaTimers;
   SyncLogicHandler m_sync;
 
-  std::list<NameLsa> m_nameLsdb;
-  std::list<AdjLsa> m_adjLsdb;
-  std::list<CoordinateLsa> m_corLsdb;
+  LsaTable<NameLsa> m_nameLsdb;
+  LsaTable<AdjLsa> m_adjLsdb;
+  LsaTable<CoordinateLsa> m_corLsdb;
+  // Updated along with m_corLsdb
+  CoordinateCache m_coordinateCache;
+  LsdbChangeLog m_changeLog;
+
+PUBLIC_WITH_TESTS_ELSE_PRIVATE:
+  LsaSegmentCache m_lsaSegmentCache;
 
+private:
   ndn::time::seconds m_lsaRefreshTime;
   std::string m_thisRouterPrefix;
 
@@ -396,13 +495,24 @@ private:
   SequenceNumberMap m_highestSeqNo;
 
   static const ndn::time::seconds GRACE_PERIOD;
+  static const ndn::time::milliseconds LSA_TIMER_TICK;
   static const ndn::time::steady_clock::TimePoint DEFAULT_LSA_RETRIEVAL_DEADLINE;
 
   ndn::time::seconds m_adjLsaBuildInterval;
 
   SequencingManager m_sequencingManager;
 
+  LsaFetcher m_lsaFetcher;
+  // The LSAs announced by the held sync batch that are being fetched
+  std::set<ndn::Name> m_syncFetches;
+  bool m_isSyncHoldActive;
+  // Whether the held sync batch is still announcing LSAs
+  bool m_isSyncBatchOpen;
+  bool m_isRoutingCalcHeld;
+  ndn::EventId m_syncHoldTimeoutEvent;
+
   ndn::util::signal::ScopedConnection m_onNewLsaConnection;
+  ndn::util::signal::ScopedConnection m_afterSyncBatchConnection;
 
 };
 
@@ -19,6 +19,7 @@
  * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
  **/
 
+#include "logger.hpp"
 #include "nlsr-runner.hpp"
 #include "version.hpp"
 
@@ -59,8 +60,10 @@ main(int32_t argc, char** argv)
   }
   catch (const std::exception& e) {
     std::cerr << e.what() << std::endl;
+    SHUTDOWN_LOGGERS();
     return EXIT_FAILURE;
   }
 
+  SHUTDOWN_LOGGERS();
   return EXIT_SUCCESS;
 }
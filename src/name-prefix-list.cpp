@@ -49,8 +49,15 @@ NamePrefixList::NamePrefixList(const std::initializer_list<NamePrefixList::NameP
 {
 }
 
-NamePrefixList::~NamePrefixList()
+NamePrefixList::NamePrefixList(std::vector<ndn::Name>&& names)
 {
+  std::sort(names.begin(), names.end());
+  names.erase(std::unique(names.begin(), names.end()), names.end());
+
+  m_names.reserve(names.size());
+  for (ndn::Name& name : names) {
+    m_names.emplace_back(std::move(name), std::vector<std::string>{""});
+  }
 }
 
 std::vector<NamePrefixList::NamePair>::iterator
@@ -24,6 +24,7 @@
 
 #include <list>
 #include <string>
+#include <vector>
 #include <boost/cstdint.hpp>
 #include <ndn-cxx/name.hpp>
 
@@ -37,6 +38,7 @@ public:
     NAME,
     SOURCES
   };
+  typedef std::vector<NamePair>::const_iterator const_iterator;
 
   NamePrefixList();
 
@@ -52,7 +54,13 @@ public:
     }
   }
 
-  ~NamePrefixList();
+  /*! \brief Takes the names without copying them.
+
+    Duplicate names are only kept once, and the list is left sorted.
+    This is much faster than inserting a long list of names one by one.
+   */
+  explicit
+  NamePrefixList(std::vector<ndn::Name>&& names);
 
   /*! \brief inserts name into NamePrefixList
       \retval true If the name was successfully inserted.
@@ -80,6 +88,19 @@ public:
   std::list<ndn::Name>
   getNames() const;
 
+  /*! \brief Iterates over the names and their sources without copying them. */
+  const_iterator
+  begin() const
+  {
+    return m_names.begin();
+  }
+
+  const_iterator
+  end() const
+  {
+    return m_names.end();
+  }
+
   bool
   operator==(const NamePrefixList& other) const;
 
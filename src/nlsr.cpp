@@ -78,10 +78,16 @@ Nlsr::Nlsr(boost::asio::io_service& ioService, ndn::Scheduler& scheduler, ndn::F
   , m_nfdRibCommandProcessor(m_localhostDispatcher,
                              m_namePrefixList,
                              m_nlsrLsdb)
-  , m_statsCollector(m_nlsrLsdb, m_helloProtocol)
+  , m_statsCollector(m_nlsrLsdb, m_helloProtocol, m_routingTable, m_namePrefixTable, m_fib)
+  , m_statisticsDatasetHandler(m_statsCollector.getStatistics(),
+                               m_localhostDispatcher,
+                               m_routerNameDispatcher)
   , m_faceMonitor(m_nlsrFace)
   , m_firstHelloInterval(FIRST_HELLO_INTERVAL_DEFAULT)
 {
+  m_nlsrLsdb.afterAdjLsaChange.connect(std::bind(&RoutingTable::onAdjLsaChange,
+                                                &m_routingTable, _1, _2));
+
   m_faceMonitor.onNotification.connect(std::bind(&Nlsr::onFaceEventNotification, this, _1));
   m_faceMonitor.start();
 }
@@ -261,6 +267,10 @@ Nlsr::initialize()
   setFirstHelloInterval(m_confParam.getFirstHelloInterval());
   m_nlsrLsdb.setAdjLsaBuildInterval(m_confParam.getAdjLsaBuildInterval());
   m_routingTable.setRoutingCalcInterval(m_confParam.getRoutingCalcInterval());
+  m_routingTable.setRoutingCalcWaits(ndn::time::milliseconds(m_confParam.getRoutingCalcInitialWait()),
+                                     ndn::time::milliseconds(m_confParam.getRoutingCalcSecondaryWait()));
+  m_routingTable.setRoutingCalcThreads(m_nlsrFace.getIoService(),
+                                       m_confParam.getRoutingCalcThreads());
 
   m_nlsrLsdb.buildAndInstallOwnNameLsa();
 
@@ -420,7 +430,7 @@ Nlsr::onFaceEventNotification(const ndn::nfd::FaceEventNotification& faceEventNo
           adjacent->setInterestTimedOutNo(m_confParam.getInterestRetryNumber());
 
           if (m_confParam.getHyperbolicState() != HYPERBOLIC_STATE_OFF) {
-            getRoutingTable().scheduleRoutingTableCalculation(*this);
+            m_nlsrLsdb.scheduleRoutingTableCalculation(m_confParam.getRouterPrefix());
           }
           else {
             m_nlsrLsdb.scheduleAdjLsaBuild();
@@ -444,7 +454,7 @@ Nlsr::onFaceEventNotification(const ndn::nfd::FaceEventNotification& faceEventNo
         registerAdjacencyPrefixes(*adjacent, ndn::time::milliseconds::max());
 
         if (m_confParam.getHyperbolicState() != HYPERBOLIC_STATE_OFF) {
-          getRoutingTable().scheduleRoutingTableCalculation(*this);
+          m_nlsrLsdb.scheduleRoutingTableCalculation(m_confParam.getRouterPrefix());
         }
         else {
          m_nlsrLsdb.scheduleAdjLsaBuild();
@@ -31,6 +31,7 @@
 #include "test-access-control.hpp"
 #include "validator.hpp"
 #include "publisher/lsdb-dataset-interest-handler.hpp"
+#include "publisher/statistics-dataset-interest-handler.hpp"
 #include "route/fib.hpp"
 #include "route/name-prefix-table.hpp"
 #include "route/routing-table.hpp"
@@ -507,6 +508,7 @@ private:
   update::PrefixUpdateProcessor m_prefixUpdateProcessor;
   update::NfdRibCommandProcessor m_nfdRibCommandProcessor;
   StatsCollector m_statsCollector;
+  StatisticsDatasetInterestHandler m_statisticsDatasetHandler;
 
   ndn::nfd::FaceMonitor m_faceMonitor;
 
@@ -0,0 +1,127 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2017,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "lsa-segment-cache.hpp"
+
+namespace nlsr {
+
+const size_t LsaSegmentCache::DEFAULT_CAPACITY = 1024;
+
+LsaSegmentCache::LsaSegmentCache(size_t capacity)
+  : m_capacity(capacity)
+  , m_nHits(0)
+  , m_nMisses(0)
+{
+}
+
+LsaSegmentCache::Publisher*
+LsaSegmentCache::find(const ndn::Name& lsaKey, uint64_t seqNo, const ndn::Name& prefix)
+{
+  Entry* entry = findEntry(lsaKey);
+  if (entry == nullptr || entry->seqNo != seqNo || entry->prefix != prefix) {
+    ++m_nMisses;
+    return nullptr;
+  }
+
+  ++m_nHits;
+  return entry->publisher.get();
+}
+
+LsaSegmentCache::Publisher*
+LsaSegmentCache::findVersion(const ndn::Name& lsaKey, const ndn::Name& versionedPrefix)
+{
+  Entry* entry = findEntry(lsaKey);
+  if (entry == nullptr || entry->publisher->getVersionedPrefix() != versionedPrefix) {
+    return nullptr;
+  }
+
+  return entry->publisher.get();
+}
+
+void
+LsaSegmentCache::insert(const ndn::Name& lsaKey, uint64_t seqNo, const ndn::Name& prefix,
+                        std::shared_ptr<Publisher> publisher)
+{
+  auto it = m_entries.find(lsaKey);
+  if (it == m_entries.end()) {
+    if (m_entries.size() >= m_capacity) {
+      evictLeastRecentlyUsed();
+    }
+    it = m_entries.emplace(lsaKey, Entry()).first;
+    it->second.useOrderIt = m_useOrder.insert(m_useOrder.begin(), lsaKey);
+  }
+  else {
+    m_useOrder.splice(m_useOrder.begin(), m_useOrder, it->second.useOrderIt);
+  }
+
+  Entry& entry = it->second;
+  entry.seqNo = seqNo;
+  entry.prefix = prefix;
+  entry.expiresAt = ndn::time::steady_clock::now() + publisher->getFreshnessPeriod();
+  entry.publisher = std::move(publisher);
+}
+
+void
+LsaSegmentCache::erase(const ndn::Name& lsaKey)
+{
+  auto it = m_entries.find(lsaKey);
+  if (it != m_entries.end()) {
+    erase(it);
+  }
+}
+
+LsaSegmentCache::Entry*
+LsaSegmentCache::findEntry(const ndn::Name& lsaKey)
+{
+  auto it = m_entries.find(lsaKey);
+  if (it == m_entries.end()) {
+    return nullptr;
+  }
+
+  ndn::time::steady_clock::TimePoint now = ndn::time::steady_clock::now();
+  if (it->second.expiresAt <= now) {
+    erase(it);
+    return nullptr;
+  }
+
+  it->second.expiresAt = now + it->second.publisher->getFreshnessPeriod();
+  m_useOrder.splice(m_useOrder.begin(), m_useOrder, it->second.useOrderIt);
+  return &it->second;
+}
+
+void
+LsaSegmentCache::erase(Entries::iterator it)
+{
+  m_useOrder.erase(it->second.useOrderIt);
+  m_entries.erase(it);
+}
+
+void
+LsaSegmentCache::evictLeastRecentlyUsed()
+{
+  // Every entry is kept for the same freshness period after it was
+  // last used, so the least recently used is also the first to expire
+  if (!m_useOrder.empty()) {
+    erase(m_entries.find(m_useOrder.back()));
+  }
+}
+
+} // namespace nlsr
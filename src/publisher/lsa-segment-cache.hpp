@@ -0,0 +1,146 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2017,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NLSR_PUBLISHER_LSA_SEGMENT_CACHE_HPP
+#define NLSR_PUBLISHER_LSA_SEGMENT_CACHE_HPP
+
+#include "segment-publisher.hpp"
+
+#include <ndn-cxx/face.hpp>
+#include <ndn-cxx/name.hpp>
+#include <ndn-cxx/util/time.hpp>
+
+#include <list>
+#include <memory>
+#include <unordered_map>
+
+namespace nlsr {
+
+/*! \brief Keeps the publishers of the LSAs being served.
+
+  Serving an LSA means encoding it and signing its segments. Only the
+  first segment is signed when the LSA is asked for; the publisher
+  keeps the encoded LSA, and signs each later segment when its
+  Interest arrives. When several neighbors fetch the same version of
+  an LSA, the segments signed for the first of them are put again for
+  the others.
+
+  Only one version of each LSA is kept: a different sequence number
+  replaces it, and it is erased when the LSA leaves the LSDB. An entry
+  expires a freshness period after it was last used, since by then the
+  segments it has signed are stale. When the cache is full, the least
+  recently used entry is evicted.
+ */
+class LsaSegmentCache
+{
+public:
+  typedef SegmentPublisher<ndn::Face> Publisher;
+
+  explicit
+  LsaSegmentCache(size_t capacity = DEFAULT_CAPACITY);
+
+  /*! \brief Returns the publisher of an LSA version, or nullptr if it is not cached.
+    \param lsaKey The key of the LSA.
+    \param seqNo The sequence number of the LSA.
+    \param prefix The name the LSA was published under.
+
+    Counts a hit or a miss.
+   */
+  Publisher*
+  find(const ndn::Name& lsaKey, uint64_t seqNo, const ndn::Name& prefix);
+
+  /*! \brief Returns the publisher of an LSA whose segments are named
+      under a prefix, or nullptr if it is not cached.
+    \param lsaKey The key of the LSA.
+    \param versionedPrefix The name of the segments, without the segment number.
+   */
+  Publisher*
+  findVersion(const ndn::Name& lsaKey, const ndn::Name& versionedPrefix);
+
+  /*! \brief Caches the publisher of an LSA version, replacing any other version.
+   */
+  void
+  insert(const ndn::Name& lsaKey, uint64_t seqNo, const ndn::Name& prefix,
+         std::shared_ptr<Publisher> publisher);
+
+  void
+  erase(const ndn::Name& lsaKey);
+
+  size_t
+  size() const
+  {
+    return m_entries.size();
+  }
+
+  uint64_t
+  getNHits() const
+  {
+    return m_nHits;
+  }
+
+  uint64_t
+  getNMisses() const
+  {
+    return m_nMisses;
+  }
+
+  static const size_t DEFAULT_CAPACITY;
+
+private:
+  // The keys of the entries, the most recently used first
+  typedef std::list<ndn::Name> UseOrder;
+
+  struct Entry
+  {
+    uint64_t seqNo;
+    ndn::Name prefix;
+    std::shared_ptr<Publisher> publisher;
+    ndn::time::steady_clock::TimePoint expiresAt;
+    UseOrder::iterator useOrderIt;
+  };
+
+  typedef std::unordered_map<ndn::Name, Entry> Entries;
+
+  /*! \brief Returns the entry of an LSA, or nullptr if it is not cached.
+
+    An entry that has expired is erased. An entry that is found is kept
+    for another freshness period, and becomes the most recently used.
+   */
+  Entry*
+  findEntry(const ndn::Name& lsaKey);
+
+  void
+  erase(Entries::iterator it);
+
+  void
+  evictLeastRecentlyUsed();
+
+private:
+  size_t m_capacity;
+  Entries m_entries;
+  UseOrder m_useOrder;
+  uint64_t m_nHits;
+  uint64_t m_nMisses;
+};
+
+} // namespace nlsr
+
+#endif // NLSR_PUBLISHER_LSA_SEGMENT_CACHE_HPP
@@ -44,6 +44,10 @@ const ndn::PartialName ADJACENCIES_DATASET = ndn::PartialName("lsdb/adjacencies"
 const ndn::PartialName COORDINATES_DATASET = ndn::PartialName("lsdb/coordinates");
 const ndn::PartialName NAMES_DATASET = ndn::PartialName("lsdb/names");
 const ndn::PartialName LISTS_DATASET = ndn::PartialName("lsdb/list");
+const ndn::PartialName CHANGES_DATASET = ndn::PartialName("lsdb/changes");
+
+const ndn::time::seconds LsdbDatasetInterestHandler::MAX_CACHED_DATASET_AGE =
+  ndn::time::seconds(10);
 
 LsdbDatasetInterestHandler::LsdbDatasetInterestHandler(Lsdb& lsdb,
                                                        ndn::mgmt::Dispatcher& localHostDispatcher,
@@ -74,6 +78,46 @@ LsdbDatasetInterestHandler::setDispatcher(ndn::mgmt::Dispatcher& dispatcher)
   dispatcher.addStatusDataset(LISTS_DATASET,
     ndn::mgmt::makeAcceptAllAuthorization(),
     std::bind(&LsdbDatasetInterestHandler::publishAllStatus, this, _1, _2, _3));
+  dispatcher.addStatusDataset(CHANGES_DATASET,
+    ndn::mgmt::makeAcceptAllAuthorization(),
+    std::bind(&LsdbDatasetInterestHandler::publishChanges, this, _1, _2, _3));
+}
+
+bool
+LsdbDatasetInterestHandler::isCurrent(const CachedDataset& dataset) const
+{
+  return dataset.isEncoded &&
+         dataset.generation == m_lsdb.getGeneration() &&
+         ndn::time::steady_clock::now() - dataset.encodedAt < MAX_CACHED_DATASET_AGE;
+}
+
+template<typename T>
+void
+LsdbDatasetInterestHandler::encodeLsas(CachedDataset& dataset)
+{
+  dataset.blocks.clear();
+  for (const T& tlvLsa : getTlvLsas<T>(m_lsdb)) {
+    dataset.blocks.push_back(tlvLsa.wireEncode());
+  }
+  markEncoded(dataset);
+}
+
+void
+LsdbDatasetInterestHandler::markEncoded(CachedDataset& dataset)
+{
+  dataset.isEncoded = true;
+  dataset.generation = m_lsdb.getGeneration();
+  dataset.encodedAt = ndn::time::steady_clock::now();
+}
+
+void
+LsdbDatasetInterestHandler::appendDataset(const CachedDataset& dataset,
+                                          ndn::mgmt::StatusDatasetContext& context)
+{
+  for (const ndn::Block& block : dataset.blocks) {
+    context.append(block);
+  }
+  context.end();
 }
 
 void
@@ -82,71 +126,34 @@ LsdbDatasetInterestHandler::publishAdjStatus(const ndn::Name& topPrefix, const n
 {
   NLSR_LOG_DEBUG("Received interest:  " << interest);
 
-  auto lsaRange = std::make_pair<std::list<AdjLsa>::const_iterator,
-                                 std::list<AdjLsa>::const_iterator>(
-    m_lsdb.getAdjLsdb().cbegin(), m_lsdb.getAdjLsdb().cend());
-  for (auto lsa = lsaRange.first; lsa != lsaRange.second; lsa++) {
-    tlv::AdjacencyLsa tlvLsa;
-    std::shared_ptr<tlv::LsaInfo> tlvLsaInfo = tlv::makeLsaInfo(*lsa);
-    tlvLsa.setLsaInfo(*tlvLsaInfo);
-
-    for (const Adjacent& adj : lsa->getAdl().getAdjList()) {
-      tlv::Adjacency tlvAdj;
-      tlvAdj.setName(adj.getName());
-      tlvAdj.setUri(adj.getFaceUri().toString());
-      tlvAdj.setCost(adj.getLinkCost());
-      tlvLsa.addAdjacency(tlvAdj);
-    }
-    const ndn::Block& wire = tlvLsa.wireEncode();
-    context.append(wire);
+  if (!isCurrent(m_adjacencyDataset)) {
+    encodeLsas<tlv::AdjacencyLsa>(m_adjacencyDataset);
   }
-  context.end();
+  appendDataset(m_adjacencyDataset, context);
 }
 
 void
 LsdbDatasetInterestHandler::publishCoordinateStatus(const ndn::Name& topPrefix, const ndn::Interest& interest,
                                                     ndn::mgmt::StatusDatasetContext& context)
 {
-  auto lsaRange = std::make_pair<std::list<CoordinateLsa>::const_iterator,
-                                 std::list<CoordinateLsa>::const_iterator>(
-    m_lsdb.getCoordinateLsdb().cbegin(), m_lsdb.getCoordinateLsdb().cend());
-
   NLSR_LOG_DEBUG("Received interest:  " << interest);
-  for (auto lsa = lsaRange.first; lsa != lsaRange.second; lsa++) {
-    tlv::CoordinateLsa tlvLsa;
-    std::shared_ptr<tlv::LsaInfo> tlvLsaInfo = tlv::makeLsaInfo(*lsa);
-    tlvLsa.setLsaInfo(*tlvLsaInfo);
 
-    tlvLsa.setHyperbolicRadius(lsa->getCorRadius());
-    tlvLsa.setHyperbolicAngle(lsa->getCorTheta());
-
-    const ndn::Block& wire = tlvLsa.wireEncode();
-    context.append(wire);
+  if (!isCurrent(m_coordinateDataset)) {
+    encodeLsas<tlv::CoordinateLsa>(m_coordinateDataset);
   }
-  context.end();
+  appendDataset(m_coordinateDataset, context);
 }
 
 void
 LsdbDatasetInterestHandler::publishNameStatus(const ndn::Name& topPrefix, const ndn::Interest& interest,
                                               ndn::mgmt::StatusDatasetContext& context)
 {
-  auto lsaRange = std::make_pair<std::list<NameLsa>::const_iterator, std::list<NameLsa>::const_iterator>(
-    m_lsdb.getNameLsdb().cbegin(), m_lsdb.getNameLsdb().cend());
   NLSR_LOG_DEBUG("Received interest:  " << interest);
-  for (auto lsa = lsaRange.first; lsa != lsaRange.second; lsa++) {
-    tlv::NameLsa tlvLsa;
-
-    std::shared_ptr<tlv::LsaInfo> tlvLsaInfo = tlv::makeLsaInfo(*lsa);
-    tlvLsa.setLsaInfo(*tlvLsaInfo);
-
-    for (const ndn::Name& name : lsa->getNpl().getNames()) {
-      tlvLsa.addName(name);
-    }
 
-    const ndn::Block& wire = tlvLsa.wireEncode();
-    context.append(wire);
+  if (!isCurrent(m_nameDataset)) {
+    encodeLsas<tlv::NameLsa>(m_nameDataset);
   }
-  context.end();
+  appendDataset(m_nameDataset, context);
 }
 
 void
@@ -154,20 +161,54 @@ LsdbDatasetInterestHandler::publishAllStatus(const ndn::Name& topPrefix, const n
                                              ndn::mgmt::StatusDatasetContext& context)
 {
   NLSR_LOG_DEBUG("Received interest:  " << interest);
-  tlv::LsdbStatus lsdbStatus;
-  for (const tlv::AdjacencyLsa& tlvLsa : getTlvLsas<tlv::AdjacencyLsa>(m_lsdb)) {
-    lsdbStatus.addAdjacencyLsa(tlvLsa);
+
+  if (!isCurrent(m_lsdbStatusDataset)) {
+    tlv::LsdbStatus lsdbStatus;
+    for (const tlv::AdjacencyLsa& tlvLsa : getTlvLsas<tlv::AdjacencyLsa>(m_lsdb)) {
+      lsdbStatus.addAdjacencyLsa(tlvLsa);
+    }
+
+    for (const tlv::CoordinateLsa& tlvLsa : getTlvLsas<tlv::CoordinateLsa>(m_lsdb)) {
+      lsdbStatus.addCoordinateLsa(tlvLsa);
+    }
+
+    for (const tlv::NameLsa& tlvLsa : getTlvLsas<tlv::NameLsa>(m_lsdb)) {
+      lsdbStatus.addNameLsa(tlvLsa);
+    }
+
+    m_lsdbStatusDataset.blocks.assign(1, lsdbStatus.wireEncode());
+    markEncoded(m_lsdbStatusDataset);
   }
+  appendDataset(m_lsdbStatusDataset, context);
+}
+
+void
+LsdbDatasetInterestHandler::publishChanges(const ndn::Name& topPrefix, const ndn::Interest& interest,
+                                           ndn::mgmt::StatusDatasetContext& context)
+{
+  NLSR_LOG_DEBUG("Received interest:  " << interest);
 
-  for (const tlv::CoordinateLsa& tlvLsa : getTlvLsas<tlv::CoordinateLsa>(m_lsdb)) {
-    lsdbStatus.addCoordinateLsa(tlvLsa);
+  const LsdbChangeLog& changeLog = m_lsdb.getChangeLog();
+  const ndn::Name& interestName = interest.getName();
+  size_t epochIndex = topPrefix.size() + CHANGES_DATASET.size();
+  uint64_t epoch = changeLog.getEpoch();
+  uint64_t lastSeen = 0;
+
+  if (interestName.size() > epochIndex) {
+    if (interestName.size() != epochIndex + 2 ||
+        !interestName[epochIndex].isNumber() ||
+        !interestName[epochIndex + 1].isSequenceNumber()) {
+      context.reject(ndn::nfd::ControlResponse(400, "Malformed last seen change"));
+      return;
+    }
+    epoch = interestName[epochIndex].toNumber();
+    lastSeen = interestName[epochIndex + 1].toSequenceNumber();
   }
 
-  for (const tlv::NameLsa& tlvLsa : getTlvLsas<tlv::NameLsa>(m_lsdb)) {
-    lsdbStatus.addNameLsa(tlvLsa);
+  for (auto change = changeLog.findAfter(epoch, lastSeen); change != changeLog.getChanges().end();
+       ++change) {
+    context.append(tlv::LsdbChange(*change).wireEncode());
   }
-  const ndn::Block& wire = lsdbStatus.wireEncode();
-  context.append(wire);
   context.end();
 }
 
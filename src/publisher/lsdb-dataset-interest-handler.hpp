@@ -24,24 +24,33 @@
 
 #include "tlv/adjacency-lsa.hpp"
 #include "tlv/coordinate-lsa.hpp"
+#include "tlv/lsdb-change.hpp"
 #include "tlv/name-lsa.hpp"
 #include "lsdb.hpp"
+#include "test-access-control.hpp"
 
 #include <ndn-cxx/mgmt/dispatcher.hpp>
 #include <ndn-cxx/face.hpp>
 #include <boost/noncopyable.hpp>
 
+#include <vector>
+
 namespace nlsr {
 
 namespace dataset {
   const ndn::Name::Component ADJACENCY_COMPONENT = ndn::Name::Component{"adjacencies"};
   const ndn::Name::Component NAME_COMPONENT = ndn::Name::Component{"names"};
   const ndn::Name::Component COORDINATE_COMPONENT = ndn::Name::Component{"coordinates"};
+  const ndn::Name::Component CHANGES_COMPONENT = ndn::Name::Component{"changes"};
 } // namespace dataset
 
 /*!
    \brief Class to publish all lsa dataset
    \sa https://redmine.named-data.net/projects/nlsr/wiki/LSDB_DataSet
+
+   The encoding of each dataset is cached, and served again until the
+   LSDB changes generation, so polling an unchanged LSDB neither walks
+   it nor encodes it again.
  */
 class LsdbDatasetInterestHandler : boost::noncopyable
 {
@@ -105,6 +114,64 @@ private:
   publishAllStatus(const ndn::Name& topPrefix, const ndn::Interest& interest,
                    ndn::mgmt::StatusDatasetContext& context);
 
+  /*! \brief provide the changes to the LSDB since the one a consumer last saw
+
+    The Interest name may end with the epoch of that change, as a
+    number name component, and its sequence number, as a sequence
+    number name component. Without them, or when the epoch is not the
+    current one, all the changes kept are provided.
+   */
+  void
+  publishChanges(const ndn::Name& topPrefix, const ndn::Interest& interest,
+                 ndn::mgmt::StatusDatasetContext& context);
+
+PUBLIC_WITH_TESTS_ELSE_PRIVATE:
+  /*! \brief The encoding of a dataset, as of a generation of the LSDB.
+   */
+  struct CachedDataset
+  {
+    CachedDataset()
+      : isEncoded(false)
+      , generation(0)
+    {
+    }
+
+    bool isEncoded;
+    uint64_t generation;
+    ndn::time::steady_clock::TimePoint encodedAt;
+    std::vector<ndn::Block> blocks;
+  };
+
+  /*! \brief Returns whether a cached dataset is still that of the LSDB.
+
+    The LSAs in the datasets carry the time left until they expire, so
+    a dataset is also encoded again once it is MAX_CACHED_DATASET_AGE
+    old, even if the LSDB has not changed.
+   */
+  bool
+  isCurrent(const CachedDataset& dataset) const;
+
+  static const ndn::time::seconds MAX_CACHED_DATASET_AGE;
+
+private:
+  /*! \brief Encodes the LSAs of type T of the LSDB into a dataset.
+   */
+  template<typename T>
+  void
+  encodeLsas(CachedDataset& dataset);
+
+  void
+  markEncoded(CachedDataset& dataset);
+
+  static void
+  appendDataset(const CachedDataset& dataset, ndn::mgmt::StatusDatasetContext& context);
+
+PUBLIC_WITH_TESTS_ELSE_PRIVATE:
+  CachedDataset m_adjacencyDataset;
+  CachedDataset m_coordinateDataset;
+  CachedDataset m_nameDataset;
+  CachedDataset m_lsdbStatusDataset;
+
 private:
   const Lsdb& m_lsdb;
   ndn::Name m_routerNamePrefix;
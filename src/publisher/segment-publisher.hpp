@@ -29,6 +29,9 @@
 #include <ndn-cxx/encoding/encoding-buffer.hpp>
 #include <ndn-cxx/security/key-chain.hpp>
 
+#include <algorithm>
+#include <vector>
+
 namespace nlsr {
 
 /*! \brief provides a publisher of Status Dataset or other segmented octet stream
@@ -78,38 +81,108 @@ public:
   publish(const ndn::Name& prefix,
           const ndn::security::SigningInfo& signingInfo = ndn::security::KeyChain::DEFAULT_SIGNING_INFO)
   {
+    for (const std::shared_ptr<ndn::Data>& data : makeSegments(prefix, signingInfo)) {
+      m_face.put(*data);
+    }
+  }
+
+  /*! \brief Make the signed segments that publish() would put on the Face
+   *
+   * This lets a caller keep the segments and put them again later,
+   * without generating and signing them again.
+   */
+  std::vector<std::shared_ptr<ndn::Data>>
+  makeSegments(const ndn::Name& prefix,
+               const ndn::security::SigningInfo& signingInfo = ndn::security::KeyChain::DEFAULT_SIGNING_INFO)
+  {
+    std::vector<std::shared_ptr<ndn::Data>> segments;
+
     ndn::EncodingBuffer buffer;
     generate(buffer);
 
-    const uint8_t* rawBuffer = buffer.buf();
-    const uint8_t* segmentBegin = rawBuffer;
-    const uint8_t* end = rawBuffer + buffer.size();
-
     ndn::Name segmentPrefix(prefix);
     segmentPrefix.appendVersion();
 
-    uint64_t segmentNo = 0;
-    do {
-      const uint8_t* segmentEnd = segmentBegin + getMaxSegmentSize();
-      if (segmentEnd > end) {
-        segmentEnd = end;
-      }
+    uint64_t nSegments = getNSegments(buffer.size());
+    for (uint64_t segmentNo = 0; segmentNo < nSegments; ++segmentNo) {
+      segments.push_back(makeSegment(segmentPrefix, buffer.buf(), buffer.size(), segmentNo,
+                                     signingInfo));
+    }
+
+    return segments;
+  }
+
+  /*! \brief Publish only the first segment of the data under the provided prefix
+   *
+   * The octets from SegmentPublisher::generate are kept, and each later
+   * segment is made and signed only when getSegment() asks for it,
+   * normally because an Interest for it has arrived. Segments that no
+   * consumer fetches are never signed.
+   */
+  void
+  publishFirstSegment(const ndn::Name& prefix,
+                      const ndn::security::SigningInfo& signingInfo =
+                        ndn::security::KeyChain::DEFAULT_SIGNING_INFO)
+  {
+    prepareSegments(ndn::Name(prefix).appendVersion(), signingInfo);
+
+    m_face.put(*getSegment(0));
+  }
+
+  /*! \brief Keep the data to be served by getSegment() under a versioned prefix
+   *
+   * Nothing is signed or put. A publisher prepared with the same
+   * versioned prefix and the same octets makes the same segments, so
+   * one that was dropped can be made again when a later segment is
+   * asked for.
+   */
+  void
+  prepareSegments(const ndn::Name& versionedPrefix,
+                  const ndn::security::SigningInfo& signingInfo =
+                    ndn::security::KeyChain::DEFAULT_SIGNING_INFO)
+  {
+    ndn::EncodingBuffer buffer;
+    generate(buffer);
 
-      ndn::Name segmentName(segmentPrefix);
-      segmentName.appendSegment(segmentNo);
+    m_content = std::make_shared<ndn::Buffer>(buffer.buf(), buffer.size());
+    m_versionedPrefix = versionedPrefix;
+    m_signingInfo = signingInfo;
+    m_segments.assign(getNSegments(m_content->size()), nullptr);
+  }
 
-      std::shared_ptr<ndn::Data> data = std::make_shared<ndn::Data>(segmentName);
-      data->setContent(segmentBegin, segmentEnd - segmentBegin);
-      data->setFreshnessPeriod(m_freshnessPeriod);
+  /*! \brief Returns a segment of the data kept by publishFirstSegment() or prepareSegments()
+   *
+   * The segment is made and signed the first time it is asked for.
+   *
+   * \return the segment, or nullptr if there is no such segment
+   */
+  std::shared_ptr<ndn::Data>
+  getSegment(uint64_t segmentNo)
+  {
+    if (segmentNo >= m_segments.size()) {
+      return nullptr;
+    }
+
+    std::shared_ptr<ndn::Data>& segment = m_segments[segmentNo];
+    if (segment == nullptr) {
+      segment = makeSegment(m_versionedPrefix, m_content->data(), m_content->size(), segmentNo,
+                            m_signingInfo);
+    }
+    return segment;
+  }
 
-      segmentBegin = segmentEnd;
-      if (segmentBegin >= end) {
-        data->setFinalBlockId(segmentName[-1]);
-      }
+  /*! \brief The prefix, with its version, of the segments made by getSegment()
+   */
+  const ndn::Name&
+  getVersionedPrefix() const
+  {
+    return m_versionedPrefix;
+  }
 
-      publishSegment(data, signingInfo);
-      ++segmentNo;
-    } while (segmentBegin < end);
+  const ndn::time::milliseconds&
+  getFreshnessPeriod() const
+  {
+    return m_freshnessPeriod;
   }
 
 protected:
@@ -119,19 +192,50 @@ protected:
   generate(ndn::EncodingBuffer& outBuffer) = 0;
 
 private:
-  /*! \brief Helper function to sign and put data on a Face.
+  static uint64_t
+  getNSegments(size_t size)
+  {
+    // Even no octets are published, as one empty segment
+    return size == 0 ? 1 : (size + getMaxSegmentSize() - 1) / getMaxSegmentSize();
+  }
+
+  /*! \brief Make and sign one segment of the octets in [content, content + size)
+   *
+   * The last segment is distinguished by having the final block ID set
+   * to its segment number.
    */
-  void
-  publishSegment(std::shared_ptr<ndn::Data>& data, const ndn::security::SigningInfo& signingInfo)
+  std::shared_ptr<ndn::Data>
+  makeSegment(const ndn::Name& versionedPrefix, const uint8_t* content, size_t size,
+              uint64_t segmentNo, const ndn::security::SigningInfo& signingInfo)
   {
+    size_t segmentBegin = segmentNo * getMaxSegmentSize();
+    size_t segmentEnd = std::min(segmentBegin + getMaxSegmentSize(), size);
+
+    ndn::Name segmentName(versionedPrefix);
+    segmentName.appendSegment(segmentNo);
+
+    std::shared_ptr<ndn::Data> data = std::make_shared<ndn::Data>(segmentName);
+    data->setContent(content + segmentBegin, segmentEnd - segmentBegin);
+    data->setFreshnessPeriod(m_freshnessPeriod);
+
+    if (segmentEnd >= size) {
+      data->setFinalBlockId(segmentName[-1]);
+    }
+
     m_keyChain.sign(*data, signingInfo);
-    m_face.put(*data);
+    return data;
   }
 
 private:
   FaceBase& m_face;
   ndn::KeyChain& m_keyChain;
   const ndn::time::milliseconds m_freshnessPeriod;
+
+  // The state of prepareSegments()
+  ndn::ConstBufferPtr m_content;
+  ndn::Name m_versionedPrefix;
+  ndn::security::SigningInfo m_signingInfo;
+  std::vector<std::shared_ptr<ndn::Data>> m_segments;
 };
 
 } // namespace nlsr
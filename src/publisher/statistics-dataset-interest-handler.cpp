@@ -0,0 +1,62 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2017,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "statistics-dataset-interest-handler.hpp"
+
+#include "tlv/router-statistics.hpp"
+#include "logger.hpp"
+
+namespace nlsr {
+
+INIT_LOGGER("StatisticsDatasetInterestHandler");
+
+const ndn::PartialName STATISTICS_DATASET = ndn::PartialName("statistics");
+
+StatisticsDatasetInterestHandler::StatisticsDatasetInterestHandler(const Statistics& statistics,
+                                                                   ndn::mgmt::Dispatcher& localHostDispatcher,
+                                                                   ndn::mgmt::Dispatcher& routerNameDispatcher)
+  : m_statistics(statistics)
+{
+  NLSR_LOG_DEBUG("Setting dispatcher for statistics dataset");
+  setDispatcher(localHostDispatcher);
+  setDispatcher(routerNameDispatcher);
+}
+
+void
+StatisticsDatasetInterestHandler::setDispatcher(ndn::mgmt::Dispatcher& dispatcher)
+{
+  dispatcher.addStatusDataset(STATISTICS_DATASET,
+    ndn::mgmt::makeAcceptAllAuthorization(),
+    std::bind(&StatisticsDatasetInterestHandler::publishStatistics, this, _1, _2, _3));
+}
+
+void
+StatisticsDatasetInterestHandler::publishStatistics(const ndn::Name& topPrefix,
+                                                    const ndn::Interest& interest,
+                                                    ndn::mgmt::StatusDatasetContext& context)
+{
+  NLSR_LOG_DEBUG("Received interest:  " << interest);
+
+  context.append(tlv::makeRouterStatistics(m_statistics).wireEncode());
+  context.end();
+}
+
+} // namespace nlsr
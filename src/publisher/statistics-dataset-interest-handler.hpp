@@ -0,0 +1,67 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2017,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NLSR_PUBLISHER_STATISTICS_DATASET_INTEREST_HANDLER_HPP
+#define NLSR_PUBLISHER_STATISTICS_DATASET_INTEREST_HANDLER_HPP
+
+#include "statistics.hpp"
+
+#include <ndn-cxx/mgmt/dispatcher.hpp>
+#include <boost/noncopyable.hpp>
+
+namespace nlsr {
+
+namespace dataset {
+  const ndn::Name::Component STATISTICS_COMPONENT = ndn::Name::Component{"statistics"};
+} // namespace dataset
+
+/*!
+   \brief Class to publish the packet counters and duration histograms of NLSR
+
+   The dataset is a single RouterStatistics block, published under
+   the same prefixes as the LSDB datasets.
+
+   \sa tlv::RouterStatistics
+ */
+class StatisticsDatasetInterestHandler : boost::noncopyable
+{
+public:
+  StatisticsDatasetInterestHandler(const Statistics& statistics,
+                                   ndn::mgmt::Dispatcher& localHostDispatcher,
+                                   ndn::mgmt::Dispatcher& routerNameDispatcher);
+
+private:
+  void
+  setDispatcher(ndn::mgmt::Dispatcher& dispatcher);
+
+  /*! \brief provide statistics dataset
+   */
+  void
+  publishStatistics(const ndn::Name& topPrefix, const ndn::Interest& interest,
+                    ndn::mgmt::StatusDatasetContext& context);
+
+private:
+  const Statistics& m_statistics;
+};
+
+} // namespace nlsr
+
+#endif // NLSR_PUBLISHER_STATISTICS_DATASET_INTEREST_HANDLER_HPP
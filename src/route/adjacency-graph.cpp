@@ -0,0 +1,166 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2017,  The University of Memphis,
+ *                           Regents of the University of California
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "adjacency-graph.hpp"
+#include "logger.hpp"
+
+#include <algorithm>
+#include <ostream>
+
+namespace nlsr {
+
+INIT_LOGGER("AdjacencyGraph");
+
+static bool
+linkCompare(const AdjacencyGraph::Link& a, const AdjacencyGraph::Link& b)
+{
+  return a.from < b.from || (a.from == b.from && a.to < b.to);
+}
+
+double
+AdjacencyGraph::correctLinkCost(double toCost, double fromCost)
+{
+  if (fromCost == toCost) {
+    return toCost;
+  }
+
+  // If both sides of the link are up, use the larger cost
+  if (toCost != 0 && fromCost != 0) {
+    return std::max(toCost, fromCost);
+  }
+  return 0.0;
+}
+
+void
+AdjacencyGraph::build(size_t nRouters, std::vector<Link>& links)
+{
+  m_offsets.assign(nRouters + 1, 0);
+  m_targets.clear();
+  m_costs.clear();
+
+  // A later advertisement of the same link overrides an earlier one
+  std::stable_sort(links.begin(), links.end(), &linkCompare);
+  auto last = std::unique(links.rbegin(), links.rend(),
+                          [] (const Link& a, const Link& b) {
+                            return a.from == b.from && a.to == b.to;
+                          }).base();
+  links.erase(links.begin(), last);
+
+  std::vector<double> correctedCosts(links.size(), 0.0);
+
+  for (size_t i = 0; i < links.size(); ++i) {
+    const Link& link = links[i];
+
+    if (link.from == link.to || link.from < 0 || link.to < 0 ||
+        static_cast<size_t>(link.from) >= nRouters || static_cast<size_t>(link.to) >= nRouters) {
+      continue;
+    }
+
+    Link reverse{link.to, link.from, 0};
+    auto it = std::lower_bound(links.begin(), links.end(), reverse, &linkCompare);
+    bool hasReverse = (it != links.end() && it->from == link.to && it->to == link.from);
+
+    double toCost = link.cost;
+    double fromCost = hasReverse ? it->cost : 0.0;
+
+    correctedCosts[i] = correctLinkCost(toCost, fromCost);
+
+    // Only warn once for each pair of routers
+    if (fromCost != toCost && (!hasReverse || link.from < link.to)) {
+      NLSR_LOG_WARN("Cost between [" << link.from << "][" << link.to << "] and [" << link.to <<
+                    "][" << link.from << "] are not the same (" << toCost << " != " <<
+                    fromCost << "). " << "Correcting to cost: " << correctedCosts[i]);
+    }
+
+    if (correctedCosts[i] > 0) {
+      ++m_offsets[link.from + 1];
+    }
+  }
+
+  for (size_t i = 0; i < nRouters; ++i) {
+    m_offsets[i + 1] += m_offsets[i];
+  }
+
+  m_targets.reserve(m_offsets[nRouters]);
+  m_costs.reserve(m_offsets[nRouters]);
+
+  // The links are sorted by source, so they can be appended in order
+  for (size_t i = 0; i < links.size(); ++i) {
+    if (correctedCosts[i] > 0) {
+      m_targets.push_back(links[i].to);
+      m_costs.push_back(correctedCosts[i]);
+    }
+  }
+}
+
+size_t
+AdjacencyGraph::findLink(int32_t from, int32_t to) const
+{
+  auto begin = m_targets.begin() + linksBegin(from);
+  auto end = m_targets.begin() + linksEnd(from);
+
+  auto it = std::lower_bound(begin, end, to);
+  if (it == end || *it != to) {
+    return linksEnd(from);
+  }
+  return it - m_targets.begin();
+}
+
+double
+AdjacencyGraph::getLinkCost(int32_t from, int32_t to) const
+{
+  size_t link = findLink(from, to);
+  if (link == linksEnd(from)) {
+    return 0;
+  }
+  return m_costs[link];
+}
+
+/*! \brief Prints the links of one router, so that nothing is formatted unless it is logged. */
+struct RouterLinks
+{
+  const AdjacencyGraph& graph;
+  size_t router;
+};
+
+static std::ostream&
+operator<<(std::ostream& os, const RouterLinks& links)
+{
+  os << links.router << ":";
+  for (size_t link = links.graph.linksBegin(links.router);
+       link < links.graph.linksEnd(links.router); ++link) {
+    os << " " << links.graph.getLinkTarget(link) << "(" << links.graph.getLinkCost(link) << ")";
+  }
+  return os;
+}
+
+void
+AdjacencyGraph::writeLog() const
+{
+  if (!NLSR_LOG_IS_DEBUG_ENABLED()) {
+    return;
+  }
+
+  for (size_t i = 0; i < getNRouters(); ++i) {
+    NLSR_LOG_DEBUG((RouterLinks{*this, i}));
+  }
+}
+
+} // namespace nlsr
@@ -0,0 +1,140 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2017,  The University of Memphis,
+ *                           Regents of the University of California
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NLSR_ADJACENCY_GRAPH_HPP
+#define NLSR_ADJACENCY_GRAPH_HPP
+
+#include <vector>
+#include <boost/cstdint.hpp>
+
+namespace nlsr {
+
+/*! \brief A sparse adjacency graph of routers, in compressed sparse row (CSR) form.
+
+  Routers are identified by their mappingNo in a Map. The links of the
+  router with mappingNo i occupy the contiguous range [linksBegin(i),
+  linksEnd(i)) of the link target and link cost arrays, sorted by
+  target. Memory use and build time are proportional to the number of
+  links, not to the square of the number of routers.
+ */
+class AdjacencyGraph
+{
+public:
+  /*! \brief A directed link as advertised in some router's adj. LSA. */
+  struct Link
+  {
+    int32_t from;
+    int32_t to;
+    double cost;
+  };
+
+  AdjacencyGraph()
+    : m_offsets(1, 0)
+  {
+  }
+
+  /*! \brief Builds the graph from the advertised links.
+    \param nRouters The number of routers; every mappingNo must be below this.
+    \param links The advertised links. This vector is sorted in place.
+
+    Links that do not have the same cost for both directions have
+    their costs corrected:
+
+      If the cost of one side of the link is 0, or one side of the
+      link is not advertised at all, the link is considered down.
+
+      Otherwise, both sides of the link use the larger of the two costs.
+
+    Only links with a positive (corrected) cost are kept.
+   */
+  void
+  build(size_t nRouters, std::vector<Link>& links);
+
+  /*! \brief Returns the cost a link is used with, given the costs advertised for it.
+    \param toCost The cost advertised by one side of the link, or 0 if not advertised.
+    \param fromCost The cost advertised by the other side, or 0 if not advertised.
+
+    \sa build for how asymmetric costs are corrected.
+   */
+  static double
+  correctLinkCost(double toCost, double fromCost);
+
+  size_t
+  getNRouters() const
+  {
+    return m_offsets.size() - 1;
+  }
+
+  size_t
+  getNLinks() const
+  {
+    return m_targets.size();
+  }
+
+  size_t
+  linksBegin(int32_t router) const
+  {
+    return m_offsets[router];
+  }
+
+  size_t
+  linksEnd(int32_t router) const
+  {
+    return m_offsets[router + 1];
+  }
+
+  size_t
+  getNumOfLinks(int32_t router) const
+  {
+    return linksEnd(router) - linksBegin(router);
+  }
+
+  int32_t
+  getLinkTarget(size_t link) const
+  {
+    return m_targets[link];
+  }
+
+  double
+  getLinkCost(size_t link) const
+  {
+    return m_costs[link];
+  }
+
+  /*! \brief Returns the index of the link between two routers, or linksEnd(from) if they are not linked. */
+  size_t
+  findLink(int32_t from, int32_t to) const;
+
+  /*! \brief Returns the cost of the link between two routers, or 0 if they are not linked. */
+  double
+  getLinkCost(int32_t from, int32_t to) const;
+
+  void
+  writeLog() const;
+
+private:
+  std::vector<size_t> m_offsets;
+  std::vector<int32_t> m_targets;
+  std::vector<double> m_costs;
+};
+
+} // namespace nlsr
+
+#endif // NLSR_ADJACENCY_GRAPH_HPP
@@ -0,0 +1,78 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2017,  The University of Memphis,
+ *                           Regents of the University of California
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "calculation-pool.hpp"
+#include "logger.hpp"
+
+#include <atomic>
+
+namespace nlsr {
+
+INIT_LOGGER("CalculationPool");
+
+CalculationPool::CalculationPool(boost::asio::io_service& ioService, size_t nThreads)
+  : m_mainIoService(ioService)
+  , m_work(new boost::asio::io_service::work(m_workIoService))
+  , m_isRunning(std::make_shared<bool>(true))
+{
+  for (size_t i = 0; i < nThreads; ++i) {
+    m_threads.create_thread([this] { m_workIoService.run(); });
+  }
+  NLSR_LOG_INFO("Started " << nThreads << " route calculation threads");
+}
+
+CalculationPool::~CalculationPool()
+{
+  *m_isRunning = false;
+  m_work.reset();
+  m_workIoService.stop();
+  m_threads.join_all();
+}
+
+void
+CalculationPool::run(std::vector<std::function<void()>> tasks, std::function<void()> afterAll)
+{
+  std::shared_ptr<bool> isRunning = m_isRunning;
+  auto deliver = [isRunning, afterAll] {
+    if (*isRunning) {
+      afterAll();
+    }
+  };
+
+  if (tasks.empty()) {
+    m_mainIoService.post(deliver);
+    return;
+  }
+
+  // The worker that finishes the last task hands the results back. Until
+  // then, the main io_service is kept from running out of work.
+  auto nRemaining = std::make_shared<std::atomic<size_t>>(tasks.size());
+  auto mainWork = std::make_shared<boost::asio::io_service::work>(m_mainIoService);
+  for (std::function<void()>& task : tasks) {
+    m_workIoService.post([this, task, nRemaining, mainWork, deliver] {
+      task();
+      if (--*nRemaining == 0) {
+        m_mainIoService.post(deliver);
+      }
+    });
+  }
+}
+
+} // namespace nlsr
@@ -0,0 +1,80 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2017,  The University of Memphis,
+ *                           Regents of the University of California
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NLSR_CALCULATION_POOL_HPP
+#define NLSR_CALCULATION_POOL_HPP
+
+#include <functional>
+#include <memory>
+#include <vector>
+#include <boost/asio/io_service.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/thread/thread.hpp>
+
+namespace nlsr {
+
+/*! \brief A pool of worker threads that route calculations run on.
+
+  NLSR otherwise does everything on the thread that runs the main
+  io_service. Tasks given to the pool must only read state that the
+  main thread does not change while they run, such as a snapshot of
+  the adj. LSDB; their results are handed back on the main thread.
+ */
+class CalculationPool : boost::noncopyable
+{
+public:
+  /*! \param ioService The main io_service, where results are handed back.
+    \param nThreads The number of worker threads to start.
+   */
+  CalculationPool(boost::asio::io_service& ioService, size_t nThreads);
+
+  /*! \brief Waits for the running tasks and stops the workers.
+
+    Queued tasks are dropped, and afterAll handlers that have not run yet
+    will not be called.
+   */
+  ~CalculationPool();
+
+  /*! \brief Runs tasks concurrently on the workers.
+    \param tasks The tasks to run, in no particular order.
+    \param afterAll Posted to the main io_service once every task has finished.
+   */
+  void
+  run(std::vector<std::function<void()>> tasks, std::function<void()> afterAll);
+
+  size_t
+  getNThreads() const
+  {
+    return m_threads.size();
+  }
+
+private:
+  boost::asio::io_service& m_mainIoService;
+  boost::asio::io_service m_workIoService;
+  std::unique_ptr<boost::asio::io_service::work> m_work;
+  boost::thread_group m_threads;
+
+  // Cleared on destruction, so that late afterAll handlers are skipped
+  std::shared_ptr<bool> m_isRunning;
+};
+
+} // namespace nlsr
+
+#endif // NLSR_CALCULATION_POOL_HPP
@@ -0,0 +1,196 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2017,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "coordinate-cache.hpp"
+#include "logger.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <boost/math/constants/constants.hpp>
+
+namespace nlsr {
+
+INIT_LOGGER("CoordinateCache");
+
+const double CoordinateCache::UNKNOWN_DISTANCE = -1.0;
+
+void
+CoordinateCache::insert(const ndn::Name& router, double radius, const std::vector<double>& angles)
+{
+  size_t slot = m_routers.size();
+  auto it = m_slots.find(router);
+  if (it != m_slots.end()) {
+    slot = it->second;
+  }
+  else {
+    m_slots.emplace(router, slot);
+    m_routers.push_back(router);
+    m_coshRadius.push_back(0.0);
+    m_sinhRadius.push_back(0.0);
+    m_dimensions.push_back(0);
+    for (auto& axis : m_axes) {
+      axis.push_back(0.0);
+    }
+  }
+
+  // Usually, we set zeta = 1 in all experiments
+  m_coshRadius[slot] = std::cosh(radius);
+  m_sinhRadius[slot] = std::sinh(radius);
+
+  const double twoPi = 2 * boost::math::constants::pi<double>();
+  if (radius <= 0.0 || angles.empty() || angles.back() < 0.0 || angles.back() > twoPi) {
+    NLSR_LOG_ERROR("Invalid coordinates for " << router << ": the radius must be positive "
+                   "and the last angle within [0, 2PI]");
+    m_dimensions[slot] = 0;
+    return;
+  }
+
+  // https://en.wikipedia.org/wiki/N-sphere#Spherical_coordinates
+  // x_0 = cos(a_0), x_m = sin(a_0) ... sin(a_(m-1)) cos(a_m), x_d = sin(a_0) ... sin(a_(d-1))
+  size_t dimension = angles.size() + 1;
+  while (m_axes.size() < dimension) {
+    m_axes.emplace_back(m_routers.size(), 0.0);
+  }
+
+  double sinProduct = 1.0;
+  for (size_t k = 0; k < angles.size(); ++k) {
+    m_axes[k][slot] = sinProduct * std::cos(angles[k]);
+    sinProduct *= std::sin(angles[k]);
+  }
+  m_axes[angles.size()][slot] = sinProduct;
+  for (size_t k = dimension; k < m_axes.size(); ++k) {
+    m_axes[k][slot] = 0.0;
+  }
+  m_dimensions[slot] = dimension;
+}
+
+void
+CoordinateCache::erase(const ndn::Name& router)
+{
+  auto it = m_slots.find(router);
+  if (it == m_slots.end()) {
+    return;
+  }
+
+  // Move the last router into the freed slot, so that the arrays stay dense
+  size_t slot = it->second;
+  size_t last = m_routers.size() - 1;
+  m_slots.erase(it);
+  if (slot != last) {
+    m_slots[m_routers[last]] = slot;
+    m_routers[slot] = std::move(m_routers[last]);
+    m_coshRadius[slot] = m_coshRadius[last];
+    m_sinhRadius[slot] = m_sinhRadius[last];
+    m_dimensions[slot] = m_dimensions[last];
+    for (auto& axis : m_axes) {
+      axis[slot] = axis[last];
+    }
+  }
+
+  m_routers.pop_back();
+  m_coshRadius.pop_back();
+  m_sinhRadius.pop_back();
+  m_dimensions.pop_back();
+  for (auto& axis : m_axes) {
+    axis.pop_back();
+  }
+}
+
+ndn::optional<size_t>
+CoordinateCache::find(const ndn::Name& router) const
+{
+  auto it = m_slots.find(router);
+  if (it == m_slots.end()) {
+    return ndn::nullopt;
+  }
+  return it->second;
+}
+
+void
+CoordinateCache::calculateDistances(size_t source, std::vector<double>& distances) const
+{
+  size_t nRouters = m_routers.size();
+  size_t dimension = m_dimensions[source];
+  if (dimension == 0) {
+    distances.assign(nRouters, UNKNOWN_DISTANCE);
+    return;
+  }
+
+  // The dot products of the source's point with every other point,
+  // accumulated one axis at a time.
+  distances.assign(nRouters, 0.0);
+  double* dotProducts = distances.data();
+  for (size_t k = 0; k < dimension; ++k) {
+    const double* axis = m_axes[k].data();
+    const double sourceCoordinate = axis[source];
+    for (size_t i = 0; i < nRouters; ++i) {
+      dotProducts[i] += sourceCoordinate * axis[i];
+    }
+  }
+
+  // cosh(x) = cosh(r_s) cosh(r_i) - sinh(r_s) sinh(r_i) cos(deltaTheta). It is
+  // at least 1, so a negative value marks the routers with no distance.
+  const double coshSource = m_coshRadius[source];
+  const double sinhSource = m_sinhRadius[source];
+  const double* coshRadius = m_coshRadius.data();
+  const double* sinhRadius = m_sinhRadius.data();
+  const size_t* dimensions = m_dimensions.data();
+  for (size_t i = 0; i < nRouters; ++i) {
+    double coshDistance = coshSource * coshRadius[i] - sinhSource * sinhRadius[i] * dotProducts[i];
+    bool isKnown = dimensions[i] == dimension && dotProducts[i] < 1.0;
+    dotProducts[i] = isKnown ? coshDistance : -1.0;
+  }
+
+  for (size_t i = 0; i < nRouters; ++i) {
+    distances[i] = distances[i] < 0.0 ? UNKNOWN_DISTANCE : std::acosh(std::max(distances[i], 1.0));
+  }
+}
+
+double
+CoordinateCache::getDistance(size_t source, size_t destination) const
+{
+  size_t dimension = m_dimensions[source];
+  if (dimension == 0) {
+    return UNKNOWN_DISTANCE;
+  }
+
+  double dotProduct = 0.0;
+  for (size_t k = 0; k < dimension; ++k) {
+    dotProduct += m_axes[k][source] * m_axes[k][destination];
+  }
+  return calculateDistance(source, destination, dotProduct);
+}
+
+double
+CoordinateCache::calculateDistance(size_t source, size_t destination, double dotProduct) const
+{
+  // The dot product is the cosine of the angular distance, which must
+  // not be 0, and the coordinates must have the same dimension.
+  if (m_dimensions[destination] != m_dimensions[source] || dotProduct >= 1.0) {
+    return UNKNOWN_DISTANCE;
+  }
+
+  double x = m_coshRadius[source] * m_coshRadius[destination] -
+             m_sinhRadius[source] * m_sinhRadius[destination] * dotProduct;
+  return std::acosh(std::max(x, 1.0));
+}
+
+} // namespace nlsr
@@ -0,0 +1,105 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2017,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NLSR_ROUTE_COORDINATE_CACHE_HPP
+#define NLSR_ROUTE_COORDINATE_CACHE_HPP
+
+#include "common.hpp"
+
+#include <unordered_map>
+#include <vector>
+
+namespace nlsr {
+
+/*! \brief The hyperbolic coordinates of the routers in the coordinate LSDB,
+  in the form that distances are calculated from.
+
+  When a router's coordinates are installed, its angles are converted
+  to a point on the unit sphere and the cosh and sinh of its radius are
+  computed. The distance between two routers then only takes a dot
+  product and one acosh, instead of O(d^2) sines and cosines and five
+  hyperbolic functions.
+
+  The points are stored one Cartesian axis per array, so that the
+  distances from one router to all the others are computed by loops
+  over contiguous arrays, which the compiler can vectorize.
+ */
+class CoordinateCache
+{
+public:
+  /*! \brief Adds or replaces the coordinates of a router.
+
+    Coordinates with a radius that is not positive, or with a last
+    angle outside [0, 2PI], are kept but have no distance to any router.
+   */
+  void
+  insert(const ndn::Name& router, double radius, const std::vector<double>& angles);
+
+  void
+  erase(const ndn::Name& router);
+
+  /*! \brief Returns the slot of a router's coordinates, if there are any.
+
+    Slots are only valid until the next insert() or erase().
+   */
+  ndn::optional<size_t>
+  find(const ndn::Name& router) const;
+
+  size_t
+  size() const
+  {
+    return m_routers.size();
+  }
+
+  /*! \brief Calculates the distance from one router to every router.
+    \param source The slot of the router to calculate distances from.
+    \param[out] distances The distance to the router in each slot, or
+                UNKNOWN_DISTANCE if it cannot be calculated.
+   */
+  void
+  calculateDistances(size_t source, std::vector<double>& distances) const;
+
+  /*! \brief Returns the distance between the routers in two slots, or UNKNOWN_DISTANCE. */
+  double
+  getDistance(size_t source, size_t destination) const;
+
+public:
+  static const double UNKNOWN_DISTANCE;
+
+private:
+  double
+  calculateDistance(size_t source, size_t destination, double dotProduct) const;
+
+private:
+  std::unordered_map<ndn::Name, size_t> m_slots;
+  std::vector<ndn::Name> m_routers;
+  std::vector<double> m_coshRadius;
+  std::vector<double> m_sinhRadius;
+  // The number of Cartesian coordinates of each router, or 0 if its
+  // coordinates are not valid.
+  std::vector<size_t> m_dimensions;
+  // m_axes[k][slot] is the k-th Cartesian coordinate of the router in slot
+  std::vector<std::vector<double>> m_axes;
+};
+
+} // namespace nlsr
+
+#endif // NLSR_ROUTE_COORDINATE_CACHE_HPP
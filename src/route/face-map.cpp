@@ -34,6 +34,10 @@ INIT_LOGGER("FaceMap");
 void
 FaceMap::writeLog()
 {
+  if (!NLSR_LOG_IS_DEBUG_ENABLED()) {
+    return;
+  }
+
   NLSR_LOG_DEBUG("------- Face Map-----------");
   for (const auto& it : m_table) {
     NLSR_LOG_DEBUG("Face Map Entry (FaceUri: " << (it.second).getFaceUri()
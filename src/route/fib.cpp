@@ -41,7 +41,7 @@ Fib::remove(const ndn::Name& name)
   NLSR_LOG_DEBUG("Fib::remove called");
   std::map<ndn::Name, FibEntry>::iterator it = m_table.find(name);
   if (it != m_table.end()) {
-    for (std::set<NextHop, NextHopComparator>::iterator nhit =
+    for (NexthopList::const_iterator nhit =
            (it->second).getNexthopList().getNextHops().begin();
          nhit != (it->second).getNexthopList().getNextHops().end(); nhit++) {
       //remove entry from NDN-FIB
@@ -121,10 +121,10 @@ Fib::update(const ndn::Name& name, NexthopList& allHops)
     FibEntry& entry = (entryIt->second);
     addNextHopsToFibEntryAndNfd(entry, hopsToAdd);
 
-    std::set<NextHop, NextHopComparator> hopsToRemove;
+    std::vector<NextHop> hopsToRemove;
     std::set_difference(entry.getNexthopList().begin(), entry.getNexthopList().end(),
                         hopsToAdd.begin(), hopsToAdd.end(),
-                        std::inserter(hopsToRemove, hopsToRemove.end()), NextHopComparator());
+                        std::back_inserter(hopsToRemove), NextHopComparator());
 
     bool isUpdatable = isPrefixUpdatable(entry.getName());
     // Remove the uninstalled next hops from NFD and FIB entry
@@ -159,7 +159,7 @@ Fib::clean()
        ++it) {
     NLSR_LOG_DEBUG("Cancelling Scheduled event. Name: " << it->second.getName());
     cancelEntryRefresh(it->second);
-    for (std::set<NextHop, NextHopComparator>::iterator nhit =
+    for (NexthopList::const_iterator nhit =
          (it->second).getNexthopList().getNextHops().begin();
          nhit != (it->second).getNexthopList().getNextHops().end(); nhit++) {
       //Remove entry from NDN-FIB
@@ -201,37 +201,158 @@ Fib::registerPrefix(const ndn::Name& namePrefix, const ndn::util::FaceUri& faceU
                     const ndn::time::milliseconds& timeout,
                     uint64_t flags, uint8_t times)
 {
-  uint64_t faceId = m_adjacencyList.getFaceId(ndn::util::FaceUri(faceUri));
-
-  if (faceId != 0) {
-    ndn::nfd::ControlParameters faceParameters;
-    faceParameters
-     .setName(namePrefix)
-     .setFaceId(faceId)
-     .setFlags(flags)
-     .setCost(faceCost)
-     .setExpirationPeriod(timeout)
-     .setOrigin(ndn::nfd::ROUTE_ORIGIN_NLSR);
-
-    NLSR_LOG_DEBUG("Registering prefix: " << faceParameters.getName() << " faceUri: " << faceUri);
-    m_controller.start<ndn::nfd::RibRegisterCommand>(faceParameters,
-                                                   std::bind(&Fib::onRegistrationSuccess, this, _1,
-                                                             "Successful in name registration",
-                                                             faceUri),
-                                                   std::bind(&Fib::onRegistrationFailure,
-                                                             this, _1,
-                                                             "Failed in name registration",
-                                                             faceParameters,
-                                                             faceUri, times));
+  enqueueRibCommand({true, namePrefix, faceUri.toString(), faceCost, timeout, flags, times});
+}
+
+void
+Fib::beginBatch()
+{
+  ++m_batchDepth;
+}
+
+void
+Fib::endBatch()
+{
+  if (--m_batchDepth == 0) {
+    sendRibCommands();
+  }
+}
+
+void
+Fib::enqueueRibCommand(const RibCommand& command)
+{
+  auto key = std::make_pair(command.namePrefix, command.faceUri);
+  auto queued = m_queuedRibCommands.find(key);
+
+  // Only the last command for a prefix and face decides what NFD ends up with
+  if (queued != m_queuedRibCommands.end()) {
+    NLSR_LOG_TRACE("Coalescing queued RIB command for prefix: " << command.namePrefix
+                   << " faceUri: " << command.faceUri);
+    *queued->second = command;
+    ++m_nRibCommandsCoalesced;
   }
   else {
+    m_queuedRibCommands.emplace(std::move(key),
+                                m_ribCommandQueue.insert(m_ribCommandQueue.end(), command));
+  }
+
+  sendRibCommands();
+}
+
+void
+Fib::sendRibCommands()
+{
+  if (m_batchDepth > 0) {
+    return;
+  }
+
+  uint32_t window = m_confParameter.getRibCommandWindow();
+
+  while (!m_ribCommandQueue.empty() && (window == 0 || m_nRibCommandsInFlight < window)) {
+    RibCommand command = std::move(m_ribCommandQueue.front());
+    m_queuedRibCommands.erase(std::make_pair(command.namePrefix, command.faceUri));
+    m_ribCommandQueue.pop_front();
+
+    if (m_nRibCommandsInFlight == 0 && m_nRibCommandsSinceIdle == 0) {
+      m_idleEndTime = ndn::time::steady_clock::now();
+    }
+
+    if (sendRibCommand(command)) {
+      ++m_nRibCommandsInFlight;
+      ++m_nRibCommandsSent;
+      ++m_nRibCommandsSinceIdle;
+    }
+  }
+
+  if (!m_ribCommandQueue.empty()) {
+    NLSR_LOG_TRACE("RIB commands in flight: " << m_nRibCommandsInFlight
+                   << " queued: " << m_ribCommandQueue.size());
+  }
+}
+
+bool
+Fib::sendRibCommand(const RibCommand& command)
+{
+  ndn::time::steady_clock::TimePoint sendTime = ndn::time::steady_clock::now();
+
+  if (!command.isRegister) {
+    uint32_t faceId = m_faceMap.getFaceId(command.faceUri);
+    NLSR_LOG_DEBUG("Unregister prefix: " << command.namePrefix << " Face Uri: " << command.faceUri);
+    if (faceId == 0) {
+      return false;
+    }
+
+    ndn::nfd::ControlParameters controlParameters;
+    controlParameters
+      .setName(command.namePrefix)
+      .setFaceId(faceId)
+      .setOrigin(ndn::nfd::ROUTE_ORIGIN_NLSR);
+    m_controller.start<ndn::nfd::RibUnregisterCommand>(controlParameters,
+                                                       std::bind(&Fib::onUnregistrationSuccess, this, _1,
+                                                                 "Successful in unregistering name",
+                                                                 sendTime),
+                                                       std::bind(&Fib::onUnregistrationFailure,
+                                                                 this, _1,
+                                                                 "Failed in unregistering name",
+                                                                 sendTime));
+    return true;
+  }
+
+  ndn::util::FaceUri faceUri(command.faceUri);
+  uint64_t faceId = m_adjacencyList.getFaceId(faceUri);
+
+  if (faceId == 0) {
     NLSR_LOG_WARN("Error: No Face Id for face uri: " << faceUri);
+    return false;
+  }
+
+  ndn::nfd::ControlParameters faceParameters;
+  faceParameters
+   .setName(command.namePrefix)
+   .setFaceId(faceId)
+   .setFlags(command.flags)
+   .setCost(command.faceCost)
+   .setExpirationPeriod(command.timeout)
+   .setOrigin(ndn::nfd::ROUTE_ORIGIN_NLSR);
+
+  NLSR_LOG_DEBUG("Registering prefix: " << faceParameters.getName() << " faceUri: " << faceUri);
+  m_controller.start<ndn::nfd::RibRegisterCommand>(faceParameters,
+                                                 std::bind(&Fib::onRegistrationSuccess, this, _1,
+                                                           "Successful in name registration",
+                                                           faceUri, sendTime),
+                                                 std::bind(&Fib::onRegistrationFailure,
+                                                           this, _1,
+                                                           "Failed in name registration",
+                                                           faceParameters,
+                                                           faceUri, command.times, sendTime));
+  return true;
+}
+
+void
+Fib::onRibCommandDone(const ndn::time::steady_clock::TimePoint& sendTime)
+{
+  ribCommandRttSignal(ndn::time::steady_clock::now() - sendTime);
+
+  if (m_nRibCommandsInFlight > 0) {
+    --m_nRibCommandsInFlight;
+  }
+
+  sendRibCommands();
+
+  if (m_nRibCommandsInFlight == 0 && m_ribCommandQueue.empty() && m_nRibCommandsSinceIdle > 0) {
+    ndn::time::milliseconds elapsed = ndn::time::duration_cast<ndn::time::milliseconds>(
+                                        ndn::time::steady_clock::now() - m_idleEndTime);
+    NLSR_LOG_DEBUG("Sent " << m_nRibCommandsSinceIdle << " RIB commands in " << elapsed.count()
+                   << " ms (" << m_nRibCommandsSinceIdle * 1000 / std::max<int64_t>(elapsed.count(), 1)
+                   << " commands/s)");
+    m_nRibCommandsSinceIdle = 0;
   }
 }
 
 void
 Fib::onRegistrationSuccess(const ndn::nfd::ControlParameters& commandSuccessResult,
-                           const std::string& message, const ndn::util::FaceUri& faceUri)
+                           const std::string& message, const ndn::util::FaceUri& faceUri,
+                           const ndn::time::steady_clock::TimePoint& sendTime)
 {
   NLSR_LOG_DEBUG(message << ": " << commandSuccessResult.getName() <<
              " Face Uri: " << faceUri << " faceId: " << commandSuccessResult.getFaceId());
@@ -244,6 +365,8 @@ Fib::onRegistrationSuccess(const ndn::nfd::ControlParameters& commandSuccessResu
   // Update the fast-access FaceMap with the new Face ID, too
   m_faceMap.update(faceUri.toString(), commandSuccessResult.getFaceId());
   m_faceMap.writeLog();
+
+  onRibCommandDone(sendTime);
 }
 
 void
@@ -251,11 +374,16 @@ Fib::onRegistrationFailure(const ndn::nfd::ControlResponse& response,
                            const std::string& message,
                            const ndn::nfd::ControlParameters& parameters,
                            const ndn::util::FaceUri& faceUri,
-                           uint8_t times)
+                           uint8_t times,
+                           const ndn::time::steady_clock::TimePoint& sendTime)
 {
   NLSR_LOG_DEBUG(message << ": " << response.getText() << " (code: " << response.getCode() << ")");
   NLSR_LOG_DEBUG("Prefix: " << parameters.getName() << " failed for: " << times);
-  if (times < 3) {
+  if (m_queuedRibCommands.count(std::make_pair(parameters.getName(), faceUri.toString())) > 0) {
+    // Retrying would replace the newer command
+    NLSR_LOG_DEBUG("Not registering again, since a newer command is queued");
+  }
+  else if (times < 3) {
     NLSR_LOG_DEBUG("Trying to register again...");
     registerPrefix(parameters.getName(), faceUri,
                    parameters.getCost(),
@@ -265,41 +393,35 @@ Fib::onRegistrationFailure(const ndn::nfd::ControlResponse& response,
   else {
     NLSR_LOG_DEBUG("Registration trial given up");
   }
+
+  onRibCommandDone(sendTime);
 }
 
 void
 Fib::unregisterPrefix(const ndn::Name& namePrefix, const std::string& faceUri)
 {
-  uint32_t faceId = m_faceMap.getFaceId(faceUri);
-  NLSR_LOG_DEBUG("Unregister prefix: " << namePrefix << " Face Uri: " << faceUri);
-  if (faceId > 0) {
-    ndn::nfd::ControlParameters controlParameters;
-    controlParameters
-      .setName(namePrefix)
-      .setFaceId(faceId)
-      .setOrigin(ndn::nfd::ROUTE_ORIGIN_NLSR);
-    m_controller.start<ndn::nfd::RibUnregisterCommand>(controlParameters,
-                                                       std::bind(&Fib::onUnregistrationSuccess, this, _1,
-                                                                 "Successful in unregistering name"),
-                                                       std::bind(&Fib::onUnregistrationFailure,
-                                                                 this, _1,
-                                                                 "Failed in unregistering name"));
-  }
+  enqueueRibCommand({false, namePrefix, faceUri, 0, ndn::time::milliseconds::zero(), 0, 0});
 }
 
 void
 Fib::onUnregistrationSuccess(const ndn::nfd::ControlParameters& commandSuccessResult,
-                             const std::string& message)
+                             const std::string& message,
+                             const ndn::time::steady_clock::TimePoint& sendTime)
 {
   NLSR_LOG_DEBUG("Unregister successful Prefix: " << commandSuccessResult.getName() <<
              " Face Id: " << commandSuccessResult.getFaceId());
+
+  onRibCommandDone(sendTime);
 }
 
 void
 Fib::onUnregistrationFailure(const ndn::nfd::ControlResponse& response,
-                             const std::string& message)
+                             const std::string& message,
+                             const ndn::time::steady_clock::TimePoint& sendTime)
 {
   NLSR_LOG_DEBUG(message << ": " << response.getText() << " (code: " << response.getCode() << ")");
+
+  onRibCommandDone(sendTime);
 }
 
 void
@@ -397,6 +519,10 @@ Fib::refreshEntry(const ndn::Name& name, afterRefreshCallback refreshCb)
 void
 Fib::writeLog()
 {
+  if (!NLSR_LOG_IS_DEBUG_ENABLED()) {
+    return;
+  }
+
   NLSR_LOG_DEBUG("-------------------FIB-----------------------------");
   for (std::map<ndn::Name, FibEntry>::iterator it = m_table.begin();
        it != m_table.end();
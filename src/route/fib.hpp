@@ -25,11 +25,17 @@
 
 #include "face-map.hpp"
 #include "fib-entry.hpp"
+#include "signals.hpp"
 #include "test-access-control.hpp"
 
 #include <ndn-cxx/mgmt/nfd/controller.hpp>
 #include <ndn-cxx/util/time.hpp>
 
+#include <boost/noncopyable.hpp>
+
+#include <list>
+#include <map>
+
 namespace nlsr {
 
 typedef std::function<void(FibEntry&)> afterRefreshCallback;
@@ -49,7 +55,7 @@ class FibEntry;
  *
  * \sa nlsr::NamePrefixTable
  * \sa nlsr::NamePrefixTable::addEntry
- * \sa nlsr::NamePrefixTable::updateWithNewRoute
+ * \sa nlsr::NamePrefixTable::updateWithChangedRoutes
  */
 class Fib
 {
@@ -59,11 +65,39 @@ public:
     : m_scheduler(scheduler)
     , m_refreshTime(0)
     , m_controller(face, keyChain)
+    , m_nRibCommandsInFlight(0)
+    , m_batchDepth(0)
+    , m_nRibCommandsSent(0)
+    , m_nRibCommandsCoalesced(0)
+    , m_nRibCommandsSinceIdle(0)
     , m_adjacencyList(adjacencyList)
     , m_confParameter(conf)
   {
   }
 
+  /*! \brief Holds back RIB commands for as long as it exists.
+   *
+   * \sa Fib::beginBatch
+   */
+  class Batch : boost::noncopyable
+  {
+  public:
+    explicit
+    Batch(Fib& fib)
+      : m_fib(fib)
+    {
+      m_fib.beginBatch();
+    }
+
+    ~Batch()
+    {
+      m_fib.endBatch();
+    }
+
+  private:
+    Fib& m_fib;
+  };
+
   /*! \brief Completely remove a name prefix from the FIB.
    *
    * If a name prefix is found to no longer be reachable from this
@@ -137,12 +171,64 @@ public:
                  uint64_t flags,
                  uint8_t times);
 
+  /*! \brief Holds back RIB commands until the matching endBatch().
+   *
+   * A route calculation or a Name LSA can change the next hops of
+   * many prefixes at once. The RIB commands for those changes are
+   * queued, and a later command for the same prefix and face replaces
+   * an earlier one that is still in the queue, so that e.g. a
+   * registration followed by an unregistration is sent to NFD as a
+   * single unregistration. Batches can be nested; the commands are
+   * sent once the outermost one ends.
+   */
+  void
+  beginBatch();
+
+  void
+  endBatch();
+
+  /*! \brief Returns the number of RIB commands waiting to be sent to NFD.
+   */
+  size_t
+  getRibCommandQueueSize() const
+  {
+    return m_ribCommandQueue.size();
+  }
+
+  /*! \brief Returns the number of RIB commands sent to NFD and not yet answered.
+   */
+  size_t
+  getRibCommandsInFlight() const
+  {
+    return m_nRibCommandsInFlight;
+  }
+
+  uint64_t
+  getRibCommandsSent() const
+  {
+    return m_nRibCommandsSent;
+  }
+
+  /*! \brief Returns the number of RIB commands that replaced a queued one.
+   */
+  uint64_t
+  getRibCommandsCoalesced() const
+  {
+    return m_nRibCommandsCoalesced;
+  }
+
   void
   setStrategy(const ndn::Name& name, const std::string& strategy, uint32_t count);
 
   void
   writeLog();
 
+public:
+  /*! Emitted with the time from a RIB command being sent to NFD
+   * answering it.
+   */
+  DurationSignal<Fib> ribCommandRttSignal;
+
 private:
   /*! \brief Indicates whether a prefix is a direct neighbor or not.
    *
@@ -169,32 +255,74 @@ private:
   void
   unregisterPrefix(const ndn::Name& namePrefix, const std::string& faceUri);
 
+  struct RibCommand
+  {
+    bool isRegister;
+    ndn::Name namePrefix;
+    std::string faceUri;
+    uint64_t faceCost;
+    ndn::time::milliseconds timeout;
+    uint64_t flags;
+    uint8_t times;
+  };
+
+  /*! \brief Queues a RIB command, replacing any queued one for the same prefix and face.
+   */
+  void
+  enqueueRibCommand(const RibCommand& command);
+
+  /*! \brief Sends queued RIB commands while there is room in the window.
+   *
+   * Nothing is sent while a batch is open.
+   */
+  void
+  sendRibCommands();
+
+  /*! \brief Sends a RIB command to NFD.
+   *
+   * \return Whether the command was sent; it is not if the face is unknown.
+   */
+  bool
+  sendRibCommand(const RibCommand& command);
+
+  /*! \brief Makes room in the window for another command, once NFD has answered one.
+   * \param sendTime When the answered command was sent.
+   */
+  void
+  onRibCommandDone(const ndn::time::steady_clock::TimePoint& sendTime);
+
   /*! \brief Log registration success, and update the Face ID associated with a URI.
    */
   void
   onRegistrationSuccess(const ndn::nfd::ControlParameters& commandSuccessResult,
-                        const std::string& message, const ndn::util::FaceUri& faceUri);
+                        const std::string& message, const ndn::util::FaceUri& faceUri,
+                        const ndn::time::steady_clock::TimePoint& sendTime);
 
   /*! \brief Retry a prefix (next-hop) registration up to three (3) times.
+   *
+   * It is not retried if a newer command for the prefix and face is queued.
    */
   void
   onRegistrationFailure(const ndn::nfd::ControlResponse& response,
                         const std::string& message,
                         const ndn::nfd::ControlParameters& parameters,
                         const ndn::util::FaceUri& faceUri,
-                        uint8_t times);
+                        uint8_t times,
+                        const ndn::time::steady_clock::TimePoint& sendTime);
 
   /*! \brief Log a successful unregistration.
    */
   void
   onUnregistrationSuccess(const ndn::nfd::ControlParameters& commandSuccessResult,
-                          const std::string& message);
+                          const std::string& message,
+                          const ndn::time::steady_clock::TimePoint& sendTime);
 
   /*! \brief Log an unregistration failure. Does not retry.
    */
   void
   onUnregistrationFailure(const ndn::nfd::ControlResponse& response,
-                               const std::string& message);
+                               const std::string& message,
+                               const ndn::time::steady_clock::TimePoint& sendTime);
 
   /*! \brief Log a successful strategy setting.
    */
@@ -252,6 +380,19 @@ private:
   int32_t m_refreshTime;
   ndn::nfd::Controller m_controller;
 
+  /*! The queued RIB commands, in the order they are sent, and an index
+   * to them by prefix and face URI so that they can be coalesced.
+   */
+  std::list<RibCommand> m_ribCommandQueue;
+  std::map<std::pair<ndn::Name, std::string>, std::list<RibCommand>::iterator> m_queuedRibCommands;
+  size_t m_nRibCommandsInFlight;
+  int m_batchDepth;
+
+  uint64_t m_nRibCommandsSent;
+  uint64_t m_nRibCommandsCoalesced;
+  uint64_t m_nRibCommandsSinceIdle;
+  ndn::time::steady_clock::TimePoint m_idleEndTime;
+
 PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   FaceMap m_faceMap;
   std::map<ndn::Name, FibEntry> m_table;
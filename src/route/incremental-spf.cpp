@@ -0,0 +1,376 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2017,  The University of Memphis,
+ *                           Regents of the University of California
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "incremental-spf.hpp"
+#include "adjacency-graph.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+
+namespace nlsr {
+
+const int32_t IncrementalSpf::NO_ROUTER = -1;
+const double IncrementalSpf::INF_DISTANCE = std::numeric_limits<double>::infinity();
+
+static bool
+advertisedLinkCompare(const IncrementalSpf::AdvertisedLink& a,
+                      const IncrementalSpf::AdvertisedLink& b)
+{
+  return a.neighbor < b.neighbor;
+}
+
+IncrementalSpf::IncrementalSpf()
+  : m_source(NO_ROUTER)
+  , m_nVisited(0)
+{
+}
+
+void
+IncrementalSpf::resize(size_t nRouters)
+{
+  if (nRouters <= m_advertised.size() && nRouters <= m_distance.size()) {
+    return;
+  }
+  nRouters = std::max(nRouters, m_advertised.size());
+
+  m_advertised.resize(nRouters);
+  m_distance.resize(nRouters, INF_DISTANCE);
+  m_parent.resize(nRouters, NO_ROUTER);
+  m_nextHop.resize(nRouters, NO_ROUTER);
+  m_children.resize(nRouters);
+  m_isAffected.resize(nRouters, false);
+  m_isChanged.resize(nRouters, false);
+}
+
+double
+IncrementalSpf::getAdvertisedCost(int32_t from, int32_t to) const
+{
+  const std::vector<AdvertisedLink>& links = m_advertised[from];
+  auto it = std::lower_bound(links.begin(), links.end(), AdvertisedLink{to, 0},
+                             &advertisedLinkCompare);
+  if (it == links.end() || it->neighbor != to) {
+    return 0;
+  }
+  return it->cost;
+}
+
+double
+IncrementalSpf::getLinkCost(int32_t from, int32_t to) const
+{
+  double cost = AdjacencyGraph::correctLinkCost(getAdvertisedCost(from, to),
+                                                getAdvertisedCost(to, from));
+  return cost > 0 ? cost : 0;
+}
+
+void
+IncrementalSpf::setAdvertisedLinks(int32_t router, std::vector<AdvertisedLink> links)
+{
+  // A later advertisement of the same link overrides an earlier one
+  std::stable_sort(links.begin(), links.end(), &advertisedLinkCompare);
+  auto last = std::unique(links.rbegin(), links.rend(),
+                          [] (const AdvertisedLink& a, const AdvertisedLink& b) {
+                            return a.neighbor == b.neighbor;
+                          }).base();
+  links.erase(links.begin(), last);
+  links.erase(std::remove_if(links.begin(), links.end(),
+                             [router] (const AdvertisedLink& link) {
+                               return link.neighbor < 0 || link.neighbor == router;
+                             }),
+              links.end());
+
+  size_t nRouters = router + 1;
+  if (!links.empty()) {
+    nRouters = std::max<size_t>(nRouters, links.back().neighbor + 1);
+  }
+  resize(nRouters);
+
+  // Until there is a tree, there is nothing to repair
+  if (!isCalculated()) {
+    m_advertised[router] = std::move(links);
+    return;
+  }
+
+  // Walk the old and new links together to find the ones that changed
+  std::vector<AdvertisedLink> oldLinks;
+  oldLinks.swap(m_advertised[router]);
+
+  auto oldIt = oldLinks.begin();
+  auto newIt = links.begin();
+  while (oldIt != oldLinks.end() || newIt != links.end()) {
+    int32_t neighbor;
+    double oldCost = 0;
+    double newCost = 0;
+
+    if (newIt == links.end() ||
+        (oldIt != oldLinks.end() && oldIt->neighbor < newIt->neighbor)) {
+      neighbor = oldIt->neighbor;
+      oldCost = (oldIt++)->cost;
+    }
+    else if (oldIt == oldLinks.end() || newIt->neighbor < oldIt->neighbor) {
+      neighbor = newIt->neighbor;
+      newCost = (newIt++)->cost;
+    }
+    else {
+      neighbor = newIt->neighbor;
+      oldCost = (oldIt++)->cost;
+      newCost = (newIt++)->cost;
+    }
+
+    if (oldCost == newCost) {
+      continue;
+    }
+
+    double reverseCost = getAdvertisedCost(neighbor, router);
+    double oldLinkCost = std::max(0.0, AdjacencyGraph::correctLinkCost(oldCost, reverseCost));
+    double newLinkCost = std::max(0.0, AdjacencyGraph::correctLinkCost(newCost, reverseCost));
+    if (oldLinkCost != newLinkCost) {
+      m_linkChanges.push_back({router, neighbor, oldLinkCost});
+    }
+  }
+
+  m_advertised[router] = std::move(links);
+}
+
+void
+IncrementalSpf::setParent(int32_t router, int32_t parent)
+{
+  int32_t oldParent = m_parent[router];
+  if (oldParent != NO_ROUTER) {
+    std::vector<int32_t>& siblings = m_children[oldParent];
+    auto it = std::find(siblings.begin(), siblings.end(), router);
+    if (it != siblings.end()) {
+      *it = siblings.back();
+      siblings.pop_back();
+    }
+  }
+
+  m_parent[router] = parent;
+  if (parent != NO_ROUTER) {
+    m_children[parent].push_back(router);
+  }
+}
+
+void
+IncrementalSpf::markChanged(int32_t router)
+{
+  if (!m_isChanged[router]) {
+    m_isChanged[router] = true;
+    m_changedRouters.push_back(router);
+    m_previousRoutes.emplace_back(m_distance[router], m_nextHop[router]);
+  }
+}
+
+void
+IncrementalSpf::relax(int32_t from, int32_t to, double cost)
+{
+  if (m_distance[from] == INF_DISTANCE) {
+    return;
+  }
+
+  double newDistance = m_distance[from] + cost;
+  if (newDistance < m_distance[to]) {
+    markChanged(to);
+    m_distance[to] = newDistance;
+    setParent(to, from);
+    m_nextHop[to] = (from == m_source) ? to : m_nextHop[from];
+
+    m_heap.emplace_back(newDistance, to);
+    std::push_heap(m_heap.begin(), m_heap.end(), std::greater<HeapEntry>());
+  }
+}
+
+void
+IncrementalSpf::cutSubtree(int32_t router)
+{
+  if (m_isAffected[router]) {
+    return;
+  }
+
+  setParent(router, NO_ROUTER);
+
+  std::vector<int32_t> stack{router};
+  while (!stack.empty()) {
+    int32_t u = stack.back();
+    stack.pop_back();
+
+    m_isAffected[u] = true;
+    m_affected.push_back(u);
+    markChanged(u);
+    m_distance[u] = INF_DISTANCE;
+    m_nextHop[u] = NO_ROUTER;
+
+    for (int32_t child : m_children[u]) {
+      m_parent[child] = NO_ROUTER;
+      stack.push_back(child);
+    }
+    m_children[u].clear();
+  }
+}
+
+void
+IncrementalSpf::runDijkstra()
+{
+  std::greater<HeapEntry> compare;
+
+  while (!m_heap.empty()) {
+    std::pop_heap(m_heap.begin(), m_heap.end(), compare);
+    double distance = m_heap.back().first;
+    int32_t u = m_heap.back().second;
+    m_heap.pop_back();
+
+    // Stale entry: u was already reached with a shorter distance
+    if (distance > m_distance[u]) {
+      continue;
+    }
+    ++m_nVisited;
+
+    for (const AdvertisedLink& link : m_advertised[u]) {
+      double cost = getLinkCost(u, link.neighbor);
+      if (cost > 0) {
+        relax(u, link.neighbor, cost);
+      }
+    }
+  }
+}
+
+void
+IncrementalSpf::calculate(int32_t source)
+{
+  size_t nRouters = std::max<size_t>(m_advertised.size(), source + 1);
+  resize(nRouters);
+
+  m_source = source;
+  m_distance.assign(nRouters, INF_DISTANCE);
+  m_parent.assign(nRouters, NO_ROUTER);
+  m_nextHop.assign(nRouters, NO_ROUTER);
+  for (std::vector<int32_t>& children : m_children) {
+    children.clear();
+  }
+  m_linkChanges.clear();
+  m_heap.clear();
+  m_nVisited = 0;
+
+  m_distance[source] = 0;
+  m_heap.emplace_back(0, source);
+  runDijkstra();
+
+  // Every route is new
+  m_isChanged.assign(nRouters, false);
+  m_previousRoutes.clear();
+  m_changedRouters.resize(nRouters);
+  for (size_t i = 0; i < nRouters; ++i) {
+    m_changedRouters[i] = i;
+  }
+}
+
+void
+IncrementalSpf::repair(int32_t source)
+{
+  if (m_source != source) {
+    calculate(source);
+    return;
+  }
+
+  resize(m_advertised.size());
+
+  for (int32_t router : m_changedRouters) {
+    m_isChanged[router] = false;
+  }
+  m_changedRouters.clear();
+  m_previousRoutes.clear();
+  m_heap.clear();
+  m_nVisited = 0;
+
+  // The tree was built with the cost each link had before its first change
+  for (LinkChange& change : m_linkChanges) {
+    if (change.from > change.to) {
+      std::swap(change.from, change.to);
+    }
+  }
+  std::stable_sort(m_linkChanges.begin(), m_linkChanges.end(),
+                   [] (const LinkChange& a, const LinkChange& b) {
+                     return a.from < b.from || (a.from == b.from && a.to < b.to);
+                   });
+  m_linkChanges.erase(std::unique(m_linkChanges.begin(), m_linkChanges.end(),
+                                  [] (const LinkChange& a, const LinkChange& b) {
+                                    return a.from == b.from && a.to == b.to;
+                                  }),
+                      m_linkChanges.end());
+
+  // Tree links that got worse or went down invalidate the subtree below them
+  for (const LinkChange& change : m_linkChanges) {
+    double newCost = getLinkCost(change.from, change.to);
+    if (change.oldCost > 0 && (newCost == 0 || newCost > change.oldCost)) {
+      if (m_parent[change.to] == change.from) {
+        cutSubtree(change.to);
+      }
+      else if (m_parent[change.from] == change.to) {
+        cutSubtree(change.from);
+      }
+    }
+  }
+
+  // Reconnect the invalidated subtrees through the rest of the tree
+  for (int32_t u : m_affected) {
+    for (const AdvertisedLink& link : m_advertised[u]) {
+      double cost = getLinkCost(u, link.neighbor);
+      if (cost > 0 && !m_isAffected[link.neighbor]) {
+        relax(link.neighbor, u, cost);
+      }
+    }
+  }
+
+  // Links that got better or came up may shorten paths
+  for (const LinkChange& change : m_linkChanges) {
+    double newCost = getLinkCost(change.from, change.to);
+    if (newCost > 0 && (change.oldCost == 0 || newCost < change.oldCost)) {
+      relax(change.from, change.to, newCost);
+      relax(change.to, change.from, newCost);
+    }
+  }
+
+  runDijkstra();
+
+  for (int32_t u : m_affected) {
+    m_isAffected[u] = false;
+  }
+  m_affected.clear();
+  m_linkChanges.clear();
+
+  // Only report routers whose route actually ended up different
+  size_t nChanged = 0;
+  for (size_t i = 0; i < m_changedRouters.size(); ++i) {
+    int32_t router = m_changedRouters[i];
+    if (m_previousRoutes[i].first != m_distance[router] ||
+        m_previousRoutes[i].second != m_nextHop[router]) {
+      m_changedRouters[nChanged] = router;
+      m_previousRoutes[nChanged] = m_previousRoutes[i];
+      ++nChanged;
+    }
+    else {
+      m_isChanged[router] = false;
+    }
+  }
+  m_changedRouters.resize(nChanged);
+  m_previousRoutes.resize(nChanged);
+}
+
+} // namespace nlsr
@@ -0,0 +1,194 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2017,  The University of Memphis,
+ *                           Regents of the University of California
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NLSR_INCREMENTAL_SPF_HPP
+#define NLSR_INCREMENTAL_SPF_HPP
+
+#include <utility>
+#include <vector>
+#include <boost/cstdint.hpp>
+
+namespace nlsr {
+
+/*! \brief Maintains a single-path shortest path tree across adjacency LSA changes.
+
+  Routers are identified by a dense, stable mappingNo. The links each
+  router advertises are kept here, and are replaced whenever its adj.
+  LSA changes. Links are corrected for asymmetric costs the same way
+  as in AdjacencyGraph::build.
+
+  After the first full calculation, repair() only revisits the part of
+  the tree that the changed links affect: the subtrees hanging off
+  tree links whose cost went up or that went down, and the routers
+  whose distance improves through links whose cost went down or that
+  came up.
+ */
+class IncrementalSpf
+{
+public:
+  struct AdvertisedLink
+  {
+    int32_t neighbor;
+    double cost;
+  };
+
+  IncrementalSpf();
+
+  /*! \brief Replaces the links that a router advertises.
+    \param router The mappingNo of the router whose adj. LSA changed.
+    \param links The links in its new adj. LSA; empty if the LSA was removed.
+
+    Links whose corrected cost changes are recorded for the next repair().
+   */
+  void
+  setAdvertisedLinks(int32_t router, std::vector<AdvertisedLink> links);
+
+  /*! \brief Calculates the tree from scratch.
+    \param source The mappingNo of the origin router.
+   */
+  void
+  calculate(int32_t source);
+
+  /*! \brief Brings the tree up to date with the links changed since the last calculation.
+
+    Falls back to calculate() if there is no tree for source yet.
+   */
+  void
+  repair(int32_t source);
+
+  bool
+  isCalculated() const
+  {
+    return m_source != NO_ROUTER;
+  }
+
+  size_t
+  getNRouters() const
+  {
+    return m_advertised.size();
+  }
+
+  bool
+  isReachable(int32_t router) const
+  {
+    return m_distance[router] != INF_DISTANCE;
+  }
+
+  double
+  getDistance(int32_t router) const
+  {
+    return m_distance[router];
+  }
+
+  int32_t
+  getParent(int32_t router) const
+  {
+    return m_parent[router];
+  }
+
+  /*! \brief Returns the neighbor of the source through which router is
+    reached, or NO_ROUTER if it is the source or is unreachable.
+   */
+  int32_t
+  getNextHop(int32_t router) const
+  {
+    return m_nextHop[router];
+  }
+
+  /*! \brief Returns the routers whose distance or next hop changed in the last calculation. */
+  const std::vector<int32_t>&
+  getChangedRouters() const
+  {
+    return m_changedRouters;
+  }
+
+  /*! \brief Returns how many routers the last calculation visited. */
+  size_t
+  getNVisited() const
+  {
+    return m_nVisited;
+  }
+
+public:
+  static const int32_t NO_ROUTER;
+  static const double INF_DISTANCE;
+
+private:
+  struct LinkChange
+  {
+    int32_t from;
+    int32_t to;
+    double oldCost;
+  };
+
+  typedef std::pair<double, int32_t> HeapEntry;
+
+  void
+  resize(size_t nRouters);
+
+  /*! \brief Returns the advertised cost of a link, or 0 if it is not advertised. */
+  double
+  getAdvertisedCost(int32_t from, int32_t to) const;
+
+  /*! \brief Returns the corrected cost of a link, or 0 if the link is down. */
+  double
+  getLinkCost(int32_t from, int32_t to) const;
+
+  void
+  setParent(int32_t router, int32_t parent);
+
+  void
+  markChanged(int32_t router);
+
+  /*! \brief Tries to improve the distance of to through from, and queues to if it does. */
+  void
+  relax(int32_t from, int32_t to, double cost);
+
+  /*! \brief Detaches the subtree rooted at router, marking its routers unreachable. */
+  void
+  cutSubtree(int32_t router);
+
+  void
+  runDijkstra();
+
+private:
+  std::vector<std::vector<AdvertisedLink>> m_advertised;
+  std::vector<LinkChange> m_linkChanges;
+
+  int32_t m_source;
+  std::vector<double> m_distance;
+  std::vector<int32_t> m_parent;
+  std::vector<int32_t> m_nextHop;
+  std::vector<std::vector<int32_t>> m_children;
+
+  std::vector<HeapEntry> m_heap;
+  std::vector<int32_t> m_affected;
+  std::vector<char> m_isAffected;
+
+  std::vector<int32_t> m_changedRouters;
+  // The distance and next hop of each changed router before the repair
+  std::vector<std::pair<double, int32_t>> m_previousRoutes;
+  std::vector<char> m_isChanged;
+  size_t m_nVisited;
+};
+
+} // namespace nlsr
+
+#endif // NLSR_INCREMENTAL_SPF_HPP
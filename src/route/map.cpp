@@ -32,62 +32,73 @@ namespace nlsr {
 
 INIT_LOGGER("Map");
 
+const int32_t Map::NO_MAPPING_NO = -1;
+
+util::Interner<ndn::Name>&
+Map::getRouterNames()
+{
+  static util::Interner<ndn::Name> routerNames;
+  return routerNames;
+}
+
 void
 Map::addEntry(const ndn::Name& rtrName)
 {
-  MapEntry me(rtrName, m_mappingIndex);
-  if (addEntry(me)) {
-    m_mappingIndex++;
+  RouterId id = getRouterNames().intern(rtrName);
+  if (id >= m_mappingNos.size()) {
+    m_mappingNos.resize(id + 1, NO_MAPPING_NO);
   }
-}
 
-bool
-Map::addEntry(MapEntry& mpe)
-{
-  return m_entries.insert(mpe).second;
+  if (m_mappingNos[id] == NO_MAPPING_NO) {
+    m_mappingNos[id] = static_cast<int32_t>(m_routerIds.size());
+    m_routerIds.push_back(id);
+  }
 }
 
 ndn::optional<ndn::Name>
-Map::getRouterNameByMappingNo(int32_t mn)
+Map::getRouterNameByMappingNo(int32_t mn) const
 {
-  auto&& mappingNumberView = m_entries.get<detail::byMappingNumber>();
-  auto iterator = mappingNumberView.find(mn);
-  if (iterator == mappingNumberView.end()) {
+  if (mn < 0 || static_cast<size_t>(mn) >= m_routerIds.size()) {
     return {};
   }
   else {
-    return {iterator->getRouter()};
+    return {getRouterName(mn)};
   }
 }
 
 ndn::optional<int32_t>
-Map::getMappingNoByRouterName(const ndn::Name& rName)
+Map::getMappingNoByRouterName(const ndn::Name& rName) const
 {
-  auto&& routerNameView = m_entries.get<detail::byRouterName>();
-  auto iterator = routerNameView.find(rName);
-  if (iterator == routerNameView.end()) {
+  RouterId id;
+  if (!getRouterNames().find(rName, id) ||
+      id >= m_mappingNos.size() || m_mappingNos[id] == NO_MAPPING_NO) {
     return {};
   }
   else {
-    return {iterator->getMappingNumber()};
+    return {m_mappingNos[id]};
   }
 }
 
 void
 Map::reset()
 {
-  m_entries = detail::entryContainer{};
-  m_mappingIndex = 0;
+  for (RouterId id : m_routerIds) {
+    m_mappingNos[id] = NO_MAPPING_NO;
+  }
+  m_routerIds.clear();
 }
 
 void
 Map::writeLog()
 {
+  if (!NLSR_LOG_IS_DEBUG_ENABLED()) {
+    return;
+  }
+
   NLSR_LOG_DEBUG("---------------Map----------------------");
-  auto&& routerNameView = m_entries.get<detail::byRouterName>();
-  for (auto entry = routerNameView.begin(); entry != routerNameView.end(); entry++) {
-    NLSR_LOG_DEBUG("MapEntry: ( Router: " << entry->getRouter() << " Mapping No: "
-               << entry->getMappingNumber() << " )");
+  for (size_t mn = 0; mn < m_routerIds.size(); ++mn) {
+    NLSR_LOG_DEBUG("MapEntry: ( Router: " << getRouterName(mn) << " Mapping No: "
+               << mn << " )");
   }
 }
 
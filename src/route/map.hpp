@@ -23,46 +23,27 @@
 
 #include "common.hpp"
 #include "map-entry.hpp"
+#include "utility/interner.hpp"
 
 #include <iostream>
 #include <list>
+#include <vector>
 #include <boost/cstdint.hpp>
 
-#include <boost/multi_index_container.hpp>
-#include <boost/multi_index/hashed_index.hpp>
-#include <boost/multi_index/mem_fun.hpp>
-#include <boost/multi_index/tag.hpp>
-
 namespace nlsr {
 
-namespace detail {
-
-  using namespace boost::multi_index;
-  // Define tags so that we can search by different indices.
-  struct byRouterName {};
-  struct byMappingNumber{};
-  using entryContainer = multi_index_container<
-    MapEntry,
-    indexed_by<
-      hashed_unique<tag<byRouterName>,
-                    const_mem_fun<MapEntry, const ndn::Name&, &MapEntry::getRouter>,
-                    std::hash<ndn::Name>>,
-      hashed_unique<tag<byMappingNumber>,
-                    const_mem_fun<MapEntry, int32_t, &MapEntry::getMappingNumber>>
-      >
-    >;
-
-} // namespace detail
-
 class Nlsr;
 
+/*! \brief Gives the routers in a calculation dense mapping numbers.
+
+  Router names are interned once for the life of the process, and a Map
+  only holds the IDs of the names it maps. Filling a Map therefore does
+  not copy any names, and a Map that is reset keeps its storage.
+ */
 class Map
 {
 public:
-  Map()
-    : m_mappingIndex(0)
-  {
-  }
+  typedef util::Interner<ndn::Name>::Id RouterId;
 
   /*! \brief Add a map entry to this map.
     \param rtrName The name of the router.
@@ -105,10 +86,20 @@ public:
   }
 
   ndn::optional<ndn::Name>
-  getRouterNameByMappingNo(int32_t mn);
+  getRouterNameByMappingNo(int32_t mn) const;
 
   ndn::optional<int32_t>
-  getMappingNoByRouterName(const ndn::Name& rName);
+  getMappingNoByRouterName(const ndn::Name& rName) const;
+
+  /*! \brief Returns the name of a router in this map, without copying it.
+    \param mn A mapping number less than getMapSize().
+   */
+  const ndn::Name&
+  getRouterName(int32_t mn) const
+  {
+    BOOST_ASSERT(mn >= 0 && static_cast<size_t>(mn) < m_routerIds.size());
+    return getRouterNames().get(m_routerIds[mn]);
+  }
 
   void
   reset();
@@ -116,18 +107,24 @@ public:
   size_t
   getMapSize() const
   {
-    return m_entries.size();
+    return m_routerIds.size();
   }
 
   void
   writeLog();
 
 private:
-  bool
-  addEntry(MapEntry& mpe);
+  /*! \brief The names of every router that has been mapped so far.
+   */
+  static util::Interner<ndn::Name>&
+  getRouterNames();
+
+  static const int32_t NO_MAPPING_NO;
 
-  int32_t m_mappingIndex;
-  detail::entryContainer m_entries;
+  // Indexed by mappingNo
+  std::vector<RouterId> m_routerIds;
+  // Indexed by RouterId; NO_MAPPING_NO for routers that are not in this map
+  std::vector<int32_t> m_mappingNos;
 };
 
 } // namespace nlsr
@@ -34,10 +34,8 @@ NamePrefixTableEntry::generateNhlfromRteList()
 {
   m_nexthopList.reset();
   for (auto iterator = m_rteList.begin(); iterator != m_rteList.end(); ++iterator) {
-    for (auto nhItr = (*iterator)->getNexthopList().getNextHops().begin();
-         nhItr != (*iterator)->getNexthopList().getNextHops().end();
-         ++nhItr) {
-      m_nexthopList.addNextHop((*nhItr));
+    for (const NextHop& nh : (*iterator)->getNexthopList()) {
+      m_nexthopList.addNextHop(nh);
     }
   }
 }
@@ -81,6 +79,10 @@ NamePrefixTableEntry::addRoutingTableEntry(std::shared_ptr<RoutingTablePoolEntry
 void
 NamePrefixTableEntry::writeLog()
 {
+  if (!NLSR_LOG_IS_DEBUG_ENABLED()) {
+    return;
+  }
+
   NLSR_LOG_DEBUG("Name: " << m_namePrefix);
   for (auto it = m_rteList.begin(); it != m_rteList.end(); ++it) {
     NLSR_LOG_DEBUG("Destination: " << (*it)->getDestination());
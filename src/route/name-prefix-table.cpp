@@ -38,8 +38,8 @@ NamePrefixTable::NamePrefixTable(Nlsr& nlsr,
   : m_nlsr(nlsr)
 {
   m_afterRoutingChangeConnection = afterRoutingChangeSignal->connect(
-    [this] (const std::list<RoutingTableEntry>& entries) {
-      updateWithNewRoute(entries);
+    [this] (const RoutingTableChanges& changes) {
+      updateWithChangedRoutes(changes);
     });
 }
 
@@ -59,12 +59,7 @@ NamePrefixTable::addEntry(const ndn::Name& name, const ndn::Name& destRouter)
 {
 
   // Check if the advertised name prefix is in the table already.
-  NptEntryList::iterator nameItr =
-    std::find_if(m_table.begin(),
-                 m_table.end(),
-                 [&] (const std::shared_ptr<NamePrefixTableEntry>& entry) {
-                   return name == entry->getNamePrefix();
-                 });
+  NptEntryList::iterator nameItr = findEntry(name);
 
   // Attempt to find a routing table pool entry (RTPE) we can use.
   RoutingTableEntryPool::iterator rtpeItr = m_rtpool.find(destRouter);
@@ -104,7 +99,7 @@ NamePrefixTable::addEntry(const ndn::Name& name, const ndn::Name& destRouter)
     npte = make_shared<NamePrefixTableEntry>(name);
     npte->addRoutingTableEntry(rtpePtr);
     npte->generateNhlfromRteList();
-    m_table.push_back(npte);
+    insertEntry(npte);
     // If this entry has next hops, we need to inform the FIB
     if (npte->getNexthopList().size() > 0) {
       NLSR_LOG_TRACE("Updating FIB with next hops for " << npte);
@@ -161,11 +156,7 @@ NamePrefixTable::removeEntry(const ndn::Name& name, const ndn::Name& destRouter)
   std::shared_ptr<RoutingTablePoolEntry> rtpePtr = rtpeItr->second;
 
   // Ensure that the entry exists
-  NptEntryList::iterator nameItr =
-    std::find_if(m_table.begin(), m_table.end(),
-                 [&] (const std::shared_ptr<NamePrefixTableEntry>& entry) {
-                   return entry->getNamePrefix() == name;
-                 });
+  NptEntryList::iterator nameItr = findEntry(name);
   if (nameItr != m_table.end()) {
     NLSR_LOG_TRACE("Removing origin: " << rtpePtr->getDestination()
                << " from prefix: " << **nameItr);
@@ -194,7 +185,7 @@ NamePrefixTable::removeEntry(const ndn::Name& name, const ndn::Name& destRouter)
     if ((*nameItr)->getRteListSize() == 0) {
       NLSR_LOG_TRACE(**nameItr << " has no routing table entries;"
                  << " removing from table and FIB");
-      m_table.erase(nameItr);
+      eraseEntry(nameItr);
       m_nlsr.getFib().remove(name);
     }
     else {
@@ -214,37 +205,105 @@ void
 NamePrefixTable::updateWithNewRoute(const std::list<RoutingTableEntry>& entries)
 {
   NLSR_LOG_DEBUG("Updating table with newly calculated routes");
+  ndn::time::steady_clock::TimePoint startTime = ndn::time::steady_clock::now();
+
+  // Send the FIB changes of all the prefixes together
+  Fib::Batch fibBatch(m_nlsr.getFib());
+
+  // Index the new routes by destination, rather than searching them for each pool entry
+  std::unordered_map<ndn::Name, const RoutingTableEntry*> entriesByDestination;
+  entriesByDestination.reserve(entries.size());
+  for (const RoutingTableEntry& entry : entries) {
+    entriesByDestination.emplace(entry.getDestination(), &entry);
+  }
 
   // Iterate over each pool entry we have
   for (auto&& poolEntryPair : m_rtpool) {
     auto&& poolEntry = poolEntryPair.second;
-    auto sourceEntry = std::find_if(entries.begin(), entries.end(),
-                                    [&poolEntry] (const RoutingTableEntry& entry) {
-                                      return poolEntry->getDestination() == entry.getDestination();
-                                    });
-    // If this pool entry has a corresponding entry in the routing table now
-    if (sourceEntry != entries.end()
-        && poolEntry->getNexthopList() != sourceEntry->getNexthopList()) {
-      NLSR_LOG_DEBUG("Routing entry: " << poolEntry->getDestination() << " has changed next-hops.");
-      poolEntry->setNexthopList(sourceEntry->getNexthopList());
-      for (const auto& nameEntry : poolEntry->namePrefixTableEntries) {
-        auto nameEntryFullPtr = nameEntry.second.lock();
-        addEntry(nameEntryFullPtr->getNamePrefix(), poolEntry->getDestination());
+    auto found = entriesByDestination.find(poolEntry->getDestination());
+    updatePoolEntry(*poolEntry, found == entriesByDestination.end() ? nullptr : found->second);
+  }
+
+  updateDurationSignal(ndn::time::steady_clock::now() - startTime);
+}
+
+void
+NamePrefixTable::updateWithChangedRoutes(const RoutingTableChanges& changes)
+{
+  NLSR_LOG_DEBUG("Updating table with " << changes.added.size() + changes.changed.size()
+                 << " new or changed routes and " << changes.removed.size() << " removed routes");
+  ndn::time::steady_clock::TimePoint startTime = ndn::time::steady_clock::now();
+
+  Fib::Batch fibBatch(m_nlsr.getFib());
+
+  // Destinations that are not in the pool are not used by any name prefix
+  for (const auto* routes : {&changes.added, &changes.changed}) {
+    for (const RoutingTableEntry* route : *routes) {
+      auto poolEntry = m_rtpool.find(route->getDestination());
+      if (poolEntry != m_rtpool.end()) {
+        updatePoolEntry(*poolEntry->second, route);
       }
     }
-    else if (sourceEntry == entries.end()) {
-      NLSR_LOG_DEBUG("Routing entry: " << poolEntry->getDestination() << " now has no next-hops.");
-      poolEntry->getNexthopList().reset();
-      for (const auto& nameEntry : poolEntry->namePrefixTableEntries) {
-        auto nameEntryFullPtr = nameEntry.second.lock();
-        addEntry(nameEntryFullPtr->getNamePrefix(), poolEntry->getDestination());
-      }
+  }
+
+  for (const ndn::Name& destination : changes.removed) {
+    auto poolEntry = m_rtpool.find(destination);
+    if (poolEntry != m_rtpool.end()) {
+      updatePoolEntry(*poolEntry->second, nullptr);
     }
-    else {
-      NLSR_LOG_TRACE("No change in routing entry:" << poolEntry->getDestination()
+  }
+
+  updateDurationSignal(ndn::time::steady_clock::now() - startTime);
+}
+
+void
+NamePrefixTable::updatePoolEntry(RoutingTablePoolEntry& poolEntry, const RoutingTableEntry* route)
+{
+  // If this pool entry has a corresponding entry in the routing table now
+  if (route != nullptr) {
+    if (poolEntry.getNexthopList() == route->getNexthopList()) {
+      NLSR_LOG_TRACE("No change in routing entry:" << poolEntry.getDestination()
                  << ", no action necessary.");
+      return;
     }
+    NLSR_LOG_DEBUG("Routing entry: " << poolEntry.getDestination() << " has changed next-hops.");
+    poolEntry.setNexthopList(route->getNexthopList());
   }
+  else {
+    NLSR_LOG_DEBUG("Routing entry: " << poolEntry.getDestination() << " now has no next-hops.");
+    poolEntry.getNexthopList().reset();
+  }
+
+  for (const auto& nameEntry : poolEntry.namePrefixTableEntries) {
+    auto nameEntryFullPtr = nameEntry.second.lock();
+    addEntry(nameEntryFullPtr->getNamePrefix(), poolEntry.getDestination());
+  }
+}
+
+NamePrefixTable::NptEntryList::iterator
+NamePrefixTable::findEntry(const ndn::Name& name)
+{
+  auto it = m_index.find(name);
+  if (it == m_index.end()) {
+    return m_table.end();
+  }
+  return it->second;
+}
+
+NamePrefixTable::NptEntryList::iterator
+NamePrefixTable::insertEntry(std::shared_ptr<NamePrefixTableEntry> npte)
+{
+  const ndn::Name& name = npte->getNamePrefix();
+  NptEntryList::iterator it = m_table.insert(m_table.end(), std::move(npte));
+  m_index.emplace(name, it);
+  return it;
+}
+
+void
+NamePrefixTable::eraseEntry(NptEntryList::iterator it)
+{
+  m_index.erase((*it)->getNamePrefix());
+  m_table.erase(it);
 }
 
   // Inserts the routing table pool entry into the NPT's RTE storage
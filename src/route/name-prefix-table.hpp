@@ -82,10 +82,23 @@ public:
     the corresponding entry in entries. If no entry is found, it is
     assumed that the destination for that pool entry is inaccessible,
     and its next hop information is deleted.
+
+    Every pool entry is visited, so the routing table calculation uses
+    updateWithChangedRoutes() instead.
    */
   void
   updateWithNewRoute(const std::list<RoutingTableEntry>& entries);
 
+  /*! \brief Updates the routing information of the destinations whose routes changed.
+
+    This is what the NPT does after each routing table calculation, so
+    the work done, including the FIB updates, is proportional to the
+    number of routes that changed rather than to the size of the
+    routing table.
+   */
+  void
+  updateWithChangedRoutes(const RoutingTableChanges& changes);
+
   /*! \brief Adds a pool entry to the pool.
     \param rtpe The entry.
 
@@ -118,10 +131,40 @@ public:
   const_iterator
   end() const;
 
+public:
+  /*! Emitted with how long each update with newly calculated routes took. */
+  DurationSignal<NamePrefixTable> updateDurationSignal;
+
+private:
+  /*! \brief Gives a pool entry new next hops, and updates the name prefixes that use it.
+    \param route The new route, or nullptr if the destination is unreachable.
+   */
+  void
+  updatePoolEntry(RoutingTablePoolEntry& poolEntry, const RoutingTableEntry* route);
+
 PUBLIC_WITH_TESTS_ELSE_PRIVATE:
+  /*! \brief Returns the entry for a name prefix, or m_table.end() if there is none. */
+  NptEntryList::iterator
+  findEntry(const ndn::Name& name);
+
+  /*! \brief Appends an entry to the table and indexes it by its name prefix.
+
+    The table must not already have an entry for the same name prefix.
+   */
+  NptEntryList::iterator
+  insertEntry(std::shared_ptr<NamePrefixTableEntry> npte);
+
+  void
+  eraseEntry(NptEntryList::iterator it);
+
   RoutingTableEntryPool m_rtpool;
 
+  /*! The entries are kept in a list, so they are iterated over in the
+    order they were added, and m_index finds the entry for a name
+    prefix in O(1) on average rather than by searching the list.
+   */
   NptEntryList m_table;
+  std::unordered_map<ndn::Name, NptEntryList::iterator> m_index;
 
 private:
   Nlsr& m_nlsr;
@@ -24,42 +24,18 @@
 #include "nexthop.hpp"
 #include "logger.hpp"
 
+#include <algorithm>
+
 namespace nlsr {
 
 INIT_LOGGER("NexthopList");
 
-static bool
-nexthopAddCompare(const NextHop& nh1, const NextHop& nh2)
-{
-  return nh1.getConnectingFaceUri() == nh2.getConnectingFaceUri();
-}
-
-static bool
-nexthopRemoveCompare(const NextHop& nh1, const NextHop& nh2)
-{
-  return (nh1.getConnectingFaceUri() == nh2.getConnectingFaceUri() &&
-          nh1.getRouteCostAsAdjustedInteger() == nh2.getRouteCostAsAdjustedInteger()) ;
-}
-
 bool
 operator==(const NexthopList& lhs, const NexthopList& rhs)
 {
-  if (lhs.size() != rhs.size()) {
-    return false;
-  }
-
-  NexthopList slhs = lhs;
-  NexthopList srhs = rhs;
-
-  for (struct {std::set<NextHop>::iterator lItr;
-    std::set<NextHop>::iterator rItr;} pair = {slhs.begin(), srhs.begin()};
-       (pair.lItr != slhs.end() || pair.rItr != srhs.end());
-       pair.rItr++, pair.lItr++) {
-    if (!((*pair.lItr) == (*pair.rItr))) {
-      return false;
-    }
-  }
-  return true;
+  // Both lists are sorted the same way
+  return lhs.size() == rhs.size() &&
+         std::equal(lhs.begin(), lhs.end(), rhs.begin());
 }
 
 bool
@@ -71,9 +47,8 @@ operator!=(const NexthopList& lhs, const NexthopList& rhs)
 std::ostream&
 operator<<(std::ostream& os, const NexthopList& nhl)
 {
-  NexthopList& ucnhl = const_cast<NexthopList&>(nhl);
   os << "NexthopList(\nNext hops: ";
-  for (auto&& nh : ucnhl.getNextHops()) {
+  for (auto&& nh : nhl.getNextHops()) {
     os << nh;
   }
   os << ")";
@@ -83,24 +58,26 @@ operator<<(std::ostream& os, const NexthopList& nhl)
 void
 NexthopList::addNextHop(const NextHop& nh)
 {
-  std::set<NextHop, NextHopComparator>::iterator it = std::find_if(m_nexthopList.begin(),
-                                                 m_nexthopList.end(),
-                                                 std::bind(&nexthopAddCompare, _1, nh));
-  if (it == m_nexthopList.end()) {
-    m_nexthopList.insert(nh);
-  }
-  else if (it->getRouteCost() > nh.getRouteCost()) {
-    removeNextHop(*it);
-    m_nexthopList.insert(nh);
+  auto it = std::find_if(m_nexthopList.begin(), m_nexthopList.end(),
+                         [&nh] (const NextHop& hop) {
+                           return hop.getFaceUriId() == nh.getFaceUriId();
+                         });
+  if (it != m_nexthopList.end()) {
+    if (it->getRouteCost() <= nh.getRouteCost()) {
+      return;
+    }
+    m_nexthopList.erase(it);
   }
+
+  m_nexthopList.insert(std::upper_bound(m_nexthopList.begin(), m_nexthopList.end(),
+                                        nh, NextHopComparator()),
+                       nh);
 }
 
 void
 NexthopList::removeNextHop(const NextHop& nh)
 {
-  std::set<NextHop, NextHopComparator>::iterator it = std::find_if(m_nexthopList.begin(),
-                                                 m_nexthopList.end(),
-                                                 std::bind(&nexthopRemoveCompare, _1, nh));
+  auto it = std::find(m_nexthopList.begin(), m_nexthopList.end(), nh);
   if (it != m_nexthopList.end()) {
     m_nexthopList.erase(it);
   }
@@ -109,9 +86,13 @@ NexthopList::removeNextHop(const NextHop& nh)
 void
 NexthopList::writeLog()
 {
+  if (!NLSR_LOG_IS_DEBUG_ENABLED()) {
+    return;
+  }
+
   int i = 1;
 
-  for (std::set<NextHop, NextHopComparator>::iterator it = m_nexthopList.begin();
+  for (NextHops::const_iterator it = m_nexthopList.begin();
        it != m_nexthopList.end() ; it++, i++) {
     NLSR_LOG_DEBUG("Nexthop " << i << ": " << (*it).getConnectingFaceUri()
                << " Route Cost: " << (*it).getRouteCost());
@@ -24,31 +24,60 @@
 #include "nexthop.hpp"
 #include "adjacent.hpp"
 
-#include <set>
 #include <iostream>
 #include <boost/cstdint.hpp>
+#include <boost/version.hpp>
 #include <ndn-cxx/face.hpp>
 
+#if BOOST_VERSION >= 105800
+#include <boost/container/small_vector.hpp>
+#else
+#include <vector>
+#endif // BOOST_VERSION >= 105800
+
 namespace nlsr {
 
+/*! \brief Orders next hops by cost, and then by face URI.
+
+  The costs are compared as precomputed integers. Face URIs are only
+  compared as strings between next hops of the same cost through
+  different faces.
+ */
 struct NextHopComparator {
   bool
   operator() (const NextHop& nh1, const NextHop& nh2) const {
-    if (nh1.getRouteCostAsAdjustedInteger() < nh2.getRouteCostAsAdjustedInteger()) {
-      return true;
+    if (nh1.getRouteCostAsAdjustedInteger() != nh2.getRouteCostAsAdjustedInteger()) {
+      return nh1.getRouteCostAsAdjustedInteger() < nh2.getRouteCostAsAdjustedInteger();
     }
-    else if (nh1.getRouteCostAsAdjustedInteger() == nh2.getRouteCostAsAdjustedInteger()) {
-      return nh1.getConnectingFaceUri() < nh2.getConnectingFaceUri();
+    else if (nh1.getFaceUriId() == nh2.getFaceUriId()) {
+      return false;
     }
     else {
-      return false;
+      return nh1.getConnectingFaceUri() < nh2.getConnectingFaceUri();
     }
   }
 };
 
+/*! \brief A list of next hops, sorted by NextHopComparator, with at most
+    one next hop per face.
+
+  The next hops are kept in a sorted flat array. Most lists have no more
+  than a few next hops, which are stored inline, so building a list
+  does not allocate.
+ */
 class NexthopList
 {
 public:
+#if BOOST_VERSION >= 105800
+  typedef boost::container::small_vector<NextHop, 8> NextHops;
+#else
+  typedef std::vector<NextHop> NextHops;
+#endif // BOOST_VERSION >= 105800
+
+  // The next hops are sorted, so they cannot be modified in place
+  typedef NextHops::const_iterator iterator;
+  typedef NextHops::const_iterator const_iterator;
+
   NexthopList()
   {
   }
@@ -87,23 +116,20 @@ public:
     m_nexthopList.clear();
   }
 
-  std::set<NextHop, NextHopComparator>&
-  getNextHops()
+  const NextHops&
+  getNextHops() const
   {
     return m_nexthopList;
   }
 
-  typedef std::set<NextHop, NextHopComparator>::iterator iterator;
-  typedef std::set<NextHop, NextHopComparator>::const_iterator const_iterator;
-
-  iterator
-  begin()
+  const_iterator
+  begin() const
   {
     return m_nexthopList.begin();
   }
 
-  iterator
-  end()
+  const_iterator
+  end() const
   {
     return m_nexthopList.end();
   }
@@ -124,12 +150,9 @@ public:
   writeLog();
 
 private:
-  std::set<NextHop, NextHopComparator> m_nexthopList;
+  NextHops m_nexthopList;
 };
 
-bool
-operator==(NexthopList& lhs, NexthopList& rhs);
-
 bool
 operator==(const NexthopList& lhs, const NexthopList& rhs);
 
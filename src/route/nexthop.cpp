@@ -21,15 +21,54 @@
  **/
 
 #include "nexthop.hpp"
+#include "utility/interner.hpp"
 
 namespace nlsr {
 
+const uint32_t NextHop::EMPTY_FACE_URI_ID = 0;
+
+static util::Interner<std::string>&
+getFaceUriInterner()
+{
+  static util::Interner<std::string> interner;
+  if (interner.size() == 0) {
+    interner.intern("");
+  }
+  return interner;
+}
+
+NextHop::NextHop(const std::string& cfu, double rc)
+  : m_faceUriId(internFaceUri(cfu))
+  , m_routeCost(rc)
+  , m_isHyperbolic(false)
+{
+  m_adjustedRouteCost = calculateAdjustedRouteCost();
+}
+
+uint32_t
+NextHop::internFaceUri(const std::string& faceUri)
+{
+  return getFaceUriInterner().intern(faceUri);
+}
+
+const std::string&
+NextHop::getConnectingFaceUri() const
+{
+  return getFaceUriInterner().get(m_faceUriId);
+}
+
+void
+NextHop::setConnectingFaceUri(const std::string& cfu)
+{
+  m_faceUriId = internFaceUri(cfu);
+}
+
 bool
 operator==(const NextHop& lhs, const NextHop& rhs)
 {
   return ((lhs.getRouteCostAsAdjustedInteger() == rhs.getRouteCostAsAdjustedInteger())
           &&
-          (lhs.getConnectingFaceUri() == rhs.getConnectingFaceUri()));
+          (lhs.getFaceUriId() == rhs.getFaceUriId()));
 }
 
 std::ostream&
@@ -24,50 +24,51 @@
 
 #include <iostream>
 #include <cmath>
+#include <string>
 #include <boost/cstdint.hpp>
 
 namespace nlsr {
+
+/*! \brief A face through which a destination can be reached, and at what cost.
+
+  The face URI is interned, so a NextHop holds no string of its own:
+  copying one does not allocate, and two NextHops are compared by an
+  integer face ID and a precomputed integer cost.
+ */
 class NextHop
 {
 public:
   NextHop()
-    : m_connectingFaceUri()
+    : m_faceUriId(EMPTY_FACE_URI_ID)
     , m_routeCost(0)
+    , m_adjustedRouteCost(0)
     , m_isHyperbolic(false)
   {
   }
 
-  NextHop(const std::string& cfu, double rc)
-    : m_isHyperbolic(false)
-  {
-    m_connectingFaceUri = cfu;
-    m_routeCost = rc;
-  }
+  NextHop(const std::string& cfu, double rc);
 
   const std::string&
-  getConnectingFaceUri() const
-  {
-    return m_connectingFaceUri;
-  }
+  getConnectingFaceUri() const;
 
   void
-  setConnectingFaceUri(const std::string& cfu)
+  setConnectingFaceUri(const std::string& cfu);
+
+  /*! \brief Returns the ID of the connecting face URI.
+
+    Two NextHops have the same face URI if and only if they have the
+    same face URI ID.
+   */
+  uint32_t
+  getFaceUriId() const
   {
-    m_connectingFaceUri = cfu;
+    return m_faceUriId;
   }
 
   uint64_t
   getRouteCostAsAdjustedInteger() const
   {
-    if (m_isHyperbolic) {
-      // Round the cost to better preserve decimal cost differences
-      // e.g. Without rounding: 12.3456 > 12.3454 -> 12345 = 12345
-      //      With rounding:    12.3456 > 12.3454 -> 12346 > 12345
-      return static_cast<uint64_t>(round(m_routeCost*HYPERBOLIC_COST_ADJUSTMENT_FACTOR));
-    }
-    else {
-      return static_cast<uint64_t>(m_routeCost);
-    }
+    return m_adjustedRouteCost;
   }
 
   double
@@ -80,12 +81,14 @@ public:
   setRouteCost(const double rc)
   {
     m_routeCost = rc;
+    m_adjustedRouteCost = calculateAdjustedRouteCost();
   }
 
   void
   setHyperbolic(bool b)
   {
     m_isHyperbolic = b;
+    m_adjustedRouteCost = calculateAdjustedRouteCost();
   }
 
   bool
@@ -95,8 +98,32 @@ public:
   }
 
 private:
-  std::string m_connectingFaceUri;
+  uint64_t
+  calculateAdjustedRouteCost() const
+  {
+    if (m_isHyperbolic) {
+      // Round the cost to better preserve decimal cost differences
+      // e.g. Without rounding: 12.3456 > 12.3454 -> 12345 = 12345
+      //      With rounding:    12.3456 > 12.3454 -> 12346 > 12345
+      return static_cast<uint64_t>(round(m_routeCost*HYPERBOLIC_COST_ADJUSTMENT_FACTOR));
+    }
+    else {
+      return static_cast<uint64_t>(m_routeCost);
+    }
+  }
+
+  static uint32_t
+  internFaceUri(const std::string& faceUri);
+
+public:
+  // The empty face URI is interned first
+  static const uint32_t EMPTY_FACE_URI_ID;
+
+private:
+  uint32_t m_faceUriId;
   double m_routeCost;
+  // Kept up to date with the route cost, as it is what next hops are sorted by
+  uint64_t m_adjustedRouteCost;
   bool m_isHyperbolic;
 
 PUBLIC_WITH_TESTS_ELSE_PRIVATE:
@@ -20,6 +20,7 @@
  **/
 
 #include "routing-table-calculator.hpp"
+#include "calculation-pool.hpp"
 #include "lsdb.hpp"
 #include "map.hpp"
 #include "lsa.hpp"
@@ -27,8 +28,8 @@
 #include "nlsr.hpp"
 #include "logger.hpp"
 
+#include <algorithm>
 #include <iostream>
-#include <boost/math/constants/constants.hpp>
 #include <cmath>
 
 namespace nlsr {
@@ -36,170 +37,37 @@ namespace nlsr {
 INIT_LOGGER("RoutingTableCalculator");
 
 void
-RoutingTableCalculator::allocateAdjMatrix()
+RoutingTableCalculator::makeAdjGraph(const Lsdb& lsdb, Map& pMap)
 {
-  adjMatrix = new double*[m_nRouters];
+  m_nRouters = pMap.getMapSize();
 
-  for (size_t i = 0; i < m_nRouters; ++i) {
-    adjMatrix[i] = new double[m_nRouters];
-  }
-}
+  // The links are kept between calculations, so that their storage is reused
+  std::vector<AdjacencyGraph::Link>& links = m_links;
+  links.clear();
 
-void
-RoutingTableCalculator::initMatrix()
-{
-  for (size_t i = 0; i < m_nRouters; i++) {
-    for (size_t j = 0; j < m_nRouters; j++) {
-      adjMatrix[i][j] = 0;
-    }
-  }
-}
-
-void
-RoutingTableCalculator::makeAdjMatrix(Nlsr& pnlsr, Map pMap)
-{
-  std::list<AdjLsa> adjLsdb = pnlsr.getLsdb().getAdjLsdb();
   // For each LSA represented in the map
-  for (std::list<AdjLsa>::iterator it = adjLsdb.begin(); it != adjLsdb.end() ; it++) {
-
-
-    ndn::optional<int32_t> row = pMap.getMappingNoByRouterName((*it).getOrigRouter());
-
-    std::list<Adjacent> adl = (*it).getAdl().getAdjList();
-    // For each adjacency represented in the LSA
-    for (std::list<Adjacent>::iterator itAdl = adl.begin(); itAdl != adl.end() ; itAdl++) {
-
-      ndn::optional<int32_t> col = pMap.getMappingNoByRouterName((*itAdl).getName());
-      double cost = (*itAdl).getLinkCost();
-
-      if (row && col && *row < static_cast<int32_t>(m_nRouters)
-          && *col < static_cast<int32_t>(m_nRouters))
-      {
-        adjMatrix[*row][*col] = cost;
-      }
+  for (const AdjLsa& adjLsa : lsdb.getAdjLsdb()) {
+    ndn::optional<int32_t> row = pMap.getMappingNoByRouterName(adjLsa.getOrigRouter());
+    if (!row) {
+      continue;
     }
-  }
-
-  // Links that do not have the same cost for both directions should
-  // have their costs corrected:
-  //
-  //   If the cost of one side of the link is 0, both sides of the
-  //   link should have their cost corrected to 0.
-  //
-  //   Otherwise, both sides of the link should use the larger of the two costs.
-  //
-  // Additionally, this means that we can halve the amount of space
-  // that the matrix uses by only maintaining a triangle.
-  // - But that is not yet implemented.
-  for (size_t row = 0; row < m_nRouters; ++row) {
-    for (size_t col = 0; col < m_nRouters; ++col) {
-      double toCost = adjMatrix[row][col];
-      double fromCost = adjMatrix[col][row];
-
-      if (fromCost != toCost) {
-        double correctedCost = 0.0;
-
-        if (toCost != 0 && fromCost != 0) {
-          // If both sides of the link are up, use the larger cost
-          correctedCost = std::max(toCost, fromCost);
-        }
 
-        NLSR_LOG_WARN("Cost between [" << row << "][" << col << "] and [" << col << "][" << row <<
-                  "] are not the same (" << toCost << " != " << fromCost << "). " <<
-                  "Correcting to cost: " << correctedCost);
-
-        adjMatrix[row][col] = correctedCost;
-        adjMatrix[col][row] = correctedCost;
+    // For each adjacency represented in the LSA
+    for (const Adjacent& adjacent : adjLsa.getAdl()) {
+      ndn::optional<int32_t> col = pMap.getMappingNoByRouterName(adjacent.getName());
+      if (col) {
+        links.push_back({*row, *col, static_cast<double>(adjacent.getLinkCost())});
       }
     }
   }
-}
 
-void
-RoutingTableCalculator::writeAdjMatrixLog()
-{
-  for (size_t i = 0; i < m_nRouters; i++) {
-    std::string line="";
-    for (size_t j = 0; j < m_nRouters; j++) {
-      line += boost::lexical_cast<std::string>(adjMatrix[i][j]);
-      line += " ";
-    }
-    NLSR_LOG_DEBUG(line);
-  }
+  m_graph.build(m_nRouters, links);
 }
 
 void
-RoutingTableCalculator::adjustAdMatrix(int source, int link, double linkCost)
-{
-  for (int i = 0; i < static_cast<int>(m_nRouters); i++) {
-    if (i == link) {
-      adjMatrix[source][i] = linkCost;
-    }
-    else {
-      adjMatrix[source][i] = 0;
-    }
-  }
-}
-
-int
-RoutingTableCalculator::getNumOfLinkfromAdjMatrix(int sRouter)
+RoutingTableCalculator::writeAdjGraphLog()
 {
-  int noLink = 0;
-
-  for (size_t i = 0; i < m_nRouters; i++) {
-    if (adjMatrix[sRouter][i] > 0) {
-      noLink++;
-    }
-  }
-  return noLink;
-}
-
-void
-RoutingTableCalculator::getLinksFromAdjMatrix(int* links,
-                                              double* linkCosts, int source)
-{
-  int j = 0;
-
-  for (size_t i = 0; i < m_nRouters; i++) {
-    if (adjMatrix[source][i] > 0) {
-      links[j] = i;
-      linkCosts[j] = adjMatrix[source][i];
-      j++;
-    }
-  }
-}
-
-void
-RoutingTableCalculator::freeAdjMatrix()
-{
-  for (size_t i = 0; i < m_nRouters; ++i) {
-    delete [] adjMatrix[i];
-  }
-  delete [] adjMatrix;
-}
-
-void
-RoutingTableCalculator::allocateLinks()
-{
-  links = new int[vNoLink];
-}
-
-void
-RoutingTableCalculator::allocateLinkCosts()
-{
-  linkCosts = new double[vNoLink];
-}
-
-
-void
-RoutingTableCalculator::freeLinks()
-{
-  delete [] links;
-}
-void
-RoutingTableCalculator::freeLinksCosts()
-{
-  delete [] linkCosts;
+  m_graph.writeLog();
 }
 
 void
@@ -207,93 +75,71 @@ LinkStateRoutingTableCalculator::calculatePath(Map& pMap,
                                                RoutingTable& rt, Nlsr& pnlsr)
 {
   NLSR_LOG_DEBUG("LinkStateRoutingTableCalculator::calculatePath Called");
-  allocateAdjMatrix();
-  initMatrix();
-  makeAdjMatrix(pnlsr, pMap);
-  writeAdjMatrixLog();
+  makeAdjGraph(pnlsr.getLsdb(), pMap);
+  writeAdjGraphLog();
   ndn::optional<int32_t> sourceRouter =
     pMap.getMappingNoByRouterName(pnlsr.getConfParameter().getRouterPrefix());
-  allocateParent(); // These two matrices are used in Dijkstra's algorithm.
-  allocateDistance(); //
   // We only bother to do the calculation if we have a router by that name.
-  if (sourceRouter && pnlsr.getConfParameter().getMaxFacesPerPrefix() == 1) {
+  if (!sourceRouter) {
+    return;
+  }
+  if (pnlsr.getConfParameter().getMaxFacesPerPrefix() == 1) {
     // In the single path case we can simply run Dijkstra's algorithm.
-    doDijkstraPathCalculation(*sourceRouter);
+    m_spf.calculate(m_graph, *sourceRouter);
     // Inform the routing table of the new next hops.
     addAllLsNextHopsToRoutingTable(pnlsr, rt, pMap, *sourceRouter);
   }
   else {
-    // Multi Path
-    setNoLink(getNumOfLinkfromAdjMatrix(*sourceRouter));
-    allocateLinks();
-    allocateLinkCosts();
-    // Gets a sparse listing of adjacencies for path calculation
-    getLinksFromAdjMatrix(links, linkCosts, *sourceRouter);
-    for (int i = 0 ; i < vNoLink; i++) {
-      // Simulate that only the current neighbor is accessible
-      adjustAdMatrix(*sourceRouter, links[i], linkCosts[i]);
-      writeAdjMatrixLog();
-      // Do Dijkstra's algorithm using the current neighbor as your start.
-      doDijkstraPathCalculation(*sourceRouter);
-      // Update the routing table with the calculations.
-      addAllLsNextHopsToRoutingTable(pnlsr, rt, pMap, *sourceRouter);
-    }
-    freeLinks();
-    freeLinksCosts();
+    // Multi Path. Every next hop of a destination is kept in the routing
+    // table; the Fib installs at most max-faces-per-prefix of them.
+    m_spf.calculateMultipath(m_graph, *sourceRouter);
+    // Update the routing table with the calculations.
+    addAllLsMultipathNextHopsToRoutingTable(pnlsr, rt, pMap, *sourceRouter);
   }
-  freeParent();
-  freeDistance();
-  freeAdjMatrix();
 }
 
-void
-LinkStateRoutingTableCalculator::doDijkstraPathCalculation(int sourceRouter)
+bool
+LinkStateRoutingTableCalculator::calculateMultipathOnPool(Map& pMap, Nlsr& pnlsr,
+                                                          CalculationPool& pool,
+                                                          std::function<void()> afterCalculation)
 {
-  int i;
-  int v, u;
-  int* Q = new int[m_nRouters]; // Each cell represents the router with that mapping no.
-  int head = 0;
-  // Initiate the parent
-  for (i = 0 ; i < static_cast<int>(m_nRouters); i++) {
-    m_parent[i] = EMPTY_PARENT;
-    // Array where the ith element is the distance to the router with mapping no i.
-    m_distance[i] = INF_DISTANCE;
-    Q[i] = i;
+  NLSR_LOG_DEBUG("LinkStateRoutingTableCalculator::calculateMultipathOnPool Called");
+  makeAdjGraph(pnlsr.getLsdb(), pMap);
+  writeAdjGraphLog();
+  ndn::optional<int32_t> sourceRouter =
+    pMap.getMappingNoByRouterName(pnlsr.getConfParameter().getRouterPrefix());
+  if (!sourceRouter) {
+    return false;
   }
-  if (sourceRouter != NO_MAPPING_NUM) {
-    // Distance to source from source is always 0.
-    m_distance[sourceRouter] = 0;
-    sortQueueByDistance(Q, m_distance, head, m_nRouters);
-    // While we haven't visited every node.
-    while (head < static_cast<int>(m_nRouters)) {
-      u = Q[head]; // Set u to be the current node pointed to by head.
-      if (m_distance[u] == INF_DISTANCE) {
-        break; // This can only happen when there are no accessible nodes.
-      }
-      // Iterate over the adjacent nodes to u.
-      for (v = 0 ; v < static_cast<int>(m_nRouters); v++) {
-        // If the current node is accessible.
-        if (adjMatrix[u][v] > 0) {
-          // And we haven't visited it yet.
-          if (isNotExplored(Q, v, head + 1, m_nRouters)) {
-            // And if the distance to this node + from this node to v
-            // is less than the distance from our source node to v
-            // that we got when we built the adj LSAs
-            if (m_distance[u] + adjMatrix[u][v] <  m_distance[v]) {
-              // Set the new distance
-              m_distance[v] = m_distance[u] + adjMatrix[u][v] ;
-              // Set how we get there.
-              m_parent[v] = u;
-            }
-          }
-        }
-      }
-      // Increment the head position, resort the list by distance from where we are.
-      head++;
-      sortQueueByDistance(Q, m_distance, head, m_nRouters);
-    }
+  m_sourceRouter = *sourceRouter;
+
+  // Each worker sweeps its own share of the first hops
+  std::vector<std::function<void()>> tasks;
+  m_spf.prepareMultipath(m_graph, m_sourceRouter);
+  size_t nFirstHops = m_spf.getNumOfFirstHops();
+  size_t nTasks = std::min(pool.getNThreads(), nFirstHops);
+  for (size_t task = 0; task < nTasks; ++task) {
+    size_t begin = task * nFirstHops / nTasks;
+    size_t end = (task + 1) * nFirstHops / nTasks;
+    tasks.push_back([this, begin, end] {
+      // Each worker keeps its own scratch storage between calculations
+      static thread_local ShortestPathCalculator scratch;
+      m_spf.calculateThrough(m_graph, m_sourceRouter, begin, end, scratch);
+    });
   }
-  delete [] Q;
+
+  NLSR_LOG_DEBUG("Calculating " << tasks.size() << " tasks on "
+                 << pool.getNThreads() << " threads");
+  pool.run(std::move(tasks), std::move(afterCalculation));
+  return true;
+}
+
+void
+LinkStateRoutingTableCalculator::addMultipathNextHopsToRoutingTable(Nlsr& pnlsr,
+                                                                    RoutingTable& rt,
+                                                                    Map& pMap)
+{
+  addAllLsMultipathNextHopsToRoutingTable(pnlsr, rt, pMap, m_sourceRouter);
 }
 
 void
@@ -304,105 +150,65 @@ LinkStateRoutingTableCalculator::addAllLsNextHopsToRoutingTable(Nlsr& pnlsr, Rou
 
   int nextHopRouter = 0;
 
+  // Next hops are neighbors of the source; look up the face of each one
+  // once, rather than for every destination
+  size_t firstLink = m_graph.linksBegin(sourceRouter);
+  std::vector<std::string> nextHopFaces(m_graph.getNumOfLinks(sourceRouter));
+
   // For each router we have
   for (size_t i = 0; i < m_nRouters ; i++) {
     if (i != sourceRouter) {
 
       // Obtain the next hop that was determined by the algorithm
-      nextHopRouter = getLsNextHop(i, sourceRouter);
+      nextHopRouter = m_spf.getNextHop(i);
 
       // If this router is accessible at all
-      if (nextHopRouter != NO_NEXT_HOP) {
+      if (nextHopRouter != ShortestPathCalculator::NO_ROUTER) {
 
         // Fetch its distance
-        double routeCost = m_distance[i];
-        // Fetch its actual name
-        ndn::optional<ndn::Name> nextHopRouterName= pMap.getRouterNameByMappingNo(nextHopRouter);
-        if (nextHopRouterName) {
-          std::string nextHopFace =
-            pnlsr.getAdjacencyList().getAdjacent(*nextHopRouterName).getFaceUri().toString();
-          // Add next hop to routing table
-          NextHop nh(nextHopFace, routeCost);
-          rt.addNextHop(*(pMap.getRouterNameByMappingNo(i)), nh);
-
+        double routeCost = m_spf.getDistance(i);
+        std::string& nextHopFace =
+          nextHopFaces[m_graph.findLink(sourceRouter, nextHopRouter) - firstLink];
+        if (nextHopFace.empty()) {
+          // Fetch its actual name
+          const ndn::Name& nextHopRouterName = pMap.getRouterName(nextHopRouter);
+          nextHopFace =
+            pnlsr.getAdjacencyList().getAdjacent(nextHopRouterName).getFaceUri().toString();
         }
+        // Add next hop to routing table
+        NextHop nh(nextHopFace, routeCost);
+        rt.addNextHop(pMap.getRouterName(i), nh);
       }
     }
   }
 }
 
-int
-LinkStateRoutingTableCalculator::getLsNextHop(int dest, int source)
-{
-  int nextHop = NO_NEXT_HOP;
-  while (m_parent[dest] != EMPTY_PARENT) {
-    nextHop = dest;
-    dest = m_parent[dest];
-  }
-  if (dest != source) {
-    nextHop = NO_NEXT_HOP;
-  }
-  return nextHop;
-}
-
 void
-LinkStateRoutingTableCalculator::sortQueueByDistance(int* Q,
-                                                     double* dist,
-                                                     int start, int element)
+LinkStateRoutingTableCalculator::addAllLsMultipathNextHopsToRoutingTable(Nlsr& pnlsr,
+                                                                         RoutingTable& rt,
+                                                                         Map& pMap,
+                                                                         uint32_t sourceRouter)
 {
-  for (int i = start ; i < element ; i++) {
-    for (int j = i + 1; j < element; j++) {
-      if (dist[Q[j]] < dist[Q[i]]) {
-        int tempU = Q[j];
-        Q[j] = Q[i];
-        Q[i] = tempU;
+  NLSR_LOG_DEBUG("LinkStateRoutingTableCalculator::addAllLsMultipathNextHopsToRoutingTable Called");
+
+  // For each neighbor that a path can start with
+  for (size_t index = 0; index < m_spf.getNumOfFirstHops(); ++index) {
+    const ndn::Name& nextHopRouterName = pMap.getRouterName(m_spf.getFirstHop(index));
+    std::string nextHopFace =
+      pnlsr.getAdjacencyList().getAdjacent(nextHopRouterName).getFaceUri().toString();
+
+    // For each router we have
+    for (size_t i = 0; i < m_nRouters; i++) {
+      // If this router is accessible through the neighbor at all
+      if (i != sourceRouter && m_spf.isReachableThrough(index, i)) {
+        // Add next hop to routing table
+        NextHop nh(nextHopFace, m_spf.getDistanceThrough(index, i));
+        rt.addNextHop(pMap.getRouterName(i), nh);
       }
     }
   }
 }
 
-int
-LinkStateRoutingTableCalculator::isNotExplored(int* Q,
-                                               int u, int start, int element)
-{
-  int ret = 0;
-  for (int i = start; i < element; i++) {
-    if (Q[i] == u) {
-      ret = 1;
-      break;
-    }
-  }
-  return ret;
-}
-
-void
-LinkStateRoutingTableCalculator::allocateParent()
-{
-  m_parent = new int[m_nRouters];
-}
-
-void
-LinkStateRoutingTableCalculator::allocateDistance()
-{
-  m_distance = new double[m_nRouters];
-}
-
-void
-LinkStateRoutingTableCalculator::freeParent()
-{
-  delete [] m_parent;
-}
-
-void LinkStateRoutingTableCalculator::freeDistance()
-{
-  delete [] m_distance;
-}
-
-const double HyperbolicRoutingCalculator::MATH_PI = boost::math::constants::pi<double>();
-
-const double HyperbolicRoutingCalculator::UNKNOWN_DISTANCE = -1.0;
-const double HyperbolicRoutingCalculator::UNKNOWN_RADIUS   = -1.0;
-
 void
 HyperbolicRoutingCalculator::calculatePaths(Map& map, RoutingTable& rt,
                                             Lsdb& lsdb, AdjacencyList& adjacencies)
@@ -410,10 +216,18 @@ HyperbolicRoutingCalculator::calculatePaths(Map& map, RoutingTable& rt,
   NLSR_LOG_TRACE("Calculating hyperbolic paths");
 
   ndn::optional<int32_t> thisRouter = map.getMappingNoByRouterName(m_thisRouterName);
+  const CoordinateCache& coordinates = lsdb.getCoordinateCache();
+
+  // Look up the coordinates of every router once, rather than once per neighbor
+  std::vector<ndn::optional<size_t>> routerCoordinates(m_nRouters);
+  for (int router = 0; router < static_cast<int>(m_nRouters); ++router) {
+    routerCoordinates[router] = coordinates.find(map.getRouterName(router));
+  }
+  std::vector<double> distances;
 
   // Iterate over directly connected neighbors
-  std::list<Adjacent> neighbors = adjacencies.getAdjList();
-  for (std::list<Adjacent>::iterator adj = neighbors.begin(); adj != neighbors.end(); ++adj) {
+  const std::list<Adjacent>& neighbors = adjacencies.getAdjList();
+  for (std::list<Adjacent>::const_iterator adj = neighbors.begin(); adj != neighbors.end(); ++adj) {
 
     // Don't calculate nexthops using an inactive router
     if (adj->getStatus() == Adjacent::STATUS_INACTIVE) {
@@ -421,7 +235,7 @@ HyperbolicRoutingCalculator::calculatePaths(Map& map, RoutingTable& rt,
       continue;
     }
 
-    ndn::Name srcRouterName = adj->getName();
+    const ndn::Name& srcRouterName = adj->getName();
 
     // Don't calculate nexthops for this router to other routers
     if (srcRouterName == m_thisRouterName) {
@@ -441,169 +255,39 @@ HyperbolicRoutingCalculator::calculatePaths(Map& map, RoutingTable& rt,
     }
 
     // Get hyperbolic distance from direct neighbor to every other router
+    ndn::optional<size_t> srcCoordinates = coordinates.find(srcRouterName);
+    if (srcCoordinates) {
+      coordinates.calculateDistances(*srcCoordinates, distances);
+    }
+
     for (int dest = 0; dest < static_cast<int>(m_nRouters); ++dest) {
       // Don't calculate nexthops to this router or from a router to itself
       if (thisRouter && dest != *thisRouter && dest != *src) {
 
-        ndn::optional<ndn::Name> destRouterName = map.getRouterNameByMappingNo(dest);
-        if (destRouterName) {
-          double distance = getHyperbolicDistance(map, lsdb, srcRouterName, *destRouterName);
-
-          // Could not compute distance
-          if (distance == UNKNOWN_DISTANCE) {
-            NLSR_LOG_WARN("Could not calculate hyperbolic distance from " << srcRouterName << " to " <<
-                      *destRouterName);
-            continue;
-          }
-
-          addNextHop(*destRouterName, srcFaceUri, distance, rt);
+        const ndn::Name& destRouterName = map.getRouterName(dest);
+        double distance = CoordinateCache::UNKNOWN_DISTANCE;
+        // Coordinate LSAs may not exist for these routers
+        if (srcCoordinates && routerCoordinates[dest]) {
+          distance = distances[*routerCoordinates[dest]];
         }
-      }
-    }
-  }
-}
-
-double
-HyperbolicRoutingCalculator::getHyperbolicDistance(Map& map, Lsdb& lsdb,
-                                                   ndn::Name src, ndn::Name dest)
-{
-  NLSR_LOG_TRACE("Calculating hyperbolic distance from " << src << " to " << dest);
-
-  double distance = UNKNOWN_DISTANCE;
 
-  ndn::Name srcLsaKey = src;
-  srcLsaKey.append(std::to_string(Lsa::Type::COORDINATE));
-
-  CoordinateLsa* srcLsa = lsdb.findCoordinateLsa(srcLsaKey);
-
-  ndn::Name destLsaKey = dest;
-  destLsaKey.append(std::to_string(Lsa::Type::COORDINATE));
-
-  CoordinateLsa* destLsa = lsdb.findCoordinateLsa(destLsaKey);
-
-  // Coordinate LSAs do not exist for these routers
-  if (srcLsa == nullptr || destLsa == nullptr) {
-    return UNKNOWN_DISTANCE;
-  }
-
-  std::vector<double> srcTheta = srcLsa->getCorTheta();
-  std::vector<double> destTheta = destLsa->getCorTheta();
-
-  double srcRadius = srcLsa->getCorRadius();
-  double destRadius = destLsa->getCorRadius();
-
-  double diffTheta = calculateAngularDistance(srcTheta, destTheta);
-
-  if (srcRadius == UNKNOWN_RADIUS || destRadius == UNKNOWN_RADIUS ||
-      diffTheta == UNKNOWN_DISTANCE) {
-    return UNKNOWN_DISTANCE;
-  }
-
-  // double r_i, double r_j, double delta_theta, double zeta = 1 (default)
-  distance = calculateHyperbolicDistance(srcRadius, destRadius, diffTheta);
-
-  NLSR_LOG_TRACE("Distance from " << src << " to " << dest << " is " << distance);
-
-  return distance;
-}
-
-double
-HyperbolicRoutingCalculator::calculateAngularDistance(std::vector<double> angleVectorI,
-                                                      std::vector<double> angleVectorJ)
-{
-  // It is not possible for angle vector size to be zero as ensured by conf-file-processor
-
-  // https://en.wikipedia.org/wiki/N-sphere#Spherical_coordinates
-
-  // Check if two vector lengths are the same
-  if (angleVectorI.size() != angleVectorJ.size()) {
-    NLSR_LOG_ERROR("Angle vector sizes do not match");
-    return UNKNOWN_DISTANCE;
-  }
-
-  // Check if all angles are within the [0, PI] and [0, 2PI] ranges
-  if (angleVectorI.size() > 1) {
-    for (unsigned int k = 0; k < angleVectorI.size() - 1; k++) {
-      if ((angleVectorI[k] > M_PI && angleVectorI[k] < 0.0) ||
-          (angleVectorJ[k] > M_PI && angleVectorJ[k] < 0.0)) {
-        NLSR_LOG_ERROR("Angle outside [0, PI]");
-        return UNKNOWN_DISTANCE;
-      }
-    }
-  }
-  if (angleVectorI[angleVectorI.size()-1] > 2.*M_PI ||
-      angleVectorI[angleVectorI.size()-1] < 0.0) {
-    NLSR_LOG_ERROR("Angle not within [0, 2PI]");
-    return UNKNOWN_DISTANCE;
-  }
-
-  if (angleVectorI[angleVectorI.size()-1] > 2.*M_PI ||
-      angleVectorI[angleVectorI.size()-1] < 0.0) {
-    NLSR_LOG_ERROR("Angle not within [0, 2PI]");
-    return UNKNOWN_DISTANCE;
-  }
-
-  // deltaTheta = arccos(vectorI . vectorJ) -> do the inner product
-  double innerProduct = 0.0;
-
-  // Calculate x0 of the vectors
-  double x0i = std::cos(angleVectorI[0]);
-  double x0j = std::cos(angleVectorJ[0]);
-
-  // Calculate xn of the vectors
-  double xni = std::sin(angleVectorI[angleVectorI.size() - 1]);
-  double xnj = std::sin(angleVectorJ[angleVectorJ.size() - 1]);
+        // Could not compute distance
+        if (distance == CoordinateCache::UNKNOWN_DISTANCE) {
+          NLSR_LOG_WARN("Could not calculate hyperbolic distance from " << srcRouterName << " to " <<
+                    destRouterName);
+          continue;
+        }
 
-  // Do the aggregation of the (n-1) coordinates (if there is more than one angle)
-  // i.e contraction of all (n-1)-dimensional angular coordinates to one variable
-  for (unsigned int k = 0; k < angleVectorI.size() - 1; k++) {
-    xni *= std::sin(angleVectorI[k]);
-    xnj *= std::sin(angleVectorJ[k]);
-  }
-  innerProduct += (x0i * x0j) + (xni * xnj);
-
-  // If d > 1
-  if (angleVectorI.size() > 1) {
-    for (unsigned int m = 1; m < angleVectorI.size(); m++) {
-      // calculate euclidean coordinates given the angles and assuming R_sphere = 1
-      double xmi = std::cos(angleVectorI[m]);
-      double xmj = std::cos(angleVectorJ[m]);
-      for (unsigned int l = 0; l < m; l++) {
-        xmi *= std::sin(angleVectorI[l]);
-        xmj *= std::sin(angleVectorJ[l]);
+        NLSR_LOG_TRACE("Distance from " << srcRouterName << " to " << destRouterName <<
+                       " is " << distance);
+        addNextHop(destRouterName, srcFaceUri, distance, rt);
       }
-      innerProduct += xmi * xmj;
     }
   }
-
-  // ArcCos of the inner product gives the angular distance
-  // between two points on a d-dimensional sphere
-  return std::acos(innerProduct);
-}
-
-double
-HyperbolicRoutingCalculator::calculateHyperbolicDistance(double rI, double rJ,
-                                                         double deltaTheta)
-{
-  if (deltaTheta == UNKNOWN_DISTANCE) {
-    return UNKNOWN_DISTANCE;
-  }
-
-  // Usually, we set zeta = 1 in all experiments
-  double zeta = 1;
-
-  if (deltaTheta <= 0.0 || rI <= 0.0 || rJ <= 0.0) {
-    NLSR_LOG_ERROR("Delta theta or rI or rJ is <= 0");
-    return UNKNOWN_DISTANCE;
-  }
-
-  double xij = (1. / zeta) * std::acosh(std::cosh(zeta*rI) * std::cosh(zeta*rJ) -
-               std::sinh(zeta*rI)*std::sinh(zeta*rJ)*std::cos(deltaTheta));
-  return xij;
 }
 
 void
-HyperbolicRoutingCalculator::addNextHop(ndn::Name dest, std::string faceUri,
+HyperbolicRoutingCalculator::addNextHop(const ndn::Name& dest, const std::string& faceUri,
                                         double cost, RoutingTable& rt)
 {
   NextHop hop(faceUri, cost);
@@ -23,7 +23,10 @@
 #define NLSR_ROUTING_TABLE_CALCULATOR_HPP
 
 #include "common.hpp"
+#include "adjacency-graph.hpp"
+#include "shortest-path-calculator.hpp"
 
+#include <functional>
 #include <list>
 #include <iostream>
 #include <boost/cstdint.hpp>
@@ -32,14 +35,17 @@
 
 namespace nlsr {
 
+class CalculationPool;
 class Map;
 class RoutingTable;
 class Nlsr;
+class Lsdb;
 
 class RoutingTableCalculator
 {
 public:
   RoutingTableCalculator()
+    : m_nRouters(0)
   {
   }
   RoutingTableCalculator(size_t nRouters)
@@ -47,162 +53,80 @@ public:
     m_nRouters = nRouters;
   }
 protected:
-  /*! \brief Allocate the space needed for the adj. matrix. */
-  void
-  allocateAdjMatrix();
-
-  /*! \brief Zero every cell of the matrix to ensure that the memory is safe. */
-  void
-  initMatrix();
-
-  /*! \brief Constructs an adj. matrix to calculate with.
-    \param pnlsr The NLSR object that contains the LSAs that we need to iterate
+  /*! \brief Constructs a sparse adj. graph to calculate with.
+    \param lsdb The LSDB that contains the adj. LSAs that we need to iterate
     over.
-    \param pMap The map to populate with the adj. data.
-  */
-  void
-  makeAdjMatrix(Nlsr& pnlsr, Map pMap);
+    \param pMap The map that gives each router its position in the graph.
 
-  void
-  writeAdjMatrixLog();
-
-  /*! \brief Returns how many links a router in the matrix has.
-    \param sRouter The router to count the links of.
-  */
-  int
-  getNumOfLinkfromAdjMatrix(int sRouter);
-
-  void
-  freeAdjMatrix();
-  /*! \brief Adjust a link cost in the adj. matrix
-    \param source The source router whose adjacency to adjust.
-    \param link The adjacency of the source to adjust.
-    \param linkCost The cost to change to.
-  */
-  void
-  adjustAdMatrix(int source, int link, double linkCost);
-
-  /*! \brief Populates temp. variables with the link costs for some router.
-    \param source The router whose values are to be adjusted.
-    \param links An integer pointer array for the link mappingNos.
-    \param linkCosts A double pointer array that stores the link costs.
-
-    Obtains a sparse list of adjacencies and link costs for some
-    router. Since this is sparse, that means while generating these
-    arrays, if there is no adjacency at i in the matrix, these
-    temporary variables will not contain a 0 at i, but rather will
-    contain the values for the next valid adjacency.
+    The LSAs are read in place, and the storage of the graph is reused
+    from the last calculation, so once it has grown to the size of the
+    network this makes no heap allocation.
   */
   void
-  getLinksFromAdjMatrix(int* links, double* linkCosts, int source);
-
-  /*! Allocates an array large enough to hold multipath calculation temps. */
-  void
-  allocateLinks();
-
-  void
-  allocateLinkCosts();
-
-  void
-  freeLinks();
+  makeAdjGraph(const Lsdb& lsdb, Map& pMap);
 
   void
-  freeLinksCosts();
-
-  void
-  setNoLink(int nl)
-  {
-    vNoLink = nl;
-  }
+  writeAdjGraphLog();
 
 protected:
-  double** adjMatrix;
+  AdjacencyGraph m_graph;
   size_t m_nRouters;
 
-  int vNoLink;
-  int* links;
-  double* linkCosts;
+private:
+  std::vector<AdjacencyGraph::Link> m_links;
 };
 
 class LinkStateRoutingTableCalculator: public RoutingTableCalculator
 {
 public:
+  LinkStateRoutingTableCalculator()
+  {
+  }
+
   LinkStateRoutingTableCalculator(size_t nRouters)
     : RoutingTableCalculator(nRouters)
-    , EMPTY_PARENT(-12345)
-    , INF_DISTANCE(2147483647)
-    , NO_MAPPING_NUM(-1)
-    , NO_NEXT_HOP(-12345)
   {
   }
 
   void
   calculatePath(Map& pMap, RoutingTable& rt, Nlsr& pnlsr);
 
-private:
-  /*! \brief Performs a Dijkstra's calculation over the adjacency matrix.
-    \param sourceRouter The origin router to compute paths from.
-  */
-  void
-  doDijkstraPathCalculation(int sourceRouter);
-
-  /*! \brief Sort the elements of a list.
-    \param Q The array that contains the elements to sort.
-    \param dist The array that contains the distances.
-    \param start The first element in the list to sort.
-    \param element The last element in the list to sort through.
+  /*! \brief Calculates the multipath next hops on a pool of worker threads.
+    \param pool The workers to calculate on; each sweeps a share of the neighbors.
+    \param afterCalculation Called on the main thread once all next hops are calculated.
+    \retval false The source router is not in the map, and afterCalculation is not called.
 
-    Sorts the list based on distance. The distances are indexed by
-    their mappingNo in dist. Currently uses an insertion sort.
+    The adj. graph is built on the calling thread, so that the workers
+    only read this snapshot while the LSDB goes on changing. The
+    calculator must stay alive until afterCalculation is called.
   */
-  void
-  sortQueueByDistance(int* Q, double* dist, int start, int element);
+  bool
+  calculateMultipathOnPool(Map& pMap, Nlsr& pnlsr, CalculationPool& pool,
+                           std::function<void()> afterCalculation);
 
-  /*! \brief Returns whether an element has been visited yet.
-    \param Q The list of elements to look through.
-    \param u The element to check.
-    \param start The start of list to look through.
-    \param element The end of the list to look through.
-  */
-  int
-  isNotExplored(int* Q, int u, int start, int element);
+  /*! \brief Adds the next hops from calculateMultipathOnPool to the routing table. */
+  void
+  addMultipathNextHopsToRoutingTable(Nlsr& pnlsr, RoutingTable& rt, Map& pMap);
 
+private:
   void
   addAllLsNextHopsToRoutingTable(Nlsr& pnlsr, RoutingTable& rt,
                                  Map& pMap, uint32_t sourceRouter);
 
-  /*! \brief Determines a destination's next hop.
-    \param dest The router whose next hop we want to determine.
-    \param source The router to determine a next path to.
-  */
-  int
-  getLsNextHop(int dest, int source);
-
-  void
-  allocateParent();
-
-  void
-  allocateDistance();
-
-  void
-  freeParent();
+  /*! \brief Adds the next hops through every neighbor of the source to the routing table.
 
+    Must be called after ShortestPathCalculator::calculateMultipath.
+  */
   void
-  freeDistance();
+  addAllLsMultipathNextHopsToRoutingTable(Nlsr& pnlsr, RoutingTable& rt,
+                                          Map& pMap, uint32_t sourceRouter);
 
 private:
-  int* m_parent;
-  double* m_distance;
-
-  const int EMPTY_PARENT;
-  const double INF_DISTANCE;
-  const int NO_MAPPING_NUM;
-  const int NO_NEXT_HOP;
-
+  ShortestPathCalculator m_spf;
+  int32_t m_sourceRouter = ShortestPathCalculator::NO_ROUTER;
 };
 
 class AdjacencyList;
-class Lsdb;
 
 class HyperbolicRoutingCalculator
 {
@@ -218,27 +142,14 @@ public:
   calculatePaths(Map& map, RoutingTable& rt, Lsdb& lsdb, AdjacencyList& adjacencies);
 
 private:
-  double
-  getHyperbolicDistance(Map& map, Lsdb& lsdb, ndn::Name src, ndn::Name dest);
-
   void
-  addNextHop(ndn::Name destinationRouter, std::string faceUri, double cost, RoutingTable& rt);
-
-  double
-  calculateHyperbolicDistance(double rI, double rJ, double deltaTheta);
-
-  double
-  calculateAngularDistance(std::vector<double> angleVectorI,
-                           std::vector<double> angleVectorJ);
+  addNextHop(const ndn::Name& destinationRouter, const std::string& faceUri, double cost,
+             RoutingTable& rt);
 
 private:
   const size_t m_nRouters;
   const bool m_isDryRun;
   const ndn::Name m_thisRouterName;
-
-  static const double MATH_PI;
-  static const double UNKNOWN_DISTANCE;
-  static const double UNKNOWN_RADIUS;
 };
 
 } // namespace nlsr
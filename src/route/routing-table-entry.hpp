@@ -25,6 +25,7 @@
 #include "nexthop-list.hpp"
 
 #include <iostream>
+#include <vector>
 #include <ndn-cxx/name.hpp>
 
 namespace nlsr {
@@ -79,6 +80,28 @@ protected:
 std::ostream&
 operator<<(std::ostream& os, const RoutingTableEntry& rte);
 
+/*! \brief The difference between two calculations of the routing table.
+
+  Only the destinations whose next hops changed are listed. The
+  entries point into the routing table, so they are only valid until
+  the table is next calculated.
+ */
+struct RoutingTableChanges
+{
+  bool
+  empty() const
+  {
+    return added.empty() && changed.empty() && removed.empty();
+  }
+
+  /*! Destinations that were unreachable before. */
+  std::vector<const RoutingTableEntry*> added;
+  /*! Destinations that are reachable through different next hops. */
+  std::vector<const RoutingTableEntry*> changed;
+  /*! Destinations that are no longer reachable. */
+  std::vector<ndn::Name> removed;
+};
+
 } // namespace nlsr
 
 #endif // NLSR_ROUTING_TABLE_ENTRY_HPP
@@ -19,6 +19,7 @@
  **/
 #include "routing-table.hpp"
 #include "nlsr.hpp"
+#include "adjacency-list.hpp"
 #include "map.hpp"
 #include "conf-parameter.hpp"
 #include "routing-table-calculator.hpp"
@@ -26,9 +27,11 @@
 #include "name-prefix-table.hpp"
 #include "logger.hpp"
 
+#include <algorithm>
 #include <iostream>
 #include <list>
 #include <string>
+#include <unordered_map>
 
 namespace nlsr {
 
@@ -39,9 +42,25 @@ RoutingTable::RoutingTable(ndn::Scheduler& scheduler)
   , m_scheduler(scheduler)
   , m_NO_NEXT_HOP{-12345}
   , m_routingCalcInterval{static_cast<uint32_t>(ROUTING_CALC_INTERVAL_DEFAULT)}
+  , m_routingCalcInitialWait{static_cast<uint32_t>(ROUTING_CALC_INITIAL_WAIT_DEFAULT)}
+  , m_routingCalcSecondaryWait{static_cast<uint32_t>(ROUTING_CALC_SECONDARY_WAIT_DEFAULT)}
+  , m_routingCalcHoldTime{m_routingCalcSecondaryWait}
+  , m_lastRoutingCalcTime{ndn::time::steady_clock::TimePoint::min()}
+  , m_nRoutingCalcsTriggered{0}
+  , m_nRoutingCalcsCoalesced{0}
+  , m_isRTableFromTree{false}
 {
 }
 
+void
+RoutingTable::setRoutingCalcThreads(boost::asio::io_service& ioService, uint32_t nThreads)
+{
+  m_calculationPool.reset();
+  if (nThreads > 0) {
+    m_calculationPool.reset(new CalculationPool(ioService, nThreads));
+  }
+}
+
 void
 RoutingTable::calculate(Nlsr& pnlsr)
 {
@@ -52,6 +71,7 @@ RoutingTable::calculate(Nlsr& pnlsr)
   if (pnlsr.getIsRoutingTableCalculating() == false) {
     //setting routing table calculation
     pnlsr.setIsRoutingTableCalculating(true);
+    m_lastRoutingCalcTime = ndn::time::steady_clock::now();
 
     bool isHrEnabled = pnlsr.getConfParameter().getHyperbolicState() != HYPERBOLIC_STATE_OFF;
 
@@ -67,8 +87,21 @@ RoutingTable::calculate(Nlsr& pnlsr)
          .doesLsaExist(ndn::Name{pnlsr.getConfParameter().getRouterPrefix()}
                        .append(std::to_string(Lsa::Type::COORDINATE)), Lsa::Type::COORDINATE))) {
       if (pnlsr.getIsBuildAdjLsaSheduled() != 1) {
-        NLSR_LOG_TRACE("Clearing old routing table");
-        clearRoutingTable();
+        if (calculateLsRoutingTableOnPool(pnlsr)) {
+          // Still calculating until the workers are done
+          pnlsr.setIsRouteCalculationScheduled(false);
+          return;
+        }
+
+        // The single-path table is updated in place, only for the routers
+        // whose route changed
+        bool isIncremental =
+          pnlsr.getConfParameter().getHyperbolicState() != HYPERBOLIC_STATE_ON &&
+          pnlsr.getConfParameter().getMaxFacesPerPrefix() == 1;
+        if (!isIncremental) {
+          NLSR_LOG_TRACE("Clearing old routing table");
+          clearRoutingTable();
+        }
         // for dry run options
         clearDryRoutingTable();
 
@@ -87,9 +120,14 @@ RoutingTable::calculate(Nlsr& pnlsr)
         if (pnlsr.getConfParameter().getHyperbolicState() == HYPERBOLIC_STATE_DRY_RUN) {
           calculateHypDryRoutingTable(pnlsr);
         }
+        spfDurationSignal(ndn::time::steady_clock::now() - m_lastRoutingCalcTime);
         // Inform the NPT that updates have been made
-        NLSR_LOG_DEBUG("Calling Update NPT With new Route");
-        (*afterRoutingChange)(m_rTable);
+        if (isIncremental) {
+          notifyRoutingChanges(m_changedDestinations);
+        }
+        else {
+          notifyRoutingChanges();
+        }
         writeLog(pnlsr.getConfParameter().getHyperbolicState());
         pnlsr.getNamePrefixTable().writeLog();
         pnlsr.getFib().writeLog();
@@ -105,8 +143,7 @@ RoutingTable::calculate(Nlsr& pnlsr)
       clearRoutingTable();
       clearDryRoutingTable(); // for dry run options
       // need to update NPT here
-      NLSR_LOG_DEBUG("Calling Update NPT With new Route");
-      (*afterRoutingChange)(m_rTable);
+      notifyRoutingChanges();
       writeLog(pnlsr.getConfParameter().getHyperbolicState());
       pnlsr.getNamePrefixTable().writeLog();
       pnlsr.getFib().writeLog();
@@ -116,7 +153,14 @@ RoutingTable::calculate(Nlsr& pnlsr)
     pnlsr.setIsRoutingTableCalculating(false); //unsetting routing table calculation
   }
   else {
-    scheduleRoutingTableCalculation(pnlsr);
+    // This event was the scheduled calculation, but the last one has not
+    // finished. Try again after the secondary wait; the calculation stays
+    // scheduled, so requests meanwhile are still folded into it. This is
+    // not a new trigger, so the throttle is not advanced.
+    NLSR_LOG_DEBUG("Routing table calculation in progress, retrying in "
+                   << m_routingCalcSecondaryWait);
+    m_scheduler.scheduleEvent(m_routingCalcSecondaryWait,
+                              std::bind(&RoutingTable::calculate, this, std::ref(pnlsr)));
   }
 }
 
@@ -125,47 +169,163 @@ RoutingTable::calculateLsRoutingTable(Nlsr& nlsr)
 {
   NLSR_LOG_DEBUG("RoutingTable::calculateLsRoutingTable Called");
 
-  Map map;
-  map.createFromAdjLsdb(nlsr.getLsdb().getAdjLsdb().begin(), nlsr.getLsdb().getAdjLsdb().end());
-  map.writeLog();
+  if (nlsr.getConfParameter().getMaxFacesPerPrefix() == 1) {
+    calculateIncrementalLsRoutingTable(nlsr);
+    return;
+  }
 
-  size_t nRouters = map.getMapSize();
+  m_lsMap.writeLog();
+  m_lsCalculator.calculatePath(m_lsMap, std::ref(*this), nlsr);
+}
 
-  LinkStateRoutingTableCalculator calculator(nRouters);
+bool
+RoutingTable::calculateLsRoutingTableOnPool(Nlsr& nlsr)
+{
+  // Single-path calculations are incremental and hyperbolic ones are
+  // cheap, so only multipath link-state calculations go to the workers
+  if (m_calculationPool == nullptr ||
+      nlsr.getConfParameter().getHyperbolicState() != HYPERBOLIC_STATE_OFF ||
+      nlsr.getConfParameter().getMaxFacesPerPrefix() == 1) {
+    return false;
+  }
+
+  NLSR_LOG_DEBUG("Calculating routing table on " << m_calculationPool->getNThreads()
+                 << " threads");
+
+  // Routers are only ever added to the map, so the mappingNos in the
+  // graph the workers calculate over stay valid while they run
+  m_lsMap.writeLog();
+  return m_lsCalculator.calculateMultipathOnPool(m_lsMap, nlsr, *m_calculationPool,
+                                                 std::bind(&RoutingTable::afterPoolCalculation,
+                                                           this, std::ref(nlsr)));
+}
+
+void
+RoutingTable::afterPoolCalculation(Nlsr& nlsr)
+{
+  NLSR_LOG_TRACE("Clearing old routing table");
+  clearRoutingTable();
+  clearDryRoutingTable();
+
+  m_lsCalculator.addMultipathNextHopsToRoutingTable(nlsr, *this, m_lsMap);
+  spfDurationSignal(ndn::time::steady_clock::now() - m_lastRoutingCalcTime);
 
-  calculator.calculatePath(map, std::ref(*this), nlsr);
+  notifyRoutingChanges();
+  writeLog(nlsr.getConfParameter().getHyperbolicState());
+  nlsr.getNamePrefixTable().writeLog();
+  nlsr.getFib().writeLog();
+
+  nlsr.setIsRoutingTableCalculating(false);
+}
+
+void
+RoutingTable::calculateIncrementalLsRoutingTable(Nlsr& nlsr)
+{
+  m_changedDestinations.clear();
+
+  ndn::optional<int32_t> sourceRouter =
+    m_lsMap.getMappingNoByRouterName(nlsr.getConfParameter().getRouterPrefix());
+  // We only bother to do the calculation if we have a router by that name.
+  if (!sourceRouter) {
+    for (const RoutingTableEntry& entry : m_rTable) {
+      m_changedDestinations.push_back(entry.getDestination());
+    }
+    clearRoutingTable();
+    return;
+  }
+
+  if (m_isRTableFromTree) {
+    m_ispf.repair(*sourceRouter);
+  }
+  else {
+    // The table was emptied or filled by another calculation, so every
+    // route is calculated again and replaced
+    m_ispf.calculate(*sourceRouter);
+  }
+  NLSR_LOG_DEBUG("Shortest path tree repaired: " << m_ispf.getChangedRouters().size()
+                 << " routers changed, " << m_ispf.getNVisited() << " visited");
+
+  // Look up the face of each next hop once, rather than for every destination
+  std::unordered_map<int32_t, std::string> nextHopFaces;
+
+  for (int32_t router : m_ispf.getChangedRouters()) {
+    const ndn::Name& destination = m_lsMap.getRouterName(router);
+    m_changedDestinations.push_back(destination);
+
+    // The old entry is kept, until notifyRoutingChanges() diffs the new one against it
+    auto entry = m_rTableIndex.find(destination);
+    if (entry != m_rTableIndex.end()) {
+      m_previousRTable.splice(m_previousRTable.end(), m_rTable, entry->second);
+      m_previousRTableIndex.emplace(destination, entry->second);
+      m_rTableIndex.erase(entry);
+    }
+
+    int32_t nextHopRouter = m_ispf.getNextHop(router);
+    if (nextHopRouter == IncrementalSpf::NO_ROUTER) {
+      continue;
+    }
+
+    // The tree only holds routers that are in the map
+    auto face = nextHopFaces.find(nextHopRouter);
+    if (face == nextHopFaces.end()) {
+      const ndn::Name& nextHopRouterName = m_lsMap.getRouterName(nextHopRouter);
+      face = nextHopFaces.emplace(nextHopRouter, nlsr.getAdjacencyList()
+                                    .getAdjacent(nextHopRouterName).getFaceUri().toString()).first;
+    }
+
+    NextHop nh(face->second, m_ispf.getDistance(router));
+    addNextHop(destination, nh);
+  }
+
+  m_isRTableFromTree = true;
+}
+
+void
+RoutingTable::onAdjLsaChange(const ndn::Name& router, const AdjacencyList& adjacencies)
+{
+  m_lsMap.addEntry(router);
+
+  std::vector<IncrementalSpf::AdvertisedLink> links;
+  for (const Adjacent& adjacent : adjacencies) {
+    m_lsMap.addEntry(adjacent.getName());
+    links.push_back({*m_lsMap.getMappingNoByRouterName(adjacent.getName()),
+                     static_cast<double>(adjacent.getLinkCost())});
+  }
+
+  m_ispf.setAdvertisedLinks(*m_lsMap.getMappingNoByRouterName(router), std::move(links));
 }
 
 void
 RoutingTable::calculateHypRoutingTable(Nlsr& nlsr)
 {
-  Map map;
-  map.createFromCoordinateLsdb(nlsr.getLsdb().getCoordinateLsdb().begin(),
-                               nlsr.getLsdb().getCoordinateLsdb().end());
-  map.writeLog();
+  m_hypMap.reset();
+  m_hypMap.createFromCoordinateLsdb(nlsr.getLsdb().getCoordinateLsdb().begin(),
+                                    nlsr.getLsdb().getCoordinateLsdb().end());
+  m_hypMap.writeLog();
 
-  size_t nRouters = map.getMapSize();
+  size_t nRouters = m_hypMap.getMapSize();
 
   HyperbolicRoutingCalculator calculator(nRouters, false,
                                          nlsr.getConfParameter().getRouterPrefix());
 
-  calculator.calculatePaths(map, std::ref(*this),
+  calculator.calculatePaths(m_hypMap, std::ref(*this),
                             nlsr.getLsdb(), nlsr.getAdjacencyList());
 }
 
 void
 RoutingTable::calculateHypDryRoutingTable(Nlsr& nlsr)
 {
-  Map map;
-  map.createFromAdjLsdb(nlsr.getLsdb().getAdjLsdb().begin(), nlsr.getLsdb().getAdjLsdb().end());
-  map.writeLog();
+  m_hypMap.reset();
+  m_hypMap.createFromAdjLsdb(nlsr.getLsdb().getAdjLsdb().begin(),
+                             nlsr.getLsdb().getAdjLsdb().end());
+  m_hypMap.writeLog();
 
-  size_t nRouters = map.getMapSize();
+  size_t nRouters = m_hypMap.getMapSize();
 
   HyperbolicRoutingCalculator calculator(nRouters, true,
                                          nlsr.getConfParameter().getRouterPrefix());
 
-  calculator.calculatePaths(map, std::ref(*this),
+  calculator.calculatePaths(m_hypMap, std::ref(*this),
                             nlsr.getLsdb(), nlsr.getAdjacencyList());
 }
 
@@ -173,19 +333,58 @@ void
 RoutingTable::scheduleRoutingTableCalculation(Nlsr& pnlsr)
 {
   if (pnlsr.getIsRouteCalculationScheduled() != true) {
-    NLSR_LOG_DEBUG("Scheduling routing table calculation in " << m_routingCalcInterval);
+    ndn::time::milliseconds delay = getRoutingCalcDelay();
+    NLSR_LOG_DEBUG("Scheduling routing table calculation in " << delay);
 
-    m_scheduler.scheduleEvent(m_routingCalcInterval,
+    m_scheduler.scheduleEvent(delay,
                               std::bind(&RoutingTable::calculate, this, std::ref(pnlsr)));
 
     pnlsr.setIsRouteCalculationScheduled(true);
+    ++m_nRoutingCalcsTriggered;
   }
+  else {
+    ++m_nRoutingCalcsCoalesced;
+  }
+}
+
+ndn::time::milliseconds
+RoutingTable::getRoutingCalcDelay()
+{
+  ndn::time::milliseconds maxWait = m_routingCalcInterval;
+  ndn::time::steady_clock::TimePoint now = ndn::time::steady_clock::now();
+
+  ndn::time::milliseconds delay;
+  if (m_lastRoutingCalcTime == ndn::time::steady_clock::TimePoint::min() ||
+      now - m_lastRoutingCalcTime >= 2 * maxWait) {
+    // The first change after a quiet period is acted on quickly
+    m_routingCalcHoldTime = m_routingCalcSecondaryWait;
+    delay = m_routingCalcInitialWait;
+  }
+  else {
+    // Under churn, back off
+    ndn::time::steady_clock::TimePoint holdEnd = m_lastRoutingCalcTime + m_routingCalcHoldTime;
+    delay = holdEnd > now ?
+            ndn::time::duration_cast<ndn::time::milliseconds>(holdEnd - now) :
+            ndn::time::milliseconds::zero();
+    m_routingCalcHoldTime = std::min<ndn::time::milliseconds>(2 * m_routingCalcHoldTime, maxWait);
+  }
+
+  return std::min(delay, maxWait);
 }
 
-static bool
-routingTableEntryCompare(RoutingTableEntry& rte, ndn::Name& destRouter)
+// Adds a next hop to the entry for a destination in a table, creating
+// the entry if there is none.
+static void
+addNextHopToTable(RoutingTable::RoutingTableEntryList& table,
+                  RoutingTable::RoutingTableEntryIndex& index,
+                  const ndn::Name& destRouter, const NextHop& nh)
 {
-  return rte.getDestination() == destRouter;
+  auto it = index.find(destRouter);
+  if (it == index.end()) {
+    auto entry = table.emplace(table.end(), destRouter);
+    it = index.emplace(destRouter, entry).first;
+  }
+  it->second->getNexthopList().addNextHop(nh);
 }
 
 void
@@ -193,33 +392,89 @@ RoutingTable::addNextHop(const ndn::Name& destRouter, NextHop& nh)
 {
   NLSR_LOG_DEBUG("Adding " << nh << " for destination: " << destRouter);
 
-  RoutingTableEntry* rteChk = findRoutingTableEntry(destRouter);
-  if (rteChk == 0) {
-    RoutingTableEntry rte(destRouter);
-    rte.getNexthopList().addNextHop(nh);
-    m_rTable.push_back(rte);
-  }
-  else {
-    rteChk->getNexthopList().addNextHop(nh);
-  }
+  addNextHopToTable(m_rTable, m_rTableIndex, destRouter, nh);
 }
 
 RoutingTableEntry*
 RoutingTable::findRoutingTableEntry(const ndn::Name& destRouter)
 {
-  std::list<RoutingTableEntry>::iterator it = std::find_if(m_rTable.begin(),
-                                                           m_rTable.end(),
-                                                           std::bind(&routingTableEntryCompare,
-                                                                     _1, destRouter));
-  if (it != m_rTable.end()) {
-    return &(*it);
+  auto it = m_rTableIndex.find(destRouter);
+  if (it != m_rTableIndex.end()) {
+    return &*it->second;
+  }
+  return nullptr;
+}
+
+void
+RoutingTable::notifyRoutingChanges()
+{
+  RoutingTableChanges changes;
+
+  for (const RoutingTableEntry& entry : m_rTable) {
+    auto previous = m_previousRTableIndex.find(entry.getDestination());
+    if (previous == m_previousRTableIndex.end()) {
+      changes.added.push_back(&entry);
+    }
+    else if (previous->second->getNexthopList() != entry.getNexthopList()) {
+      changes.changed.push_back(&entry);
+    }
+  }
+
+  for (const RoutingTableEntry& entry : m_previousRTable) {
+    if (m_rTableIndex.count(entry.getDestination()) == 0) {
+      changes.removed.push_back(entry.getDestination());
+    }
+  }
+
+  emitRoutingChanges(changes);
+}
+
+void
+RoutingTable::notifyRoutingChanges(const std::vector<ndn::Name>& destinations)
+{
+  RoutingTableChanges changes;
+
+  for (const ndn::Name& destination : destinations) {
+    auto current = m_rTableIndex.find(destination);
+    auto previous = m_previousRTableIndex.find(destination);
+    if (current == m_rTableIndex.end()) {
+      if (previous != m_previousRTableIndex.end()) {
+        changes.removed.push_back(destination);
+      }
+    }
+    else if (previous == m_previousRTableIndex.end()) {
+      changes.added.push_back(&*current->second);
+    }
+    else if (previous->second->getNexthopList() != current->second->getNexthopList()) {
+      changes.changed.push_back(&*current->second);
+    }
+  }
+
+  emitRoutingChanges(changes);
+}
+
+void
+RoutingTable::emitRoutingChanges(const RoutingTableChanges& changes)
+{
+  m_previousRTable.clear();
+  m_previousRTableIndex.clear();
+
+  NLSR_LOG_DEBUG("Routes added: " << changes.added.size() << ", changed: "
+                 << changes.changed.size() << ", removed: " << changes.removed.size());
+
+  if (!changes.empty()) {
+    NLSR_LOG_DEBUG("Calling Update NPT With new Route");
+    (*afterRoutingChange)(changes);
   }
-  return 0;
 }
 
 void
 RoutingTable::writeLog(int hyperbolicState)
 {
+  if (!NLSR_LOG_IS_DEBUG_ENABLED()) {
+    return;
+  }
+
   NLSR_LOG_DEBUG("---------------Routing Table------------------");
   for (std::list<RoutingTableEntry>::iterator it = m_rTable.begin() ;
        it != m_rTable.end(); ++it) {
@@ -244,34 +499,25 @@ RoutingTable::addNextHopToDryTable(const ndn::Name& destRouter, NextHop& nh)
 {
   NLSR_LOG_DEBUG("Adding " << nh << " to dry table for destination: " << destRouter);
 
-  std::list<RoutingTableEntry>::iterator it = std::find_if(m_dryTable.begin(),
-                                                           m_dryTable.end(),
-                                                           std::bind(&routingTableEntryCompare,
-                                                                     _1, destRouter));
-  if (it == m_dryTable.end()) {
-    RoutingTableEntry rte(destRouter);
-    rte.getNexthopList().addNextHop(nh);
-    m_dryTable.push_back(rte);
-  }
-  else {
-    (*it).getNexthopList().addNextHop(nh);
-  }
+  addNextHopToTable(m_dryTable, m_dryTableIndex, destRouter, nh);
 }
 
 void
 RoutingTable::clearRoutingTable()
 {
-  if (m_rTable.size() > 0) {
-    m_rTable.clear();
-  }
+  // Swapping keeps the iterators in the index valid
+  m_previousRTable.swap(m_rTable);
+  m_previousRTableIndex.swap(m_rTableIndex);
+  m_rTable.clear();
+  m_rTableIndex.clear();
+  m_isRTableFromTree = false;
 }
 
 void
 RoutingTable::clearDryRoutingTable()
 {
-  if (m_dryTable.size() > 0) {
-    m_dryTable.clear();
-  }
+  m_dryTable.clear();
+  m_dryTableIndex.clear();
 }
 
 } // namespace nlsr
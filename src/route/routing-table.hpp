@@ -22,24 +22,35 @@
 #ifndef NLSR_ROUTING_TABLE_HPP
 #define NLSR_ROUTING_TABLE_HPP
 
+#include "calculation-pool.hpp"
 #include "conf-parameter.hpp"
+#include "incremental-spf.hpp"
+#include "map.hpp"
+#include "routing-table-calculator.hpp"
 #include "routing-table-entry.hpp"
 #include "signals.hpp"
 
 #include <iostream>
+#include <list>
 #include <utility>
 #include <string>
+#include <unordered_map>
+#include <vector>
 #include <boost/cstdint.hpp>
 #include <ndn-cxx/util/scheduler.hpp>
 
 namespace nlsr {
 
+class AdjacencyList;
 class Nlsr;
 class NextHop;
 
 class RoutingTable
 {
 public:
+  using RoutingTableEntryList = std::list<RoutingTableEntry>;
+  using RoutingTableEntryIndex = std::unordered_map<ndn::Name, RoutingTableEntryList::iterator>;
+
   RoutingTable(ndn::Scheduler& scheduler);
 
   /*! \brief Calculates a list of next hops for each router in the network.
@@ -64,12 +75,34 @@ public:
   void
   addNextHopToDryTable(const ndn::Name& destRouter, NextHop& nh);
 
+  /*! \brief Returns the entry for a destination, or nullptr if there is none.
+
+    Entries are indexed by destination, so this is O(1) on average.
+   */
   RoutingTableEntry*
   findRoutingTableEntry(const ndn::Name& destRouter);
 
+  /*! \brief Updates the links that a router advertises in its adj. LSA.
+   * \param router The origin router of the LSA.
+   * \param adjacencies The adjacencies in the LSA; empty if it was removed.
+   *
+   * The changes are applied to the single-path shortest path tree on the
+   * next link-state calculation.
+   */
+  void
+  onAdjLsaChange(const ndn::Name& router, const AdjacencyList& adjacencies);
+
   /*! \brief Schedules a calculation event in the event scheduler only
    * if one isn't already scheduled.
    * \param pnlsr The NLSR whose scheduling status is needed.
+   *
+   * Calculations are throttled as IS-IS and OSPF throttle SPF runs.
+   * After a quiet period, the calculation is scheduled after the initial
+   * wait. Otherwise it waits until the hold time has passed since the last
+   * calculation; the hold time starts at the secondary wait and doubles
+   * with each calculation. No wait is longer than the routing calc.
+   * interval, and the network is quiet once no calculation has run for
+   * twice that interval.
    */
   void
   scheduleRoutingTableCalculation(Nlsr& pnlsr);
@@ -92,11 +125,71 @@ public:
     return m_routingCalcInterval;
   }
 
+  /*! \brief Sets the waits of the calculation throttle.
+   * \param initialWait The wait before a calculation after a quiet period.
+   * \param secondaryWait The first hold time between calculations.
+   */
+  void
+  setRoutingCalcWaits(const ndn::time::milliseconds& initialWait,
+                      const ndn::time::milliseconds& secondaryWait)
+  {
+    m_routingCalcInitialWait = initialWait;
+    m_routingCalcSecondaryWait = secondaryWait;
+  }
+
+  /*! \brief Returns how many calculations have been scheduled. */
+  uint64_t
+  getNRoutingCalcsTriggered() const
+  {
+    return m_nRoutingCalcsTriggered;
+  }
+
+  /*! \brief Returns how many requests were folded into an already scheduled calculation. */
+  uint64_t
+  getNRoutingCalcsCoalesced() const
+  {
+    return m_nRoutingCalcsCoalesced;
+  }
+
+  /*! \brief Starts worker threads for multipath link-state calculations.
+   * \param ioService The main io_service, where the results are applied.
+   * \param nThreads The number of workers; with 0, calculations run on the main thread.
+   */
+  void
+  setRoutingCalcThreads(boost::asio::io_service& ioService, uint32_t nThreads);
+
 private:
+  /*! \brief Returns how long to wait before the next calculation, and
+   * advances the throttle.
+   */
+  ndn::time::milliseconds
+  getRoutingCalcDelay();
+
   /*! \brief Calculates a link-state routing table. */
   void
   calculateLsRoutingTable(Nlsr& pnlsr);
 
+  /*! \brief Calculates a single-path link-state routing table by
+   * repairing the shortest path tree kept from the last calculation.
+   *
+   * Only the entries of the routers whose route changed are replaced,
+   * and their destinations are kept in m_changedDestinations.
+   */
+  void
+  calculateIncrementalLsRoutingTable(Nlsr& pnlsr);
+
+  /*! \brief Starts a multipath link-state calculation on the worker threads.
+   * \retval false The calculation cannot be started, and should be done in place.
+   *
+   * The routing table is left as is until afterPoolCalculation() replaces it.
+   */
+  bool
+  calculateLsRoutingTableOnPool(Nlsr& pnlsr);
+
+  /*! \brief Replaces the routing table with the results from the worker threads. */
+  void
+  afterPoolCalculation(Nlsr& pnlsr);
+
   /*! \brief Calculates a HR routing table. */
   void
   calculateHypRoutingTable(Nlsr& pnlsr);
@@ -105,29 +198,99 @@ private:
   void
   calculateHypDryRoutingTable(Nlsr& pnlsr);
 
+  void
+  clearDryRoutingTable();
+
+  void
+  writeLog(int hyperbolicState);
+
+PUBLIC_WITH_TESTS_ELSE_PRIVATE:
+  /*! \brief Empties the routing table before it is calculated again.
+
+    The old routes are kept, until notifyRoutingChanges() diffs the
+    new ones against them.
+   */
   void
   clearRoutingTable();
 
+  /*! \brief Emits afterRoutingChange with the destinations whose routes
+    changed since clearRoutingTable().
+
+    Nothing is emitted if no route changed.
+   */
   void
-  clearDryRoutingTable();
+  notifyRoutingChanges();
 
+  /*! \brief Emits afterRoutingChange with the changes to some destinations only.
+
+    The entries of the other destinations must not have been cleared.
+   */
   void
-  writeLog(int hyperbolicState);
+  notifyRoutingChanges(const std::vector<ndn::Name>& destinations);
+
+private:
+  void
+  emitRoutingChanges(const RoutingTableChanges& changes);
 
 public:
+  /*! Emitted with the changes after each calculation, so that the NPT
+    only updates the name prefixes whose routes changed.
+   */
   std::unique_ptr<AfterRoutingChange> afterRoutingChange;
 
+  /*! Emitted with how long each routing table calculation took,
+    including any time spent waiting for the workers.
+   */
+  DurationSignal<RoutingTable> spfDurationSignal;
+
 PUBLIC_WITH_TESTS_ELSE_PRIVATE:
-  std::list<RoutingTableEntry> m_rTable;
+  /*! The entries are kept in a list, so they are iterated over in the
+    order they were added, and m_rTableIndex finds the entry for a
+    destination in O(1) on average rather than by searching the list.
+   */
+  RoutingTableEntryList m_rTable;
+  RoutingTableEntryIndex m_rTableIndex;
 
 private:
   ndn::Scheduler& m_scheduler;
 
   const int m_NO_NEXT_HOP;
 
-  std::list<RoutingTableEntry> m_dryTable;
+  // The routes before the calculation in progress, which the NPT has
+  // last been told about
+  RoutingTableEntryList m_previousRTable;
+  RoutingTableEntryIndex m_previousRTableIndex;
+
+  RoutingTableEntryList m_dryTable;
+  RoutingTableEntryIndex m_dryTableIndex;
 
   ndn::time::seconds m_routingCalcInterval;
+  ndn::time::milliseconds m_routingCalcInitialWait;
+  ndn::time::milliseconds m_routingCalcSecondaryWait;
+  // Doubles with each calculation until the network is quiet again
+  ndn::time::milliseconds m_routingCalcHoldTime;
+  ndn::time::steady_clock::TimePoint m_lastRoutingCalcTime;
+  uint64_t m_nRoutingCalcsTriggered;
+  uint64_t m_nRoutingCalcsCoalesced;
+
+  // Whether the routing table holds the routes of m_ispf, so that it can
+  // be updated for the routers that changed
+  bool m_isRTableFromTree;
+  std::vector<ndn::Name> m_changedDestinations;
+
+  // Routers keep their mappingNo across calculations, so that the tree
+  // can be repaired in place.
+  Map m_lsMap;
+  IncrementalSpf m_ispf;
+
+  // Refilled for each hyperbolic calculation, reusing its storage
+  Map m_hypMap;
+
+  // Kept between calculations, so that its storage is reused. The workers
+  // read its snapshot of the LSDB while a calculation is on the pool.
+  LinkStateRoutingTableCalculator m_lsCalculator;
+  // Declared last, so that the workers are stopped before what they use is destroyed
+  std::unique_ptr<CalculationPool> m_calculationPool;
 };
 
 } // namespace nlsr
@@ -0,0 +1,221 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2017,  The University of Memphis,
+ *                           Regents of the University of California
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "shortest-path-calculator.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+
+namespace nlsr {
+
+const int32_t ShortestPathCalculator::NO_ROUTER = -1;
+const double ShortestPathCalculator::INF_DISTANCE = std::numeric_limits<double>::infinity();
+
+void
+ShortestPathCalculator::calculate(const AdjacencyGraph& graph, int32_t source, int32_t firstHop)
+{
+  size_t nRouters = graph.getNRouters();
+
+  m_distance.assign(nRouters, INF_DISTANCE);
+  m_parent.assign(nRouters, NO_ROUTER);
+  m_nextHop.assign(nRouters, NO_ROUTER);
+  m_heap.clear();
+
+  if (source < 0 || static_cast<size_t>(source) >= nRouters) {
+    return;
+  }
+
+  std::greater<HeapEntry> compare;
+
+  // Distance to source from source is always 0.
+  m_distance[source] = 0;
+  m_heap.emplace_back(0, source);
+
+  while (!m_heap.empty()) {
+    std::pop_heap(m_heap.begin(), m_heap.end(), compare);
+    double distance = m_heap.back().first;
+    int32_t u = m_heap.back().second;
+    m_heap.pop_back();
+
+    // Stale entry: u was already reached with a shorter distance
+    if (distance > m_distance[u]) {
+      continue;
+    }
+
+    for (size_t link = graph.linksBegin(u); link < graph.linksEnd(u); ++link) {
+      int32_t v = graph.getLinkTarget(link);
+
+      // Only the first hop is accessible from the source, if one is given.
+      if (u == source && firstHop != NO_ROUTER && v != firstHop) {
+        continue;
+      }
+
+      double newDistance = distance + graph.getLinkCost(link);
+      if (newDistance < m_distance[v]) {
+        m_distance[v] = newDistance;
+        m_parent[v] = u;
+        m_nextHop[v] = (u == source) ? v : m_nextHop[u];
+
+        m_heap.emplace_back(newDistance, v);
+        std::push_heap(m_heap.begin(), m_heap.end(), compare);
+      }
+    }
+  }
+}
+
+void
+ShortestPathCalculator::calculateMultipath(const AdjacencyGraph& graph, int32_t source)
+{
+  size_t nFirstHops = 0;
+  if (source >= 0 && static_cast<size_t>(source) < graph.getNRouters()) {
+    nFirstHops = graph.getNumOfLinks(source);
+  }
+  sweepMultipath(graph, source, 0, nFirstHops);
+}
+
+void
+ShortestPathCalculator::prepareMultipath(const AdjacencyGraph& graph, int32_t source)
+{
+  m_nRouters = graph.getNRouters();
+  m_firstHops.clear();
+
+  if (source < 0 || static_cast<size_t>(source) >= m_nRouters) {
+    m_multipathDistance.clear();
+    return;
+  }
+
+  for (size_t link = graph.linksBegin(source); link < graph.linksEnd(source); ++link) {
+    m_firstHops.push_back(graph.getLinkTarget(link));
+  }
+
+  m_multipathDistance.assign(m_firstHops.size() * m_nRouters, INF_DISTANCE);
+}
+
+void
+ShortestPathCalculator::calculateThrough(const AdjacencyGraph& graph, int32_t source,
+                                         size_t begin, size_t end,
+                                         ShortestPathCalculator& scratch)
+{
+  scratch.sweepMultipath(graph, source, begin, end);
+
+  size_t nFirstHops = m_firstHops.size();
+  size_t nSwept = end - begin;
+  for (size_t router = 0; router < m_nRouters; ++router) {
+    std::copy(scratch.m_multipathDistance.begin() + router * nSwept,
+              scratch.m_multipathDistance.begin() + (router + 1) * nSwept,
+              m_multipathDistance.begin() + router * nFirstHops + begin);
+  }
+}
+
+void
+ShortestPathCalculator::sweepMultipath(const AdjacencyGraph& graph, int32_t source,
+                                       size_t begin, size_t end)
+{
+  m_nRouters = graph.getNRouters();
+  m_firstHops.clear();
+  m_heap.clear();
+
+  if (source < 0 || static_cast<size_t>(source) >= m_nRouters) {
+    m_multipathDistance.clear();
+    return;
+  }
+
+  size_t firstLink = graph.linksBegin(source);
+  for (size_t index = begin; index < end; ++index) {
+    m_firstHops.push_back(graph.getLinkTarget(firstLink + index));
+  }
+
+  size_t nFirstHops = m_firstHops.size();
+  m_multipathDistance.assign(nFirstHops * m_nRouters, INF_DISTANCE);
+  m_followedDistance.assign(nFirstHops * m_nRouters, INF_DISTANCE);
+  m_changedFirstHops.resize(nFirstHops * m_nRouters);
+  m_nChangedFirstHops.assign(m_nRouters, 0);
+  m_routerKey.assign(m_nRouters, INF_DISTANCE);
+
+  for (size_t index = 0; index < nFirstHops; ++index) {
+    improveThrough(m_firstHops[index], index, graph.getLinkCost(firstLink + begin + index));
+  }
+
+  std::greater<HeapEntry> compare;
+
+  while (!m_heap.empty()) {
+    std::pop_heap(m_heap.begin(), m_heap.end(), compare);
+    double key = m_heap.back().first;
+    int32_t u = m_heap.back().second;
+    m_heap.pop_back();
+
+    // Stale entry: u was queued again with a lower key, or has been taken off since
+    if (key > m_routerKey[u]) {
+      continue;
+    }
+    m_routerKey[u] = INF_DISTANCE;
+
+    // Changes made while following the links are queued afresh, so take
+    // the ones to follow now
+    uint32_t nChanged = m_nChangedFirstHops[u];
+    m_nChangedFirstHops[u] = 0;
+    const int32_t* changed = &m_changedFirstHops[u * nFirstHops];
+    const double* distance = &m_multipathDistance[u * nFirstHops];
+    double* followedDistance = &m_followedDistance[u * nFirstHops];
+    for (uint32_t i = 0; i < nChanged; ++i) {
+      followedDistance[changed[i]] = distance[changed[i]];
+    }
+
+    for (size_t link = graph.linksBegin(u); link < graph.linksEnd(u); ++link) {
+      int32_t v = graph.getLinkTarget(link);
+
+      // Paths never go back through the source
+      if (v == source) {
+        continue;
+      }
+
+      double linkCost = graph.getLinkCost(link);
+      const double* vDistance = &m_multipathDistance[v * nFirstHops];
+      for (uint32_t i = 0; i < nChanged; ++i) {
+        int32_t index = changed[i];
+        double newDistance = followedDistance[index] + linkCost;
+        if (newDistance < vDistance[index]) {
+          improveThrough(v, index, newDistance);
+        }
+      }
+    }
+  }
+}
+
+void
+ShortestPathCalculator::improveThrough(int32_t router, size_t index, double distance)
+{
+  size_t label = router * m_firstHops.size() + index;
+
+  // Not changed yet since the links of the router were last followed
+  if (m_multipathDistance[label] == m_followedDistance[label]) {
+    m_changedFirstHops[router * m_firstHops.size() + m_nChangedFirstHops[router]++] = index;
+  }
+  m_multipathDistance[label] = distance;
+
+  if (distance < m_routerKey[router]) {
+    m_routerKey[router] = distance;
+    m_heap.emplace_back(distance, router);
+    std::push_heap(m_heap.begin(), m_heap.end(), std::greater<HeapEntry>());
+  }
+}
+
+} // namespace nlsr
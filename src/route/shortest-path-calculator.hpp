@@ -0,0 +1,183 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2017,  The University of Memphis,
+ *                           Regents of the University of California
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NLSR_SHORTEST_PATH_CALCULATOR_HPP
+#define NLSR_SHORTEST_PATH_CALCULATOR_HPP
+
+#include "adjacency-graph.hpp"
+
+#include <utility>
+#include <vector>
+#include <boost/cstdint.hpp>
+
+namespace nlsr {
+
+/*! \brief Computes a shortest path tree over an AdjacencyGraph.
+
+  Uses Dijkstra's algorithm with a lazy-deletion binary heap, so one
+  calculation costs O((V + E) log V). The storage is kept between
+  calculations so that repeated runs do not allocate.
+ */
+class ShortestPathCalculator
+{
+public:
+  /*! \brief Runs Dijkstra's algorithm from a source router.
+    \param graph The graph to calculate over.
+    \param source The mappingNo of the origin router.
+    \param firstHop If not NO_ROUTER, simulate that only this neighbor
+    of the source router is accessible.
+   */
+  void
+  calculate(const AdjacencyGraph& graph, int32_t source, int32_t firstHop = NO_ROUTER);
+
+  bool
+  isReachable(int32_t router) const
+  {
+    return m_distance[router] != INF_DISTANCE;
+  }
+
+  double
+  getDistance(int32_t router) const
+  {
+    return m_distance[router];
+  }
+
+  int32_t
+  getParent(int32_t router) const
+  {
+    return m_parent[router];
+  }
+
+  /*! \brief Returns the neighbor of the source through which router is
+    reached, or NO_ROUTER if it is the source or is unreachable.
+   */
+  int32_t
+  getNextHop(int32_t router) const
+  {
+    return m_nextHop[router];
+  }
+
+  /*! \brief Calculates the distance to every router through each neighbor of a source router.
+    \param graph The graph to calculate over.
+    \param source The mappingNo of the origin router.
+
+    The distance to a router through a neighbor is the cost of the
+    link to the neighbor plus the shortest distance from the neighbor
+    to the router that does not pass through the source. This is
+    what calculate(graph, source, neighbor) yields for each neighbor.
+
+    All neighbors are calculated in one sweep. Each router keeps a
+    distance per neighbor, and is queued on one shared heap keyed by the
+    least of its distances that have changed since its links were last
+    followed. When it is taken off the heap, every changed distance is
+    carried over each of its links at once. A router is thus taken off
+    the heap a few times rather than once per neighbor, and its links
+    are read together for all the neighbors that changed.
+
+    No first hop is left out, so the distances are exact for all of
+    them; limiting the next hops of a prefix is left to the FIB.
+   */
+  void
+  calculateMultipath(const AdjacencyGraph& graph, int32_t source);
+
+  /*! \brief Sets up the first hops of a source router without calculating through them.
+
+    Groups of first hops can then be calculated separately with calculateThrough().
+   */
+  void
+  prepareMultipath(const AdjacencyGraph& graph, int32_t source);
+
+  /*! \brief Calculates the distance to every router through a range of first hops.
+    \param graph The graph that prepareMultipath() was called with.
+    \param source The source router that prepareMultipath() was called with.
+    \param begin The index of the first first hop in the range.
+    \param end The index past the last first hop in the range.
+    \param scratch The calculator to sweep the range with.
+
+    The range is calculated in one sweep, as calculateMultipath() does.
+    Calls for disjoint ranges only write to their own distances, so they
+    can run concurrently as long as each uses its own scratch.
+   */
+  void
+  calculateThrough(const AdjacencyGraph& graph, int32_t source, size_t begin, size_t end,
+                   ShortestPathCalculator& scratch);
+
+  size_t
+  getNumOfFirstHops() const
+  {
+    return m_firstHops.size();
+  }
+
+  /*! \brief Returns the neighbor of the source that is the index-th first hop. */
+  int32_t
+  getFirstHop(size_t index) const
+  {
+    return m_firstHops[index];
+  }
+
+  bool
+  isReachableThrough(size_t index, int32_t router) const
+  {
+    return getDistanceThrough(index, router) != INF_DISTANCE;
+  }
+
+  double
+  getDistanceThrough(size_t index, int32_t router) const
+  {
+    return m_multipathDistance[router * m_firstHops.size() + index];
+  }
+
+public:
+  static const int32_t NO_ROUTER;
+  static const double INF_DISTANCE;
+
+private:
+  /*! \brief Sweeps the first hops [begin, end) of a source router into this calculator. */
+  void
+  sweepMultipath(const AdjacencyGraph& graph, int32_t source, size_t begin, size_t end);
+
+  /*! \brief Lowers the distance to a router through a first hop, and queues the router. */
+  void
+  improveThrough(int32_t router, size_t index, double distance);
+
+private:
+  typedef std::pair<double, int32_t> HeapEntry;
+
+  std::vector<double> m_distance;
+  std::vector<int32_t> m_parent;
+  std::vector<int32_t> m_nextHop;
+  std::vector<HeapEntry> m_heap;
+
+  size_t m_nRouters = 0;
+  std::vector<int32_t> m_firstHops;
+  // The distances of a router through each first hop are kept together
+  std::vector<double> m_multipathDistance;
+  // The distances each router's links were last followed with
+  std::vector<double> m_followedDistance;
+  // The first hops whose distance to each router has changed since then
+  std::vector<int32_t> m_changedFirstHops;
+  std::vector<uint32_t> m_nChangedFirstHops;
+  // The least changed distance of each router, its key on the heap
+  std::vector<double> m_routerKey;
+};
+
+} // namespace nlsr
+
+#endif // NLSR_SHORTEST_PATH_CALCULATOR_HPP
@@ -28,12 +28,22 @@
 
 namespace nlsr {
 
+class AdjacencyList;
+class Lsdb;
 class RoutingTable;
-class RoutingTableEntry;
 class SyncLogicHandler;
+struct RoutingTableChanges;
 
-using AfterRoutingChange = ndn::util::Signal<RoutingTable, const std::list<RoutingTableEntry>&>;
+using AfterRoutingChange = ndn::util::Signal<RoutingTable, const RoutingTableChanges&>;
+using AfterAdjLsaChange = ndn::util::Signal<Lsdb, const ndn::Name&, const AdjacencyList&>;
 using OnNewLsa = ndn::util::Signal<SyncLogicHandler, const ndn::Name&, const uint64_t&>;
+using AfterSyncBatch = ndn::util::Signal<SyncLogicHandler>;
+
+/*! Emitted with how long an operation took, for the duration
+  histograms in Statistics.
+ */
+template<typename Owner>
+using DurationSignal = ndn::util::Signal<Owner, const ndn::time::nanoseconds&>;
 
 } // namespace nlsr
 
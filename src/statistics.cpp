@@ -23,34 +23,66 @@
 #include "nlsr.hpp"
 #include "utility/name-helper.hpp"
 
+#include <algorithm>
+
 namespace nlsr {
 
+const size_t DurationHistogram::N_BUCKETS;
+const size_t Statistics::N_PACKET_TYPES;
+const size_t Statistics::N_DURATION_TYPES;
+
+DurationHistogram::DurationHistogram()
+{
+  reset();
+}
+
 size_t
-Statistics::get(PacketType type) const
+DurationHistogram::getBucket(const ndn::time::nanoseconds& duration)
 {
-  std::map<PacketType,int>::const_iterator it = m_packetCounter.find(type);
-  if(it != m_packetCounter.end())
-  {
-    return it->second;
-  }
-  else
-  {
-    return 0;
+  int64_t microseconds = ndn::time::duration_cast<ndn::time::microseconds>(duration).count();
+
+  size_t bucket = 0;
+  while (microseconds > 0 && bucket < N_BUCKETS - 1) {
+    microseconds >>= 1;
+    ++bucket;
   }
+  return bucket;
 }
 
 void
-Statistics::increment(PacketType type)
+DurationHistogram::record(const ndn::time::nanoseconds& duration)
 {
-  m_packetCounter[type]++;
+  int64_t microseconds = ndn::time::duration_cast<ndn::time::microseconds>(duration).count();
+
+  m_count.fetch_add(1, std::memory_order_relaxed);
+  m_totalMicroseconds.fetch_add(std::max<int64_t>(microseconds, 0), std::memory_order_relaxed);
+  m_buckets[getBucket(duration)].fetch_add(1, std::memory_order_relaxed);
+}
+
+void
+DurationHistogram::reset()
+{
+  m_count.store(0, std::memory_order_relaxed);
+  m_totalMicroseconds.store(0, std::memory_order_relaxed);
+  for (std::atomic<uint64_t>& bucket : m_buckets) {
+    bucket.store(0, std::memory_order_relaxed);
+  }
+}
+
+Statistics::Statistics()
+{
+  resetAll();
 }
 
 void
 Statistics::resetAll()
 {
-  for (auto&& it : m_packetCounter )
-  {
-    it.second = 0;
+  for (PacketCounter& counter : m_packetCounters) {
+    counter.value.store(0, std::memory_order_relaxed);
+  }
+
+  for (DurationHistogram& histogram : m_histograms) {
+    histogram.reset();
   }
 }
 
@@ -98,4 +130,74 @@ operator<<(std::ostream& os, const Statistics& stats)
   return os;
 }
 
+std::ostream&
+operator<<(std::ostream& os, Statistics::PacketType type)
+{
+  using PacketType = Statistics::PacketType;
+
+  switch (type) {
+  case PacketType::SENT_HELLO_INTEREST:
+    return os << "sent-hello-interest";
+  case PacketType::SENT_HELLO_DATA:
+    return os << "sent-hello-data";
+  case PacketType::RCV_HELLO_INTEREST:
+    return os << "received-hello-interest";
+  case PacketType::RCV_HELLO_DATA:
+    return os << "received-hello-data";
+  case PacketType::SENT_LSA_INTEREST:
+    return os << "sent-lsa-interest";
+  case PacketType::SENT_ADJ_LSA_INTEREST:
+    return os << "sent-adjacency-lsa-interest";
+  case PacketType::SENT_COORD_LSA_INTEREST:
+    return os << "sent-coordinate-lsa-interest";
+  case PacketType::SENT_NAME_LSA_INTEREST:
+    return os << "sent-name-lsa-interest";
+  case PacketType::SENT_LSA_DATA:
+    return os << "sent-lsa-data";
+  case PacketType::SENT_ADJ_LSA_DATA:
+    return os << "sent-adjacency-lsa-data";
+  case PacketType::SENT_COORD_LSA_DATA:
+    return os << "sent-coordinate-lsa-data";
+  case PacketType::SENT_NAME_LSA_DATA:
+    return os << "sent-name-lsa-data";
+  case PacketType::RCV_LSA_INTEREST:
+    return os << "received-lsa-interest";
+  case PacketType::RCV_ADJ_LSA_INTEREST:
+    return os << "received-adjacency-lsa-interest";
+  case PacketType::RCV_COORD_LSA_INTEREST:
+    return os << "received-coordinate-lsa-interest";
+  case PacketType::RCV_NAME_LSA_INTEREST:
+    return os << "received-name-lsa-interest";
+  case PacketType::RCV_LSA_DATA:
+    return os << "received-lsa-data";
+  case PacketType::RCV_ADJ_LSA_DATA:
+    return os << "received-adjacency-lsa-data";
+  case PacketType::RCV_COORD_LSA_DATA:
+    return os << "received-coordinate-lsa-data";
+  case PacketType::RCV_NAME_LSA_DATA:
+    return os << "received-name-lsa-data";
+  }
+
+  return os << "unknown-" << static_cast<int>(type);
+}
+
+std::ostream&
+operator<<(std::ostream& os, Statistics::DurationType type)
+{
+  using DurationType = Statistics::DurationType;
+
+  switch (type) {
+  case DurationType::LSA_FETCH_LATENCY:
+    return os << "lsa-fetch-latency";
+  case DurationType::SPF_DURATION:
+    return os << "spf-duration";
+  case DurationType::NPT_UPDATE_DURATION:
+    return os << "npt-update-duration";
+  case DurationType::FIB_COMMAND_RTT:
+    return os << "fib-command-rtt";
+  }
+
+  return os << "unknown-" << static_cast<int>(type);
+}
+
 } // namespace nlsr
@@ -22,10 +22,73 @@
 #ifndef NLSR_STATISTICS_HPP
 #define NLSR_STATISTICS_HPP
 
-#include <map>
+#include <ndn-cxx/util/time.hpp>
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <ostream>
 
 namespace nlsr {
 
+/*! \brief A histogram of durations, in buckets of powers of two microseconds.
+
+  Bucket 0 counts the durations under a microsecond, and bucket i
+  those from 2^(i-1) up to 2^i microseconds. The last bucket also
+  counts everything longer.
+
+  The counts are relaxed atomics, so they can be read from any thread
+  while NLSR records into them, although a reader may see a sample in
+  the count but not yet in its bucket.
+ */
+class alignas(64) DurationHistogram
+{
+public:
+  static const size_t N_BUCKETS = 32;
+
+  DurationHistogram();
+
+  void
+  record(const ndn::time::nanoseconds& duration);
+
+  uint64_t
+  getCount() const
+  {
+    return m_count.load(std::memory_order_relaxed);
+  }
+
+  ndn::time::microseconds
+  getTotal() const
+  {
+    return ndn::time::microseconds(m_totalMicroseconds.load(std::memory_order_relaxed));
+  }
+
+  uint64_t
+  getBucketCount(size_t bucket) const
+  {
+    return m_buckets[bucket].load(std::memory_order_relaxed);
+  }
+
+  /*! \brief Returns the duration that a bucket counts the durations below.
+   */
+  static ndn::time::microseconds
+  getBucketUpperBound(size_t bucket)
+  {
+    return ndn::time::microseconds(uint64_t(1) << bucket);
+  }
+
+  static size_t
+  getBucket(const ndn::time::nanoseconds& duration);
+
+  void
+  reset();
+
+private:
+  std::atomic<uint64_t> m_count;
+  std::atomic<uint64_t> m_totalMicroseconds;
+  std::array<std::atomic<uint64_t>, N_BUCKETS> m_buckets;
+};
+
 class Statistics
 {
 
@@ -53,28 +116,67 @@ public:
     RCV_NAME_LSA_DATA
   };
 
+  static const size_t N_PACKET_TYPES = static_cast<size_t>(PacketType::RCV_NAME_LSA_DATA) + 1;
+
+  enum class DurationType {
+    LSA_FETCH_LATENCY,
+    SPF_DURATION,
+    NPT_UPDATE_DURATION,
+    FIB_COMMAND_RTT
+  };
+
+  static const size_t N_DURATION_TYPES = static_cast<size_t>(DurationType::FIB_COMMAND_RTT) + 1;
+
+  Statistics();
+
   size_t
-  get(PacketType) const;
+  get(PacketType type) const
+  {
+    return m_packetCounters[static_cast<size_t>(type)].value.load(std::memory_order_relaxed);
+  }
 
   void
   resetAll();
 
   void
-  increment(PacketType);
+  increment(PacketType type)
+  {
+    m_packetCounters[static_cast<size_t>(type)].value.fetch_add(1, std::memory_order_relaxed);
+  }
 
-  const std::map<PacketType,int>&
-  getCounter() const
+  const DurationHistogram&
+  getHistogram(DurationType type) const
   {
-    return m_packetCounter;
+    return m_histograms[static_cast<size_t>(type)];
+  }
+
+  void
+  record(DurationType type, const ndn::time::nanoseconds& duration)
+  {
+    m_histograms[static_cast<size_t>(type)].record(duration);
   }
 
 private:
-  std::map<PacketType,int> m_packetCounter;
+  // Each counter has a cache line to itself, so that counters bumped
+  // together from different threads do not contend for it.
+  struct alignas(64) PacketCounter
+  {
+    std::atomic<uint64_t> value;
+  };
+
+  std::array<PacketCounter, N_PACKET_TYPES> m_packetCounters;
+  std::array<DurationHistogram, N_DURATION_TYPES> m_histograms;
 };
 
 std::ostream&
 operator<<(std::ostream&, const Statistics& stats);
 
+std::ostream&
+operator<<(std::ostream& os, Statistics::PacketType type);
+
+std::ostream&
+operator<<(std::ostream& os, Statistics::DurationType type);
+
 } // namespace nlsr
 
 #endif // NLSR_STATISTICS_HPP
@@ -24,7 +24,8 @@
 
 namespace nlsr {
 
-StatsCollector::StatsCollector(Lsdb& lsdb, HelloProtocol& hp)
+StatsCollector::StatsCollector(Lsdb& lsdb, HelloProtocol& hp, RoutingTable& routingTable,
+                               NamePrefixTable& namePrefixTable, Fib& fib)
   : m_lsdb(lsdb)
   , m_hp(hp)
 {
@@ -35,12 +36,32 @@ StatsCollector::StatsCollector(Lsdb& lsdb, HelloProtocol& hp)
   m_helloIncrementConn =
   this->m_hp.hpIncrementSignal.connect(std::bind(&StatsCollector::statsIncrement,
                                                  this, _1));
+
+  m_lsaFetchLatencyConn =
+  this->m_lsdb.getLsaFetcher().fetchLatencySignal.connect(
+    std::bind(&StatsCollector::statsRecord, this, Statistics::DurationType::LSA_FETCH_LATENCY, _1));
+
+  m_spfDurationConn =
+  routingTable.spfDurationSignal.connect(
+    std::bind(&StatsCollector::statsRecord, this, Statistics::DurationType::SPF_DURATION, _1));
+
+  m_nptUpdateDurationConn =
+  namePrefixTable.updateDurationSignal.connect(
+    std::bind(&StatsCollector::statsRecord, this, Statistics::DurationType::NPT_UPDATE_DURATION, _1));
+
+  m_fibCommandRttConn =
+  fib.ribCommandRttSignal.connect(
+    std::bind(&StatsCollector::statsRecord, this, Statistics::DurationType::FIB_COMMAND_RTT, _1));
 }
 
 StatsCollector::~StatsCollector()
 {
   m_lsaIncrementConn.disconnect();
   m_helloIncrementConn.disconnect();
+  m_lsaFetchLatencyConn.disconnect();
+  m_spfDurationConn.disconnect();
+  m_nptUpdateDurationConn.disconnect();
+  m_fibCommandRttConn.disconnect();
 }
 
 void
@@ -49,4 +70,10 @@ StatsCollector::statsIncrement(Statistics::PacketType pType)
   m_stats.increment(pType);
 }
 
+void
+StatsCollector::statsRecord(Statistics::DurationType dType, const ndn::time::nanoseconds& duration)
+{
+  m_stats.record(dType, duration);
+}
+
 } // namespace nlsr
@@ -24,6 +24,9 @@
 #include "statistics.hpp"
 #include "lsdb.hpp"
 #include "hello-protocol.hpp"
+#include "route/fib.hpp"
+#include "route/name-prefix-table.hpp"
+#include "route/routing-table.hpp"
 #include <ndn-cxx/util/signal.hpp>
 
 namespace nlsr {
@@ -34,7 +37,8 @@ class StatsCollector
 {
 public:
 
-  StatsCollector(Lsdb& lsdb, HelloProtocol& hp);
+  StatsCollector(Lsdb& lsdb, HelloProtocol& hp, RoutingTable& routingTable,
+                 NamePrefixTable& namePrefixTable, Fib& fib);
 
   ~StatsCollector();
 
@@ -57,6 +61,12 @@ private:
   void
   statsIncrement(Statistics::PacketType pType);
 
+  /*!
+   * \brief: records a duration in the histogram of a Statistics::DurationType
+   */
+  void
+  statsRecord(Statistics::DurationType dType, const ndn::time::nanoseconds& duration);
+
 private:
 
   Lsdb& m_lsdb;
@@ -65,6 +75,10 @@ private:
 
   ndn::util::signal::ScopedConnection m_lsaIncrementConn;
   ndn::util::signal::ScopedConnection m_helloIncrementConn;
+  ndn::util::signal::ScopedConnection m_lsaFetchLatencyConn;
+  ndn::util::signal::ScopedConnection m_spfDurationConn;
+  ndn::util::signal::ScopedConnection m_nptUpdateDurationConn;
+  ndn::util::signal::ScopedConnection m_fibCommandRttConn;
 };
 
 } // namespace nlsr
@@ -39,6 +39,7 @@ LsaInfo::LsaInfo()
   : m_sequenceNumber(0)
   , m_expirationPeriod(INFINITE_EXPIRATION_PERIOD)
   , m_hasInfiniteExpirationPeriod(true)
+  , m_hasExpirationTime(false)
 {
 }
 
@@ -53,6 +54,12 @@ LsaInfo::wireEncode(ndn::EncodingImpl<TAG>& encoder) const
 {
   size_t totalLength = 0;
 
+  if (m_hasExpirationTime) {
+    totalLength += prependNonNegativeIntegerBlock(encoder,
+                                                  ndn::tlv::nlsr::ExpirationTime,
+                                                  ndn::time::toUnixTimestamp(m_expirationTime).count());
+  }
+
   // Absence of an ExpirationPeriod signifies non-expiration
   if (!m_hasInfiniteExpirationPeriod) {
     totalLength += prependNonNegativeIntegerBlock(encoder,
@@ -102,6 +109,7 @@ LsaInfo::wireDecode(const ndn::Block& wire)
   m_originRouter.clear();
   m_sequenceNumber = 0;
   m_expirationPeriod = ndn::time::milliseconds::min();
+  m_hasExpirationTime = false;
 
   m_wire = wire;
 
@@ -144,11 +152,18 @@ LsaInfo::wireDecode(const ndn::Block& wire)
   if (val != m_wire.elements_end() && val->type() == ndn::tlv::nlsr::ExpirationPeriod) {
     m_expirationPeriod = ndn::time::milliseconds(ndn::readNonNegativeInteger(*val));
     m_hasInfiniteExpirationPeriod = false;
+    ++val;
   }
   else {
     m_expirationPeriod = INFINITE_EXPIRATION_PERIOD;
     m_hasInfiniteExpirationPeriod = true;
   }
+
+  if (val != m_wire.elements_end() && val->type() == ndn::tlv::nlsr::ExpirationTime) {
+    m_expirationTime = ndn::time::fromUnixTimestamp(
+                         ndn::time::milliseconds(ndn::readNonNegativeInteger(*val)));
+    m_hasExpirationTime = true;
+  }
 }
 
 std::ostream&
@@ -165,6 +180,10 @@ operator<<(std::ostream& os, const LsaInfo& lsaInfo)
     os << "ExpirationPeriod: Infinity";
   }
 
+  if (lsaInfo.hasExpirationTime()) {
+    os << ", ExpirationTime: " << ndn::time::toIsoString(lsaInfo.getExpirationTime());
+  }
+
   os << ")";
 
   return os;
@@ -41,6 +41,12 @@ namespace tlv {
                 OriginRouter
                 SequenceNumber
                 ExpirationPeriod?
+                ExpirationTime?
+
+   The ExpirationPeriod is relative to when the LsaInfo was encoded,
+   and is used in the LSDB Status Dataset. The ExpirationTime is in
+   milliseconds since the Unix epoch, and is used in the content of
+   LSA Data, which can be served long after it is encoded.
 
    \sa https://redmine.named-data.net/projects/nlsr/wiki/LSDB_DataSet
  */
@@ -115,6 +121,27 @@ public:
     return m_hasInfiniteExpirationPeriod;
   }
 
+  const ndn::time::system_clock::TimePoint&
+  getExpirationTime() const
+  {
+    return m_expirationTime;
+  }
+
+  LsaInfo&
+  setExpirationTime(const ndn::time::system_clock::TimePoint& expirationTime)
+  {
+    m_expirationTime = expirationTime;
+    m_hasExpirationTime = true;
+    m_wire.reset();
+    return *this;
+  }
+
+  bool
+  hasExpirationTime() const
+  {
+    return m_hasExpirationTime;
+  }
+
   /*! \brief Encodes LSA info using the method in TAG.
    *
    * This function will TLV-format LSA info using the implementation
@@ -150,6 +177,8 @@ private:
   uint64_t m_sequenceNumber;
   ndn::time::milliseconds m_expirationPeriod;
   bool m_hasInfiniteExpirationPeriod;
+  ndn::time::system_clock::TimePoint m_expirationTime;
+  bool m_hasExpirationTime;
 
   mutable ndn::Block m_wire;
 };
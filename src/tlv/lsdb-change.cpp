@@ -0,0 +1,185 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2017,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "lsdb-change.hpp"
+#include "tlv-nlsr.hpp"
+
+#include <ndn-cxx/util/concepts.hpp>
+#include <ndn-cxx/encoding/block-helpers.hpp>
+
+namespace nlsr {
+namespace tlv {
+
+BOOST_CONCEPT_ASSERT((ndn::WireEncodable<LsdbChange>));
+BOOST_CONCEPT_ASSERT((ndn::WireDecodable<LsdbChange>));
+static_assert(std::is_base_of<ndn::tlv::Error, LsdbChange::Error>::value,
+              "LsdbChange::Error must inherit from tlv::Error");
+
+LsdbChange::LsdbChange()
+  : m_epoch(0)
+  , m_changeSequenceNumber(0)
+  , m_kind(nlsr::LsdbChange::Kind::INSTALLED)
+  , m_lsaType(Lsa::Type::BASE)
+  , m_sequenceNumber(0)
+{
+}
+
+LsdbChange::LsdbChange(const nlsr::LsdbChange& change)
+  : m_epoch(change.epoch)
+  , m_changeSequenceNumber(change.sequenceNumber)
+  , m_kind(change.kind)
+  , m_lsaType(change.lsaType)
+  , m_originRouter(change.originRouter)
+  , m_sequenceNumber(change.lsaSequenceNumber)
+{
+}
+
+LsdbChange::LsdbChange(const ndn::Block& block)
+{
+  wireDecode(block);
+}
+
+template<ndn::encoding::Tag TAG>
+size_t
+LsdbChange::wireEncode(ndn::EncodingImpl<TAG>& block) const
+{
+  size_t totalLength = 0;
+
+  totalLength += prependNonNegativeIntegerBlock(block, ndn::tlv::nlsr::SequenceNumber,
+                                                m_sequenceNumber);
+  totalLength += prependNestedBlock(block, ndn::tlv::nlsr::OriginRouter, m_originRouter);
+  totalLength += prependNonNegativeIntegerBlock(block, ndn::tlv::nlsr::LsaType,
+                                                static_cast<uint64_t>(m_lsaType));
+  totalLength += prependNonNegativeIntegerBlock(block, ndn::tlv::nlsr::ChangeKind,
+                                                static_cast<uint64_t>(m_kind));
+  totalLength += prependNonNegativeIntegerBlock(block, ndn::tlv::nlsr::ChangeSequenceNumber,
+                                                m_changeSequenceNumber);
+  totalLength += prependNonNegativeIntegerBlock(block, ndn::tlv::nlsr::ChangeEpoch, m_epoch);
+
+  totalLength += block.prependVarNumber(totalLength);
+  totalLength += block.prependVarNumber(ndn::tlv::nlsr::LsdbChange);
+
+  return totalLength;
+}
+
+template size_t
+LsdbChange::wireEncode<ndn::encoding::EncoderTag>(ndn::EncodingImpl<ndn::encoding::EncoderTag>& block) const;
+
+template size_t
+LsdbChange::wireEncode<ndn::encoding::EstimatorTag>(ndn::EncodingImpl<ndn::encoding::EstimatorTag>& block) const;
+
+const ndn::Block&
+LsdbChange::wireEncode() const
+{
+  if (m_wire.hasWire()) {
+    return m_wire;
+  }
+
+  ndn::EncodingEstimator estimator;
+  size_t estimatedSize = wireEncode(estimator);
+
+  ndn::EncodingBuffer buffer(estimatedSize, 0);
+  wireEncode(buffer);
+
+  m_wire = buffer.block();
+
+  return m_wire;
+}
+
+/*! \brief Reads a required nonNegativeInteger field of an LsdbChange.
+ */
+static uint64_t
+readField(ndn::Block::element_const_iterator& val, const ndn::Block& parent, uint32_t type,
+          const std::string& fieldName)
+{
+  if (val == parent.elements_end() || val->type() != type) {
+    BOOST_THROW_EXCEPTION(LsdbChange::Error("Missing required " + fieldName + " field"));
+  }
+
+  return ndn::readNonNegativeInteger(*val++);
+}
+
+void
+LsdbChange::wireDecode(const ndn::Block& wire)
+{
+  m_wire = wire;
+
+  if (m_wire.type() != ndn::tlv::nlsr::LsdbChange) {
+    std::stringstream error;
+    error << "Expected LsdbChange Block, but Block is of a different type: #"
+          << m_wire.type();
+    BOOST_THROW_EXCEPTION(Error(error.str()));
+  }
+
+  m_wire.parse();
+
+  ndn::Block::element_const_iterator val = m_wire.elements_begin();
+
+  m_epoch = readField(val, m_wire, ndn::tlv::nlsr::ChangeEpoch, "ChangeEpoch");
+  m_changeSequenceNumber = readField(val, m_wire, ndn::tlv::nlsr::ChangeSequenceNumber,
+                                     "ChangeSequenceNumber");
+  m_kind = static_cast<nlsr::LsdbChange::Kind>(readField(val, m_wire, ndn::tlv::nlsr::ChangeKind,
+                                                         "ChangeKind"));
+  m_lsaType = static_cast<Lsa::Type>(readField(val, m_wire, ndn::tlv::nlsr::LsaType, "LsaType"));
+
+  if (val != m_wire.elements_end() && val->type() == ndn::tlv::nlsr::OriginRouter) {
+    val->parse();
+    ndn::Block::element_const_iterator it = val->elements_begin();
+
+    if (it != val->elements_end() && it->type() == ndn::tlv::Name) {
+      m_originRouter.wireDecode(*it);
+    }
+    else {
+      BOOST_THROW_EXCEPTION(Error("OriginRouter: Missing required Name field"));
+    }
+
+    ++val;
+  }
+  else {
+    BOOST_THROW_EXCEPTION(Error("Missing required OriginRouter field"));
+  }
+
+  m_sequenceNumber = readField(val, m_wire, ndn::tlv::nlsr::SequenceNumber, "SequenceNumber");
+
+  if (val != m_wire.elements_end()) {
+    std::stringstream error;
+    error << "Expected the end of elements, but Block is of a different type: #"
+          << val->type();
+    BOOST_THROW_EXCEPTION(Error(error.str()));
+  }
+}
+
+std::ostream&
+operator<<(std::ostream& os, const LsdbChange& lsdbChange)
+{
+  os << "LsdbChange("
+     << "ChangeEpoch: " << lsdbChange.getEpoch() << ", "
+     << "ChangeSequenceNumber: " << lsdbChange.getChangeSequenceNumber() << ", "
+     << "ChangeKind: " << lsdbChange.getKind() << ", "
+     << "LsaType: " << lsdbChange.getLsaType() << ", "
+     << "OriginRouter: " << lsdbChange.getOriginRouter() << ", "
+     << "SequenceNumber: " << lsdbChange.getSequenceNumber() << ")";
+
+  return os;
+}
+
+} // namespace tlv
+} // namespace nlsr
@@ -0,0 +1,181 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2017,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NLSR_TLV_LSDB_CHANGE_HPP
+#define NLSR_TLV_LSDB_CHANGE_HPP
+
+#include "lsdb-change-log.hpp"
+
+#include <ndn-cxx/encoding/block.hpp>
+#include <ndn-cxx/encoding/encoding-buffer.hpp>
+#include <ndn-cxx/encoding/tlv.hpp>
+#include <ndn-cxx/name.hpp>
+
+namespace nlsr {
+namespace tlv {
+
+/*!
+   \brief Data abstraction for LsdbChange
+
+   LsdbChange := LSDB-CHANGE-TYPE TLV-LENGTH
+                   ChangeEpoch
+                   ChangeSequenceNumber
+                   ChangeKind
+                   LsaType
+                   OriginRouter
+                   SequenceNumber
+
+   The ChangeKind is an LsdbChange::Kind and the LsaType an Lsa::Type.
+   The SequenceNumber is that of the LSA after the change.
+ */
+class LsdbChange
+{
+public:
+  class Error : public ndn::tlv::Error
+  {
+  public:
+    explicit
+    Error(const std::string& what)
+      : ndn::tlv::Error(what)
+    {
+    }
+  };
+
+  LsdbChange();
+
+  explicit
+  LsdbChange(const nlsr::LsdbChange& change);
+
+  explicit
+  LsdbChange(const ndn::Block& block);
+
+  uint64_t
+  getEpoch() const
+  {
+    return m_epoch;
+  }
+
+  LsdbChange&
+  setEpoch(uint64_t epoch)
+  {
+    m_epoch = epoch;
+    m_wire.reset();
+    return *this;
+  }
+
+  uint64_t
+  getChangeSequenceNumber() const
+  {
+    return m_changeSequenceNumber;
+  }
+
+  LsdbChange&
+  setChangeSequenceNumber(uint64_t changeSequenceNumber)
+  {
+    m_changeSequenceNumber = changeSequenceNumber;
+    m_wire.reset();
+    return *this;
+  }
+
+  nlsr::LsdbChange::Kind
+  getKind() const
+  {
+    return m_kind;
+  }
+
+  LsdbChange&
+  setKind(nlsr::LsdbChange::Kind kind)
+  {
+    m_kind = kind;
+    m_wire.reset();
+    return *this;
+  }
+
+  Lsa::Type
+  getLsaType() const
+  {
+    return m_lsaType;
+  }
+
+  LsdbChange&
+  setLsaType(Lsa::Type lsaType)
+  {
+    m_lsaType = lsaType;
+    m_wire.reset();
+    return *this;
+  }
+
+  const ndn::Name&
+  getOriginRouter() const
+  {
+    return m_originRouter;
+  }
+
+  LsdbChange&
+  setOriginRouter(const ndn::Name& originRouter)
+  {
+    m_originRouter = originRouter;
+    m_wire.reset();
+    return *this;
+  }
+
+  uint64_t
+  getSequenceNumber() const
+  {
+    return m_sequenceNumber;
+  }
+
+  LsdbChange&
+  setSequenceNumber(uint64_t sequenceNumber)
+  {
+    m_sequenceNumber = sequenceNumber;
+    m_wire.reset();
+    return *this;
+  }
+
+  template<ndn::encoding::Tag TAG>
+  size_t
+  wireEncode(ndn::EncodingImpl<TAG>& block) const;
+
+  const ndn::Block&
+  wireEncode() const;
+
+  void
+  wireDecode(const ndn::Block& wire);
+
+private:
+  uint64_t m_epoch;
+  uint64_t m_changeSequenceNumber;
+  nlsr::LsdbChange::Kind m_kind;
+  Lsa::Type m_lsaType;
+  ndn::Name m_originRouter;
+  uint64_t m_sequenceNumber;
+
+  mutable ndn::Block m_wire;
+};
+
+std::ostream&
+operator<<(std::ostream& os, const LsdbChange& lsdbChange);
+
+} // namespace tlv
+} // namespace nlsr
+
+#endif // NLSR_TLV_LSDB_CHANGE_HPP
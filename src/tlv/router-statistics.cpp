@@ -0,0 +1,239 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2017,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "router-statistics.hpp"
+#include "tlv-nlsr.hpp"
+
+#include <ndn-cxx/util/concepts.hpp>
+#include <ndn-cxx/encoding/block-helpers.hpp>
+
+namespace nlsr {
+namespace tlv {
+
+BOOST_CONCEPT_ASSERT((ndn::WireEncodable<RouterStatistics>));
+BOOST_CONCEPT_ASSERT((ndn::WireDecodable<RouterStatistics>));
+static_assert(std::is_base_of<ndn::tlv::Error, RouterStatistics::Error>::value,
+              "RouterStatistics::Error must inherit from tlv::Error");
+
+RouterStatistics::RouterStatistics()
+{
+}
+
+RouterStatistics::RouterStatistics(const ndn::Block& block)
+{
+  wireDecode(block);
+}
+
+template<ndn::encoding::Tag TAG>
+size_t
+RouterStatistics::wireEncode(ndn::EncodingImpl<TAG>& block) const
+{
+  size_t totalLength = 0;
+
+  for (auto it = m_durationHistograms.rbegin(); it != m_durationHistograms.rend(); ++it) {
+    size_t length = 0;
+
+    for (auto bucket = it->buckets.rbegin(); bucket != it->buckets.rend(); ++bucket) {
+      length += prependNonNegativeIntegerBlock(block, ndn::tlv::nlsr::BucketCount, *bucket);
+    }
+    length += prependNonNegativeIntegerBlock(block, ndn::tlv::nlsr::TotalDuration,
+                                             it->total.count());
+    length += prependNonNegativeIntegerBlock(block, ndn::tlv::nlsr::Count, it->count);
+    length += prependNonNegativeIntegerBlock(block, ndn::tlv::nlsr::StatisticType,
+                                             static_cast<uint64_t>(it->type));
+
+    length += block.prependVarNumber(length);
+    length += block.prependVarNumber(ndn::tlv::nlsr::DurationHistogram);
+    totalLength += length;
+  }
+
+  for (auto it = m_packetCounters.rbegin(); it != m_packetCounters.rend(); ++it) {
+    size_t length = 0;
+
+    length += prependNonNegativeIntegerBlock(block, ndn::tlv::nlsr::Count, it->count);
+    length += prependNonNegativeIntegerBlock(block, ndn::tlv::nlsr::StatisticType,
+                                             static_cast<uint64_t>(it->type));
+
+    length += block.prependVarNumber(length);
+    length += block.prependVarNumber(ndn::tlv::nlsr::PacketCounter);
+    totalLength += length;
+  }
+
+  totalLength += block.prependVarNumber(totalLength);
+  totalLength += block.prependVarNumber(ndn::tlv::nlsr::RouterStatistics);
+
+  return totalLength;
+}
+
+template size_t
+RouterStatistics::wireEncode<ndn::encoding::EncoderTag>(ndn::EncodingImpl<ndn::encoding::EncoderTag>& block) const;
+
+template size_t
+RouterStatistics::wireEncode<ndn::encoding::EstimatorTag>(ndn::EncodingImpl<ndn::encoding::EstimatorTag>& block) const;
+
+const ndn::Block&
+RouterStatistics::wireEncode() const
+{
+  if (m_wire.hasWire()) {
+    return m_wire;
+  }
+
+  ndn::EncodingEstimator estimator;
+  size_t estimatedSize = wireEncode(estimator);
+
+  ndn::EncodingBuffer buffer(estimatedSize, 0);
+  wireEncode(buffer);
+
+  m_wire = buffer.block();
+
+  return m_wire;
+}
+
+/*! \brief Reads a required nonNegativeInteger field of a counter or histogram.
+ */
+static uint64_t
+readField(ndn::Block::element_const_iterator& val, const ndn::Block& parent, uint32_t type,
+          const std::string& fieldName)
+{
+  if (val == parent.elements_end() || val->type() != type) {
+    BOOST_THROW_EXCEPTION(RouterStatistics::Error("Missing required " + fieldName + " field"));
+  }
+
+  return ndn::readNonNegativeInteger(*val++);
+}
+
+void
+RouterStatistics::wireDecode(const ndn::Block& wire)
+{
+  m_packetCounters.clear();
+  m_durationHistograms.clear();
+
+  m_wire = wire;
+
+  if (m_wire.type() != ndn::tlv::nlsr::RouterStatistics) {
+    std::stringstream error;
+    error << "Expected RouterStatistics Block, but Block is of a different type: #"
+          << m_wire.type();
+    BOOST_THROW_EXCEPTION(Error(error.str()));
+  }
+
+  m_wire.parse();
+
+  ndn::Block::element_const_iterator val = m_wire.elements_begin();
+
+  for (; val != m_wire.elements_end() && val->type() == ndn::tlv::nlsr::PacketCounter; ++val) {
+    val->parse();
+    ndn::Block::element_const_iterator field = val->elements_begin();
+
+    PacketCounter counter;
+    counter.type = static_cast<Statistics::PacketType>(
+                     readField(field, *val, ndn::tlv::nlsr::StatisticType, "StatisticType"));
+    counter.count = readField(field, *val, ndn::tlv::nlsr::Count, "Count");
+    m_packetCounters.push_back(counter);
+  }
+
+  for (; val != m_wire.elements_end() && val->type() == ndn::tlv::nlsr::DurationHistogram; ++val) {
+    val->parse();
+    ndn::Block::element_const_iterator field = val->elements_begin();
+
+    DurationHistogram histogram;
+    histogram.type = static_cast<Statistics::DurationType>(
+                       readField(field, *val, ndn::tlv::nlsr::StatisticType, "StatisticType"));
+    histogram.count = readField(field, *val, ndn::tlv::nlsr::Count, "Count");
+    histogram.total = ndn::time::microseconds(
+                        readField(field, *val, ndn::tlv::nlsr::TotalDuration, "TotalDuration"));
+    for (; field != val->elements_end() && field->type() == ndn::tlv::nlsr::BucketCount; ++field) {
+      histogram.buckets.push_back(ndn::readNonNegativeInteger(*field));
+    }
+    m_durationHistograms.push_back(histogram);
+  }
+
+  if (val != m_wire.elements_end()) {
+    std::stringstream error;
+    error << "Expected the end of elements, but Block is of a different type: #"
+          << val->type();
+    BOOST_THROW_EXCEPTION(Error(error.str()));
+  }
+}
+
+std::ostream&
+operator<<(std::ostream& os, const RouterStatistics& routerStatistics)
+{
+  os << "RouterStatistics(";
+
+  bool isFirst = true;
+
+  for (const auto& counter : routerStatistics.getPacketCounters()) {
+    if (isFirst) {
+      isFirst = false;
+    }
+    else {
+      os << ", ";
+    }
+
+    os << counter.type << ": " << counter.count;
+  }
+
+  for (const auto& histogram : routerStatistics.getDurationHistograms()) {
+    if (isFirst) {
+      isFirst = false;
+    }
+    else {
+      os << ", ";
+    }
+
+    os << histogram.type << ": " << histogram.count << " in " << histogram.total;
+  }
+
+  os << ")";
+
+  return os;
+}
+
+RouterStatistics
+makeRouterStatistics(const Statistics& statistics)
+{
+  RouterStatistics routerStatistics;
+
+  for (size_t i = 0; i < Statistics::N_PACKET_TYPES; ++i) {
+    Statistics::PacketType type = static_cast<Statistics::PacketType>(i);
+    routerStatistics.addPacketCounter({type, statistics.get(type)});
+  }
+
+  for (size_t i = 0; i < Statistics::N_DURATION_TYPES; ++i) {
+    Statistics::DurationType type = static_cast<Statistics::DurationType>(i);
+    const nlsr::DurationHistogram& histogram = statistics.getHistogram(type);
+
+    RouterStatistics::DurationHistogram tlvHistogram;
+    tlvHistogram.type = type;
+    tlvHistogram.count = histogram.getCount();
+    tlvHistogram.total = histogram.getTotal();
+    for (size_t bucket = 0; bucket < nlsr::DurationHistogram::N_BUCKETS; ++bucket) {
+      tlvHistogram.buckets.push_back(histogram.getBucketCount(bucket));
+    }
+    routerStatistics.addDurationHistogram(tlvHistogram);
+  }
+
+  return routerStatistics;
+}
+
+} // namespace tlv
+} // namespace nlsr
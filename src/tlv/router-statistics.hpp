@@ -0,0 +1,147 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2017,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NLSR_TLV_ROUTER_STATISTICS_HPP
+#define NLSR_TLV_ROUTER_STATISTICS_HPP
+
+#include "statistics.hpp"
+
+#include <ndn-cxx/util/time.hpp>
+#include <ndn-cxx/encoding/block.hpp>
+#include <ndn-cxx/encoding/encoding-buffer.hpp>
+#include <ndn-cxx/encoding/tlv.hpp>
+
+#include <vector>
+
+namespace nlsr {
+namespace tlv {
+
+/*!
+   \brief Data abstraction for RouterStatistics
+
+   RouterStatistics := ROUTER-STATISTICS-TYPE TLV-LENGTH
+                         PacketCounter*
+                         DurationHistogram*
+
+   PacketCounter := PACKET-COUNTER-TYPE TLV-LENGTH
+                      StatisticType
+                      Count
+
+   DurationHistogram := DURATION-HISTOGRAM-TYPE TLV-LENGTH
+                          StatisticType
+                          Count
+                          TotalDuration
+                          BucketCount*
+
+   The StatisticType is a Statistics::PacketType or
+   Statistics::DurationType. TotalDuration is in microseconds, and the
+   BucketCounts are those of the buckets of a DurationHistogram, in
+   order.
+ */
+class RouterStatistics
+{
+public:
+  class Error : public ndn::tlv::Error
+  {
+  public:
+    explicit
+    Error(const std::string& what)
+      : ndn::tlv::Error(what)
+    {
+    }
+  };
+
+  struct PacketCounter
+  {
+    Statistics::PacketType type;
+    uint64_t count;
+  };
+
+  struct DurationHistogram
+  {
+    Statistics::DurationType type;
+    uint64_t count;
+    ndn::time::microseconds total;
+    std::vector<uint64_t> buckets;
+  };
+
+  RouterStatistics();
+
+  explicit
+  RouterStatistics(const ndn::Block& block);
+
+  const std::vector<PacketCounter>&
+  getPacketCounters() const
+  {
+    return m_packetCounters;
+  }
+
+  RouterStatistics&
+  addPacketCounter(const PacketCounter& counter)
+  {
+    m_packetCounters.push_back(counter);
+    m_wire.reset();
+    return *this;
+  }
+
+  const std::vector<DurationHistogram>&
+  getDurationHistograms() const
+  {
+    return m_durationHistograms;
+  }
+
+  RouterStatistics&
+  addDurationHistogram(const DurationHistogram& histogram)
+  {
+    m_durationHistograms.push_back(histogram);
+    m_wire.reset();
+    return *this;
+  }
+
+  template<ndn::encoding::Tag TAG>
+  size_t
+  wireEncode(ndn::EncodingImpl<TAG>& block) const;
+
+  const ndn::Block&
+  wireEncode() const;
+
+  void
+  wireDecode(const ndn::Block& wire);
+
+private:
+  std::vector<PacketCounter> m_packetCounters;
+  std::vector<DurationHistogram> m_durationHistograms;
+
+  mutable ndn::Block m_wire;
+};
+
+std::ostream&
+operator<<(std::ostream& os, const RouterStatistics& routerStatistics);
+
+/*! \brief Takes a snapshot of the counters and histograms of a Statistics.
+ */
+RouterStatistics
+makeRouterStatistics(const Statistics& statistics);
+
+} // namespace tlv
+} // namespace nlsr
+
+#endif // NLSR_TLV_ROUTER_STATISTICS_HPP
@@ -31,7 +31,7 @@ namespace nlsr {
 /*! The TLV block types that NLSR uses to encode/decode LSA types. The
  *  way NLSR encodes LSAs to TLV is by encoding each element of the
  *  LSA as a separate TLV block. So, block types are needed. These are
- *  used in the LSDB Status Dataset.
+ *  used in the LSDB Status Dataset and in the content of LSA Data.
  */
 enum {
   LsaInfo          = 128,
@@ -47,7 +47,22 @@ enum {
   LsdbStatus       = 138,
   ExpirationPeriod = 139,
   Cost             = 140,
-  Uri              = 141
+  Uri              = 141,
+  ExpirationTime   = 142,
+  RouterStatistics = 143,
+  PacketCounter    = 144,
+  DurationHistogram = 145,
+  StatisticType    = 146,
+  Count            = 147,
+  TotalDuration    = 148,
+  BucketCount      = 149,
+  LsdbChange       = 150,
+  ChangeSequenceNumber = 151,
+  ChangeKind       = 152,
+  LsaType          = 153,
+  LsaContent       = 154,
+  LsaContentVersion = 155,
+  ChangeEpoch      = 156
 };
 
 } // namespace nlsr
@@ -0,0 +1,104 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2017,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NLSR_INTERNER_HPP
+#define NLSR_INTERNER_HPP
+
+#include <boost/assert.hpp>
+#include <boost/noncopyable.hpp>
+
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+namespace nlsr {
+namespace util {
+
+/*! \brief Gives each distinct value a dense integer ID.
+
+  IDs are handed out in the order values are first interned, starting
+  at 0, and a value keeps its ID for the life of the Interner. Values
+  can then be stored, compared and hashed as IDs, and looked up again
+  only where the value itself is needed. References returned by get()
+  stay valid for the life of the Interner.
+
+  An Interner is not thread-safe.
+ */
+template<typename T, typename Hash = std::hash<T>>
+class Interner : boost::noncopyable
+{
+public:
+  typedef uint32_t Id;
+
+  /*! \brief Returns the ID of a value, giving it the next ID if it has none yet.
+   */
+  Id
+  intern(const T& value)
+  {
+    auto it = m_ids.find(value);
+    if (it != m_ids.end()) {
+      return it->second;
+    }
+
+    Id id = static_cast<Id>(m_values.size());
+    it = m_ids.emplace(value, id).first;
+    // Elements of an unordered_map are not moved by rehashing
+    m_values.push_back(&it->first);
+    return id;
+  }
+
+  /*! \brief Looks up the ID of a value without interning it.
+    \return false if the value has not been interned.
+   */
+  bool
+  find(const T& value, Id& id) const
+  {
+    auto it = m_ids.find(value);
+    if (it == m_ids.end()) {
+      return false;
+    }
+    id = it->second;
+    return true;
+  }
+
+  const T&
+  get(Id id) const
+  {
+    BOOST_ASSERT(id < m_values.size());
+    return *m_values[id];
+  }
+
+  size_t
+  size() const
+  {
+    return m_values.size();
+  }
+
+private:
+  std::unordered_map<T, Id, Hash> m_ids;
+  std::vector<const T*> m_values;
+};
+
+} // namespace util
+} // namespace nlsr
+
+#endif // NLSR_INTERNER_HPP
@@ -0,0 +1,175 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2017,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NLSR_LOCK_FREE_RING_BUFFER_HPP
+#define NLSR_LOCK_FREE_RING_BUFFER_HPP
+
+#include <boost/noncopyable.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+namespace nlsr {
+namespace util {
+
+/*! \brief A bounded queue that any number of threads can push to and pop from
+    without taking a lock.
+
+  Each cell of the ring carries a sequence number that tells a
+  producer whether the cell is free for its position, and a consumer
+  whether the cell holds the value of its position. A thread claims a
+  position with a single compare-and-swap, so neither pushing nor
+  popping ever blocks. When the ring is full, tryPush fails instead of
+  waiting.
+
+  The capacity is rounded up to a power of two.
+ */
+template<typename T>
+class LockFreeRingBuffer : boost::noncopyable
+{
+public:
+  explicit
+  LockFreeRingBuffer(size_t capacity)
+    : m_mask(roundUpToPowerOfTwo(capacity) - 1)
+    , m_cells(new Cell[m_mask + 1])
+    , m_pushPosition(0)
+    , m_popPosition(0)
+  {
+    for (size_t i = 0; i <= m_mask; ++i) {
+      m_cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  size_t
+  capacity() const
+  {
+    return m_mask + 1;
+  }
+
+  /*! \brief Appends a value to the queue.
+    \return false, leaving the value alone, if the queue is full.
+   */
+  bool
+  tryPush(T& value)
+  {
+    size_t position = m_pushPosition.load(std::memory_order_relaxed);
+    Cell* cell = nullptr;
+
+    while (true) {
+      cell = &m_cells[position & m_mask];
+      size_t sequence = cell->sequence.load(std::memory_order_acquire);
+      intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+
+      if (difference == 0) {
+        if (m_pushPosition.compare_exchange_weak(position, position + 1,
+                                                 std::memory_order_relaxed)) {
+          break;
+        }
+      }
+      else if (difference < 0) {
+        return false;
+      }
+      else {
+        position = m_pushPosition.load(std::memory_order_relaxed);
+      }
+    }
+
+    cell->value = std::move(value);
+    cell->sequence.store(position + 1, std::memory_order_release);
+    return true;
+  }
+
+  /*! \brief Removes the oldest value from the queue.
+    \return false if the queue is empty.
+   */
+  bool
+  tryPop(T& value)
+  {
+    size_t position = m_popPosition.load(std::memory_order_relaxed);
+    Cell* cell = nullptr;
+
+    while (true) {
+      cell = &m_cells[position & m_mask];
+      size_t sequence = cell->sequence.load(std::memory_order_acquire);
+      intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position + 1);
+
+      if (difference == 0) {
+        if (m_popPosition.compare_exchange_weak(position, position + 1,
+                                                std::memory_order_relaxed)) {
+          break;
+        }
+      }
+      else if (difference < 0) {
+        return false;
+      }
+      else {
+        position = m_popPosition.load(std::memory_order_relaxed);
+      }
+    }
+
+    value = std::move(cell->value);
+    // Don't keep whatever the value refers to alive until the cell is reused.
+    cell->value = T();
+    cell->sequence.store(position + m_mask + 1, std::memory_order_release);
+    return true;
+  }
+
+private:
+  static size_t
+  roundUpToPowerOfTwo(size_t n)
+  {
+    size_t powerOfTwo = 1;
+    while (powerOfTwo < n) {
+      powerOfTwo <<= 1;
+    }
+    return powerOfTwo;
+  }
+
+private:
+  struct Cell
+  {
+    std::atomic<size_t> sequence;
+    T value;
+  };
+
+  // Producers and consumers update different positions, so keep them
+  // on different cache lines. The positions are padded rather than
+  // aligned, so that the ring buffer and its owners stay allocatable
+  // with plain new in C++11.
+  static const size_t CACHE_LINE_SIZE = 64;
+
+  const size_t m_mask;
+  std::unique_ptr<Cell[]> m_cells;
+
+  char m_padding0[CACHE_LINE_SIZE];
+  std::atomic<size_t> m_pushPosition;
+  char m_padding1[CACHE_LINE_SIZE - sizeof(std::atomic<size_t>)];
+  std::atomic<size_t> m_popPosition;
+  char m_padding2[CACHE_LINE_SIZE - sizeof(std::atomic<size_t>)];
+};
+
+} // namespace util
+} // namespace nlsr
+
+#endif // NLSR_LOCK_FREE_RING_BUFFER_HPP
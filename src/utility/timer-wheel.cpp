@@ -0,0 +1,247 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2017,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "timer-wheel.hpp"
+
+#include <algorithm>
+
+namespace nlsr {
+namespace util {
+
+const int TimerWheel::BITS_PER_LEVEL = 6;
+const uint32_t TimerWheel::SLOTS_PER_LEVEL = 1 << TimerWheel::BITS_PER_LEVEL;
+const int TimerWheel::N_LEVELS = 4;
+const uint32_t TimerWheel::NONE = std::numeric_limits<uint32_t>::max();
+
+TimerWheel::TimerWheel(ndn::Scheduler& scheduler, const ndn::time::milliseconds& tick)
+  : m_scheduler(scheduler)
+  , m_tick(tick)
+  , m_startTime(ndn::time::steady_clock::now())
+  , m_currentTick(0)
+  , m_freeList(NONE)
+  , m_slots(N_LEVELS * SLOTS_PER_LEVEL, NONE)
+  , m_nTimers(0)
+  , m_isTickScheduled(false)
+  , m_isTicking(false)
+{
+  BOOST_ASSERT(m_tick > ndn::time::nanoseconds::zero());
+}
+
+TimerWheel::~TimerWheel()
+{
+  if (m_isTickScheduled) {
+    m_scheduler.cancelEvent(m_tickEvent);
+  }
+}
+
+TimerWheel::TimerId
+TimerWheel::schedule(const ndn::time::nanoseconds& delay, const Callback& callback)
+{
+  // An idle wheel has not been following the clock, so catch it up
+  // before working out which tick the timer expires in.
+  bool isIdle = !m_isTickScheduled && !m_isTicking;
+  if (isIdle) {
+    m_currentTick = getElapsedTicks();
+  }
+
+  ndn::time::nanoseconds due = ndn::time::steady_clock::now() - m_startTime +
+                               std::max(delay, ndn::time::nanoseconds::zero());
+  uint64_t expiry = static_cast<uint64_t>((due.count() + m_tick.count() - 1) / m_tick.count());
+  expiry = std::max(expiry, m_currentTick + 1);
+
+  uint32_t index;
+  if (m_freeList != NONE) {
+    index = m_freeList;
+    m_freeList = m_timers[index].next;
+  }
+  else {
+    index = static_cast<uint32_t>(m_timers.size());
+    m_timers.push_back(Timer());
+    m_timers[index].generation = 0;
+  }
+
+  Timer& timer = m_timers[index];
+  timer.callback = callback;
+  timer.expiry = expiry;
+  link(index);
+  ++m_nTimers;
+
+  if (isIdle) {
+    scheduleTick();
+  }
+
+  return TimerId(index, timer.generation);
+}
+
+void
+TimerWheel::cancel(const TimerId& id)
+{
+  if (id.m_index >= m_timers.size()) {
+    return;
+  }
+
+  Timer& timer = m_timers[id.m_index];
+  if (timer.slot == NONE || timer.generation != id.m_generation) {
+    return;
+  }
+
+  unlink(id.m_index);
+  release(id.m_index);
+}
+
+void
+TimerWheel::onTick()
+{
+  m_isTickScheduled = false;
+  m_isTicking = true;
+
+  uint64_t elapsedTicks = getElapsedTicks();
+  while (m_currentTick < elapsedTicks && m_nTimers > 0) {
+    advance();
+  }
+
+  m_isTicking = false;
+
+  if (m_nTimers > 0) {
+    scheduleTick();
+  }
+}
+
+uint64_t
+TimerWheel::getElapsedTicks() const
+{
+  ndn::time::nanoseconds elapsed = ndn::time::steady_clock::now() - m_startTime;
+  return static_cast<uint64_t>(elapsed.count() / m_tick.count());
+}
+
+void
+TimerWheel::scheduleTick()
+{
+  ndn::time::steady_clock::TimePoint nextTick = m_startTime +
+                                                 m_tick * static_cast<int64_t>(m_currentTick + 1);
+  ndn::time::nanoseconds delay = std::max(nextTick - ndn::time::steady_clock::now(),
+                                          ndn::time::nanoseconds::zero());
+
+  m_tickEvent = m_scheduler.scheduleEvent(delay, std::bind(&TimerWheel::onTick, this));
+  m_isTickScheduled = true;
+}
+
+void
+TimerWheel::link(uint32_t index)
+{
+  Timer& timer = m_timers[index];
+
+  // Timers beyond the range of the top level are parked in its farthest
+  // slot, and placed again by their real expiry when it cascades.
+  const uint64_t range = uint64_t(1) << (BITS_PER_LEVEL * N_LEVELS);
+  uint64_t placement = std::min(timer.expiry, m_currentTick + range - 1);
+  uint64_t diff = placement - m_currentTick;
+
+  int level = 0;
+  while (level < N_LEVELS - 1 && diff >= (uint64_t(1) << (BITS_PER_LEVEL * (level + 1)))) {
+    ++level;
+  }
+
+  uint32_t slot = level * SLOTS_PER_LEVEL +
+                  ((placement >> (BITS_PER_LEVEL * level)) & (SLOTS_PER_LEVEL - 1));
+
+  timer.slot = slot;
+  timer.prev = NONE;
+  timer.next = m_slots[slot];
+  if (timer.next != NONE) {
+    m_timers[timer.next].prev = index;
+  }
+  m_slots[slot] = index;
+}
+
+void
+TimerWheel::unlink(uint32_t index)
+{
+  Timer& timer = m_timers[index];
+
+  if (timer.prev != NONE) {
+    m_timers[timer.prev].next = timer.next;
+  }
+  else {
+    m_slots[timer.slot] = timer.next;
+  }
+
+  if (timer.next != NONE) {
+    m_timers[timer.next].prev = timer.prev;
+  }
+}
+
+TimerWheel::Callback
+TimerWheel::release(uint32_t index)
+{
+  Timer& timer = m_timers[index];
+
+  Callback callback;
+  callback.swap(timer.callback);
+
+  timer.slot = NONE;
+  ++timer.generation;
+  timer.next = m_freeList;
+  m_freeList = index;
+  --m_nTimers;
+
+  return callback;
+}
+
+void
+TimerWheel::advance()
+{
+  ++m_currentTick;
+
+  // Each level that has wrapped around hands the timers of its next
+  // slot down to the levels below, highest level first so that a timer
+  // can drop through more than one level in the same tick.
+  for (int level = N_LEVELS - 1; level > 0; --level) {
+    uint64_t mask = (uint64_t(1) << (BITS_PER_LEVEL * level)) - 1;
+    if ((m_currentTick & mask) != 0) {
+      continue;
+    }
+
+    uint32_t slot = level * SLOTS_PER_LEVEL +
+                    ((m_currentTick >> (BITS_PER_LEVEL * level)) & (SLOTS_PER_LEVEL - 1));
+    uint32_t index = m_slots[slot];
+    m_slots[slot] = NONE;
+
+    while (index != NONE) {
+      uint32_t next = m_timers[index].next;
+      link(index);
+      index = next;
+    }
+  }
+
+  // Timers are taken off the slot one at a time, as a callback may
+  // cancel others in the same slot.
+  uint32_t slot = m_currentTick & (SLOTS_PER_LEVEL - 1);
+  while (m_slots[slot] != NONE) {
+    uint32_t index = m_slots[slot];
+    unlink(index);
+    Callback callback = release(index);
+    callback();
+  }
+}
+
+} // namespace util
+} // namespace nlsr
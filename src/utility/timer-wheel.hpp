@@ -0,0 +1,170 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2017,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NLSR_TIMER_WHEEL_HPP
+#define NLSR_TIMER_WHEEL_HPP
+
+#include "common.hpp"
+#include "test-access-control.hpp"
+
+#include <ndn-cxx/util/scheduler.hpp>
+#include <ndn-cxx/util/time.hpp>
+
+#include <boost/noncopyable.hpp>
+
+#include <limits>
+#include <vector>
+
+namespace nlsr {
+namespace util {
+
+/*! \brief A hashed hierarchical timing wheel.
+
+  The wheel holds timers that need no more than a tick of precision,
+  such as LSA lifetimes. It has four levels of 64 slots; a timer is
+  kept in the slot of the lowest level that can hold its expiration
+  tick, and moves down a level each time the level below it wraps
+  around. Scheduling and cancelling a timer are O(1), whatever the
+  number of timers.
+
+  The wheel is driven by one scheduler event per tick, which fires all
+  of the timers due in that tick together. No event is scheduled while
+  the wheel is empty.
+ */
+class TimerWheel : boost::noncopyable
+{
+public:
+  typedef std::function<void()> Callback;
+
+  /*! \brief Identifies a scheduled timer.
+
+    An ID stays safe to cancel after its timer has fired or been
+    cancelled; cancelling it then does nothing.
+   */
+  class TimerId
+  {
+  public:
+    TimerId()
+      : m_index(std::numeric_limits<uint32_t>::max())
+      , m_generation(0)
+    {
+    }
+
+  private:
+    TimerId(uint32_t index, uint32_t generation)
+      : m_index(index)
+      , m_generation(generation)
+    {
+    }
+
+  private:
+    uint32_t m_index;
+    uint32_t m_generation;
+
+    friend class TimerWheel;
+  };
+
+  TimerWheel(ndn::Scheduler& scheduler, const ndn::time::milliseconds& tick);
+
+  ~TimerWheel();
+
+  /*! \brief Schedules a callback to be called after a delay.
+
+    The callback is called at the end of the first tick that ends at
+    least \p delay from now.
+   */
+  TimerId
+  schedule(const ndn::time::nanoseconds& delay, const Callback& callback);
+
+  void
+  cancel(const TimerId& id);
+
+  /*! \brief Returns the number of timers scheduled. */
+  size_t
+  size() const
+  {
+    return m_nTimers;
+  }
+
+PUBLIC_WITH_TESTS_ELSE_PRIVATE:
+  /*! \brief Fires the timers due up to now. */
+  void
+  onTick();
+
+private:
+  struct Timer
+  {
+    Callback callback;
+    uint64_t expiry;
+    uint32_t prev;
+    uint32_t next;
+    uint32_t slot;
+    uint32_t generation;
+  };
+
+  uint64_t
+  getElapsedTicks() const;
+
+  void
+  scheduleTick();
+
+  /*! \brief Adds a timer to the slot that its expiration tick falls in. */
+  void
+  link(uint32_t index);
+
+  void
+  unlink(uint32_t index);
+
+  /*! \brief Frees a timer and returns its callback. */
+  Callback
+  release(uint32_t index);
+
+  /*! \brief Moves on to the next tick, and fires the timers due in it. */
+  void
+  advance();
+
+private:
+  static const int BITS_PER_LEVEL;
+  static const uint32_t SLOTS_PER_LEVEL;
+  static const int N_LEVELS;
+  static const uint32_t NONE;
+
+  ndn::Scheduler& m_scheduler;
+  ndn::time::nanoseconds m_tick;
+  ndn::time::steady_clock::TimePoint m_startTime;
+  uint64_t m_currentTick;
+
+  // All of the timers, scheduled or free. A scheduled timer is in the
+  // doubly linked list of its slot, and a free timer in the free list.
+  std::vector<Timer> m_timers;
+  uint32_t m_freeList;
+  std::vector<uint32_t> m_slots;
+  size_t m_nTimers;
+
+  ndn::EventId m_tickEvent;
+  bool m_isTickScheduled;
+  bool m_isTicking;
+};
+
+} // namespace util
+} // namespace nlsr
+
+#endif // NLSR_TIMER_WHEEL_HPP
@@ -0,0 +1,224 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2017,  The University of Memphis,
+ *                           Regents of the University of California
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+/*! \file
+ * \brief Counts the heap allocations of a link-state routing table calculation.
+ *
+ * The whole multipath calculation is counted: building the adj. graph
+ * from the adj. LSAs in the LSDB and the Map, the shortest path
+ * calculation, and adding the next hops to the RoutingTable. The
+ * topology is a ring of routers, each also linked to the router
+ * halfway around.
+ *
+ * Once the routing table has entries for every destination, a
+ * recalculation must make the same number of allocations whatever the
+ * size of the network, never one per LSA, router or Adjacent. Filling
+ * an empty routing table allocates for each next hop it adds, and must
+ * do so at the same rate whatever the size of the network.
+ *
+ * The counting replaces the global operator new, which is why these
+ * tests are built into unit-tests-allocations, a test program of their
+ * own, rather than into unit-tests-nlsr.
+ */
+
+#define BOOST_TEST_MAIN 1
+#define BOOST_TEST_DYN_LINK 1
+
+#include "boost-test.hpp"
+#include "nlsr.hpp"
+#include "route/map.hpp"
+#include "route/routing-table.hpp"
+#include "route/routing-table-calculator.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#include <log4cxx/level.h>
+#include <ndn-cxx/util/dummy-client-face.hpp>
+
+namespace {
+
+std::atomic<bool> g_isCounting(false);
+std::atomic<size_t> g_nAllocations(0);
+
+} // anonymous namespace
+
+void*
+operator new(std::size_t size)
+{
+  if (g_isCounting) {
+    ++g_nAllocations;
+  }
+  void* p = std::malloc(size == 0 ? 1 : size);
+  if (p == nullptr) {
+    throw std::bad_alloc();
+  }
+  return p;
+}
+
+void
+operator delete(void* p) noexcept
+{
+  std::free(p);
+}
+
+namespace nlsr {
+namespace test {
+
+/*! \brief Counts the heap allocations made while it is alive. */
+class AllocationCounter
+{
+public:
+  AllocationCounter()
+  {
+    g_nAllocations = 0;
+    g_isCounting = true;
+  }
+
+  ~AllocationCounter()
+  {
+    g_isCounting = false;
+  }
+
+  size_t
+  get() const
+  {
+    return g_nAllocations;
+  }
+};
+
+struct Allocations
+{
+  // By a recalculation into a routing table that has every destination
+  size_t recalculation;
+  // By a calculation into an empty routing table, per next hop it adds
+  double perNextHop;
+};
+
+static ndn::Name
+makeRouterName(int32_t router)
+{
+  return ndn::Name("/ndn/site/%C1.Router").append("router" + std::to_string(router));
+}
+
+static ndn::util::FaceUri
+makeFaceUri(int32_t router)
+{
+  return ndn::util::FaceUri("udp4://10.0." + std::to_string(router / 256) + "." +
+                            std::to_string(router % 256));
+}
+
+static Allocations
+countAllocations(int32_t nRouters)
+{
+  boost::asio::io_service ioService;
+  ndn::Scheduler scheduler(ioService);
+  ndn::KeyChain keyChain("pib-memory:", "tpm-memory:");
+  ndn::util::DummyClientFace face(ioService, keyChain);
+  Nlsr nlsr(ioService, scheduler, face, keyChain);
+
+  ConfParameter& conf = nlsr.getConfParameter();
+  conf.setNetwork("/ndn");
+  conf.setSiteName("/site");
+  conf.setRouterName(ndn::Name("/%C1.Router").append("router0"));
+  conf.buildRouterPrefix();
+
+  // Ring links cost 10 and the links across the ring cost 25
+  for (int32_t router = 0; router < nRouters; ++router) {
+    AdjacencyList adjacencies;
+    for (int32_t offset : {1, nRouters - 1, nRouters / 2}) {
+      int32_t neighbor = (router + offset) % nRouters;
+      adjacencies.insert(Adjacent(makeRouterName(neighbor), makeFaceUri(neighbor),
+                                  offset == nRouters / 2 ? 25 : 10,
+                                  Adjacent::STATUS_ACTIVE, 0, 0));
+    }
+    if (router == 0) {
+      nlsr.getAdjacencyList() = adjacencies;
+    }
+    nlsr.getLsdb().installAdjLsa(AdjLsa(makeRouterName(router), 1,
+                                        ndn::time::system_clock::TimePoint::max(),
+                                        adjacencies.size(), adjacencies));
+  }
+
+  Map map;
+  map.createFromAdjLsdb(nlsr.getLsdb().getAdjLsdb().begin(), nlsr.getLsdb().getAdjLsdb().end());
+  LinkStateRoutingTableCalculator calculator(map.getMapSize());
+
+  // An earlier calculation has sized the storage of the calculator
+  RoutingTable routingTable(scheduler);
+  calculator.calculatePath(map, routingTable, nlsr);
+
+  size_t nNextHops = 0;
+  for (int32_t router = 1; router < nRouters; ++router) {
+    RoutingTableEntry* entry = routingTable.findRoutingTableEntry(makeRouterName(router));
+    nNextHops += entry == nullptr ? 0 : entry->getNexthopList().size();
+  }
+
+  Allocations allocations;
+  {
+    AllocationCounter counter;
+    calculator.calculatePath(map, routingTable, nlsr);
+    allocations.recalculation = counter.get();
+  }
+
+  RoutingTable emptyRoutingTable(scheduler);
+  {
+    AllocationCounter counter;
+    calculator.calculatePath(map, emptyRoutingTable, nlsr);
+    allocations.perNextHop = static_cast<double>(counter.get() - allocations.recalculation) /
+                             nNextHops;
+  }
+  return allocations;
+}
+
+class AllocationsFixture
+{
+public:
+  AllocationsFixture()
+  {
+    // Log statements that are not logged do not allocate
+    log4cxx::Logger::getRootLogger()->setLevel(log4cxx::Level::getWarn());
+  }
+};
+
+BOOST_FIXTURE_TEST_SUITE(TestRouteCalculationAllocations, AllocationsFixture)
+
+BOOST_AUTO_TEST_CASE(RecalculationDoesNotGrowWithNetwork)
+{
+  Allocations small = countAllocations(100);
+  Allocations large = countAllocations(1000);
+
+  BOOST_CHECK_EQUAL(small.recalculation, large.recalculation);
+}
+
+BOOST_AUTO_TEST_CASE(FillingGrowsWithNextHopsOnly)
+{
+  Allocations small = countAllocations(100);
+  Allocations large = countAllocations(1000);
+
+  // The index of the routing table is rehashed a few more times as it grows
+  BOOST_CHECK_SMALL(small.perNextHop - large.perNextHop, 0.1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace test
+} // namespace nlsr
@@ -0,0 +1,153 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2017,  The University of Memphis,
+ *                           Regents of the University of California
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+/*! \file
+ * \brief Compares the hyperbolic distance calculation of CoordinateCache
+ *        with the per-pair calculation that NLSR used before it.
+ *
+ * Each calculation computes the distance from 32 neighbors to every
+ * router, as HyperbolicRoutingCalculator does. The coordinates are
+ * random, with one or two angles.
+ */
+
+#include "route/coordinate-cache.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+
+namespace nlsr {
+namespace bench {
+
+static const size_t N_NEIGHBORS = 32;
+
+struct Coordinates
+{
+  double radius;
+  std::vector<double> angles;
+};
+
+/*! \brief The distance as HyperbolicRoutingCalculator calculated it
+  before CoordinateCache, taking the angle vectors by value.
+ */
+static double
+calculateAngularDistance(std::vector<double> angleVectorI, std::vector<double> angleVectorJ)
+{
+  double innerProduct = 0.0;
+  double x0i = std::cos(angleVectorI[0]);
+  double x0j = std::cos(angleVectorJ[0]);
+  double xni = std::sin(angleVectorI[angleVectorI.size() - 1]);
+  double xnj = std::sin(angleVectorJ[angleVectorJ.size() - 1]);
+  for (unsigned int k = 0; k < angleVectorI.size() - 1; k++) {
+    xni *= std::sin(angleVectorI[k]);
+    xnj *= std::sin(angleVectorJ[k]);
+  }
+  innerProduct += (x0i * x0j) + (xni * xnj);
+  for (unsigned int m = 1; m < angleVectorI.size(); m++) {
+    double xmi = std::cos(angleVectorI[m]);
+    double xmj = std::cos(angleVectorJ[m]);
+    for (unsigned int l = 0; l < m; l++) {
+      xmi *= std::sin(angleVectorI[l]);
+      xmj *= std::sin(angleVectorJ[l]);
+    }
+    innerProduct += xmi * xmj;
+  }
+  return std::acos(innerProduct);
+}
+
+static double
+legacyDistance(const Coordinates& src, const Coordinates& dest)
+{
+  std::vector<double> srcTheta = src.angles;
+  std::vector<double> destTheta = dest.angles;
+  double deltaTheta = calculateAngularDistance(srcTheta, destTheta);
+  return std::acosh(std::cosh(src.radius) * std::cosh(dest.radius) -
+                    std::sinh(src.radius) * std::sinh(dest.radius) * std::cos(deltaTheta));
+}
+
+static int
+main()
+{
+  std::cout << "routers\tangles\tlegacy (us)\tcache (us)\tspeedup" << std::endl;
+
+  for (size_t nAngles : {1, 2}) {
+    for (size_t nRouters : {1000, 10000}) {
+      std::mt19937 rng(1);
+      std::uniform_real_distribution<double> radiusDist(10, 20);
+      std::uniform_real_distribution<double> angleDist(0.1, 3.0);
+
+      std::vector<Coordinates> routers(nRouters);
+      CoordinateCache cache;
+      for (size_t i = 0; i < nRouters; ++i) {
+        routers[i].radius = radiusDist(rng);
+        for (size_t k = 0; k < nAngles; ++k) {
+          routers[i].angles.push_back(angleDist(rng));
+        }
+        cache.insert(ndn::Name("/router").appendNumber(i), routers[i].radius, routers[i].angles);
+      }
+
+      std::vector<double> legacyDistances(nRouters);
+      auto start = std::chrono::steady_clock::now();
+      for (size_t src = 0; src < N_NEIGHBORS; ++src) {
+        for (size_t dest = 0; dest < nRouters; ++dest) {
+          if (dest != src) {
+            legacyDistances[dest] = legacyDistance(routers[src], routers[dest]);
+          }
+        }
+      }
+      std::chrono::duration<double, std::micro> legacyTime = std::chrono::steady_clock::now() - start;
+
+      std::vector<double> distances;
+      start = std::chrono::steady_clock::now();
+      for (size_t src = 0; src < N_NEIGHBORS; ++src) {
+        cache.calculateDistances(*cache.find(ndn::Name("/router").appendNumber(src)), distances);
+      }
+      std::chrono::duration<double, std::micro> cacheTime = std::chrono::steady_clock::now() - start;
+
+      // Both calculations must agree on the distances from the last neighbor
+      size_t lastSrc = N_NEIGHBORS - 1;
+      for (size_t dest = 0; dest < nRouters; ++dest) {
+        if (dest == lastSrc) {
+          continue;
+        }
+        double distance = distances[*cache.find(ndn::Name("/router").appendNumber(dest))];
+        if (std::abs(distance - legacyDistances[dest]) > 1e-6 * legacyDistances[dest]) {
+          std::cerr << "Distance mismatch for router " << dest << std::endl;
+          return 1;
+        }
+      }
+
+      std::cout << nRouters << "\t" << nAngles << "\t" << legacyTime.count() << "\t"
+                << cacheTime.count() << "\t" << legacyTime.count() / cacheTime.count() << std::endl;
+    }
+  }
+
+  return 0;
+}
+
+} // namespace bench
+} // namespace nlsr
+
+int
+main()
+{
+  return nlsr::bench::main();
+}
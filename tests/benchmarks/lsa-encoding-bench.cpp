@@ -0,0 +1,132 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2017,  The University of Memphis,
+ *                           Regents of the University of California
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+/*! \file
+ * \brief Compares the TLV encoding of LSA content with the text serialization
+ *        that NLSR used before it.
+ *
+ * For name LSAs of increasing size and for an adj. LSA of a router with
+ * many neighbors, reports the size of each encoding and the time to
+ * encode and decode one LSA.
+ */
+
+#include "lsa.hpp"
+
+#include <chrono>
+#include <functional>
+#include <iostream>
+
+namespace nlsr {
+namespace bench {
+
+static double
+timeMicroseconds(const std::function<void()>& f, int nRepeats)
+{
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < nRepeats; ++i) {
+    f();
+  }
+  std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+  return elapsed.count() / nRepeats;
+}
+
+template<typename T>
+static bool
+compare(const std::string& label, const T& lsa, int nRepeats)
+{
+  std::string text = lsa.serialize();
+  ndn::Block wire = lsa.wireEncode();
+
+  double textEncode = timeMicroseconds([&] { lsa.serialize(); }, nRepeats);
+  double tlvEncode = timeMicroseconds([&] { lsa.wireEncode(); }, nRepeats);
+
+  double textDecode = timeMicroseconds([&] {
+      T decoded;
+      decoded.deserialize(text);
+    }, nRepeats);
+  double tlvDecode = timeMicroseconds([&] {
+      T decoded;
+      decoded.decodeContent(wire.wire(), wire.size());
+    }, nRepeats);
+
+  // Both encodings must decode to the same LSA
+  T fromText;
+  T fromWire;
+  if (!fromText.deserialize(text) || !fromWire.decodeContent(wire.wire(), wire.size()) ||
+      fromText.serialize() != fromWire.serialize()) {
+    std::cerr << "Decoding mismatch for " << label << std::endl;
+    return false;
+  }
+
+  std::cout << label << "\t"
+            << text.size() << "\t" << wire.size() << "\t"
+            << textEncode << "\t" << tlvEncode << "\t"
+            << textDecode << "\t" << tlvDecode << std::endl;
+  return true;
+}
+
+static int
+main()
+{
+  // Whole milliseconds, which is what the TLV encoding keeps
+  ndn::time::system_clock::TimePoint expiration =
+    ndn::time::fromUnixTimestamp(ndn::time::toUnixTimestamp(ndn::time::system_clock::now()));
+
+  std::cout << "lsa\ttext (B)\ttlv (B)\ttext enc (us)\ttlv enc (us)\t"
+            << "text dec (us)\ttlv dec (us)" << std::endl;
+
+  for (int nNames : {10, 100, 1000}) {
+    NamePrefixList names;
+    for (int i = 0; i < nNames; ++i) {
+      names.insert(ndn::Name("/ndn/edu/site/prefix").appendNumber(i));
+    }
+    NameLsa lsa("/ndn/edu/site/%C1.Router/router", 1, expiration, names);
+
+    if (!compare("name x" + std::to_string(nNames), lsa, nNames >= 1000 ? 100 : 1000)) {
+      return 1;
+    }
+  }
+
+  AdjacencyList adjacencies;
+  for (int i = 0; i < 64; ++i) {
+    Adjacent adjacent(ndn::Name("/ndn/edu/site/%C1.Router").appendNumber(i),
+                      ndn::util::FaceUri("udp4://10.0." + std::to_string(i / 256) + "." +
+                                         std::to_string(i % 256) + ":6363"),
+                      10 + i, Adjacent::STATUS_ACTIVE, 0, 0);
+    adjacencies.insert(adjacent);
+  }
+  AdjLsa adjLsa("/ndn/edu/site/%C1.Router/router", 1, expiration,
+                adjacencies.size(), adjacencies);
+
+  if (!compare("adj x64", adjLsa, 1000)) {
+    return 1;
+  }
+
+  return 0;
+}
+
+} // namespace bench
+} // namespace nlsr
+
+int
+main()
+{
+  return nlsr::bench::main();
+}
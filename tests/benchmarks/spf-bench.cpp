@@ -0,0 +1,258 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2017,  The University of Memphis,
+ *                           Regents of the University of California
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+/*! \file
+ * \brief Compares the heap-based ShortestPathCalculator with the
+ *        exchange-sort queue Dijkstra that NLSR used before it.
+ *
+ * The topologies are synthetic: a ring, so that every router is
+ * reachable, plus random chords for an average degree of about 4.
+ *
+ * Usage: spf-bench [--with-legacy-10k]
+ * The legacy calculation is O(N^3) and is skipped at 10k routers
+ * unless requested.
+ *
+ * A second table compares the multipath sweep with one calculation per
+ * neighbor, at a source that is given 32 and 64 extra neighbors.
+ */
+
+#include "route/adjacency-graph.hpp"
+#include "route/shortest-path-calculator.hpp"
+
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <random>
+
+namespace nlsr {
+namespace bench {
+
+static AdjacencyGraph
+makeTopology(size_t nRouters, unsigned int seed, size_t nHubNeighbors = 0)
+{
+  std::mt19937 rng(seed);
+  std::uniform_int_distribution<int32_t> routerDist(0, nRouters - 1);
+  std::uniform_int_distribution<int> costDist(1, 100);
+
+  std::vector<AdjacencyGraph::Link> links;
+  auto addLink = [&links] (int32_t a, int32_t b, double cost) {
+    links.push_back({a, b, cost});
+    links.push_back({b, a, cost});
+  };
+
+  for (size_t i = 0; i < nRouters; ++i) {
+    addLink(i, (i + 1) % nRouters, costDist(rng));
+  }
+  for (size_t i = 0; i < nRouters; ++i) {
+    int32_t other = routerDist(rng);
+    if (other != static_cast<int32_t>(i)) {
+      addLink(i, other, costDist(rng));
+    }
+  }
+  // Router 0 is linked to routers spread evenly around the ring
+  for (size_t i = 0; i < nHubNeighbors; ++i) {
+    addLink(0, 2 + i * (nRouters - 2) / nHubNeighbors, costDist(rng));
+  }
+
+  AdjacencyGraph graph;
+  graph.build(nRouters, links);
+  return graph;
+}
+
+static const double INF_DISTANCE = 2147483647;
+
+/*! \brief The Dijkstra's calculation that NLSR used before ShortestPathCalculator.
+
+  The queue is re-sorted with an exchange sort after every pop and
+  every candidate link is checked against the queue with a linear scan.
+ */
+class LegacyDijkstra
+{
+public:
+  void
+  calculate(const AdjacencyGraph& graph, int32_t source)
+  {
+    int n = graph.getNRouters();
+    m_parent.assign(n, -1);
+    m_distance.assign(n, INF_DISTANCE);
+    std::vector<int> queue(n);
+    for (int i = 0; i < n; ++i) {
+      queue[i] = i;
+    }
+
+    int head = 0;
+    m_distance[source] = 0;
+    sortQueueByDistance(queue, head);
+    while (head < n) {
+      int u = queue[head];
+      if (m_distance[u] == INF_DISTANCE) {
+        break;
+      }
+      for (size_t link = graph.linksBegin(u); link < graph.linksEnd(u); ++link) {
+        int v = graph.getLinkTarget(link);
+        if (isNotExplored(queue, v, head + 1) &&
+            m_distance[u] + graph.getLinkCost(link) < m_distance[v]) {
+          m_distance[v] = m_distance[u] + graph.getLinkCost(link);
+          m_parent[v] = u;
+        }
+      }
+      head++;
+      sortQueueByDistance(queue, head);
+    }
+  }
+
+  double
+  getDistance(int32_t router) const
+  {
+    return m_distance[router];
+  }
+
+private:
+  void
+  sortQueueByDistance(std::vector<int>& queue, int start)
+  {
+    for (size_t i = start; i < queue.size(); i++) {
+      for (size_t j = i + 1; j < queue.size(); j++) {
+        if (m_distance[queue[j]] < m_distance[queue[i]]) {
+          std::swap(queue[i], queue[j]);
+        }
+      }
+    }
+  }
+
+  static bool
+  isNotExplored(const std::vector<int>& queue, int u, int start)
+  {
+    for (size_t i = start; i < queue.size(); i++) {
+      if (queue[i] == u) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+private:
+  std::vector<int> m_parent;
+  std::vector<double> m_distance;
+};
+
+template<typename Calculator>
+static double
+timeCalculation(Calculator& calculator, const AdjacencyGraph& graph, int nRepeats)
+{
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < nRepeats; ++i) {
+    calculator.calculate(graph, i % graph.getNRouters());
+  }
+  std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+  return elapsed.count() / nRepeats;
+}
+
+static int
+main(int argc, char** argv)
+{
+  bool withLegacy10k = argc > 1 && std::strcmp(argv[1], "--with-legacy-10k") == 0;
+
+  std::cout << "routers\tlinks\theap (us)\tlegacy (us)\tspeedup" << std::endl;
+
+  for (size_t nRouters : {100, 1000, 10000}) {
+    AdjacencyGraph graph = makeTopology(nRouters, 1);
+
+    ShortestPathCalculator spf;
+    double heapTime = timeCalculation(spf, graph, nRouters >= 10000 ? 20 : 100);
+
+    std::cout << nRouters << "\t" << graph.getNLinks() << "\t" << heapTime << "\t";
+
+    if (nRouters >= 10000 && !withLegacy10k) {
+      std::cout << "skipped\t-" << std::endl;
+      continue;
+    }
+
+    LegacyDijkstra legacy;
+    double legacyTime = timeCalculation(legacy, graph, nRouters >= 1000 ? 1 : 10);
+
+    // Both calculations must agree on the distances
+    spf.calculate(graph, 0);
+    legacy.calculate(graph, 0);
+    for (size_t i = 0; i < nRouters; ++i) {
+      if (spf.getDistance(i) != legacy.getDistance(i)) {
+        std::cerr << "Distance mismatch for router " << i << std::endl;
+        return 1;
+      }
+    }
+
+    std::cout << legacyTime << "\t" << legacyTime / heapTime << "x" << std::endl;
+  }
+
+  std::cout << std::endl
+            << "routers\tneighbors\tsweep (us)\tper neighbor (us)\tspeedup" << std::endl;
+
+  for (size_t nRouters : {1000, 10000}) {
+    for (size_t nHubNeighbors : {32, 64}) {
+      AdjacencyGraph graph = makeTopology(nRouters, 1, nHubNeighbors);
+      int nRepeats = nRouters >= 10000 ? 5 : 20;
+
+      ShortestPathCalculator sweep;
+      auto start = std::chrono::steady_clock::now();
+      for (int i = 0; i < nRepeats; ++i) {
+        sweep.calculateMultipath(graph, 0);
+      }
+      std::chrono::duration<double, std::micro> sweepTime = std::chrono::steady_clock::now() - start;
+
+      ShortestPathCalculator perNeighbor;
+      start = std::chrono::steady_clock::now();
+      for (int i = 0; i < nRepeats; ++i) {
+        for (size_t index = 0; index < sweep.getNumOfFirstHops(); ++index) {
+          perNeighbor.calculate(graph, 0, sweep.getFirstHop(index));
+        }
+      }
+      std::chrono::duration<double, std::micro> perNeighborTime =
+        std::chrono::steady_clock::now() - start;
+
+      // The sweep must find the same distance through every neighbor
+      for (size_t index = 0; index < sweep.getNumOfFirstHops(); ++index) {
+        perNeighbor.calculate(graph, 0, sweep.getFirstHop(index));
+        for (size_t i = 1; i < nRouters; ++i) {
+          if (sweep.getDistanceThrough(index, i) != perNeighbor.getDistance(i)) {
+            std::cerr << "Distance mismatch for router " << i << " through first hop "
+                      << sweep.getFirstHop(index) << std::endl;
+            return 1;
+          }
+        }
+      }
+
+      std::cout << nRouters << "\t" << sweep.getNumOfFirstHops() << "\t"
+                << sweepTime.count() / nRepeats << "\t"
+                << perNeighborTime.count() / nRepeats << "\t"
+                << perNeighborTime.count() / sweepTime.count() << "x" << std::endl;
+    }
+  }
+
+  return 0;
+}
+
+} // namespace bench
+} // namespace nlsr
+
+int
+main(int argc, char** argv)
+{
+  return nlsr::bench::main(argc, argv);
+}
@@ -0,0 +1,101 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2017,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+/*! \file
+ * \brief Compares the cost of keeping LSA lifetimes in TimerWheel with
+ *        keeping them as ndn::Scheduler events, as Lsdb did before.
+ *
+ * Each run schedules one timer per LSA, then updates every LSA once by
+ * cancelling its timer and scheduling a new one. The lifetimes are
+ * random, between the default refresh time and router dead interval.
+ */
+
+#include "utility/timer-wheel.hpp"
+
+#include <boost/asio/io_service.hpp>
+
+#include <chrono>
+#include <iostream>
+#include <random>
+
+namespace nlsr {
+namespace bench {
+
+static int
+main()
+{
+  std::cout << "lsas\tscheduler (ms)\twheel (ms)\tspeedup" << std::endl;
+
+  for (size_t nLsas : {10000, 100000, 500000}) {
+    std::mt19937 rng(1);
+    std::uniform_int_distribution<int> lifetimeDist(1800, 3600);
+    std::vector<ndn::time::seconds> lifetimes(2 * nLsas);
+    for (ndn::time::seconds& lifetime : lifetimes) {
+      lifetime = ndn::time::seconds(lifetimeDist(rng));
+    }
+
+    boost::asio::io_service ioService;
+    ndn::Scheduler scheduler(ioService);
+
+    std::vector<ndn::EventId> events(nLsas);
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < nLsas; ++i) {
+      events[i] = scheduler.scheduleEvent(lifetimes[i], [] {});
+    }
+    for (size_t i = 0; i < nLsas; ++i) {
+      scheduler.cancelEvent(events[i]);
+      events[i] = scheduler.scheduleEvent(lifetimes[nLsas + i], [] {});
+    }
+    std::chrono::duration<double, std::milli> schedulerTime = std::chrono::steady_clock::now() - start;
+    scheduler.cancelAllEvents();
+
+    util::TimerWheel wheel(scheduler, ndn::time::seconds(1));
+    std::vector<util::TimerWheel::TimerId> timers(nLsas);
+    start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < nLsas; ++i) {
+      timers[i] = wheel.schedule(lifetimes[i], [] {});
+    }
+    for (size_t i = 0; i < nLsas; ++i) {
+      wheel.cancel(timers[i]);
+      timers[i] = wheel.schedule(lifetimes[nLsas + i], [] {});
+    }
+    std::chrono::duration<double, std::milli> wheelTime = std::chrono::steady_clock::now() - start;
+
+    if (wheel.size() != nLsas) {
+      std::cerr << "Wheel holds " << wheel.size() << " timers, expected " << nLsas << std::endl;
+      return 1;
+    }
+
+    std::cout << nLsas << "\t" << schedulerTime.count() << "\t" << wheelTime.count() << "\t"
+              << schedulerTime.count() / wheelTime.count() << std::endl;
+  }
+
+  return 0;
+}
+
+} // namespace bench
+} // namespace nlsr
+
+int
+main()
+{
+  return nlsr::bench::main();
+}
@@ -47,6 +47,17 @@ MockLsa::deserialize(const std::string& content) noexcept
   return true;
 }
 
+ndn::Block
+MockLsa::wireEncode() const
+{
+  return ndn::Block();
+}
+
+void
+MockLsa::wireDecode(const ndn::Block& wire)
+{
+}
+
 void
 MockLsa::writeLog() const
 {
@@ -44,6 +44,12 @@ public:
   bool
   deserialize(const std::string& content) noexcept override;
 
+  ndn::Block
+  wireEncode() const override;
+
+  void
+  wireDecode(const ndn::Block& wire) override;
+
   void
   writeLog() const override;
 };
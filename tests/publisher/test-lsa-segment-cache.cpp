@@ -0,0 +1,137 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2017,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "publisher/lsa-segment-cache.hpp"
+#include "tests/test-common.hpp"
+
+#include "../boost-test.hpp"
+
+#include <ndn-cxx/encoding/block-helpers.hpp>
+#include <ndn-cxx/encoding/tlv.hpp>
+
+namespace nlsr {
+namespace test {
+
+class TestLsaPublisher : public LsaSegmentCache::Publisher
+{
+public:
+  TestLsaPublisher(ndn::Face& face, ndn::KeyChain& keyChain)
+    : LsaSegmentCache::Publisher(face, keyChain, ndn::time::seconds(10))
+  {
+  }
+
+protected:
+  virtual size_t
+  generate(ndn::EncodingBuffer& outBuffer)
+  {
+    return prependNonNegativeIntegerBlock(outBuffer, ndn::tlv::Content, 1);
+  }
+};
+
+class LsaSegmentCacheFixture : public UnitTestTimeFixture
+{
+public:
+  LsaSegmentCacheFixture()
+    : face(g_ioService)
+    , cache(2)
+  {
+  }
+
+  void
+  insert(const ndn::Name& lsaKey, uint64_t seqNo)
+  {
+    auto publisher = std::make_shared<TestLsaPublisher>(face, g_keyChain);
+    publisher->publishFirstSegment(ndn::Name(lsaKey).appendNumber(seqNo));
+    cache.insert(lsaKey, seqNo, ndn::Name(lsaKey).appendNumber(seqNo), std::move(publisher));
+  }
+
+public:
+  ndn::util::DummyClientFace face;
+  LsaSegmentCache cache;
+};
+
+BOOST_FIXTURE_TEST_SUITE(PublisherTestLsaSegmentCache, LsaSegmentCacheFixture)
+
+BOOST_AUTO_TEST_CASE(FindVersion)
+{
+  insert("/router1/NAME", 1);
+
+  LsaSegmentCache::Publisher* publisher = cache.find("/router1/NAME", 1, "/router1/NAME/%01");
+  BOOST_REQUIRE(publisher != nullptr);
+  BOOST_CHECK(cache.findVersion("/router1/NAME", publisher->getVersionedPrefix()) == publisher);
+  BOOST_CHECK(cache.findVersion("/router1/NAME", "/router1/NAME/%01") == nullptr);
+
+  BOOST_CHECK(cache.find("/router1/NAME", 2, "/router1/NAME/%02") == nullptr);
+  BOOST_CHECK_EQUAL(cache.getNHits(), 1);
+  BOOST_CHECK_EQUAL(cache.getNMisses(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(ExpireAfterFreshnessPeriod)
+{
+  insert("/router1/NAME", 1);
+
+  // Using an entry keeps it for another freshness period
+  advanceClocks(ndn::time::seconds(6));
+  BOOST_CHECK(cache.find("/router1/NAME", 1, "/router1/NAME/%01") != nullptr);
+  advanceClocks(ndn::time::seconds(6));
+  BOOST_CHECK(cache.find("/router1/NAME", 1, "/router1/NAME/%01") != nullptr);
+
+  advanceClocks(ndn::time::seconds(10));
+  BOOST_CHECK(cache.find("/router1/NAME", 1, "/router1/NAME/%01") == nullptr);
+  BOOST_CHECK_EQUAL(cache.size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(EvictLeastRecentlyUsed)
+{
+  insert("/router1/NAME", 1);
+  advanceClocks(ndn::time::seconds(1));
+  insert("/router2/NAME", 1);
+  advanceClocks(ndn::time::seconds(1));
+
+  // A new version replaces the old one without evicting another LSA
+  insert("/router2/NAME", 2);
+  BOOST_CHECK_EQUAL(cache.size(), 2);
+
+  insert("/router3/NAME", 1);
+  BOOST_CHECK_EQUAL(cache.size(), 2);
+  BOOST_CHECK(cache.find("/router1/NAME", 1, "/router1/NAME/%01") == nullptr);
+  BOOST_CHECK(cache.find("/router2/NAME", 2, "/router2/NAME/%02") != nullptr);
+  BOOST_CHECK(cache.find("/router3/NAME", 1, "/router3/NAME/%01") != nullptr);
+
+  // Using an entry keeps it over one that was inserted after it
+  advanceClocks(ndn::time::seconds(1));
+  BOOST_CHECK(cache.find("/router2/NAME", 2, "/router2/NAME/%02") != nullptr);
+  insert("/router4/NAME", 1);
+  BOOST_CHECK(cache.find("/router3/NAME", 1, "/router3/NAME/%01") == nullptr);
+  BOOST_CHECK(cache.find("/router2/NAME", 2, "/router2/NAME/%02") != nullptr);
+  BOOST_CHECK(cache.find("/router4/NAME", 1, "/router4/NAME/%01") != nullptr);
+
+  cache.erase("/router2/NAME");
+  BOOST_CHECK_EQUAL(cache.size(), 1);
+  insert("/router5/NAME", 1);
+  BOOST_CHECK_EQUAL(cache.size(), 2);
+  BOOST_CHECK(cache.find("/router4/NAME", 1, "/router4/NAME/%01") != nullptr);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace test
+} // namespace nlsr
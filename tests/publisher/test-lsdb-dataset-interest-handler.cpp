@@ -140,6 +140,118 @@ BOOST_AUTO_TEST_CASE(Routername)
     [] (const ndn::Block& block) { return block.type() == ndn::tlv::nlsr::LsdbStatus; });
 }
 
+BOOST_AUTO_TEST_CASE(CachedUntilLsdbChanges)
+{
+  LsdbDatasetInterestHandler& handler = nlsr.getLsdbDatasetHandler();
+
+  NameLsa nameLsaA;
+  nameLsaA.setOrigRouter("/RouterA");
+  nameLsaA.addName("/RouterA/name1");
+  lsdb.installNameLsa(nameLsaA);
+
+  face.receive(ndn::Interest(ndn::Name("/localhost/nlsr/lsdb").append("names")));
+  processDatasetInterest(face,
+    [] (const ndn::Block& block) { return block.type() == ndn::tlv::nlsr::NameLsa; });
+
+  BOOST_CHECK(handler.isCurrent(handler.m_nameDataset));
+  BOOST_CHECK_EQUAL(handler.m_nameDataset.generation, lsdb.getGeneration());
+  const uint8_t* cachedWire = handler.m_nameDataset.blocks.at(0).wire();
+
+  // The LSDB has not changed, so the cached encoding is served
+  face.receive(ndn::Interest(ndn::Name("/localhost/nlsr/lsdb").append("names")));
+  processDatasetInterest(face,
+    [] (const ndn::Block& block) { return block.type() == ndn::tlv::nlsr::NameLsa; });
+  BOOST_CHECK(handler.m_nameDataset.blocks.at(0).wire() == cachedWire);
+
+  NameLsa nameLsaB;
+  nameLsaB.setOrigRouter("/RouterB");
+  nameLsaB.addName("/RouterB/name1");
+  lsdb.installNameLsa(nameLsaB);
+  BOOST_CHECK(!handler.isCurrent(handler.m_nameDataset));
+
+  face.receive(ndn::Interest(ndn::Name("/localhost/nlsr/lsdb").append("names")));
+  face.processEvents(ndn::time::milliseconds(30));
+  BOOST_REQUIRE_EQUAL(face.sentData.size(), 1);
+
+  ndn::Block parser(face.sentData[0].getContent());
+  parser.parse();
+  BOOST_CHECK_EQUAL(parser.elements_size(), 2);
+  BOOST_CHECK(handler.isCurrent(handler.m_nameDataset));
+  face.sentData.clear();
+
+  lsdb.removeNameLsa(nameLsaB.getKey());
+  BOOST_CHECK(!handler.isCurrent(handler.m_nameDataset));
+
+  face.receive(ndn::Interest(ndn::Name("/localhost/nlsr/lsdb").append("names")));
+  processDatasetInterest(face,
+    [] (const ndn::Block& block) { return block.type() == ndn::tlv::nlsr::NameLsa; });
+}
+
+BOOST_AUTO_TEST_CASE(Changes)
+{
+  uint64_t epoch = lsdb.getChangeLog().getEpoch();
+  uint64_t lastSeen = lsdb.getGeneration();
+
+  NameLsa nameLsa;
+  nameLsa.setOrigRouter("/RouterA");
+  nameLsa.addName("/RouterA/name1");
+  lsdb.installNameLsa(nameLsa);
+  lsdb.removeNameLsa(nameLsa.getKey());
+
+  face.receive(ndn::Interest(ndn::Name("/localhost/nlsr/lsdb/changes")
+                               .appendNumber(epoch).appendSequenceNumber(lastSeen)));
+  face.processEvents(ndn::time::milliseconds(30));
+  BOOST_REQUIRE_EQUAL(face.sentData.size(), 1);
+
+  ndn::Block parser(face.sentData[0].getContent());
+  parser.parse();
+  BOOST_REQUIRE_EQUAL(parser.elements_size(), 2);
+
+  tlv::LsdbChange installed(parser.elements()[0]);
+  BOOST_CHECK_EQUAL(installed.getEpoch(), epoch);
+  BOOST_CHECK_EQUAL(installed.getChangeSequenceNumber(), lastSeen + 1);
+  BOOST_CHECK(installed.getKind() == LsdbChange::Kind::INSTALLED);
+  BOOST_CHECK_EQUAL(installed.getLsaType(), Lsa::Type::NAME);
+  BOOST_CHECK_EQUAL(installed.getOriginRouter(), "/RouterA");
+
+  tlv::LsdbChange removed(parser.elements()[1]);
+  BOOST_CHECK_EQUAL(removed.getChangeSequenceNumber(), lastSeen + 2);
+  BOOST_CHECK(removed.getKind() == LsdbChange::Kind::REMOVED);
+  face.sentData.clear();
+
+  // Only the changes after the last one seen are returned
+  face.receive(ndn::Interest(ndn::Name("/localhost/nlsr/lsdb/changes")
+                               .appendNumber(epoch).appendSequenceNumber(lastSeen + 1)));
+  face.processEvents(ndn::time::milliseconds(30));
+  BOOST_REQUIRE_EQUAL(face.sentData.size(), 1);
+  parser = face.sentData[0].getContent();
+  parser.parse();
+  BOOST_REQUIRE_EQUAL(parser.elements_size(), 1);
+  BOOST_CHECK_EQUAL(tlv::LsdbChange(parser.elements()[0]).getChangeSequenceNumber(),
+                    lastSeen + 2);
+  face.sentData.clear();
+
+  // A consumer that saw changes before NLSR restarted gets all those kept
+  face.receive(ndn::Interest(ndn::Name("/localhost/nlsr/lsdb/changes")
+                               .appendNumber(epoch + 1).appendSequenceNumber(lastSeen + 1)));
+  face.processEvents(ndn::time::milliseconds(30));
+  BOOST_REQUIRE_EQUAL(face.sentData.size(), 1);
+  parser = face.sentData[0].getContent();
+  parser.parse();
+  BOOST_CHECK_EQUAL(parser.elements_size(), lsdb.getChangeLog().getChanges().size());
+  face.sentData.clear();
+
+  // The sequence number is not accepted without the epoch
+  face.receive(ndn::Interest(ndn::Name("/localhost/nlsr/lsdb/changes")
+                               .appendSequenceNumber(lastSeen)));
+  face.processEvents(ndn::time::milliseconds(30));
+  checkErrorResponse(face, 400);
+
+  face.receive(ndn::Interest(ndn::Name("/localhost/nlsr/lsdb/changes").append("bad")));
+  face.processEvents(ndn::time::milliseconds(30));
+  checkErrorResponse(face, 400);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace test
@@ -164,6 +164,39 @@ BOOST_FIXTURE_TEST_CASE_TEMPLATE(Generate, T, DatasetSizes, SegmentPublisherFixt
   }
 }
 
+BOOST_FIXTURE_TEST_CASE_TEMPLATE(PublishFirstSegment, T, DatasetSizes, SegmentPublisherFixture<T::value>)
+{
+  this->m_publisher.publishFirstSegment(this->m_publishingPrefix);
+  this->m_face->processEvents();
+
+  // Only the first segment is put, and the payload is generated once
+  BOOST_REQUIRE_EQUAL(this->m_face->sentData.size(), 1);
+  const ndn::Data& firstSegment = this->m_face->sentData[0];
+  BOOST_CHECK_EQUAL(firstSegment.getName().getPrefix(-1),
+                    this->m_publisher.getVersionedPrefix());
+  BOOST_CHECK(this->m_publisher.getSegment(0)->wireEncode() == firstSegment.wireEncode());
+  this->validate(firstSegment);
+
+  uint64_t segmentNo = 1;
+  for (std::shared_ptr<ndn::Data> data = this->m_publisher.getSegment(segmentNo);
+       data != nullptr;
+       data = this->m_publisher.getSegment(++segmentNo)) {
+    BOOST_CHECK_EQUAL(data->getName()[-1].toSegment(), segmentNo);
+    // A segment is signed once, however often it is asked for
+    BOOST_CHECK(this->m_publisher.getSegment(segmentNo) == data);
+    this->validate(*data);
+  }
+
+  size_t nSegments = this->m_publisher.getTotalPayloadLength() /
+                     this->m_publisher.getMaxSegmentSize();
+  if (this->m_publisher.getTotalPayloadLength() % this->m_publisher.getMaxSegmentSize() != 0 ||
+      nSegments == 0)
+    ++nSegments;
+
+  BOOST_CHECK_EQUAL(segmentNo, nSegments);
+  BOOST_CHECK_EQUAL(this->m_face->sentData.size(), 1);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace tests
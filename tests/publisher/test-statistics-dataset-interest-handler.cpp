@@ -0,0 +1,92 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2017,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "publisher/statistics-dataset-interest-handler.hpp"
+#include "tests/test-common.hpp"
+#include "tlv/router-statistics.hpp"
+#include "tlv/tlv-nlsr.hpp"
+
+#include "publisher-fixture.hpp"
+#include "../boost-test.hpp"
+
+namespace nlsr {
+namespace test {
+
+class StatisticsDatasetFixture : public PublisherFixture
+{
+public:
+  tlv::RouterStatistics
+  requestStatistics(const ndn::Name& name)
+  {
+    face.receive(ndn::Interest(name));
+    face.processEvents(ndn::time::milliseconds(30));
+    BOOST_REQUIRE_EQUAL(face.sentData.size(), 1);
+
+    ndn::Block parser(face.sentData[0].getContent());
+    parser.parse();
+    face.sentData.clear();
+
+    BOOST_REQUIRE_EQUAL(parser.elements_size(), 1);
+    BOOST_REQUIRE_EQUAL(parser.elements()[0].type(), ndn::tlv::nlsr::RouterStatistics);
+    return tlv::RouterStatistics(parser.elements()[0]);
+  }
+};
+
+BOOST_FIXTURE_TEST_SUITE(PublisherTestStatisticsDatasetInterestHandler, StatisticsDatasetFixture)
+
+BOOST_AUTO_TEST_CASE(Localhost)
+{
+  Statistics& statistics = nlsr.getStatsCollector().getStatistics();
+  statistics.resetAll();
+  statistics.increment(Statistics::PacketType::SENT_HELLO_INTEREST);
+  statistics.record(Statistics::DurationType::SPF_DURATION, ndn::time::microseconds(3));
+
+  tlv::RouterStatistics routerStatistics =
+    requestStatistics(ndn::Name("/localhost/nlsr/statistics"));
+
+  BOOST_REQUIRE_EQUAL(routerStatistics.getPacketCounters().size(), Statistics::N_PACKET_TYPES);
+  const tlv::RouterStatistics::PacketCounter& counter =
+    routerStatistics.getPacketCounters()[static_cast<size_t>(Statistics::PacketType::SENT_HELLO_INTEREST)];
+  BOOST_CHECK_EQUAL(counter.type, Statistics::PacketType::SENT_HELLO_INTEREST);
+  BOOST_CHECK_EQUAL(counter.count, 1);
+
+  BOOST_REQUIRE_EQUAL(routerStatistics.getDurationHistograms().size(), Statistics::N_DURATION_TYPES);
+  const tlv::RouterStatistics::DurationHistogram& histogram =
+    routerStatistics.getDurationHistograms()[static_cast<size_t>(Statistics::DurationType::SPF_DURATION)];
+  BOOST_CHECK_EQUAL(histogram.type, Statistics::DurationType::SPF_DURATION);
+  BOOST_CHECK_EQUAL(histogram.count, 1);
+  BOOST_CHECK_EQUAL(histogram.total, ndn::time::microseconds(3));
+  BOOST_CHECK_EQUAL(histogram.buckets.at(2), 1);
+}
+
+BOOST_AUTO_TEST_CASE(Routername)
+{
+  tlv::RouterStatistics routerStatistics =
+    requestStatistics(ndn::Name("/ndn/This/Router/statistics"));
+
+  BOOST_CHECK_EQUAL(routerStatistics.getPacketCounters().size(), Statistics::N_PACKET_TYPES);
+  BOOST_CHECK_EQUAL(routerStatistics.getDurationHistograms().size(), Statistics::N_DURATION_TYPES);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace test
+} // namespace nlsr
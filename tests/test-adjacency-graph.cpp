@@ -0,0 +1,93 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2017,  The University of Memphis,
+ *                           Regents of the University of California
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "route/adjacency-graph.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+namespace nlsr {
+namespace test {
+
+BOOST_AUTO_TEST_SUITE(TestAdjacencyGraph)
+
+BOOST_AUTO_TEST_CASE(Build)
+{
+  std::vector<AdjacencyGraph::Link> links = {
+    {2, 0, 10}, {0, 1, 5}, {1, 0, 5}, {0, 2, 10}, {1, 2, 17}, {2, 1, 17}
+  };
+
+  AdjacencyGraph graph;
+  graph.build(4, links);
+
+  BOOST_CHECK_EQUAL(graph.getNRouters(), 4);
+  BOOST_CHECK_EQUAL(graph.getNLinks(), 6);
+
+  BOOST_REQUIRE_EQUAL(graph.getNumOfLinks(0), 2);
+  BOOST_CHECK_EQUAL(graph.getLinkTarget(graph.linksBegin(0)), 1);
+  BOOST_CHECK_EQUAL(graph.getLinkCost(graph.linksBegin(0)), 5);
+  BOOST_CHECK_EQUAL(graph.getLinkTarget(graph.linksBegin(0) + 1), 2);
+  BOOST_CHECK_EQUAL(graph.getLinkCost(graph.linksBegin(0) + 1), 10);
+
+  BOOST_CHECK_EQUAL(graph.getLinkCost(1, 2), 17);
+  BOOST_CHECK_EQUAL(graph.getLinkCost(2, 1), 17);
+
+  // Router 3 has no links
+  BOOST_CHECK_EQUAL(graph.getNumOfLinks(3), 0);
+  BOOST_CHECK_EQUAL(graph.getLinkCost(3, 0), 0);
+}
+
+BOOST_AUTO_TEST_CASE(AsymmetricCost)
+{
+  std::vector<AdjacencyGraph::Link> links = {
+    {0, 1, 5}, {1, 0, 7}, // Should use the larger cost
+    {0, 2, 10}, {2, 0, 0}, // Down in one direction
+    {1, 2, 17} // Not advertised by router 2
+  };
+
+  AdjacencyGraph graph;
+  graph.build(3, links);
+
+  BOOST_CHECK_EQUAL(graph.getLinkCost(0, 1), 7);
+  BOOST_CHECK_EQUAL(graph.getLinkCost(1, 0), 7);
+
+  BOOST_CHECK_EQUAL(graph.getLinkCost(0, 2), 0);
+  BOOST_CHECK_EQUAL(graph.getLinkCost(2, 0), 0);
+
+  BOOST_CHECK_EQUAL(graph.getLinkCost(1, 2), 0);
+  BOOST_CHECK_EQUAL(graph.getNLinks(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(LaterLinkOverrides)
+{
+  std::vector<AdjacencyGraph::Link> links = {
+    {0, 1, 5}, {1, 0, 8}, {0, 1, 8}
+  };
+
+  AdjacencyGraph graph;
+  graph.build(2, links);
+
+  BOOST_CHECK_EQUAL(graph.getNLinks(), 2);
+  BOOST_CHECK_EQUAL(graph.getLinkCost(0, 1), 8);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace test
+} // namespace nlsr
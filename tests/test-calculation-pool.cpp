@@ -0,0 +1,95 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2017,  The University of Memphis,
+ *                           Regents of the University of California
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "route/calculation-pool.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+
+namespace nlsr {
+namespace test {
+
+BOOST_AUTO_TEST_SUITE(TestCalculationPool)
+
+BOOST_AUTO_TEST_CASE(RunTasks)
+{
+  boost::asio::io_service ioService;
+  CalculationPool pool(ioService, 4);
+  BOOST_CHECK_EQUAL(pool.getNThreads(), 4);
+
+  const size_t N_TASKS = 100;
+  std::vector<int> results(N_TASKS, 0);
+  std::atomic<size_t> nRun(0);
+
+  std::vector<std::function<void()>> tasks;
+  for (size_t i = 0; i < N_TASKS; ++i) {
+    tasks.push_back([&results, &nRun, i] {
+      results[i] = i * i;
+      ++nRun;
+    });
+  }
+
+  int nAfterAll = 0;
+  boost::thread::id afterAllThread;
+  pool.run(tasks, [&] {
+    ++nAfterAll;
+    afterAllThread = boost::this_thread::get_id();
+    BOOST_CHECK_EQUAL(nRun, N_TASKS);
+  });
+
+  ioService.run();
+
+  BOOST_CHECK_EQUAL(nAfterAll, 1);
+  BOOST_CHECK(afterAllThread == boost::this_thread::get_id());
+  for (size_t i = 0; i < N_TASKS; ++i) {
+    BOOST_CHECK_EQUAL(results[i], static_cast<int>(i * i));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(NoTasks)
+{
+  boost::asio::io_service ioService;
+  CalculationPool pool(ioService, 1);
+
+  bool isCalled = false;
+  pool.run({}, [&] { isCalled = true; });
+  ioService.run();
+
+  BOOST_CHECK(isCalled);
+}
+
+BOOST_AUTO_TEST_CASE(DestroyedBeforeDelivery)
+{
+  boost::asio::io_service ioService;
+  bool isCalled = false;
+  {
+    CalculationPool pool(ioService, 2);
+    pool.run({[] {}}, [&] { isCalled = true; });
+  }
+  ioService.run();
+
+  BOOST_CHECK(!isCalled);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace test
+} // namespace nlsr
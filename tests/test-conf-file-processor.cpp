@@ -43,6 +43,9 @@ const std::string SECTION_GENERAL =
   "  router /cs/pollux/\n"
   "  lsa-refresh-time 1800\n"
   "  lsa-interest-lifetime 3\n"
+  "  lsa-fetch-window 16\n"
+  "  sync-batch-window 20\n"
+  "  lsa-content-format tlv\n"
   "  router-dead-interval 86400\n"
   "  log-level  INFO\n"
   "  log-dir /tmp\n"
@@ -59,6 +62,9 @@ const std::string SECTION_GENERAL_WITH_LOG4CXX =
   "  router /cs/pollux/\n"
   "  lsa-refresh-time 1800\n"
   "  lsa-interest-lifetime 3\n"
+  "  lsa-fetch-window 16\n"
+  "  sync-batch-window 20\n"
+  "  lsa-content-format tlv\n"
   "  router-dead-interval 86400\n"
   "  log-level  INFO\n"
   "  log-dir /tmp\n"
@@ -117,6 +123,10 @@ const std::string SECTION_FIB =
   "{\n"
   "   max-faces-per-prefix 3\n"
   "   routing-calc-interval 9\n"
+  "   routing-calc-initial-wait 100\n"
+  "   routing-calc-secondary-wait 500\n"
+  "   routing-calc-threads 4\n"
+  "   rib-command-window 32\n"
   "}\n\n";
 
 const std::string SECTION_ADVERTISING =
@@ -236,6 +246,9 @@ BOOST_AUTO_TEST_CASE(LinkState)
   BOOST_CHECK_EQUAL(conf.getLsaPrefix(), "/localhop/ndn/NLSR/LSA");
   BOOST_CHECK_EQUAL(conf.getLsaRefreshTime(), 1800);
   BOOST_CHECK_EQUAL(conf.getLsaInterestLifetime(), ndn::time::seconds(3));
+  BOOST_CHECK_EQUAL(conf.getLsaFetchWindow(), 16);
+  BOOST_CHECK_EQUAL(conf.getSyncBatchWindow(), 20);
+  BOOST_CHECK_EQUAL(conf.getLsaContentFormat(), LSA_CONTENT_FORMAT_TLV);
   BOOST_CHECK_EQUAL(conf.getRouterDeadInterval(), 86400);
   BOOST_CHECK_EQUAL(conf.getLogLevel(), "INFO");
   BOOST_CHECK_EQUAL(conf.getLogDir(), "/tmp");
@@ -267,6 +280,10 @@ BOOST_AUTO_TEST_CASE(LinkState)
   // FIB
   BOOST_CHECK_EQUAL(conf.getMaxFacesPerPrefix(), 3);
   BOOST_CHECK_EQUAL(conf.getRoutingCalcInterval(), 9);
+  BOOST_CHECK_EQUAL(conf.getRoutingCalcInitialWait(), 100);
+  BOOST_CHECK_EQUAL(conf.getRoutingCalcSecondaryWait(), 500);
+  BOOST_CHECK_EQUAL(conf.getRoutingCalcThreads(), 4);
+  BOOST_CHECK_EQUAL(conf.getRibCommandWindow(), 32);
 
   // Advertising
   BOOST_CHECK_EQUAL(nlsr.getNamePrefixList().size(), 2);
@@ -399,6 +416,9 @@ BOOST_AUTO_TEST_CASE(DefaultValuesGeneral)
 
   commentOut("lsa-refresh-time", config);
   commentOut("lsa-interest-lifetime", config);
+  commentOut("lsa-fetch-window", config);
+  commentOut("sync-batch-window", config);
+  commentOut("lsa-content-format", config);
   commentOut("router-dead-interval", config);
   commentOut("log-level", config);
 
@@ -409,6 +429,9 @@ BOOST_AUTO_TEST_CASE(DefaultValuesGeneral)
   BOOST_CHECK_EQUAL(conf.getLsaRefreshTime(), static_cast<uint32_t>(LSA_REFRESH_TIME_DEFAULT));
   BOOST_CHECK_EQUAL(conf.getLsaInterestLifetime(),
                     static_cast<ndn::time::seconds>(LSA_INTEREST_LIFETIME_DEFAULT));
+  BOOST_CHECK_EQUAL(conf.getLsaFetchWindow(), static_cast<uint32_t>(LSA_FETCH_WINDOW_DEFAULT));
+  BOOST_CHECK_EQUAL(conf.getSyncBatchWindow(), static_cast<uint32_t>(SYNC_BATCH_WINDOW_DEFAULT));
+  BOOST_CHECK_EQUAL(conf.getLsaContentFormat(), LSA_CONTENT_FORMAT_TEXT);
   BOOST_CHECK_EQUAL(conf.getRouterDeadInterval(), (2*conf.getLsaRefreshTime()));
   BOOST_CHECK_EQUAL(conf.getLogLevel(), "INFO");
 }
@@ -442,6 +465,10 @@ BOOST_AUTO_TEST_CASE(DefaultValuesFib)
 
   commentOut("max-faces-per-prefix", config);
   commentOut("routing-calc-interval", config);
+  commentOut("routing-calc-initial-wait", config);
+  commentOut("routing-calc-secondary-wait", config);
+  commentOut("routing-calc-threads", config);
+  commentOut("rib-command-window", config);
 
   BOOST_CHECK_EQUAL(processConfigurationString(config), true);
 
@@ -451,6 +478,14 @@ BOOST_AUTO_TEST_CASE(DefaultValuesFib)
                     static_cast<uint32_t>(MAX_FACES_PER_PREFIX_DEFAULT));
   BOOST_CHECK_EQUAL(conf.getRoutingCalcInterval(),
                     static_cast<uint32_t>(ROUTING_CALC_INTERVAL_DEFAULT));
+  BOOST_CHECK_EQUAL(conf.getRoutingCalcInitialWait(),
+                    static_cast<uint32_t>(ROUTING_CALC_INITIAL_WAIT_DEFAULT));
+  BOOST_CHECK_EQUAL(conf.getRoutingCalcSecondaryWait(),
+                    static_cast<uint32_t>(ROUTING_CALC_SECONDARY_WAIT_DEFAULT));
+  BOOST_CHECK_EQUAL(conf.getRoutingCalcThreads(),
+                    static_cast<uint32_t>(ROUTING_CALC_THREADS_DEFAULT));
+  BOOST_CHECK_EQUAL(conf.getRibCommandWindow(),
+                    static_cast<uint32_t>(RIB_COMMAND_WINDOW_DEFAULT));
 }
 
 BOOST_AUTO_TEST_CASE(DefaultValuesHyperbolic)
@@ -496,6 +531,14 @@ BOOST_AUTO_TEST_CASE(NegativeValue)
   BOOST_CHECK_EQUAL(processConfigurationString(SECTION_GENERAL_NEGATIVE_VALUE), false);
 }
 
+BOOST_AUTO_TEST_CASE(UnknownLsaContentFormat)
+{
+  std::string config = SECTION_GENERAL;
+  boost::replace_first(config, "lsa-content-format tlv", "lsa-content-format binary");
+
+  BOOST_CHECK_EQUAL(processConfigurationString(config), false);
+}
+
 BOOST_AUTO_TEST_CASE(LoadCertToPublish)
 {
   ndn::Name identity("/TestNLSR/identity");
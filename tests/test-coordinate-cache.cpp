@@ -0,0 +1,137 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2017,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "route/coordinate-cache.hpp"
+
+#include "test-common.hpp"
+
+#include <cmath>
+
+namespace nlsr {
+namespace test {
+
+// The distance as NLSR used to calculate it from the angles, with
+// zeta = 1: the angular distance from the inner product of the points
+// on the unit sphere, then the hyperbolic law of cosines.
+static double
+legacyDistance(double rI, const std::vector<double>& anglesI,
+               double rJ, const std::vector<double>& anglesJ)
+{
+  size_t d = anglesI.size();
+  double xni = std::sin(anglesI[d - 1]);
+  double xnj = std::sin(anglesJ[d - 1]);
+  for (size_t k = 0; k < d - 1; ++k) {
+    xni *= std::sin(anglesI[k]);
+    xnj *= std::sin(anglesJ[k]);
+  }
+  double innerProduct = std::cos(anglesI[0]) * std::cos(anglesJ[0]) + xni * xnj;
+  for (size_t m = 1; m < d; ++m) {
+    double xmi = std::cos(anglesI[m]);
+    double xmj = std::cos(anglesJ[m]);
+    for (size_t l = 0; l < m; ++l) {
+      xmi *= std::sin(anglesI[l]);
+      xmj *= std::sin(anglesJ[l]);
+    }
+    innerProduct += xmi * xmj;
+  }
+  double deltaTheta = std::acos(innerProduct);
+  return std::acosh(std::cosh(rI) * std::cosh(rJ) -
+                    std::sinh(rI) * std::sinh(rJ) * std::cos(deltaTheta));
+}
+
+BOOST_AUTO_TEST_SUITE(TestCoordinateCache)
+
+BOOST_AUTO_TEST_CASE(Distances)
+{
+  CoordinateCache cache;
+  cache.insert("/router/a", 16.23, {2.97, 1.22});
+  cache.insert("/router/b", 16.59, {3.0, 0.09});
+  cache.insert("/router/c", 14.11, {321, 2.99});
+  cache.insert("/router/d", 15.0, {0.5, 4.0});
+  BOOST_CHECK_EQUAL(cache.size(), 4);
+
+  size_t a = *cache.find("/router/a");
+  size_t b = *cache.find("/router/b");
+  size_t c = *cache.find("/router/c");
+  BOOST_CHECK(!cache.find("/router/e"));
+
+  BOOST_CHECK_CLOSE(cache.getDistance(b, c), legacyDistance(16.59, {3.0, 0.09}, 14.11, {321, 2.99}),
+                    1e-9);
+  BOOST_CHECK_CLOSE(cache.getDistance(c, a), legacyDistance(14.11, {321, 2.99}, 16.23, {2.97, 1.22}),
+                    1e-9);
+
+  // The batch calculation agrees with the distance between each pair
+  std::vector<double> distances;
+  cache.calculateDistances(b, distances);
+  BOOST_REQUIRE_EQUAL(distances.size(), 4);
+  for (size_t i = 0; i < distances.size(); ++i) {
+    BOOST_CHECK_CLOSE(distances[i], cache.getDistance(b, i), 1e-9);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(UnknownDistances)
+{
+  CoordinateCache cache;
+  cache.insert("/router/a", 16.23, {2.97});
+  cache.insert("/router/b", 16.59, {3.0, 0.09});
+  cache.insert("/router/c", -1, {2.99});
+  cache.insert("/router/d", 14.11, {7.0});
+
+  size_t a = *cache.find("/router/a");
+
+  std::vector<double> distances;
+  cache.calculateDistances(a, distances);
+
+  // Different dimensions
+  BOOST_CHECK_EQUAL(distances[*cache.find("/router/b")], CoordinateCache::UNKNOWN_DISTANCE);
+  // Unknown radius
+  BOOST_CHECK_EQUAL(distances[*cache.find("/router/c")], CoordinateCache::UNKNOWN_DISTANCE);
+  // Last angle outside [0, 2PI]
+  BOOST_CHECK_EQUAL(distances[*cache.find("/router/d")], CoordinateCache::UNKNOWN_DISTANCE);
+
+  // Valid coordinates replace invalid ones
+  cache.insert("/router/d", 14.11, {2.99});
+  BOOST_CHECK_CLOSE(cache.getDistance(a, *cache.find("/router/d")),
+                    legacyDistance(16.23, {2.97}, 14.11, {2.99}), 1e-9);
+}
+
+BOOST_AUTO_TEST_CASE(Erase)
+{
+  CoordinateCache cache;
+  cache.insert("/router/a", 16.23, {2.97});
+  cache.insert("/router/b", 16.59, {3.0});
+  cache.insert("/router/c", 14.11, {2.99});
+
+  cache.erase("/router/a");
+  cache.erase("/router/e");
+  BOOST_CHECK_EQUAL(cache.size(), 2);
+  BOOST_CHECK(!cache.find("/router/a"));
+
+  // The router moved into the freed slot keeps its coordinates
+  size_t b = *cache.find("/router/b");
+  size_t c = *cache.find("/router/c");
+  BOOST_CHECK_CLOSE(cache.getDistance(b, c), legacyDistance(16.59, {3.0}, 14.11, {2.99}), 1e-9);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace test
+} // namespace nlsr
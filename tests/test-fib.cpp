@@ -25,6 +25,7 @@
 #include "adjacency-list.hpp"
 #include "conf-parameter.hpp"
 
+#include <ndn-cxx/mgmt/nfd/control-response.hpp>
 #include <ndn-cxx/util/dummy-client-face.hpp>
 
 namespace nlsr {
@@ -60,6 +61,26 @@ public:
     fib->m_faceMap.update(router3FaceUri, router3FaceId);
   }
 
+  /*! \brief Answers a RIB command as NFD would, echoing its parameters on success. */
+  void
+  answerRibCommand(const ndn::Interest& interest, uint32_t code)
+  {
+    ndn::nfd::ControlParameters parameters;
+    ndn::Name::Component verb;
+    extractRibCommandParameters(interest, verb, parameters);
+
+    ndn::nfd::ControlResponse response(code, code == 200 ? "OK" : "Error");
+    if (code == 200) {
+      response.setBody(parameters.wireEncode());
+    }
+
+    ndn::Data data(interest.getName());
+    data.setContent(response.wireEncode());
+    keyChain.sign(data);
+    face->receive(data);
+    face->processEvents(ndn::time::milliseconds(-1));
+  }
+
 public:
   std::shared_ptr<ndn::util::DummyClientFace> face;
   ndn::KeyChain keyChain;
@@ -304,6 +325,129 @@ BOOST_AUTO_TEST_CASE(NextHopsMaxPrefixesAfterRecalculation)
               verb == ndn::Name::Component("unregister"));
 }
 
+BOOST_AUTO_TEST_CASE(BatchCoalescesCommands)
+{
+  NextHop hop1(router1FaceUri, 10);
+  NextHop hop2(router2FaceUri, 20);
+
+  NexthopList hops;
+  hops.addNextHop(hop1);
+  hops.addNextHop(hop2);
+
+  fib->beginBatch();
+  fib->update("/ndn/name", hops);
+  fib->update("/ndn/other", hops);
+  fib->remove("/ndn/name");
+  face->processEvents(ndn::time::milliseconds(-1));
+
+  // Nothing is sent until the batch ends
+  BOOST_CHECK_EQUAL(interests.size(), 0);
+  BOOST_CHECK_EQUAL(fib->getRibCommandQueueSize(), 4);
+  BOOST_CHECK_EQUAL(fib->getRibCommandsCoalesced(), 2);
+
+  fib->endBatch();
+  face->processEvents(ndn::time::milliseconds(-1));
+
+  // The registrations of /ndn/name were replaced by its unregistrations
+  BOOST_REQUIRE_EQUAL(interests.size(), 4);
+
+  ndn::nfd::ControlParameters extractedParameters;
+  ndn::Name::Component verb;
+
+  extractRibCommandParameters(interests[0], verb, extractedParameters);
+  BOOST_CHECK(extractedParameters.getName() == "/ndn/name" &&
+              extractedParameters.getFaceId() == router1FaceId &&
+              verb == ndn::Name::Component("unregister"));
+
+  extractRibCommandParameters(interests[2], verb, extractedParameters);
+  BOOST_CHECK(extractedParameters.getName() == "/ndn/other" &&
+              extractedParameters.getFaceId() == router1FaceId &&
+              verb == ndn::Name::Component("register"));
+}
+
+BOOST_AUTO_TEST_CASE(CommandWindow)
+{
+  conf.setRibCommandWindow(3);
+
+  NextHop hop1(router1FaceUri, 10);
+  NextHop hop2(router2FaceUri, 20);
+
+  NexthopList hops;
+  hops.addNextHop(hop1);
+  hops.addNextHop(hop2);
+
+  fib->update("/ndn/name1", hops);
+  fib->update("/ndn/name2", hops);
+  face->processEvents(ndn::time::milliseconds(-1));
+
+  // Only as many commands as the window allows are sent before NFD answers
+  BOOST_CHECK_EQUAL(interests.size(), 3);
+  BOOST_CHECK_EQUAL(fib->getRibCommandsInFlight(), 3);
+  BOOST_CHECK_EQUAL(fib->getRibCommandQueueSize(), 1);
+  BOOST_CHECK_EQUAL(fib->getRibCommandsSent(), 3);
+
+  // A success makes room for the queued command
+  answerRibCommand(interests[0], 200);
+  BOOST_REQUIRE_EQUAL(interests.size(), 4);
+  BOOST_CHECK_EQUAL(fib->getRibCommandsInFlight(), 3);
+  BOOST_CHECK_EQUAL(fib->getRibCommandQueueSize(), 0);
+
+  // So does a failure, whose retry takes the slot
+  answerRibCommand(interests[1], 400);
+  BOOST_REQUIRE_EQUAL(interests.size(), 5);
+  BOOST_CHECK_EQUAL(interests[4].getName()[4], interests[1].getName()[4]);
+  BOOST_CHECK_EQUAL(fib->getRibCommandsInFlight(), 3);
+  BOOST_CHECK_EQUAL(fib->getRibCommandQueueSize(), 0);
+
+  answerRibCommand(interests[2], 200);
+  answerRibCommand(interests[3], 400);
+  answerRibCommand(interests[4], 200);
+  BOOST_REQUIRE_EQUAL(interests.size(), 6);
+  answerRibCommand(interests[5], 200);
+
+  BOOST_CHECK_EQUAL(fib->getRibCommandsInFlight(), 0);
+  BOOST_CHECK_EQUAL(fib->getRibCommandQueueSize(), 0);
+  BOOST_CHECK_EQUAL(fib->getRibCommandsSent(), 6);
+}
+
+BOOST_AUTO_TEST_CASE(RetryDoesNotReplaceNewerCommand)
+{
+  conf.setRibCommandWindow(1);
+
+  NextHop hop1(router1FaceUri, 10);
+  NextHop hop2(router2FaceUri, 20);
+
+  NexthopList hops;
+  hops.addNextHop(hop1);
+  hops.addNextHop(hop2);
+
+  fib->update("/ndn/name", hops);
+  fib->remove("/ndn/name");
+  face->processEvents(ndn::time::milliseconds(-1));
+
+  // The registration on router1's face is in flight, and its
+  // unregistration is queued behind it
+  BOOST_REQUIRE_EQUAL(interests.size(), 1);
+  BOOST_CHECK_EQUAL(fib->getRibCommandQueueSize(), 2);
+  uint64_t nCoalesced = fib->getRibCommandsCoalesced();
+
+  // The failed registration is not retried over the unregistration
+  answerRibCommand(interests[0], 400);
+  BOOST_CHECK_EQUAL(fib->getRibCommandsCoalesced(), nCoalesced);
+  BOOST_REQUIRE_EQUAL(interests.size(), 2);
+  answerRibCommand(interests[1], 200);
+  BOOST_REQUIRE_EQUAL(interests.size(), 3);
+  answerRibCommand(interests[2], 200);
+  BOOST_CHECK_EQUAL(interests.size(), 3);
+
+  ndn::nfd::ControlParameters extractedParameters;
+  ndn::Name::Component verb;
+  for (size_t i = 1; i < interests.size(); ++i) {
+    extractRibCommandParameters(interests[i], verb, extractedParameters);
+    BOOST_CHECK_EQUAL(verb, ndn::Name::Component("unregister"));
+  }
+}
+
 BOOST_FIXTURE_TEST_CASE(ScheduleFibEntryRefresh, FibFixture)
 {
   ndn::Name name1("/name/1");
@@ -0,0 +1,307 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2017,  The University of Memphis,
+ *                           Regents of the University of California
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "route/incremental-spf.hpp"
+#include "route/adjacency-graph.hpp"
+#include "route/shortest-path-calculator.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <map>
+#include <random>
+
+namespace nlsr {
+namespace test {
+
+class IncrementalSpfFixture
+{
+public:
+  IncrementalSpfFixture()
+  {
+    // 0 -5- 1 -1- 3
+    //  \         /
+    //   10 -2- 2     4 (isolated)
+    addLink(0, 1, 5);
+    addLink(0, 2, 10);
+    addLink(1, 3, 1);
+    addLink(2, 3, 2);
+    advertise(4);
+  }
+
+  void
+  addLink(int32_t a, int32_t b, double cost)
+  {
+    lsas[a][b] = cost;
+    lsas[b][a] = cost;
+  }
+
+  void
+  removeLink(int32_t a, int32_t b)
+  {
+    lsas[a].erase(b);
+    lsas[b].erase(a);
+  }
+
+  void
+  advertise(int32_t router)
+  {
+    std::vector<IncrementalSpf::AdvertisedLink> links;
+    for (const auto& link : lsas[router]) {
+      links.push_back({link.first, link.second});
+    }
+    ispf.setAdvertisedLinks(router, links);
+  }
+
+  /*! \brief Checks the maintained tree against a full calculation. */
+  void
+  checkAgainstFullCalculation(int32_t source)
+  {
+    std::vector<AdjacencyGraph::Link> links;
+    for (const auto& lsa : lsas) {
+      for (const auto& link : lsa.second) {
+        links.push_back({lsa.first, link.first, link.second});
+      }
+    }
+
+    AdjacencyGraph graph;
+    graph.build(ispf.getNRouters(), links);
+
+    ShortestPathCalculator spf;
+    spf.calculate(graph, source);
+
+    for (size_t i = 0; i < ispf.getNRouters(); ++i) {
+      BOOST_CHECK_EQUAL(ispf.isReachable(i), spf.isReachable(i));
+      if (spf.isReachable(i)) {
+        BOOST_CHECK_CLOSE(ispf.getDistance(i), spf.getDistance(i), 1e-9);
+        BOOST_CHECK_EQUAL(ispf.getNextHop(i), spf.getNextHop(i));
+      }
+      else {
+        BOOST_CHECK_EQUAL(ispf.getNextHop(i), IncrementalSpf::NO_ROUTER);
+      }
+    }
+  }
+
+public:
+  std::map<int32_t, std::map<int32_t, double>> lsas;
+  IncrementalSpf ispf;
+};
+
+BOOST_FIXTURE_TEST_SUITE(TestIncrementalSpf, IncrementalSpfFixture)
+
+BOOST_AUTO_TEST_CASE(Calculate)
+{
+  for (int32_t router = 0; router < 4; ++router) {
+    advertise(router);
+  }
+  BOOST_CHECK(!ispf.isCalculated());
+
+  ispf.repair(0);
+
+  BOOST_CHECK(ispf.isCalculated());
+  BOOST_CHECK_EQUAL(ispf.getDistance(2), 8);
+  BOOST_CHECK_EQUAL(ispf.getParent(2), 3);
+  BOOST_CHECK_EQUAL(ispf.getNextHop(2), 1);
+  BOOST_CHECK(!ispf.isReachable(4));
+  BOOST_CHECK_EQUAL(ispf.getChangedRouters().size(), 5);
+  checkAgainstFullCalculation(0);
+}
+
+BOOST_AUTO_TEST_CASE(CostIncrease)
+{
+  for (int32_t router = 0; router < 4; ++router) {
+    advertise(router);
+  }
+  ispf.calculate(0);
+
+  // 1-3 is on the tree; 3 and 2 now go through 0-2
+  addLink(1, 3, 20);
+  advertise(1);
+  advertise(3);
+  ispf.repair(0);
+
+  BOOST_CHECK_EQUAL(ispf.getDistance(3), 12);
+  BOOST_CHECK_EQUAL(ispf.getNextHop(3), 2);
+  BOOST_CHECK_EQUAL(ispf.getDistance(2), 10);
+  BOOST_CHECK_EQUAL(ispf.getNextHop(2), 2);
+  checkAgainstFullCalculation(0);
+
+  // Router 1 is unaffected
+  std::vector<int32_t> changed = ispf.getChangedRouters();
+  std::sort(changed.begin(), changed.end());
+  std::vector<int32_t> expected{2, 3};
+  BOOST_CHECK_EQUAL_COLLECTIONS(changed.begin(), changed.end(),
+                                expected.begin(), expected.end());
+}
+
+BOOST_AUTO_TEST_CASE(CostDecrease)
+{
+  for (int32_t router = 0; router < 4; ++router) {
+    advertise(router);
+  }
+  ispf.calculate(0);
+
+  addLink(0, 2, 3);
+  advertise(0);
+  advertise(2);
+  ispf.repair(0);
+
+  BOOST_CHECK_EQUAL(ispf.getDistance(2), 3);
+  BOOST_CHECK_EQUAL(ispf.getNextHop(2), 2);
+  BOOST_CHECK_EQUAL(ispf.getDistance(3), 5);
+  BOOST_CHECK_EQUAL(ispf.getNextHop(3), 2);
+  checkAgainstFullCalculation(0);
+}
+
+BOOST_AUTO_TEST_CASE(AsymmetricAdvertisement)
+{
+  for (int32_t router = 0; router < 4; ++router) {
+    advertise(router);
+  }
+  ispf.calculate(0);
+
+  // Only one side has been updated; the higher cost is used
+  lsas[1][3] = 20;
+  advertise(1);
+  ispf.repair(0);
+
+  BOOST_CHECK_EQUAL(ispf.getDistance(3), 12);
+  checkAgainstFullCalculation(0);
+
+  // Both sides agree again
+  lsas[3][1] = 20;
+  advertise(3);
+  ispf.repair(0);
+
+  BOOST_CHECK_EQUAL(ispf.getDistance(3), 12);
+  BOOST_CHECK(ispf.getChangedRouters().empty());
+}
+
+BOOST_AUTO_TEST_CASE(LinkUpAndDown)
+{
+  for (int32_t router = 0; router < 4; ++router) {
+    advertise(router);
+  }
+  ispf.calculate(0);
+
+  // A link is only up once both sides advertise it
+  lsas[3][4] = 1;
+  advertise(3);
+  ispf.repair(0);
+  BOOST_CHECK(!ispf.isReachable(4));
+
+  lsas[4][3] = 1;
+  advertise(4);
+  ispf.repair(0);
+  BOOST_CHECK_EQUAL(ispf.getDistance(4), 7);
+  BOOST_CHECK_EQUAL(ispf.getNextHop(4), 1);
+  checkAgainstFullCalculation(0);
+
+  removeLink(0, 1);
+  advertise(0);
+  advertise(1);
+  ispf.repair(0);
+  BOOST_CHECK_EQUAL(ispf.getDistance(1), 13);
+  BOOST_CHECK_EQUAL(ispf.getNextHop(4), 2);
+  checkAgainstFullCalculation(0);
+}
+
+BOOST_AUTO_TEST_CASE(LsaRemoval)
+{
+  for (int32_t router = 0; router < 4; ++router) {
+    advertise(router);
+  }
+  ispf.calculate(0);
+
+  // Router 3's LSA expires; its neighbors still advertise links to it
+  lsas.erase(3);
+  ispf.setAdvertisedLinks(3, {});
+  ispf.repair(0);
+
+  BOOST_CHECK(!ispf.isReachable(3));
+  BOOST_CHECK_EQUAL(ispf.getDistance(2), 10);
+  checkAgainstFullCalculation(0);
+}
+
+BOOST_AUTO_TEST_CASE(NewRouter)
+{
+  for (int32_t router = 0; router < 4; ++router) {
+    advertise(router);
+  }
+  ispf.calculate(0);
+
+  addLink(2, 7, 1);
+  advertise(2);
+  advertise(7);
+  ispf.repair(0);
+
+  BOOST_CHECK_EQUAL(ispf.getNRouters(), 8);
+  BOOST_CHECK_EQUAL(ispf.getDistance(7), 9);
+  BOOST_CHECK(!ispf.isReachable(6));
+  checkAgainstFullCalculation(0);
+}
+
+BOOST_AUTO_TEST_CASE(RandomChanges)
+{
+  const int32_t N_ROUTERS = 60;
+
+  std::mt19937 random(1);
+  std::uniform_int_distribution<int32_t> pickRouter(0, N_ROUTERS - 1);
+  std::uniform_real_distribution<double> pickCost(1, 100);
+
+  lsas.clear();
+  for (int32_t router = 1; router < N_ROUTERS; ++router) {
+    addLink(router, pickRouter(random) % router, pickCost(random));
+  }
+  for (int i = 0; i < N_ROUTERS; ++i) {
+    addLink(pickRouter(random), pickRouter(random), pickCost(random));
+  }
+  for (int32_t router = 0; router < N_ROUTERS; ++router) {
+    lsas[router].erase(router);
+    advertise(router);
+  }
+  ispf.calculate(0);
+  checkAgainstFullCalculation(0);
+
+  for (int round = 0; round < 50; ++round) {
+    for (int change = 0; change < 3; ++change) {
+      int32_t a = pickRouter(random);
+      int32_t b = pickRouter(random);
+      if (a == b) {
+        continue;
+      }
+      if (lsas[a].count(b) != 0 && random() % 3 == 0) {
+        removeLink(a, b);
+      }
+      else {
+        addLink(a, b, pickCost(random));
+      }
+      advertise(a);
+      advertise(b);
+    }
+    ispf.repair(0);
+    checkAgainstFullCalculation(0);
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace test
+} // namespace nlsr
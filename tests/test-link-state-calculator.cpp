@@ -26,11 +26,15 @@
 #include "lsdb.hpp"
 #include "nlsr.hpp"
 #include "test-common.hpp"
+#include "route/calculation-pool.hpp"
 #include "route/map.hpp"
 #include "route/routing-table.hpp"
 
 #include <ndn-cxx/util/dummy-client-face.hpp>
 
+#include <algorithm>
+#include <limits>
+
 namespace nlsr {
 namespace test {
 
@@ -262,6 +266,172 @@ BOOST_AUTO_TEST_CASE(AsymmetricZeroCost)
               nextHopForC.getRouteCostAsAdjustedInteger() == LINK_AC_COST);
 }
 
+BOOST_AUTO_TEST_CASE(OnPool)
+{
+  CalculationPool pool(g_ioService, 2);
+
+  LinkStateRoutingTableCalculator calculator(map.getMapSize());
+  bool isCalculated = false;
+  BOOST_REQUIRE(calculator.calculateMultipathOnPool(map, nlsr, pool, [&] {
+    calculator.addMultipathNextHopsToRoutingTable(nlsr, routingTable, map);
+    isCalculated = true;
+  }));
+
+  g_ioService.reset();
+  while (!isCalculated && g_ioService.run_one() > 0) {
+  }
+  BOOST_REQUIRE(isCalculated);
+
+  // Same routes as calculating in place
+  RoutingTableEntry* entryB = routingTable.findRoutingTableEntry(ROUTER_B_NAME);
+  BOOST_REQUIRE(entryB != nullptr);
+  BOOST_REQUIRE_EQUAL(entryB->getNexthopList().getNextHops().size(), 2);
+
+  for (const NextHop& hop : entryB->getNexthopList()) {
+    std::string faceUri = hop.getConnectingFaceUri();
+    uint64_t cost = hop.getRouteCostAsAdjustedInteger();
+
+    BOOST_CHECK((faceUri == ROUTER_B_FACE && cost == LINK_AB_COST) ||
+                (faceUri == ROUTER_C_FACE && cost == LINK_AC_COST + LINK_BC_COST));
+  }
+
+  RoutingTableEntry* entryC = routingTable.findRoutingTableEntry(ROUTER_C_NAME);
+  BOOST_REQUIRE(entryC != nullptr);
+  BOOST_REQUIRE_EQUAL(entryC->getNexthopList().getNextHops().size(), 2);
+
+  for (const NextHop& hop : entryC->getNexthopList()) {
+    std::string faceUri = hop.getConnectingFaceUri();
+    uint64_t cost = hop.getRouteCostAsAdjustedInteger();
+
+    BOOST_CHECK((faceUri == ROUTER_C_FACE && cost == LINK_AC_COST) ||
+                (faceUri == ROUTER_B_FACE && cost == LINK_AB_COST + LINK_BC_COST));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(MaxFacesPerPrefixKeepsAllNextHops)
+{
+  // Link a fourth router D to A, B and C, so that A has three neighbors
+  const ndn::Name ROUTER_D_NAME("/ndn/router/d");
+  Adjacent d(ROUTER_D_NAME, ndn::util::FaceUri("udp4://10.0.0.4"), 3, Adjacent::STATUS_ACTIVE, 0, 0);
+  nlsr.getAdjacencyList().insert(d);
+
+  for (const ndn::Name& router : {ROUTER_A_NAME, ROUTER_B_NAME, ROUTER_C_NAME}) {
+    AdjLsa* lsa = lsdb.findAdjLsa(ndn::Name(router).append(std::to_string(Lsa::Type::ADJACENCY)));
+    BOOST_REQUIRE(lsa != nullptr);
+    lsa->getAdl().insert(d);
+  }
+
+  AdjacencyList adjacencyListD;
+  for (const ndn::Name& router : {ROUTER_A_NAME, ROUTER_B_NAME, ROUTER_C_NAME}) {
+    adjacencyListD.insert(Adjacent(router, ndn::util::FaceUri("udp4://10.0.0.5"), 3,
+                                   Adjacent::STATUS_ACTIVE, 0, 0));
+  }
+  lsdb.installAdjLsa(AdjLsa(ROUTER_D_NAME, 1, MAX_TIME, 3, adjacencyListD));
+  map.createFromAdjLsdb(lsdb.getAdjLsdb().begin(), lsdb.getAdjLsdb().end());
+
+  // Only two faces are installed into the FIB per prefix, but the routing
+  // table still has the next hops through all three neighbors
+  nlsr.getConfParameter().setMaxFacesPerPrefix(2);
+
+  LinkStateRoutingTableCalculator calculator(map.getMapSize());
+  calculator.calculatePath(map, routingTable, nlsr);
+
+  RoutingTableEntry* entryB = routingTable.findRoutingTableEntry(ROUTER_B_NAME);
+  BOOST_REQUIRE(entryB != nullptr);
+  BOOST_CHECK_EQUAL(entryB->getNexthopList().getNextHops().size(), 3);
+
+  RoutingTableEntry* entryC = routingTable.findRoutingTableEntry(ROUTER_C_NAME);
+  BOOST_REQUIRE(entryC != nullptr);
+  BOOST_CHECK_EQUAL(entryC->getNexthopList().getNextHops().size(), 3);
+}
+
+BOOST_AUTO_TEST_CASE(MultipathCostsMatchPerNeighborCalculation)
+{
+  // A has four neighbors, and paths through them overlap further out
+  const int N_ROUTERS = 9;
+  const double LINKS[][3] = {
+    {0, 1, 5}, {0, 2, 10}, {0, 3, 3}, {0, 4, 7.5},
+    {1, 2, 17}, {1, 5, 2}, {2, 6, 4}, {3, 5, 9}, {3, 7, 1},
+    {4, 7, 6}, {4, 8, 2}, {5, 6, 3}, {6, 8, 11}, {7, 8, 4}, {5, 8, 8},
+  };
+
+  std::vector<ndn::Name> names;
+  std::vector<std::string> faces;
+  std::vector<AdjacencyList> adjacencies(N_ROUTERS);
+  for (int i = 0; i < N_ROUTERS; ++i) {
+    names.push_back(ndn::Name("/ndn/router").append(std::string(1, 'a' + i)));
+    faces.push_back("udp4://10.0.0." + std::to_string(i + 1));
+  }
+
+  // The costs the baseline calculation reads from its adjacency matrix
+  std::vector<std::vector<double>> matrix(N_ROUTERS, std::vector<double>(N_ROUTERS, 0));
+  for (const auto& link : LINKS) {
+    int from = link[0];
+    int to = link[1];
+    matrix[from][to] = matrix[to][from] = link[2];
+    adjacencies[from].insert(Adjacent(names[to], ndn::util::FaceUri(faces[to]), link[2],
+                                      Adjacent::STATUS_ACTIVE, 0, 0));
+    adjacencies[to].insert(Adjacent(names[from], ndn::util::FaceUri(faces[from]), link[2],
+                                    Adjacent::STATUS_ACTIVE, 0, 0));
+  }
+
+  nlsr.getAdjacencyList() = adjacencies[0];
+  for (int i = 0; i < N_ROUTERS; ++i) {
+    lsdb.installAdjLsa(AdjLsa(names[i], 2, MAX_TIME, adjacencies[i].size(), adjacencies[i]));
+  }
+  map.createFromAdjLsdb(lsdb.getAdjLsdb().begin(), lsdb.getAdjLsdb().end());
+
+  nlsr.getConfParameter().setMaxFacesPerPrefix(2);
+  LinkStateRoutingTableCalculator calculator(map.getMapSize());
+  calculator.calculatePath(map, routingTable, nlsr);
+
+  // As the calculation before the sweep did: for each neighbor, leave
+  // only the link to it out of the source, and run Dijkstra over the matrix
+  for (int neighbor = 1; neighbor < N_ROUTERS; ++neighbor) {
+    if (matrix[0][neighbor] == 0) {
+      continue;
+    }
+
+    std::vector<double> distance(N_ROUTERS, std::numeric_limits<double>::infinity());
+    std::vector<bool> isExplored(N_ROUTERS, false);
+    distance[0] = 0;
+    for (int round = 0; round < N_ROUTERS; ++round) {
+      int u = -1;
+      for (int v = 0; v < N_ROUTERS; ++v) {
+        if (!isExplored[v] && (u < 0 || distance[v] < distance[u])) {
+          u = v;
+        }
+      }
+      isExplored[u] = true;
+      for (int v = 0; v < N_ROUTERS; ++v) {
+        bool isAccessible = matrix[u][v] > 0 && (u != 0 || v == neighbor);
+        if (isAccessible && !isExplored[v] && distance[u] + matrix[u][v] < distance[v]) {
+          distance[v] = distance[u] + matrix[u][v];
+        }
+      }
+    }
+
+    for (int router = 1; router < N_ROUTERS; ++router) {
+      RoutingTableEntry* entry = routingTable.findRoutingTableEntry(names[router]);
+      BOOST_REQUIRE(entry != nullptr);
+
+      auto hop = std::find_if(entry->getNexthopList().begin(), entry->getNexthopList().end(),
+                              [&] (const NextHop& nh) {
+                                return nh.getConnectingFaceUri() == faces[neighbor];
+                              });
+      BOOST_REQUIRE(hop != entry->getNexthopList().end());
+      BOOST_CHECK_EQUAL(hop->getRouteCost(), distance[router]);
+    }
+  }
+
+  // Every neighbor is a next hop for every other router
+  for (int router = 1; router < N_ROUTERS; ++router) {
+    RoutingTableEntry* entry = routingTable.findRoutingTableEntry(names[router]);
+    BOOST_REQUIRE(entry != nullptr);
+    BOOST_CHECK_EQUAL(entry->getNexthopList().getNextHops().size(), 4);
+  }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace test
@@ -0,0 +1,128 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2017,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utility/lock-free-ring-buffer.hpp"
+#include "boost-test.hpp"
+
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace nlsr {
+namespace test {
+
+using util::LockFreeRingBuffer;
+
+BOOST_AUTO_TEST_SUITE(TestLockFreeRingBuffer)
+
+BOOST_AUTO_TEST_CASE(Capacity)
+{
+  LockFreeRingBuffer<int> ring(5);
+  BOOST_CHECK_EQUAL(ring.capacity(), 8);
+}
+
+BOOST_AUTO_TEST_CASE(PushPop)
+{
+  LockFreeRingBuffer<int> ring(4);
+
+  int value = 0;
+  BOOST_CHECK(!ring.tryPop(value));
+
+  // Go around the ring several times
+  for (int round = 0; round < 3; ++round) {
+    for (int i = 0; i < 4; ++i) {
+      value = round * 4 + i;
+      BOOST_CHECK(ring.tryPush(value));
+    }
+
+    value = -1;
+    BOOST_CHECK(!ring.tryPush(value));
+    BOOST_CHECK_EQUAL(value, -1);
+
+    for (int i = 0; i < 4; ++i) {
+      BOOST_REQUIRE(ring.tryPop(value));
+      BOOST_CHECK_EQUAL(value, round * 4 + i);
+    }
+    BOOST_CHECK(!ring.tryPop(value));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(ReleaseOnPop)
+{
+  LockFreeRingBuffer<std::shared_ptr<int>> ring(2);
+
+  std::shared_ptr<int> value = std::make_shared<int>(1);
+  std::weak_ptr<int> weak = value;
+  BOOST_CHECK(ring.tryPush(value));
+  BOOST_CHECK(value == nullptr);
+
+  BOOST_CHECK(ring.tryPop(value));
+  value.reset();
+  BOOST_CHECK(weak.expired());
+}
+
+BOOST_AUTO_TEST_CASE(ManyProducers)
+{
+  const int N_PRODUCERS = 4;
+  const int N_VALUES = 10000;
+
+  LockFreeRingBuffer<int> ring(64);
+
+  std::vector<std::thread> producers;
+  for (int producer = 0; producer < N_PRODUCERS; ++producer) {
+    producers.emplace_back([&ring, producer] {
+        for (int i = 0; i < N_VALUES; ++i) {
+          int value = producer * N_VALUES + i;
+          while (!ring.tryPush(value)) {
+            std::this_thread::yield();
+          }
+        }
+      });
+  }
+
+  // Each producer's values come out in the order it pushed them.
+  std::vector<int> next(N_PRODUCERS, 0);
+  int nPopped = 0;
+  while (nPopped < N_PRODUCERS * N_VALUES) {
+    int value = 0;
+    if (!ring.tryPop(value)) {
+      std::this_thread::yield();
+      continue;
+    }
+
+    int producer = value / N_VALUES;
+    BOOST_REQUIRE_EQUAL(value % N_VALUES, next[producer]);
+    ++next[producer];
+    ++nPopped;
+  }
+
+  for (std::thread& thread : producers) {
+    thread.join();
+  }
+
+  int value = 0;
+  BOOST_CHECK(!ring.tryPop(value));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace test
+} // namespace nlsr
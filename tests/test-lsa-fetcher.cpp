@@ -0,0 +1,237 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2017,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "communication/lsa-fetcher.hpp"
+#include "test-common.hpp"
+#include "nlsr.hpp"
+
+#include <ndn-cxx/util/dummy-client-face.hpp>
+#include <ndn-cxx/util/segment-fetcher.hpp>
+
+namespace nlsr {
+namespace test {
+
+class LsaFetcherFixture : public UnitTestTimeFixture
+{
+public:
+  LsaFetcherFixture()
+    : face(std::make_shared<ndn::util::DummyClientFace>(g_ioService))
+    , nlsr(g_ioService, g_scheduler, std::ref(*face), g_keyChain)
+    , conf(nlsr.getConfParameter())
+    , fetcher(*face, nlsr.getValidator(), g_scheduler, conf,
+              [this] (const ndn::ConstBufferPtr&, const ndn::Name& interestName) {
+                fetched.push_back(interestName);
+              },
+              [] (const ndn::Name&) {},
+              [] (const ndn::Name&) {})
+    , deadline(ndn::time::steady_clock::now() + ndn::time::seconds(60))
+  {
+    conf.setLsaInterestLifetime(ndn::time::seconds(4));
+  }
+
+  ndn::Name
+  makeLsaName(const std::string& router, Lsa::Type lsaType, uint64_t seqNo)
+  {
+    return ndn::Name("/ndn/NLSR/LSA/site/%C1.Router").append(router)
+             .append(std::to_string(lsaType)).appendNumber(seqNo);
+  }
+
+  void
+  receiveFirstSegment(const ndn::Name& interestName)
+  {
+    ndn::Data data(ndn::Name(interestName).appendVersion().appendSegment(0));
+    fetcher.afterSegmentReceived(data, interestName);
+  }
+
+  void
+  complete(const ndn::Name& interestName)
+  {
+    fetcher.afterFetch(std::make_shared<ndn::Buffer>(), interestName);
+  }
+
+public:
+  std::shared_ptr<ndn::util::DummyClientFace> face;
+  Nlsr nlsr;
+  ConfParameter& conf;
+  LsaFetcher fetcher;
+  ndn::time::steady_clock::TimePoint deadline;
+  std::vector<ndn::Name> fetched;
+};
+
+BOOST_FIXTURE_TEST_SUITE(TestLsaFetcher, LsaFetcherFixture)
+
+BOOST_AUTO_TEST_CASE(WindowAndPriority)
+{
+  conf.setLsaFetchWindow(64);
+
+  for (int i = 0; i < 5; ++i) {
+    fetcher.fetch(makeLsaName("router" + std::to_string(i), Lsa::Type::NAME, 1), deadline);
+  }
+  fetcher.fetch(makeLsaName("router0", Lsa::Type::ADJACENCY, 1), deadline);
+  this->advanceClocks(ndn::time::milliseconds(1));
+
+  // The window starts small
+  BOOST_CHECK_EQUAL(face->sentInterests.size(), 4);
+  BOOST_CHECK_EQUAL(fetcher.getNOutstanding(), 4);
+  BOOST_CHECK_EQUAL(fetcher.getQueueSize(), 2);
+  face->sentInterests.clear();
+
+  // A fetch that succeeds grows the window, and adjacency LSAs go first
+  complete(makeLsaName("router0", Lsa::Type::NAME, 1));
+  this->advanceClocks(ndn::time::milliseconds(1));
+
+  BOOST_REQUIRE_EQUAL(face->sentInterests.size(), 2);
+  BOOST_CHECK_EQUAL(face->sentInterests[0].getName(),
+                    makeLsaName("router0", Lsa::Type::ADJACENCY, 1));
+  BOOST_CHECK_EQUAL(face->sentInterests[1].getName(),
+                    makeLsaName("router4", Lsa::Type::NAME, 1));
+  BOOST_CHECK_EQUAL(fetcher.getWindow(), 5);
+  BOOST_CHECK_EQUAL(fetched.size(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(MaxWindow)
+{
+  conf.setLsaFetchWindow(2);
+
+  for (int i = 0; i < 4; ++i) {
+    fetcher.fetch(makeLsaName("router" + std::to_string(i), Lsa::Type::NAME, 1), deadline);
+  }
+  this->advanceClocks(ndn::time::milliseconds(1));
+
+  BOOST_CHECK_EQUAL(face->sentInterests.size(), 2);
+  BOOST_CHECK_EQUAL(fetcher.getQueueSize(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(Deduplication)
+{
+  conf.setLsaFetchWindow(1);
+
+  fetcher.fetch(makeLsaName("router0", Lsa::Type::NAME, 1), deadline);
+  fetcher.fetch(makeLsaName("router1", Lsa::Type::NAME, 1), deadline);
+
+  // Already being fetched
+  fetcher.fetch(makeLsaName("router0", Lsa::Type::NAME, 1), deadline);
+  // Already queued
+  fetcher.fetch(makeLsaName("router1", Lsa::Type::NAME, 1), deadline);
+  // Replaces the queued fetch
+  fetcher.fetch(makeLsaName("router1", Lsa::Type::NAME, 2), deadline);
+  this->advanceClocks(ndn::time::milliseconds(1));
+
+  BOOST_CHECK_EQUAL(face->sentInterests.size(), 1);
+  BOOST_CHECK_EQUAL(fetcher.getQueueSize(), 1);
+  BOOST_CHECK_EQUAL(fetcher.getNDeduplicated(), 3);
+  face->sentInterests.clear();
+
+  complete(makeLsaName("router0", Lsa::Type::NAME, 1));
+  this->advanceClocks(ndn::time::milliseconds(1));
+
+  BOOST_REQUIRE_EQUAL(face->sentInterests.size(), 1);
+  BOOST_CHECK_EQUAL(face->sentInterests[0].getName(), makeLsaName("router1", Lsa::Type::NAME, 2));
+
+  // An LSA that has been superseded is dropped
+  fetcher.fetch(makeLsaName("router1", Lsa::Type::NAME, 3), deadline);
+  complete(makeLsaName("router1", Lsa::Type::NAME, 2));
+  BOOST_CHECK_EQUAL(fetched.size(), 1);
+  complete(makeLsaName("router1", Lsa::Type::NAME, 3));
+  BOOST_CHECK_EQUAL(fetched.size(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(RetransmissionTimeout)
+{
+  ndn::Name router("/ndn/NLSR/LSA/site/%C1.Router/router0");
+
+  // Until there is a sample, the Interest lifetime is lsa-interest-lifetime
+  BOOST_CHECK_EQUAL(fetcher.getRto(router), ndn::time::seconds(4));
+
+  fetcher.fetch(makeLsaName("router0", Lsa::Type::NAME, 1), deadline);
+  this->advanceClocks(ndn::time::milliseconds(100));
+  receiveFirstSegment(makeLsaName("router0", Lsa::Type::NAME, 1));
+
+  // The RTT is taken up to the first segment, not the whole fetch
+  this->advanceClocks(ndn::time::milliseconds(50));
+  complete(makeLsaName("router0", Lsa::Type::NAME, 1));
+
+  // SRTT + 4 * RTTVAR
+  BOOST_CHECK_EQUAL(fetcher.getRto(router), ndn::time::milliseconds(300));
+  BOOST_CHECK_EQUAL(fetcher.getMeanFetchLatency(), ndn::time::milliseconds(150));
+
+  face->sentInterests.clear();
+  fetcher.fetch(makeLsaName("router0", Lsa::Type::ADJACENCY, 1), deadline);
+  this->advanceClocks(ndn::time::milliseconds(1));
+
+  BOOST_REQUIRE_EQUAL(face->sentInterests.size(), 1);
+  BOOST_CHECK_EQUAL(face->sentInterests[0].getInterestLifetime(), ndn::time::milliseconds(300));
+  face->sentInterests.clear();
+
+  // A timeout doubles the timeout and is retransmitted straight away
+  fetcher.onFetchError(ndn::util::SegmentFetcher::ErrorCode::INTEREST_TIMEOUT, "Timeout",
+                       makeLsaName("router0", Lsa::Type::ADJACENCY, 1));
+  this->advanceClocks(ndn::time::milliseconds(1));
+
+  BOOST_REQUIRE_EQUAL(face->sentInterests.size(), 1);
+  BOOST_CHECK_EQUAL(face->sentInterests[0].getInterestLifetime(), ndn::time::milliseconds(600));
+  BOOST_CHECK_EQUAL(fetcher.getNRetransmitted(), 1);
+  BOOST_CHECK_EQUAL(fetcher.getWindow(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(ReplacedSequenceNumber)
+{
+  ndn::Name router("/ndn/NLSR/LSA/site/%C1.Router/router0");
+
+  fetcher.fetch(makeLsaName("router0", Lsa::Type::NAME, 1), deadline);
+  this->advanceClocks(ndn::time::milliseconds(500));
+
+  // A newer sequence number is timed from when it was requested
+  fetcher.fetch(makeLsaName("router0", Lsa::Type::NAME, 2), deadline);
+  this->advanceClocks(ndn::time::milliseconds(100));
+
+  // The first segment of the older sequence number gives no sample
+  receiveFirstSegment(makeLsaName("router0", Lsa::Type::NAME, 1));
+  BOOST_CHECK_EQUAL(fetcher.getRto(router), ndn::time::seconds(4));
+
+  receiveFirstSegment(makeLsaName("router0", Lsa::Type::NAME, 2));
+  complete(makeLsaName("router0", Lsa::Type::NAME, 2));
+
+  BOOST_CHECK_EQUAL(fetcher.getRto(router), ndn::time::milliseconds(300));
+  BOOST_CHECK_EQUAL(fetcher.getMeanFetchLatency(), ndn::time::milliseconds(100));
+  BOOST_CHECK_EQUAL(fetcher.getMaxFetchLatency(), ndn::time::milliseconds(100));
+}
+
+BOOST_AUTO_TEST_CASE(GiveUpAfterDeadline)
+{
+  fetcher.fetch(makeLsaName("router0", Lsa::Type::NAME, 1),
+                ndn::time::steady_clock::now() + ndn::time::seconds(1));
+  this->advanceClocks(ndn::time::milliseconds(1));
+  face->sentInterests.clear();
+
+  this->advanceClocks(ndn::time::seconds(2));
+  fetcher.onFetchError(ndn::util::SegmentFetcher::ErrorCode::INTEREST_TIMEOUT, "Timeout",
+                       makeLsaName("router0", Lsa::Type::NAME, 1));
+  this->advanceClocks(ndn::time::milliseconds(1));
+
+  BOOST_CHECK_EQUAL(face->sentInterests.size(), 0);
+  BOOST_CHECK_EQUAL(fetcher.getNOutstanding(), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace test
+} // namespace nlsr
@@ -0,0 +1,76 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2017,  The University of Memphis,
+ *                           Regents of the University of California
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "lsa-table.hpp"
+#include "lsa.hpp"
+
+#include "test-common.hpp"
+
+namespace nlsr {
+namespace test {
+
+BOOST_AUTO_TEST_SUITE(TestLsaTable)
+
+BOOST_AUTO_TEST_CASE(InsertFindErase)
+{
+  LsaTable<NameLsa> table;
+  NamePrefixList npl;
+
+  NameLsa lsaA("/router/a", 1, ndn::time::system_clock::now(), npl);
+  NameLsa lsaB("/router/b", 1, ndn::time::system_clock::now(), npl);
+  NameLsa lsaC("/router/c", 1, ndn::time::system_clock::now(), npl);
+
+  BOOST_CHECK(table.insert(lsaA));
+  BOOST_CHECK(table.insert(lsaB));
+  BOOST_CHECK(table.insert(lsaC));
+  BOOST_CHECK_EQUAL(table.size(), 3);
+
+  // Only one LSA per key
+  NameLsa newerLsaB("/router/b", 2, ndn::time::system_clock::now(), npl);
+  BOOST_CHECK(!table.insert(newerLsaB));
+  BOOST_CHECK_EQUAL(table.find(lsaB.getKey())->getLsSeqNo(), 1);
+
+  NameLsa* foundC = table.find(lsaC.getKey());
+  BOOST_REQUIRE(foundC != nullptr);
+  BOOST_CHECK_EQUAL(foundC->getOrigRouter(), "/router/c");
+  BOOST_CHECK(table.contains(lsaA.getKey()));
+  BOOST_CHECK(table.find(ndn::Name("/router/d/NAME")) == nullptr);
+
+  // Erasing one LSA leaves pointers to the others valid
+  BOOST_CHECK(table.erase(lsaB.getKey()));
+  BOOST_CHECK(!table.erase(lsaB.getKey()));
+  BOOST_CHECK(!table.contains(lsaB.getKey()));
+  BOOST_CHECK_EQUAL(table.find(lsaC.getKey()), foundC);
+
+  // Iteration is in insertion order
+  BOOST_CHECK(table.insert(newerLsaB));
+  std::vector<ndn::Name> routers;
+  for (const NameLsa& lsa : table.getLsas()) {
+    routers.push_back(lsa.getOrigRouter());
+  }
+  std::vector<ndn::Name> expected{"/router/a", "/router/c", "/router/b"};
+  BOOST_CHECK_EQUAL_COLLECTIONS(routers.begin(), routers.end(),
+                                expected.begin(), expected.end());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace test
+} // namespace nlsr
@@ -23,7 +23,10 @@
 #include "test-common.hpp"
 #include "adjacent.hpp"
 #include "name-prefix-list.hpp"
+#include "tlv/tlv-nlsr.hpp"
 
+#include <ndn-cxx/data.hpp>
+#include <ndn-cxx/encoding/block-helpers.hpp>
 #include <ndn-cxx/util/time.hpp>
 #include <sstream>
 
@@ -200,6 +203,119 @@ BOOST_AUTO_TEST_CASE(TestInitializeFromContent)
   BOOST_CHECK_EQUAL(clsa1.serialize(), clsa2.serialize());
 }
 
+BOOST_AUTO_TEST_CASE(TestWireEncodeDecode)
+{
+  Adjacent adj1("adjacent1", ndn::util::FaceUri("udp://10.0.0.1"), 10,
+                Adjacent::STATUS_ACTIVE, 0, 0);
+  Adjacent adj2("adjacent2", ndn::util::FaceUri("udp://10.0.0.2"), 25,
+                Adjacent::STATUS_ACTIVE, 0, 0);
+
+  AdjacencyList adjList;
+  adjList.insert(adj1);
+  adjList.insert(adj2);
+
+  // The expiration time is encoded in milliseconds
+  ndn::time::system_clock::TimePoint testTimePoint =
+    ndn::time::fromUnixTimestamp(ndn::time::toUnixTimestamp(ndn::time::system_clock::now()));
+
+  //Adj LSA
+  AdjLsa adjlsa1("/router1", 1, testTimePoint, adjList.size(), adjList);
+  ndn::ConstBufferPtr adjContent = adjlsa1.encodeContent(LSA_CONTENT_FORMAT_TLV);
+  AdjLsa adjlsa2;
+
+  BOOST_CHECK(adjlsa2.decodeContent(adjContent->data(), adjContent->size()));
+  BOOST_CHECK(adjlsa1.isEqualContent(adjlsa2));
+  BOOST_CHECK_EQUAL(adjlsa2.getOrigRouter(), "/router1");
+  BOOST_CHECK_EQUAL(adjlsa2.getLsSeqNo(), 1);
+  BOOST_CHECK(adjlsa2.getExpirationTimePoint() == testTimePoint);
+
+  //Name LSA
+  NamePrefixList npl1{ndn::Name("name1"), ndn::Name("name2")};
+  NameLsa nlsa1("/router1", 2, testTimePoint, npl1);
+  ndn::ConstBufferPtr nameContent = nlsa1.encodeContent(LSA_CONTENT_FORMAT_TLV);
+  NameLsa nlsa2;
+
+  BOOST_CHECK(nlsa2.decodeContent(nameContent->data(), nameContent->size()));
+  BOOST_CHECK_EQUAL(nlsa1.serialize(), nlsa2.serialize());
+
+  // The TLV encoding is smaller than the text
+  BOOST_CHECK_LT(nameContent->size(), nlsa1.encodeContent(LSA_CONTENT_FORMAT_TEXT)->size());
+
+  //Coordinate LSA
+  std::vector<double> angles = {30, 40.125};
+  CoordinateLsa clsa1("/router1", 12, testTimePoint, 2.5, angles);
+  ndn::ConstBufferPtr corContent = clsa1.encodeContent(LSA_CONTENT_FORMAT_TLV);
+  CoordinateLsa clsa2;
+
+  BOOST_CHECK(clsa2.decodeContent(corContent->data(), corContent->size()));
+  BOOST_CHECK_EQUAL(clsa1.serialize(), clsa2.serialize());
+
+  // An LSA of another type is not accepted
+  NameLsa nlsa3;
+  BOOST_CHECK(!nlsa3.decodeContent(corContent->data(), corContent->size()));
+}
+
+BOOST_AUTO_TEST_CASE(MixedContentFormats)
+{
+  NamePrefixList npl{ndn::Name("/name1"), ndn::Name("/name2")};
+  NameLsa nlsa1("/router1", 2, ndn::time::system_clock::now(), npl);
+
+  // A router that has not been upgraded sends text, which is still read
+  std::string text = nlsa1.serialize();
+  NameLsa nlsa2;
+  BOOST_CHECK(nlsa2.decodeContent(reinterpret_cast<const uint8_t*>(text.data()), text.size()));
+  BOOST_CHECK(nlsa2.isEqualContent(nlsa1));
+
+  // An upgraded router publishing text sends what a router that has not
+  // been upgraded reads
+  ndn::ConstBufferPtr textContent = nlsa1.encodeContent(LSA_CONTENT_FORMAT_TEXT);
+  BOOST_CHECK_EQUAL(std::string(textContent->begin(), textContent->end()), text);
+  NameLsa nlsa3;
+  BOOST_CHECK(nlsa3.deserialize(std::string(textContent->begin(), textContent->end())));
+  BOOST_CHECK(nlsa3.isEqualContent(nlsa1));
+
+  // The TLV format says which version it is
+  ndn::ConstBufferPtr tlvContent = nlsa1.encodeContent(LSA_CONTENT_FORMAT_TLV);
+  ndn::Block versioned(tlvContent);
+  BOOST_CHECK_EQUAL(versioned.type(), tlv::LsaContent);
+  versioned.parse();
+  BOOST_CHECK_EQUAL(ndn::readNonNegativeInteger(versioned.get(tlv::LsaContentVersion)),
+                    Lsa::CONTENT_VERSION);
+
+  // A version that this router does not know is rejected
+  ndn::Block unknown(tlv::LsaContent);
+  unknown.push_back(ndn::makeNonNegativeIntegerBlock(tlv::LsaContentVersion,
+                                                     Lsa::CONTENT_VERSION + 1));
+  unknown.push_back(nlsa1.wireEncode());
+  unknown.encode();
+  NameLsa nlsa4;
+  BOOST_CHECK(!nlsa4.decodeContent(unknown.wire(), unknown.size()));
+
+  // A TLV-encoded LSA without its version is not guessed at
+  ndn::Block unversioned = nlsa1.wireEncode();
+  NameLsa nlsa5;
+  BOOST_CHECK(!nlsa5.decodeContent(unversioned.wire(), unversioned.size()));
+}
+
+BOOST_AUTO_TEST_CASE(DecodeContentSharesBuffer)
+{
+  NamePrefixList npl{ndn::Name("/name1"), ndn::Name("/name2")};
+  NameLsa nlsa1("/router1", 2, ndn::time::system_clock::now(), npl);
+  ndn::ConstBufferPtr content = nlsa1.encodeContent(LSA_CONTENT_FORMAT_TLV);
+
+  ndn::Data data("/ndn/NLSR/LSA/router1/NAME/2");
+  data.setContent(content->data(), content->size());
+
+  NameLsa nlsa2;
+  BOOST_REQUIRE(nlsa2.decodeContent(data.getContent()));
+  BOOST_REQUIRE_EQUAL(nlsa2.getNpl().size(), 2);
+
+  // The decoded names point into the content instead of copies of it
+  const ndn::Name& name = std::get<NamePrefixList::NamePairIndex::NAME>(*nlsa2.getNpl().begin());
+  BOOST_CHECK_EQUAL(name, "/name1");
+  BOOST_CHECK(name.wireEncode().getBuffer() == data.getContent().getBuffer());
+}
+
 BOOST_AUTO_TEST_SUITE(TestNameLsa)
 
 BOOST_AUTO_TEST_CASE(OperatorEquals)
@@ -0,0 +1,105 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2017,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "lsdb-change-log.hpp"
+#include "test-common.hpp"
+
+namespace nlsr {
+namespace test {
+
+BOOST_AUTO_TEST_SUITE(TestLsdbChangeLog)
+
+BOOST_AUTO_TEST_CASE(Record)
+{
+  LsdbChangeLog changeLog;
+  BOOST_CHECK_EQUAL(changeLog.getLastSequenceNumber(), 0);
+  BOOST_CHECK(changeLog.findAfter(changeLog.getEpoch(), 0) == changeLog.getChanges().end());
+
+  NamePrefixList npl;
+  NameLsa lsa("/router1", 12, ndn::time::system_clock::now(), npl);
+  changeLog.record(LsdbChange::Kind::INSTALLED, lsa);
+  lsa.setLsSeqNo(13);
+  changeLog.record(LsdbChange::Kind::UPDATED, lsa);
+
+  BOOST_CHECK_EQUAL(changeLog.getLastSequenceNumber(), 2);
+  BOOST_REQUIRE_EQUAL(changeLog.getChanges().size(), 2);
+
+  const LsdbChange& change = changeLog.getChanges().back();
+  BOOST_CHECK_EQUAL(change.epoch, changeLog.getEpoch());
+  BOOST_CHECK_EQUAL(change.sequenceNumber, 2);
+  BOOST_CHECK(change.kind == LsdbChange::Kind::UPDATED);
+  BOOST_CHECK_EQUAL(change.lsaType, Lsa::Type::NAME);
+  BOOST_CHECK_EQUAL(change.originRouter, "/router1");
+  BOOST_CHECK_EQUAL(change.lsaSequenceNumber, 13);
+}
+
+BOOST_AUTO_TEST_CASE(FindAfter)
+{
+  LsdbChangeLog changeLog(3);
+
+  NamePrefixList npl;
+  NameLsa lsa("/router1", 1, ndn::time::system_clock::now(), npl);
+  for (int i = 0; i < 5; ++i) {
+    changeLog.record(LsdbChange::Kind::UPDATED, lsa);
+  }
+
+  // Only the last three changes are kept
+  BOOST_CHECK_EQUAL(changeLog.getLastSequenceNumber(), 5);
+  BOOST_REQUIRE_EQUAL(changeLog.getChanges().size(), 3);
+  BOOST_CHECK_EQUAL(changeLog.getChanges().front().sequenceNumber, 3);
+
+  uint64_t epoch = changeLog.getEpoch();
+  BOOST_CHECK_EQUAL(changeLog.findAfter(epoch, 3)->sequenceNumber, 4);
+  BOOST_CHECK_EQUAL(changeLog.findAfter(epoch, 4)->sequenceNumber, 5);
+  BOOST_CHECK(changeLog.findAfter(epoch, 5) == changeLog.getChanges().end());
+
+  // A consumer that has fallen behind finds a gap
+  BOOST_CHECK_EQUAL(changeLog.findAfter(epoch, 0)->sequenceNumber, 3);
+  BOOST_CHECK_EQUAL(changeLog.findAfter(epoch, 1)->sequenceNumber, 3);
+}
+
+BOOST_AUTO_TEST_CASE(Restart)
+{
+  NamePrefixList npl;
+  NameLsa lsa("/router1", 1, ndn::time::system_clock::now(), npl);
+
+  LsdbChangeLog before;
+  for (int i = 0; i < 5; ++i) {
+    before.record(LsdbChange::Kind::UPDATED, lsa);
+  }
+
+  // After a restart, the changes are numbered from 1 again, in a new epoch
+  LsdbChangeLog after;
+  for (int i = 0; i < 7; ++i) {
+    after.record(LsdbChange::Kind::UPDATED, lsa);
+  }
+  BOOST_CHECK_NE(after.getEpoch(), before.getEpoch());
+
+  // A consumer that has seen changes from before the restart gets all of
+  // them, even those numbered after the last one it saw
+  BOOST_CHECK_EQUAL(after.findAfter(before.getEpoch(), 5)->sequenceNumber, 1);
+  BOOST_CHECK(after.findAfter(before.getEpoch(), 5)->epoch == after.getEpoch());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace test
+} // namespace nlsr
@@ -108,7 +108,7 @@ BOOST_AUTO_TEST_CASE(LsdbSync)
   ndn::Name oldInterestName = interestName;
   oldInterestName.appendNumber(oldSeqNo);
 
-  lsdb.expressInterest(oldInterestName, 0);
+  lsdb.expressInterest(oldInterestName);
   face->processEvents(ndn::time::milliseconds(1));
 
   std::vector<ndn::Interest>& interests = face->sentInterests;
@@ -123,12 +123,9 @@ BOOST_AUTO_TEST_CASE(LsdbSync)
   BOOST_CHECK(didFindInterest);
   interests.clear();
 
-  ndn::time::steady_clock::TimePoint deadline = ndn::time::steady_clock::now() +
-    ndn::time::seconds(LSA_REFRESH_TIME_MAX);
-
   // Simulate an LSA interest timeout
-  lsdb.onFetchLsaError(ndn::util::SegmentFetcher::ErrorCode::INTEREST_TIMEOUT, "Timeout",
-                       oldInterestName, 0, deadline, interestName, oldSeqNo);
+  lsdb.getLsaFetcher().onFetchError(ndn::util::SegmentFetcher::ErrorCode::INTEREST_TIMEOUT,
+                                    "Timeout", oldInterestName);
   face->processEvents(ndn::time::milliseconds(1));
 
   BOOST_REQUIRE(interests.size() > 0);
@@ -146,7 +143,7 @@ BOOST_AUTO_TEST_CASE(LsdbSync)
   ndn::Name newInterestName = interestName;
   newInterestName.appendNumber(newSeqNo);
 
-  lsdb.expressInterest(newInterestName, 0);
+  lsdb.expressInterest(newInterestName);
   face->processEvents(ndn::time::milliseconds(1));
 
   BOOST_REQUIRE(interests.size() > 0);
@@ -161,8 +158,8 @@ BOOST_AUTO_TEST_CASE(LsdbSync)
   interests.clear();
 
   // Simulate an LSA interest timeout where the sequence number is outdated
-  lsdb.onFetchLsaError(ndn::util::SegmentFetcher::ErrorCode::INTEREST_TIMEOUT, "Timeout",
-                       oldInterestName, 0, deadline, interestName, oldSeqNo);
+  lsdb.getLsaFetcher().onFetchError(ndn::util::SegmentFetcher::ErrorCode::INTEREST_TIMEOUT,
+                                    "Timeout", oldInterestName);
   face->processEvents(ndn::time::milliseconds(1));
 
   // Interest should not be expressed for outdated sequence number
@@ -180,11 +177,12 @@ BOOST_AUTO_TEST_CASE(SegmentLsaData)
   ndn::Name prefix("/ndn/edu/memphis/netlab/research/nlsr/test/prefix/");
 
   int nPrefixes = 0;
-  while (lsa.serialize().size() < ndn::MAX_NDN_PACKET_SIZE) {
+  while (lsa.encodeContent(conf.getLsaContentFormat())->size() < ndn::MAX_NDN_PACKET_SIZE) {
     lsa.addName(ndn::Name(prefix).appendNumber(++nPrefixes));
   }
 
-  std::string expectedDataContent = lsa.serialize();
+  ndn::ConstBufferPtr expectedContent = lsa.encodeContent(conf.getLsaContentFormat());
+  std::string expectedDataContent(expectedContent->begin(), expectedContent->end());
   lsdb.installNameLsa(lsa);
 
   ndn::Name interestName("/ndn/NLSR/LSA/cs/%C1.Router/router1/NAME/");
@@ -195,18 +193,153 @@ BOOST_AUTO_TEST_CASE(SegmentLsaData)
   lsdb.processInterest(ndn::Name(), interest);
   face->processEvents(ndn::time::milliseconds(1));
 
-  std::vector<ndn::Data> data = face->sentData;
+  // Only the first segment is sent until the others are asked for
+  BOOST_REQUIRE_EQUAL(face->sentData.size(), 1);
+
   std::string recvDataContent;
-  for (unsigned int i = 0; i < data.size(); ++i)
-  {
-    const ndn::Block& nameBlock = data[i].getContent();
+  for (uint64_t segmentNo = 1; ; ++segmentNo) {
+    const ndn::Data& data = face->sentData.back();
+    const ndn::Block& nameBlock = data.getContent();
 
     std::string nameBlockContent(reinterpret_cast<char const*>(nameBlock.value()),
                                  nameBlock.value_size());
     recvDataContent += nameBlockContent;
+
+    if (data.getFinalBlockId() == data.getName()[-1]) {
+      break;
+    }
+
+    ndn::Name segmentName = data.getName().getPrefix(-1).appendSegment(segmentNo);
+    lsdb.processInterest(ndn::Name(), ndn::Interest(segmentName));
+    face->processEvents(ndn::time::milliseconds(1));
+    BOOST_REQUIRE_EQUAL(face->sentData.size(), segmentNo + 1);
   }
 
   BOOST_CHECK_EQUAL(expectedDataContent, recvDataContent);
+
+  // There is no segment past the last one
+  size_t nSegments = face->sentData.size();
+  BOOST_CHECK_GT(nSegments, 1);
+  ndn::Name pastLastName = face->sentData.back().getName().getPrefix(-1).appendSegment(nSegments);
+  lsdb.processInterest(ndn::Name(), ndn::Interest(pastLastName));
+  face->processEvents(ndn::time::milliseconds(1));
+  BOOST_CHECK_EQUAL(face->sentData.size(), nSegments);
+}
+
+BOOST_AUTO_TEST_CASE(SegmentLsaDataAfterEviction)
+{
+  ndn::Name router("/ndn/cs/%C1.Router/router1");
+  uint64_t seqNo = 12;
+  NamePrefixList prefixList;
+
+  NameLsa lsa(router, seqNo, ndn::time::system_clock::now(), prefixList);
+
+  ndn::Name prefix("/ndn/edu/memphis/netlab/research/nlsr/test/prefix/");
+
+  int nPrefixes = 0;
+  while (lsa.encodeContent(conf.getLsaContentFormat())->size() < ndn::MAX_NDN_PACKET_SIZE) {
+    lsa.addName(ndn::Name(prefix).appendNumber(++nPrefixes));
+  }
+  lsdb.installNameLsa(lsa);
+
+  ndn::Name interestName("/ndn/NLSR/LSA/cs/%C1.Router/router1/NAME/");
+  interestName.appendNumber(seqNo);
+
+  lsdb.processInterest(ndn::Name(), ndn::Interest(interestName));
+  face->processEvents(ndn::time::milliseconds(1));
+  BOOST_REQUIRE_EQUAL(face->sentData.size(), 1);
+
+  // The version of the segments is the sequence number of the LSA
+  ndn::Name versionedPrefix = face->sentData.back().getName().getPrefix(-1);
+  BOOST_CHECK_EQUAL(versionedPrefix, ndn::Name(interestName).appendVersion(seqNo));
+
+  // The segments are prepared again when the publisher has been dropped
+  lsdb.m_lsaSegmentCache.erase(lsa.getKey());
+  lsdb.processInterest(ndn::Name(), ndn::Interest(ndn::Name(versionedPrefix).appendSegment(1)));
+  face->processEvents(ndn::time::milliseconds(1));
+  BOOST_REQUIRE_EQUAL(face->sentData.size(), 2);
+  BOOST_CHECK_EQUAL(face->sentData.back().getName(), ndn::Name(versionedPrefix).appendSegment(1));
+  BOOST_CHECK_EQUAL(lsdb.m_lsaSegmentCache.size(), 1);
+
+  // A version that is no longer in the LSDB is not served
+  lsdb.m_lsaSegmentCache.erase(lsa.getKey());
+  NameLsa newLsa(router, seqNo + 1, ndn::time::system_clock::now(), prefixList);
+  lsdb.installNameLsa(newLsa);
+  lsdb.processInterest(ndn::Name(), ndn::Interest(ndn::Name(versionedPrefix).appendSegment(1)));
+  face->processEvents(ndn::time::milliseconds(1));
+  BOOST_CHECK_EQUAL(face->sentData.size(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(LsaContentFormat)
+{
+  ndn::Name router("/ndn/cs/%C1.Router/router1");
+  uint64_t seqNo = 12;
+  NamePrefixList prefixList{ndn::Name("/prefix/1")};
+
+  ndn::Name interestName("/ndn/NLSR/LSA/cs/%C1.Router/router1/NAME/");
+
+  // Text is published until TLV is configured
+  NameLsa lsa(router, seqNo, ndn::time::system_clock::now(), prefixList);
+  lsdb.installNameLsa(lsa);
+  lsdb.processInterest(ndn::Name(), ndn::Interest(ndn::Name(interestName).appendNumber(seqNo)));
+  face->processEvents(ndn::time::milliseconds(1));
+
+  BOOST_REQUIRE_EQUAL(face->sentData.size(), 1);
+  const ndn::Block& textContent = face->sentData.back().getContent();
+  BOOST_CHECK_EQUAL(std::string(textContent.value_begin(), textContent.value_end()),
+                    lsa.serialize());
+
+  conf.setLsaContentFormat(LSA_CONTENT_FORMAT_TLV);
+  NameLsa newLsa(router, seqNo + 1, ndn::time::system_clock::now(), prefixList);
+  lsdb.installNameLsa(newLsa);
+  lsdb.processInterest(ndn::Name(), ndn::Interest(ndn::Name(interestName).appendNumber(seqNo + 1)));
+  face->processEvents(ndn::time::milliseconds(1));
+
+  BOOST_REQUIRE_EQUAL(face->sentData.size(), 2);
+  const ndn::Block& tlvContent = face->sentData.back().getContent();
+  BOOST_CHECK_EQUAL(*tlvContent.value_begin(), tlv::LsaContent);
+
+  NameLsa decoded;
+  BOOST_REQUIRE(decoded.decodeContent(tlvContent));
+  BOOST_CHECK(decoded.isEqualContent(newLsa));
+}
+
+BOOST_AUTO_TEST_CASE(CachedLsaData)
+{
+  ndn::Name router("/ndn/cs/%C1.Router/router1");
+  uint64_t seqNo = 12;
+  NamePrefixList prefixList{ndn::Name("/prefix/1")};
+
+  NameLsa lsa(router, seqNo, ndn::time::system_clock::now(), prefixList);
+  lsdb.installNameLsa(lsa);
+
+  ndn::Name interestName("/ndn/NLSR/LSA/cs/%C1.Router/router1/NAME/");
+  interestName.appendNumber(seqNo);
+
+  // The second neighbor asking for the same LSA gets the same signed Data
+  lsdb.processInterest(ndn::Name(), ndn::Interest(interestName));
+  lsdb.processInterest(ndn::Name(), ndn::Interest(interestName));
+  face->processEvents(ndn::time::milliseconds(1));
+
+  BOOST_REQUIRE_EQUAL(face->sentData.size(), 2);
+  BOOST_CHECK_EQUAL(face->sentData[0].wireEncode(), face->sentData[1].wireEncode());
+  BOOST_CHECK_EQUAL(lsdb.m_lsaSegmentCache.getNMisses(), 1);
+  BOOST_CHECK_EQUAL(lsdb.m_lsaSegmentCache.getNHits(), 1);
+
+  // A new version of the LSA is signed again
+  NameLsa newLsa(router, seqNo + 1, ndn::time::system_clock::now(), prefixList);
+  lsdb.installNameLsa(newLsa);
+
+  ndn::Name newInterestName("/ndn/NLSR/LSA/cs/%C1.Router/router1/NAME/");
+  newInterestName.appendNumber(seqNo + 1);
+  lsdb.processInterest(ndn::Name(), ndn::Interest(newInterestName));
+
+  BOOST_CHECK_EQUAL(lsdb.m_lsaSegmentCache.getNMisses(), 2);
+  BOOST_CHECK_EQUAL(lsdb.m_lsaSegmentCache.size(), 1);
+
+  // Removing the LSA drops its segments
+  lsdb.removeNameLsa(lsa.getKey());
+  BOOST_CHECK_EQUAL(lsdb.m_lsaSegmentCache.size(), 0);
 }
 
 BOOST_AUTO_TEST_CASE(ReceiveSegmentedLsaData)
@@ -357,7 +490,129 @@ BOOST_AUTO_TEST_CASE(TestIsLsaNew)
   BOOST_CHECK(lsdb.isLsaNew(originRouter, Lsa::Type::NAME, higherSeqNo));
 }
 
+BOOST_AUTO_TEST_CASE(SyncFetchHoldsRoutingCalculation)
+{
+  ndn::Name updateName = conf.getLsaPrefix();
+  updateName.append("site").append("%C1.Router").append("other-router")
+            .append(std::to_string(Lsa::Type::ADJACENCY));
+
+  (*lsdb.getSyncLogicHandler().onNewLsa)(updateName, 1);
+  (*lsdb.getSyncLogicHandler().afterBatch)();
+  BOOST_CHECK(lsdb.getLsaFetcher().isFetching(updateName));
+
+  // An LSA installed while the announced LSA is fetched does not
+  // trigger a calculation of its own
+  nlsr.setIsRouteCalculationScheduled(false);
+  AdjacencyList adjacencies;
+  AdjLsa lsa("/ndn/site/%C1.Router/another-router", 1,
+             ndn::time::system_clock::TimePoint::max(), 0, adjacencies);
+  lsdb.installAdjLsa(lsa);
+  BOOST_CHECK(!nlsr.getIsRouteCalculationScheduled());
+
+  // The calculation runs once the fetch has completed or failed
+  lsdb.getLsaFetcher().onFetchError(ndn::util::SegmentFetcher::ErrorCode::INTEREST_TIMEOUT,
+                                    "Timeout", ndn::Name(updateName).appendNumber(1));
+  BOOST_CHECK(nlsr.getIsRouteCalculationScheduled());
+}
+
 BOOST_AUTO_TEST_SUITE_END() // TestLsdb
 
+class SyncHoldFixture : public UnitTestTimeFixture
+{
+public:
+  SyncHoldFixture()
+    : face(std::make_shared<ndn::util::DummyClientFace>(g_ioService))
+    , nlsr(g_ioService, g_scheduler, std::ref(*face), g_keyChain)
+    , lsdb(nlsr.getLsdb())
+    , conf(nlsr.getConfParameter())
+  {
+    conf.setNetwork("/ndn");
+    conf.setSiteName("/site");
+    conf.setRouterName("/%C1.router/this-router");
+
+    nlsr.initialize();
+    advanceClocks(ndn::time::milliseconds(1), 10);
+  }
+
+  /*! \brief Announces the adjacency LSA of another router in a sync batch of its own.
+   */
+  void
+  announce(const std::string& router)
+  {
+    ndn::Name updateName = conf.getLsaPrefix();
+    updateName.append("site").append("%C1.Router").append(router)
+              .append(std::to_string(Lsa::Type::ADJACENCY));
+
+    (*lsdb.getSyncLogicHandler().onNewLsa)(updateName, 1);
+    (*lsdb.getSyncLogicHandler().afterBatch)();
+  }
+
+  void
+  install(const std::string& router)
+  {
+    AdjacencyList adjacencies;
+    AdjLsa lsa(ndn::Name("/ndn/site/%C1.Router").append(router), 1,
+               ndn::time::system_clock::TimePoint::max(), 0, adjacencies);
+    lsdb.installAdjLsa(lsa);
+  }
+
+  /*! \brief Returns how many calculations the LSDB has asked the routing table for.
+   */
+  uint64_t
+  getNRoutingCalcRequests()
+  {
+    return nlsr.getRoutingTable().getNRoutingCalcsTriggered() +
+           nlsr.getRoutingTable().getNRoutingCalcsCoalesced();
+  }
+
+public:
+  std::shared_ptr<ndn::util::DummyClientFace> face;
+  Nlsr nlsr;
+  Lsdb& lsdb;
+  ConfParameter& conf;
+};
+
+BOOST_FIXTURE_TEST_SUITE(TestLsdbSyncHold, SyncHoldFixture)
+
+BOOST_AUTO_TEST_CASE(HoldIsCappedUnderChurn)
+{
+  announce("router0");
+  uint64_t nRequests = getNRoutingCalcRequests();
+  install("router0");
+  BOOST_CHECK_EQUAL(getNRoutingCalcRequests(), nRequests);
+
+  // Later batches keep announcing LSAs, but do not extend the hold
+  ndn::time::nanoseconds elapsed(0);
+  for (int i = 1; getNRoutingCalcRequests() == nRequests &&
+                  elapsed <= conf.getLsaInterestLifetime(); ++i) {
+    advanceClocks(ndn::time::milliseconds(100));
+    elapsed += ndn::time::milliseconds(100);
+
+    announce("router" + std::to_string(i));
+    install("router" + std::to_string(i));
+  }
+
+  BOOST_CHECK_GT(getNRoutingCalcRequests(), nRequests);
+  BOOST_CHECK_LE(elapsed, conf.getLsaInterestLifetime());
+}
+
+BOOST_AUTO_TEST_CASE(LocalChangeIsNotHeld)
+{
+  announce("router0");
+  uint64_t nRequests = getNRoutingCalcRequests();
+  install("router0");
+  BOOST_CHECK_EQUAL(getNRoutingCalcRequests(), nRequests);
+
+  // A change to this router's adjacencies releases the held calculation
+  lsdb.scheduleRoutingTableCalculation(conf.getRouterPrefix());
+  BOOST_CHECK_EQUAL(getNRoutingCalcRequests(), nRequests + 1);
+
+  // The hold is over, so the next LSA is not held back either
+  install("router1");
+  BOOST_CHECK_EQUAL(getNRoutingCalcRequests(), nRequests + 2);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestLsdbSyncHold
+
 } // namespace test
 } // namespace nlsr
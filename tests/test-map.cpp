@@ -42,6 +42,38 @@ BOOST_AUTO_TEST_CASE(MapAddElementAndSize)
   BOOST_CHECK_EQUAL(map1.getMapSize(), 2);
 }
 
+BOOST_AUTO_TEST_CASE(MappingNumbers)
+{
+  Map map1;
+  map1.addEntry(ndn::Name("/ndn/r1"));
+  map1.addEntry(ndn::Name("/ndn/r2"));
+  map1.addEntry(ndn::Name("/ndn/r1"));
+
+  BOOST_CHECK_EQUAL(map1.getMapSize(), 2);
+  BOOST_CHECK_EQUAL(*map1.getMappingNoByRouterName("/ndn/r1"), 0);
+  BOOST_CHECK_EQUAL(*map1.getMappingNoByRouterName("/ndn/r2"), 1);
+  BOOST_CHECK_EQUAL(map1.getRouterName(1), ndn::Name("/ndn/r2"));
+  BOOST_CHECK(!map1.getMappingNoByRouterName("/ndn/r3"));
+  BOOST_CHECK(!map1.getRouterNameByMappingNo(2));
+
+  // Mapping numbers are dense in each map, whichever routers other maps have seen
+  Map map2;
+  map2.addEntry(ndn::Name("/ndn/r3"));
+  map2.addEntry(ndn::Name("/ndn/r2"));
+
+  BOOST_CHECK_EQUAL(*map2.getMappingNoByRouterName("/ndn/r3"), 0);
+  BOOST_CHECK_EQUAL(*map2.getMappingNoByRouterName("/ndn/r2"), 1);
+  BOOST_CHECK(!map2.getMappingNoByRouterName("/ndn/r1"));
+
+  map1.reset();
+  BOOST_CHECK_EQUAL(map1.getMapSize(), 0);
+  BOOST_CHECK(!map1.getMappingNoByRouterName("/ndn/r1"));
+
+  map1.addEntry(ndn::Name("/ndn/r2"));
+  BOOST_CHECK_EQUAL(*map1.getMappingNoByRouterName("/ndn/r2"), 0);
+  BOOST_CHECK_EQUAL(*map1.getRouterNameByMappingNo(0), ndn::Name("/ndn/r2"));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace test
@@ -189,6 +189,22 @@ BOOST_AUTO_TEST_CASE(BraceInitializerCtors)
   BOOST_CHECK(list1 == list4);
 }
 
+BOOST_AUTO_TEST_CASE(MoveNamesIn)
+{
+  const ndn::Name name1{"/ndn/test/name1"};
+  const ndn::Name name2{"/ndn/test/name2"};
+  const ndn::Name name3{"/ndn/test/name3"};
+
+  std::vector<ndn::Name> names{name3, name1, name2, name1};
+  NamePrefixList list(std::move(names));
+
+  // Duplicates are dropped and the names are sorted
+  NamePrefixList expected{name1, name2, name3};
+  BOOST_CHECK_EQUAL(list.size(), 3);
+  BOOST_CHECK(list == expected);
+  BOOST_CHECK_EQUAL(list.countSources(name1), 1);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace test
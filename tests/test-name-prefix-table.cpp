@@ -187,7 +187,7 @@ BOOST_FIXTURE_TEST_CASE(RemoveRoutingEntryFromNptEntry, NamePrefixTableFixture)
   RoutingTablePoolEntry rtpe1("/ndn/memphis/rtr1", 0);
 
   NamePrefixTableEntry npte1("/ndn/memphis/rtr2");
-  npt.m_table.push_back(make_shared<NamePrefixTableEntry>(npte1));
+  npt.insertEntry(make_shared<NamePrefixTableEntry>(npte1));
 
   npt.addEntry("/ndn/memphis/rtr2", "/ndn/memphis/rtr1");
   npt.addEntry("/ndn/memphis/rtr2", "/ndn/memphis/altrtr");
@@ -211,7 +211,7 @@ BOOST_FIXTURE_TEST_CASE(AddNptEntryPtrToRoutingEntry, NamePrefixTableFixture)
 {
   NamePrefixTable& npt = nlsr.getNamePrefixTable();
   NamePrefixTableEntry npte1("/ndn/memphis/rtr2");
-  npt.m_table.push_back(make_shared<NamePrefixTableEntry>(npte1));
+  npt.insertEntry(make_shared<NamePrefixTableEntry>(npte1));
 
   npt.addEntry("/ndn/memphis/rtr2", "/ndn/memphis/rtr1");
 
@@ -240,8 +240,8 @@ BOOST_FIXTURE_TEST_CASE(RemoveNptEntryPtrFromRoutingEntry, NamePrefixTableFixtur
   NamePrefixTableEntry npte1("/ndn/memphis/rtr1");
   NamePrefixTableEntry npte2("/ndn/memphis/rtr2");
   RoutingTableEntry rte1("/ndn/memphis/destination1");
-  npt.m_table.push_back(make_shared<NamePrefixTableEntry>(npte1));
-  npt.m_table.push_back(make_shared<NamePrefixTableEntry>(npte2));
+  npt.insertEntry(make_shared<NamePrefixTableEntry>(npte1));
+  npt.insertEntry(make_shared<NamePrefixTableEntry>(npte2));
 
   npt.addEntry(npte1.getNamePrefix(), rte1.getDestination());
   // We have to add two entries, otherwise the routing pool entry will be deleted.
@@ -315,6 +315,78 @@ BOOST_FIXTURE_TEST_CASE(RoutingTableUpdate, NamePrefixTableFixture)
   BOOST_CHECK_EQUAL(nextHops.size(), 3);
 }
 
+BOOST_FIXTURE_TEST_CASE(UpdateWithChangedRoutes, NamePrefixTableFixture)
+{
+  const ndn::Name destination1("/ndn/destination1");
+  const ndn::Name destination2("/ndn/destination2");
+  npt.addEntry("/ndn/prefix1", destination1);
+  npt.addEntry("/ndn/prefix2", destination2);
+
+  RoutingTableEntry route1(destination1);
+  route1.getNexthopList().addNextHop(NextHop("udp4://10.0.0.1", 1));
+  RoutingTableEntry route2(destination2);
+  route2.getNexthopList().addNextHop(NextHop("udp4://10.0.0.2", 1));
+
+  // Only the routes in the changes are applied
+  RoutingTableChanges changes;
+  changes.added.push_back(&route1);
+  npt.updateWithChangedRoutes(changes);
+
+  BOOST_CHECK_EQUAL(npt.m_rtpool.at(destination1)->getNexthopList().size(), 1);
+  BOOST_CHECK_EQUAL(npt.m_rtpool.at(destination2)->getNexthopList().size(), 0);
+  BOOST_CHECK_EQUAL((*npt.findEntry("/ndn/prefix1"))->getNexthopList().size(), 1);
+
+  changes = RoutingTableChanges();
+  changes.changed.push_back(&route2);
+  changes.removed.push_back(destination1);
+  npt.updateWithChangedRoutes(changes);
+
+  BOOST_CHECK_EQUAL(npt.m_rtpool.at(destination1)->getNexthopList().size(), 0);
+  BOOST_CHECK_EQUAL(npt.m_rtpool.at(destination2)->getNexthopList().size(), 1);
+  BOOST_CHECK_EQUAL((*npt.findEntry("/ndn/prefix1"))->getNexthopList().size(), 0);
+  BOOST_CHECK_EQUAL((*npt.findEntry("/ndn/prefix2"))->getNexthopList().size(), 1);
+
+  // Destinations no name prefix uses are ignored
+  RoutingTableEntry route3("/ndn/destination3");
+  route3.getNexthopList().addNextHop(NextHop("udp4://10.0.0.3", 1));
+  changes = RoutingTableChanges();
+  changes.added.push_back(&route3);
+  npt.updateWithChangedRoutes(changes);
+
+  BOOST_CHECK(npt.m_rtpool.find("/ndn/destination3") == npt.m_rtpool.end());
+}
+
+BOOST_FIXTURE_TEST_CASE(IndexFollowsTable, NamePrefixTableFixture)
+{
+  const ndn::Name router1("/ndn/router1");
+  const ndn::Name router2("/ndn/router2");
+
+  for (int i = 0; i < 1000; ++i) {
+    npt.addEntry(ndn::Name("/ndn/prefix").appendNumber(i), router1);
+  }
+  npt.addEntry(ndn::Name("/ndn/prefix").appendNumber(0), router2);
+
+  BOOST_CHECK_EQUAL(npt.m_table.size(), 1000);
+  BOOST_CHECK_EQUAL(npt.m_index.size(), 1000);
+
+  // Entries are still iterated over in the order they were added
+  BOOST_CHECK_EQUAL((*npt.begin())->getNamePrefix(), ndn::Name("/ndn/prefix").appendNumber(0));
+
+  for (int i = 0; i < 1000; i += 2) {
+    npt.removeEntry(ndn::Name("/ndn/prefix").appendNumber(i), router1);
+  }
+
+  // The prefix advertised by router2 as well is kept
+  BOOST_CHECK_EQUAL(npt.m_table.size(), 501);
+  BOOST_CHECK_EQUAL(npt.m_index.size(), 501);
+
+  auto it = npt.findEntry(ndn::Name("/ndn/prefix").appendNumber(0));
+  BOOST_REQUIRE(it != npt.m_table.end());
+  BOOST_CHECK_EQUAL((*it)->getRteListSize(), 1);
+  BOOST_CHECK(npt.findEntry(ndn::Name("/ndn/prefix").appendNumber(2)) == npt.m_table.end());
+  BOOST_CHECK(npt.findEntry(ndn::Name("/ndn/prefix").appendNumber(3)) != npt.m_table.end());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace test
@@ -103,6 +103,25 @@ BOOST_AUTO_TEST_CASE(HyperbolicRound)
   BOOST_CHECK(hop1.getRouteCostAsAdjustedInteger() > hop2.getRouteCostAsAdjustedInteger());
 }
 
+BOOST_AUTO_TEST_CASE(FaceUriId)
+{
+  NextHop hop1("udp://test/uri", 10);
+  NextHop hop2;
+  BOOST_CHECK_EQUAL(hop2.getFaceUriId(), NextHop::EMPTY_FACE_URI_ID);
+  BOOST_CHECK_EQUAL(hop2.getConnectingFaceUri(), "");
+
+  hop2.setConnectingFaceUri("udp://test/uri");
+  BOOST_CHECK_EQUAL(hop1.getFaceUriId(), hop2.getFaceUriId());
+
+  hop2.setConnectingFaceUri("udp://test/other-uri");
+  BOOST_CHECK_NE(hop1.getFaceUriId(), hop2.getFaceUriId());
+  BOOST_CHECK_EQUAL(hop2.getConnectingFaceUri(), "udp://test/other-uri");
+
+  NextHop hop3 = hop1;
+  BOOST_CHECK_EQUAL(hop3.getConnectingFaceUri(), "udp://test/uri");
+  BOOST_CHECK_EQUAL(hop3, hop1);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace test
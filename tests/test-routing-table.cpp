@@ -25,6 +25,12 @@
 #include "route/routing-table.hpp"
 #include "route/routing-table-entry.hpp"
 #include "route/nexthop.hpp"
+#include "nlsr.hpp"
+#include "lsa.hpp"
+#include "adjacency-list.hpp"
+
+#include <algorithm>
+#include <map>
 #include <boost/test/unit_test.hpp>
 
 namespace nlsr {
@@ -46,6 +52,260 @@ BOOST_AUTO_TEST_CASE(RoutingTableAddNextHop)
                     "destRouter");
 }
 
+BOOST_AUTO_TEST_CASE(NotifyRoutingChanges)
+{
+  RoutingTable rt(g_scheduler);
+
+  std::vector<ndn::Name> added;
+  std::vector<ndn::Name> changed;
+  std::vector<ndn::Name> removed;
+  size_t nNotifications = 0;
+  rt.afterRoutingChange->connect([&] (const RoutingTableChanges& changes) {
+      ++nNotifications;
+      added.clear();
+      changed.clear();
+      removed = changes.removed;
+      for (const RoutingTableEntry* entry : changes.added) {
+        added.push_back(entry->getDestination());
+      }
+      for (const RoutingTableEntry* entry : changes.changed) {
+        changed.push_back(entry->getDestination());
+      }
+    });
+
+  const ndn::Name ROUTER_A("/ndn/router/a");
+  const ndn::Name ROUTER_B("/ndn/router/b");
+  const ndn::Name ROUTER_C("/ndn/router/c");
+  NextHop hop1("udp4://10.0.0.1", 10);
+  NextHop hop2("udp4://10.0.0.2", 20);
+
+  rt.clearRoutingTable();
+  rt.addNextHop(ROUTER_A, hop1);
+  rt.addNextHop(ROUTER_B, hop1);
+  rt.notifyRoutingChanges();
+
+  BOOST_CHECK_EQUAL(nNotifications, 1);
+  BOOST_CHECK_EQUAL(added.size(), 2);
+  BOOST_CHECK(changed.empty());
+  BOOST_CHECK(removed.empty());
+
+  // A is unchanged, B has another next hop and C is new
+  rt.clearRoutingTable();
+  rt.addNextHop(ROUTER_A, hop1);
+  rt.addNextHop(ROUTER_B, hop1);
+  rt.addNextHop(ROUTER_B, hop2);
+  rt.addNextHop(ROUTER_C, hop2);
+  rt.notifyRoutingChanges();
+
+  BOOST_CHECK_EQUAL(nNotifications, 2);
+  BOOST_REQUIRE_EQUAL(added.size(), 1);
+  BOOST_CHECK_EQUAL(added[0], ROUTER_C);
+  BOOST_REQUIRE_EQUAL(changed.size(), 1);
+  BOOST_CHECK_EQUAL(changed[0], ROUTER_B);
+  BOOST_CHECK(removed.empty());
+  BOOST_CHECK_EQUAL(rt.findRoutingTableEntry(ROUTER_B)->getNexthopList().size(), 2);
+
+  // Nothing changed, so nothing is emitted
+  rt.clearRoutingTable();
+  rt.addNextHop(ROUTER_A, hop1);
+  rt.addNextHop(ROUTER_B, hop1);
+  rt.addNextHop(ROUTER_B, hop2);
+  rt.addNextHop(ROUTER_C, hop2);
+  rt.notifyRoutingChanges();
+
+  BOOST_CHECK_EQUAL(nNotifications, 2);
+
+  // B and C are no longer reachable
+  rt.clearRoutingTable();
+  rt.addNextHop(ROUTER_A, hop1);
+  rt.notifyRoutingChanges();
+
+  BOOST_CHECK_EQUAL(nNotifications, 3);
+  BOOST_CHECK(added.empty());
+  BOOST_CHECK(changed.empty());
+  BOOST_CHECK_EQUAL(removed.size(), 2);
+  BOOST_CHECK(rt.findRoutingTableEntry(ROUTER_B) == nullptr);
+  BOOST_CHECK(rt.findRoutingTableEntry(ROUTER_A) != nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(IncrementalCalculationTouchesChangedRoutersOnly)
+{
+  auto face = std::make_shared<ndn::util::DummyClientFace>(g_ioService);
+  Nlsr nlsr(g_ioService, g_scheduler, std::ref(*face), g_keyChain);
+  RoutingTable& rt = nlsr.getRoutingTable();
+
+  ConfParameter& conf = nlsr.getConfParameter();
+  conf.setNetwork("/ndn");
+  conf.setSiteName("/router");
+  conf.setRouterName("/a");
+  conf.buildRouterPrefix();
+  conf.setMaxFacesPerPrefix(1);
+
+  const ndn::Name ROUTER_A("/ndn/router/a");
+  const ndn::Name ROUTER_B("/ndn/router/b");
+  const ndn::Name ROUTER_C("/ndn/router/c");
+  const ndn::Name ROUTER_D("/ndn/router/d");
+  const ndn::Name ROUTER_E("/ndn/router/e");
+  const ndn::time::system_clock::TimePoint MAX_TIME = ndn::time::system_clock::TimePoint::max();
+
+  const std::map<ndn::Name, std::string> faces{
+    {ROUTER_A, "udp4://10.0.0.1"}, {ROUTER_B, "udp4://10.0.0.2"}, {ROUTER_C, "udp4://10.0.0.3"},
+    {ROUTER_D, "udp4://10.0.0.4"}, {ROUTER_E, "udp4://10.0.0.5"}};
+
+  // D is reached through B, and E through C
+  auto installLsa = [&] (const ndn::Name& router, uint64_t seqNo,
+                         std::initializer_list<std::pair<ndn::Name, double>> links) {
+    AdjacencyList adjacencies;
+    for (const auto& link : links) {
+      adjacencies.insert(Adjacent(link.first, ndn::util::FaceUri(faces.at(link.first)),
+                                  link.second, Adjacent::STATUS_ACTIVE, 0, 0));
+    }
+    if (router == ROUTER_A) {
+      nlsr.getAdjacencyList() = adjacencies;
+    }
+    nlsr.getLsdb().installAdjLsa(AdjLsa(router, seqNo, MAX_TIME, adjacencies.size(), adjacencies));
+  };
+  installLsa(ROUTER_A, 1, {{ROUTER_B, 5}, {ROUTER_C, 10}});
+  installLsa(ROUTER_B, 1, {{ROUTER_A, 5}, {ROUTER_D, 3}});
+  installLsa(ROUTER_C, 1, {{ROUTER_A, 10}, {ROUTER_E, 4}});
+  installLsa(ROUTER_D, 1, {{ROUTER_B, 3}});
+  installLsa(ROUTER_E, 1, {{ROUTER_C, 4}});
+
+  std::vector<ndn::Name> added;
+  std::vector<ndn::Name> changed;
+  std::vector<ndn::Name> removed;
+  rt.afterRoutingChange->connect([&] (const RoutingTableChanges& changes) {
+      added.clear();
+      changed.clear();
+      removed = changes.removed;
+      for (const RoutingTableEntry* entry : changes.added) {
+        added.push_back(entry->getDestination());
+      }
+      for (const RoutingTableEntry* entry : changes.changed) {
+        changed.push_back(entry->getDestination());
+      }
+    });
+
+  rt.calculate(nlsr);
+  BOOST_CHECK_EQUAL(added.size(), 4);
+  BOOST_CHECK(changed.empty());
+  BOOST_CHECK(removed.empty());
+
+  const RoutingTableEntry* entryB = rt.findRoutingTableEntry(ROUTER_B);
+  const RoutingTableEntry* entryD = rt.findRoutingTableEntry(ROUTER_D);
+  BOOST_REQUIRE(entryB != nullptr);
+  BOOST_REQUIRE(entryD != nullptr);
+
+  // Only the routes to C and E go over the link whose cost changes
+  installLsa(ROUTER_A, 2, {{ROUTER_B, 5}, {ROUTER_C, 12}});
+  installLsa(ROUTER_C, 2, {{ROUTER_A, 12}, {ROUTER_E, 4}});
+  rt.calculate(nlsr);
+
+  BOOST_CHECK(added.empty());
+  BOOST_CHECK(removed.empty());
+  std::sort(changed.begin(), changed.end());
+  std::vector<ndn::Name> expectedChanged{ROUTER_C, ROUTER_E};
+  BOOST_CHECK_EQUAL_COLLECTIONS(changed.begin(), changed.end(),
+                                expectedChanged.begin(), expectedChanged.end());
+
+  // The entries of the other routers were left in place
+  BOOST_CHECK_EQUAL(rt.findRoutingTableEntry(ROUTER_B), entryB);
+  BOOST_CHECK_EQUAL(rt.findRoutingTableEntry(ROUTER_D), entryD);
+  BOOST_CHECK_EQUAL(rt.m_rTable.size(), 4);
+
+  const RoutingTableEntry* entryE = rt.findRoutingTableEntry(ROUTER_E);
+  BOOST_REQUIRE(entryE != nullptr);
+  BOOST_REQUIRE_EQUAL(entryE->getNexthopList().size(), 1);
+  BOOST_CHECK_EQUAL(entryE->getNexthopList().begin()->getRouteCost(), 16);
+}
+
+BOOST_FIXTURE_TEST_CASE(CalculationThrottle, UnitTestTimeFixture)
+{
+  auto face = std::make_shared<ndn::util::DummyClientFace>(g_ioService);
+  Nlsr nlsr(g_ioService, g_scheduler, std::ref(*face), g_keyChain);
+  RoutingTable& rt = nlsr.getRoutingTable();
+  rt.setRoutingCalcInterval(10);
+  rt.setRoutingCalcWaits(ndn::time::milliseconds(50), ndn::time::milliseconds(1000));
+
+  // After a quiet period, a calculation runs after the initial wait, and
+  // requests until then are folded into it
+  rt.scheduleRoutingTableCalculation(nlsr);
+  rt.scheduleRoutingTableCalculation(nlsr);
+  BOOST_CHECK_EQUAL(rt.getNRoutingCalcsTriggered(), 1);
+  BOOST_CHECK_EQUAL(rt.getNRoutingCalcsCoalesced(), 1);
+
+  this->advanceClocks(ndn::time::milliseconds(10), 4);
+  BOOST_CHECK(nlsr.getIsRouteCalculationScheduled());
+  this->advanceClocks(ndn::time::milliseconds(10));
+  BOOST_CHECK(!nlsr.getIsRouteCalculationScheduled());
+
+  // Under churn, the hold time since the last calculation starts at the
+  // secondary wait and doubles
+  rt.scheduleRoutingTableCalculation(nlsr);
+  this->advanceClocks(ndn::time::milliseconds(100), 9);
+  BOOST_CHECK(nlsr.getIsRouteCalculationScheduled());
+  this->advanceClocks(ndn::time::milliseconds(100));
+  BOOST_CHECK(!nlsr.getIsRouteCalculationScheduled());
+
+  rt.scheduleRoutingTableCalculation(nlsr);
+  this->advanceClocks(ndn::time::milliseconds(100), 19);
+  BOOST_CHECK(nlsr.getIsRouteCalculationScheduled());
+  this->advanceClocks(ndn::time::milliseconds(100));
+  BOOST_CHECK(!nlsr.getIsRouteCalculationScheduled());
+
+  // No wait is longer than the routing calc. interval
+  for (int i = 0; i < 4; ++i) {
+    rt.scheduleRoutingTableCalculation(nlsr);
+    this->advanceClocks(ndn::time::seconds(1), 10);
+    BOOST_CHECK(!nlsr.getIsRouteCalculationScheduled());
+  }
+
+  // Once the network has been quiet for twice the interval, the initial
+  // wait applies again
+  this->advanceClocks(ndn::time::seconds(1), 20);
+  rt.scheduleRoutingTableCalculation(nlsr);
+  this->advanceClocks(ndn::time::milliseconds(50));
+  BOOST_CHECK(!nlsr.getIsRouteCalculationScheduled());
+
+  BOOST_CHECK_EQUAL(rt.getNRoutingCalcsTriggered(), 8);
+  BOOST_CHECK_EQUAL(rt.getNRoutingCalcsCoalesced(), 1);
+}
+
+BOOST_FIXTURE_TEST_CASE(CalculationInProgress, UnitTestTimeFixture)
+{
+  auto face = std::make_shared<ndn::util::DummyClientFace>(g_ioService);
+  Nlsr nlsr(g_ioService, g_scheduler, std::ref(*face), g_keyChain);
+  RoutingTable& rt = nlsr.getRoutingTable();
+  rt.setRoutingCalcInterval(10);
+  rt.setRoutingCalcWaits(ndn::time::milliseconds(50), ndn::time::milliseconds(1000));
+
+  rt.scheduleRoutingTableCalculation(nlsr);
+  this->advanceClocks(ndn::time::milliseconds(10), 5);
+  BOOST_CHECK(!nlsr.getIsRouteCalculationScheduled());
+
+  // A calculation that finds the last one still running is retried after
+  // the secondary wait, without counting as another trigger
+  nlsr.setIsRoutingTableCalculating(true);
+  rt.scheduleRoutingTableCalculation(nlsr);
+  this->advanceClocks(ndn::time::milliseconds(100), 10);
+  BOOST_CHECK(nlsr.getIsRouteCalculationScheduled());
+
+  rt.scheduleRoutingTableCalculation(nlsr);
+  BOOST_CHECK_EQUAL(rt.getNRoutingCalcsTriggered(), 2);
+  BOOST_CHECK_EQUAL(rt.getNRoutingCalcsCoalesced(), 1);
+
+  nlsr.setIsRoutingTableCalculating(false);
+  this->advanceClocks(ndn::time::milliseconds(100), 10);
+  BOOST_CHECK(!nlsr.getIsRouteCalculationScheduled());
+
+  // The hold time has doubled once, for the one trigger
+  rt.scheduleRoutingTableCalculation(nlsr);
+  this->advanceClocks(ndn::time::milliseconds(100), 19);
+  BOOST_CHECK(nlsr.getIsRouteCalculationScheduled());
+  this->advanceClocks(ndn::time::milliseconds(100));
+  BOOST_CHECK(!nlsr.getIsRouteCalculationScheduled());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace test
@@ -0,0 +1,184 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2017,  The University of Memphis,
+ *                           Regents of the University of California
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "route/shortest-path-calculator.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+
+namespace nlsr {
+namespace test {
+
+class ShortestPathCalculatorFixture
+{
+public:
+  ShortestPathCalculatorFixture()
+  {
+    // 0 -5- 1 -1- 3
+    //  \         /
+    //   10 -2- 2     4 (isolated)
+    std::vector<AdjacencyGraph::Link> links;
+    addLink(links, 0, 1, 5);
+    addLink(links, 0, 2, 10);
+    addLink(links, 1, 3, 1);
+    addLink(links, 2, 3, 2);
+
+    graph.build(5, links);
+  }
+
+  static void
+  addLink(std::vector<AdjacencyGraph::Link>& links, int32_t a, int32_t b, double cost)
+  {
+    links.push_back({a, b, cost});
+    links.push_back({b, a, cost});
+  }
+
+public:
+  AdjacencyGraph graph;
+  ShortestPathCalculator spf;
+};
+
+BOOST_FIXTURE_TEST_SUITE(TestShortestPathCalculator, ShortestPathCalculatorFixture)
+
+BOOST_AUTO_TEST_CASE(SinglePath)
+{
+  spf.calculate(graph, 0);
+
+  BOOST_CHECK_EQUAL(spf.getDistance(0), 0);
+  BOOST_CHECK_EQUAL(spf.getNextHop(0), ShortestPathCalculator::NO_ROUTER);
+
+  BOOST_CHECK_EQUAL(spf.getDistance(1), 5);
+  BOOST_CHECK_EQUAL(spf.getNextHop(1), 1);
+
+  BOOST_CHECK_EQUAL(spf.getDistance(3), 6);
+  BOOST_CHECK_EQUAL(spf.getParent(3), 1);
+  BOOST_CHECK_EQUAL(spf.getNextHop(3), 1);
+
+  BOOST_CHECK_EQUAL(spf.getDistance(2), 8);
+  BOOST_CHECK_EQUAL(spf.getParent(2), 3);
+  BOOST_CHECK_EQUAL(spf.getNextHop(2), 1);
+
+  BOOST_CHECK(!spf.isReachable(4));
+  BOOST_CHECK_EQUAL(spf.getNextHop(4), ShortestPathCalculator::NO_ROUTER);
+}
+
+BOOST_AUTO_TEST_CASE(FirstHop)
+{
+  spf.calculate(graph, 0, 2);
+
+  BOOST_CHECK_EQUAL(spf.getDistance(2), 10);
+  BOOST_CHECK_EQUAL(spf.getNextHop(2), 2);
+
+  BOOST_CHECK_EQUAL(spf.getDistance(3), 12);
+  BOOST_CHECK_EQUAL(spf.getNextHop(3), 2);
+
+  // Paths must not go back through the source
+  BOOST_CHECK_EQUAL(spf.getDistance(1), 13);
+  BOOST_CHECK_EQUAL(spf.getNextHop(1), 2);
+}
+
+BOOST_AUTO_TEST_CASE(Multipath)
+{
+  spf.calculateMultipath(graph, 0);
+
+  BOOST_REQUIRE_EQUAL(spf.getNumOfFirstHops(), 2);
+  BOOST_CHECK_EQUAL(spf.getFirstHop(0), 1);
+  BOOST_CHECK_EQUAL(spf.getFirstHop(1), 2);
+
+  BOOST_CHECK_EQUAL(spf.getDistanceThrough(0, 1), 5);
+  BOOST_CHECK_EQUAL(spf.getDistanceThrough(0, 3), 6);
+  BOOST_CHECK_EQUAL(spf.getDistanceThrough(0, 2), 8);
+
+  BOOST_CHECK_EQUAL(spf.getDistanceThrough(1, 2), 10);
+  BOOST_CHECK_EQUAL(spf.getDistanceThrough(1, 3), 12);
+  BOOST_CHECK_EQUAL(spf.getDistanceThrough(1, 1), 13);
+
+  BOOST_CHECK(!spf.isReachableThrough(0, 0));
+  BOOST_CHECK(!spf.isReachableThrough(0, 4));
+  BOOST_CHECK(!spf.isReachableThrough(1, 4));
+}
+
+BOOST_AUTO_TEST_CASE(MultipathThroughEachFirstHop)
+{
+  ShortestPathCalculator all;
+  all.calculateMultipath(graph, 0);
+
+  // First hops are calculated in reverse, each with its own scratch
+  spf.prepareMultipath(graph, 0);
+  BOOST_REQUIRE_EQUAL(spf.getNumOfFirstHops(), 2);
+  for (size_t index = spf.getNumOfFirstHops(); index-- > 0;) {
+    ShortestPathCalculator scratch;
+    spf.calculateThrough(graph, 0, index, index + 1, scratch);
+  }
+
+  for (size_t index = 0; index < 2; ++index) {
+    for (int32_t router = 0; router < 5; ++router) {
+      BOOST_CHECK_EQUAL(spf.isReachableThrough(index, router),
+                        all.isReachableThrough(index, router));
+      BOOST_CHECK_EQUAL(spf.getDistanceThrough(index, router),
+                        all.getDistanceThrough(index, router));
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(MultipathIsExactForEveryFirstHop)
+{
+  // A denser graph where paths through different neighbors overlap
+  std::vector<AdjacencyGraph::Link> links;
+  for (int32_t i = 0; i < 12; ++i) {
+    addLink(links, i, (i + 1) % 12, 1 + i % 4);
+    addLink(links, i, (i + 5) % 12, 2 + i % 3);
+  }
+  addLink(links, 0, 3, 4);
+  addLink(links, 0, 6, 5.5);
+  graph.build(12, links);
+
+  ShortestPathCalculator all;
+  all.calculateMultipath(graph, 0);
+  BOOST_REQUIRE_EQUAL(all.getNumOfFirstHops(), 6);
+
+  // Every first hop is kept, however much worse than the others it is
+  for (size_t index = 0; index < all.getNumOfFirstHops(); ++index) {
+    spf.calculate(graph, 0, all.getFirstHop(index));
+    for (int32_t router = 1; router < 12; ++router) {
+      BOOST_CHECK(all.isReachableThrough(index, router));
+      BOOST_CHECK_EQUAL(all.getDistanceThrough(index, router), spf.getDistance(router));
+    }
+  }
+
+  // Sweeping the first hops in two shares gives the same distances
+  ShortestPathCalculator shares;
+  ShortestPathCalculator scratch;
+  shares.prepareMultipath(graph, 0);
+  shares.calculateThrough(graph, 0, 4, 6, scratch);
+  shares.calculateThrough(graph, 0, 0, 4, scratch);
+  for (size_t index = 0; index < all.getNumOfFirstHops(); ++index) {
+    for (int32_t router = 1; router < 12; ++router) {
+      BOOST_CHECK_EQUAL(shares.getDistanceThrough(index, router),
+                        all.getDistanceThrough(index, router));
+    }
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace test
+} // namespace nlsr
@@ -102,7 +102,7 @@ public:
   {
     size_t sentBefore = collector.getStatistics().get(statsType);
 
-    lsdb.expressInterest(ndn::Name(prefix + lsaType).appendNumber(seqNo), 0,
+    lsdb.expressInterest(ndn::Name(prefix + lsaType).appendNumber(seqNo),
                          ndn::time::steady_clock::TimePoint::min());
     face->processEvents(ndn::time::milliseconds(1));
 
@@ -139,8 +139,49 @@ BOOST_AUTO_TEST_CASE(StatsReset)
 {
   Statistics stats;
   stats.increment(Statistics::PacketType::SENT_HELLO_INTEREST);
+  stats.record(Statistics::DurationType::SPF_DURATION, ndn::time::milliseconds(5));
   stats.resetAll();
   BOOST_CHECK_EQUAL(stats.get(Statistics::PacketType::SENT_HELLO_INTEREST), 0);
+  BOOST_CHECK_EQUAL(stats.getHistogram(Statistics::DurationType::SPF_DURATION).getCount(), 0);
+}
+
+/*
+ * Durations are placed in power-of-two microsecond buckets; anything beyond the last bound
+ * falls into the last bucket.
+ */
+BOOST_AUTO_TEST_CASE(DurationHistogramBuckets)
+{
+  BOOST_CHECK_EQUAL(DurationHistogram::getBucket(ndn::time::nanoseconds(0)), 0);
+  BOOST_CHECK_EQUAL(DurationHistogram::getBucket(ndn::time::nanoseconds(999)), 0);
+  BOOST_CHECK_EQUAL(DurationHistogram::getBucket(ndn::time::microseconds(1)), 1);
+  BOOST_CHECK_EQUAL(DurationHistogram::getBucket(ndn::time::microseconds(3)), 2);
+  BOOST_CHECK_EQUAL(DurationHistogram::getBucket(ndn::time::microseconds(4)), 3);
+  BOOST_CHECK_EQUAL(DurationHistogram::getBucket(ndn::time::hours(24)),
+                    DurationHistogram::N_BUCKETS - 1);
+
+  DurationHistogram histogram;
+  histogram.record(ndn::time::microseconds(3));
+  histogram.record(ndn::time::microseconds(2));
+  histogram.record(ndn::time::microseconds(100));
+
+  BOOST_CHECK_EQUAL(histogram.getCount(), 3);
+  BOOST_CHECK_EQUAL(histogram.getTotal(), ndn::time::microseconds(105));
+  BOOST_CHECK_EQUAL(histogram.getBucketCount(2), 2);
+  BOOST_CHECK_EQUAL(histogram.getBucketCount(7), 1);
+}
+
+/*
+ * Updating the NamePrefixTable is timed and recorded by the StatsCollector.
+ */
+BOOST_AUTO_TEST_CASE(NptUpdateDuration)
+{
+  const DurationHistogram& histogram =
+    collector.getStatistics().getHistogram(Statistics::DurationType::NPT_UPDATE_DURATION);
+  uint64_t before = histogram.getCount();
+
+  nlsr.getNamePrefixTable().updateWithNewRoute({});
+
+  BOOST_CHECK_EQUAL(histogram.getCount(), before + 1);
 }
 
 
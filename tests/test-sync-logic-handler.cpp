@@ -57,6 +57,8 @@ public:
     conf.setSiteName(CONFIG_SITE);
     conf.setRouterName(CONFIG_ROUTER_NAME);
     conf.buildRouterPrefix();
+    // Process each update as soon as it is received
+    conf.setSyncBatchWindow(0);
     INIT_LOGGERS("/tmp", "TRACE");
   }
 
@@ -98,7 +100,7 @@ BOOST_FIXTURE_TEST_SUITE(TestSyncLogicHandler, SyncLogicFixture)
  */
 BOOST_AUTO_TEST_CASE(UpdateForOtherLS)
 {
-  SyncLogicHandler sync{std::ref(*face), testIsLsaNew, conf};
+  SyncLogicHandler sync{std::ref(*face), g_scheduler, testIsLsaNew, conf};
   sync.createSyncSocket(conf.getChronosyncPrefix());
 
   std::vector<Lsa::Type> lsaTypes = {Lsa::Type::NAME, Lsa::Type::ADJACENCY};
@@ -128,7 +130,7 @@ BOOST_AUTO_TEST_CASE(UpdateForOtherHR)
 {
   conf.setHyperbolicState(HYPERBOLIC_STATE_ON);
 
-  SyncLogicHandler sync{std::ref(*face), testIsLsaNew, conf};
+  SyncLogicHandler sync{std::ref(*face), g_scheduler, testIsLsaNew, conf};
   sync.createSyncSocket(conf.getChronosyncPrefix());
 
   uint64_t syncSeqNo = 1;
@@ -156,7 +158,7 @@ BOOST_AUTO_TEST_CASE(UpdateForOtherHRDry)
 {
   conf.setHyperbolicState(HYPERBOLIC_STATE_DRY_RUN);
 
-  SyncLogicHandler sync{std::ref(*face), testIsLsaNew, conf};
+  SyncLogicHandler sync{std::ref(*face), g_scheduler, testIsLsaNew, conf};
   sync.createSyncSocket(conf.getChronosyncPrefix());
 
   for (const Lsa::Type& lsaType : lsaTypes) {
@@ -183,7 +185,7 @@ BOOST_AUTO_TEST_CASE(NoUpdateForSelf)
 {
   const uint64_t sequenceNumber = 1;
 
-  SyncLogicHandler sync{std::ref(*face), testIsLsaNew, conf};
+  SyncLogicHandler sync{std::ref(*face), g_scheduler, testIsLsaNew, conf};
   sync.createSyncSocket(conf.getChronosyncPrefix());
 
   for (const Lsa::Type& lsaType : lsaTypes) {
@@ -209,7 +211,7 @@ BOOST_AUTO_TEST_CASE(MalformedUpdate)
 {
   const uint64_t sequenceNumber = 1;
 
-  SyncLogicHandler sync{std::ref(*face), testIsLsaNew, conf};
+  SyncLogicHandler sync{std::ref(*face), g_scheduler, testIsLsaNew, conf};
   sync.createSyncSocket(conf.getChronosyncPrefix());
 
   for (const Lsa::Type& lsaType : lsaTypes) {
@@ -237,7 +239,7 @@ BOOST_AUTO_TEST_CASE(LsaNotNew)
   };
 
   const uint64_t sequenceNumber = 1;
-  SyncLogicHandler sync{std::ref(*face), testLsaAlwaysFalse, conf};
+  SyncLogicHandler sync{std::ref(*face), g_scheduler, testLsaAlwaysFalse, conf};
   sync.createSyncSocket(conf.getChronosyncPrefix());
     ndn::util::signal::ScopedConnection connection = sync.onNewLsa->connect(
       [& ,this] (const ndn::Name& routerName, const uint64_t& sequenceNumber) {
@@ -251,6 +253,81 @@ BOOST_AUTO_TEST_CASE(LsaNotNew)
   receiveUpdate(updateName, sequenceNumber, sync);
 }
 
+/* Tests that the updates received together are coalesced per LSA,
+   and that adjacency LSAs are emitted before name LSAs.
+ */
+BOOST_AUTO_TEST_CASE(CoalesceUpdates)
+{
+  SyncLogicHandler sync{std::ref(*face), g_scheduler, testIsLsaNew, conf};
+  sync.createSyncSocket(conf.getChronosyncPrefix());
+
+  std::string routerPrefix = conf.getLsaPrefix().toUri() + CONFIG_SITE;
+  ndn::Name nameUpdate(routerPrefix + "/%C1.Router/router1/" + std::to_string(Lsa::Type::NAME));
+  ndn::Name adjUpdate(routerPrefix + "/%C1.Router/router2/" + std::to_string(Lsa::Type::ADJACENCY));
+
+  std::vector<chronosync::MissingDataInfo> updates;
+  updates.push_back({ndn::Name(nameUpdate).appendNumber(1), 0, 3});
+  updates.push_back({ndn::Name(adjUpdate).appendNumber(1), 0, 2});
+  updates.push_back({ndn::Name(nameUpdate).appendNumber(1), 0, 5});
+
+  std::vector<std::pair<ndn::Name, uint64_t>> emitted;
+  ndn::util::signal::ScopedConnection connection = sync.onNewLsa->connect(
+    [&] (const ndn::Name& updateName, const uint64_t& sequenceNumber) {
+      emitted.push_back(std::make_pair(updateName, sequenceNumber));
+    });
+
+  sync.onChronoSyncUpdate(updates);
+
+  BOOST_REQUIRE_EQUAL(emitted.size(), 2);
+  BOOST_CHECK_EQUAL(emitted[0].first, adjUpdate);
+  BOOST_CHECK_EQUAL(emitted[0].second, 2);
+  BOOST_CHECK_EQUAL(emitted[1].first, nameUpdate);
+  BOOST_CHECK_EQUAL(emitted[1].second, 5);
+  BOOST_CHECK_EQUAL(sync.getNUpdatesCoalesced(), 1);
+}
+
+/* Tests that the updates received within the batch window are
+   emitted together once it has passed.
+ */
+BOOST_FIXTURE_TEST_CASE(BatchWindow, UnitTestTimeFixture)
+{
+  ndn::util::DummyClientFace face(g_ioService);
+  ConfParameter conf;
+  conf.setNetwork("/ndn");
+  conf.setSiteName("/site");
+  conf.setRouterName("/%C1.Router/this-router");
+  conf.buildRouterPrefix();
+  conf.setSyncBatchWindow(50);
+
+  SyncLogicHandler sync{face, g_scheduler,
+                        [] (const ndn::Name&, const Lsa::Type&, const uint64_t&) {
+                          return true;
+                        },
+                        conf};
+
+  ndn::Name updateName = conf.getLsaPrefix();
+  updateName.append("site").append("%C1.Router").append("other-router")
+            .append(std::to_string(Lsa::Type::NAME));
+
+  std::vector<uint64_t> emitted;
+  ndn::util::signal::ScopedConnection connection = sync.onNewLsa->connect(
+    [&] (const ndn::Name&, const uint64_t& sequenceNumber) {
+      emitted.push_back(sequenceNumber);
+    });
+
+  sync.onChronoSyncUpdate({{ndn::Name(updateName).appendNumber(1), 0, 1}});
+  this->advanceClocks(ndn::time::milliseconds(30));
+  sync.onChronoSyncUpdate({{ndn::Name(updateName).appendNumber(1), 0, 2}});
+  this->advanceClocks(ndn::time::milliseconds(10));
+
+  BOOST_CHECK(emitted.empty());
+
+  this->advanceClocks(ndn::time::milliseconds(10));
+
+  BOOST_REQUIRE_EQUAL(emitted.size(), 1);
+  BOOST_CHECK_EQUAL(emitted[0], 2);
+}
+
 /* Tests that SyncLogicHandler successfully concatenates configured
    variables together to form the necessary prefixes to advertise
    through ChronoSync.
@@ -258,7 +335,7 @@ BOOST_AUTO_TEST_CASE(LsaNotNew)
 BOOST_AUTO_TEST_CASE(UpdatePrefix)
 {
 
-  SyncLogicHandler sync{std::ref(*face), testIsLsaNew, conf};
+  SyncLogicHandler sync{std::ref(*face), g_scheduler, testIsLsaNew, conf};
 
   ndn::Name expectedPrefix = nlsr.getConfParameter().getLsaPrefix();
   expectedPrefix.append(CONFIG_SITE);
@@ -0,0 +1,155 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2017,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utility/timer-wheel.hpp"
+#include "test-common.hpp"
+
+namespace nlsr {
+namespace test {
+
+using namespace ndn::time;
+using util::TimerWheel;
+
+class TimerWheelFixture : public UnitTestTimeFixture
+{
+public:
+  TimerWheelFixture()
+    : wheel(g_scheduler, seconds(1))
+    , startTime(steady_clock::now())
+  {
+  }
+
+  TimerWheel::TimerId
+  schedule(const nanoseconds& delay, int id)
+  {
+    return wheel.schedule(delay, [this, id] {
+        fired.push_back(id);
+        firedAt.push_back(steady_clock::now() - startTime);
+      });
+  }
+
+public:
+  TimerWheel wheel;
+  steady_clock::TimePoint startTime;
+  std::vector<int> fired;
+  std::vector<nanoseconds> firedAt;
+};
+
+BOOST_FIXTURE_TEST_SUITE(TestTimerWheel, TimerWheelFixture)
+
+BOOST_AUTO_TEST_CASE(FireInOrder)
+{
+  schedule(seconds(3), 3);
+  schedule(seconds(1), 1);
+  schedule(seconds(2), 2);
+  BOOST_CHECK_EQUAL(wheel.size(), 3);
+
+  this->advanceClocks(milliseconds(100), 9);
+  BOOST_CHECK(fired.empty());
+
+  this->advanceClocks(milliseconds(100), 25);
+  std::vector<int> expected{1, 2, 3};
+  BOOST_CHECK_EQUAL_COLLECTIONS(fired.begin(), fired.end(), expected.begin(), expected.end());
+  BOOST_CHECK_EQUAL(wheel.size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(FireInBatches)
+{
+  // Both expire within the second tick
+  schedule(milliseconds(1200), 1);
+  schedule(milliseconds(1800), 2);
+
+  this->advanceClocks(milliseconds(100), 19);
+  BOOST_CHECK(fired.empty());
+
+  this->advanceClocks(milliseconds(100));
+  BOOST_CHECK_EQUAL(fired.size(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(Cancel)
+{
+  TimerWheel::TimerId id1 = schedule(seconds(1), 1);
+  TimerWheel::TimerId id2 = schedule(seconds(2), 2);
+  schedule(seconds(2), 3);
+
+  wheel.cancel(id2);
+  BOOST_CHECK_EQUAL(wheel.size(), 2);
+
+  this->advanceClocks(milliseconds(100), 30);
+  std::vector<int> expected{1, 3};
+  BOOST_CHECK_EQUAL_COLLECTIONS(fired.begin(), fired.end(), expected.begin(), expected.end());
+
+  // The IDs of fired and cancelled timers are stale
+  TimerWheel::TimerId id4 = schedule(seconds(1), 4);
+  wheel.cancel(id1);
+  wheel.cancel(id2);
+  wheel.cancel(TimerWheel::TimerId());
+  BOOST_CHECK_EQUAL(wheel.size(), 1);
+
+  wheel.cancel(id4);
+  this->advanceClocks(milliseconds(100), 20);
+  BOOST_CHECK_EQUAL(fired.size(), 2);
+  BOOST_CHECK_EQUAL(wheel.size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(FarTimers)
+{
+  // One for each level of the wheel, and one beyond its range
+  schedule(seconds(30), 1);
+  schedule(seconds(3000), 2);
+  schedule(seconds(200000), 3);
+  schedule(seconds(300000), 4);
+  schedule(seconds(20000000), 5);
+
+  this->advanceClocks(seconds(100), 200010);
+
+  std::vector<int> expected{1, 2, 3, 4, 5};
+  BOOST_CHECK_EQUAL_COLLECTIONS(fired.begin(), fired.end(), expected.begin(), expected.end());
+
+  std::vector<seconds> due{seconds(30), seconds(3000), seconds(200000),
+                           seconds(300000), seconds(20000000)};
+  BOOST_REQUIRE_EQUAL(firedAt.size(), due.size());
+  for (size_t i = 0; i < due.size(); ++i) {
+    BOOST_CHECK(firedAt[i] >= due[i]);
+    BOOST_CHECK(firedAt[i] <= due[i] + seconds(101));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(ScheduleFromCallback)
+{
+  wheel.schedule(seconds(1), [this] {
+      fired.push_back(1);
+      schedule(seconds(0), 2);
+    });
+
+  this->advanceClocks(milliseconds(100), 10);
+  BOOST_CHECK_EQUAL(fired.size(), 1);
+
+  // Not fired in the tick that scheduled it
+  this->advanceClocks(milliseconds(100), 10);
+  std::vector<int> expected{1, 2};
+  BOOST_CHECK_EQUAL_COLLECTIONS(fired.begin(), fired.end(), expected.begin(), expected.end());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace test
+} // namespace nlsr
@@ -53,6 +53,19 @@ const uint8_t LsaInfoDataInfiniteExpirationPeriod[] =
   0x82, 0x1, 0x80
 };
 
+const uint8_t LsaInfoDataExpirationTime[] =
+{
+  // Header
+  0x80, 0x27,
+  // OriginRouter
+  0x81, 0x18, 0x07, 0x16, 0x08, 0x04, 0x74, 0x65, 0x73, 0x74, 0x08, 0x03, 0x6c, 0x73,
+  0x61, 0x08, 0x04, 0x69, 0x6e, 0x66, 0x6f, 0x08, 0x03, 0x74, 0x6c, 0x76,
+  // SequenceNumber
+  0x82, 0x01, 0x80,
+  // ExpirationTime
+  0x8e, 0x08, 0x00, 0x00, 0x01, 0x5d, 0x3e, 0xf7, 0x98, 0x00
+};
+
 BOOST_AUTO_TEST_CASE(LsaInfoEncode)
 {
   LsaInfo lsaInfo;
@@ -109,6 +122,33 @@ BOOST_AUTO_TEST_CASE(LsaInfoInfiniteExpirationPeriodDecode)
   BOOST_REQUIRE_EQUAL(lsaInfo.hasInfiniteExpirationPeriod(), true);
 }
 
+BOOST_AUTO_TEST_CASE(LsaInfoExpirationTimeEncode)
+{
+  LsaInfo lsaInfo;
+  lsaInfo.setOriginRouter("/test/lsa/info/tlv");
+  lsaInfo.setSequenceNumber(128);
+  lsaInfo.setExpirationTime(ndn::time::fromUnixTimestamp(ndn::time::milliseconds(1500000000000)));
+
+  const ndn::Block& wire = lsaInfo.wireEncode();
+
+  BOOST_REQUIRE_EQUAL_COLLECTIONS(LsaInfoDataExpirationTime,
+                                  LsaInfoDataExpirationTime + sizeof(LsaInfoDataExpirationTime),
+                                  wire.begin(), wire.end());
+}
+
+BOOST_AUTO_TEST_CASE(LsaInfoExpirationTimeDecode)
+{
+  LsaInfo lsaInfo;
+
+  lsaInfo.wireDecode(ndn::Block(LsaInfoDataExpirationTime, sizeof(LsaInfoDataExpirationTime)));
+
+  BOOST_REQUIRE_EQUAL(lsaInfo.getSequenceNumber(), 128);
+  BOOST_REQUIRE_EQUAL(lsaInfo.hasInfiniteExpirationPeriod(), true);
+  BOOST_REQUIRE_EQUAL(lsaInfo.hasExpirationTime(), true);
+  BOOST_CHECK(lsaInfo.getExpirationTime() ==
+              ndn::time::fromUnixTimestamp(ndn::time::milliseconds(1500000000000)));
+}
+
 BOOST_AUTO_TEST_CASE(LsaInfoOutputStream)
 {
   LsaInfo lsaInfo;
@@ -0,0 +1,74 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2017,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "tlv/lsdb-change.hpp"
+#include "tlv/tlv-nlsr.hpp"
+
+#include "../boost-test.hpp"
+#include <boost/lexical_cast.hpp>
+
+namespace nlsr {
+namespace tlv {
+namespace test {
+
+BOOST_AUTO_TEST_SUITE(TlvTestLsdbChange)
+
+BOOST_AUTO_TEST_CASE(EncodeDecode)
+{
+  nlsr::LsdbChange change{0x1234567890abcdef, 7, nlsr::LsdbChange::Kind::REMOVED, Lsa::Type::ADJACENCY,
+                          "/ndn/site/%C1.Router/router1", 42};
+  LsdbChange lsdbChange(change);
+
+  const ndn::Block& wire = lsdbChange.wireEncode();
+  BOOST_CHECK_EQUAL(wire.type(), ndn::tlv::nlsr::LsdbChange);
+
+  LsdbChange decoded(wire);
+  BOOST_CHECK_EQUAL(decoded.getEpoch(), 0x1234567890abcdef);
+  BOOST_CHECK_EQUAL(decoded.getChangeSequenceNumber(), 7);
+  BOOST_CHECK(decoded.getKind() == nlsr::LsdbChange::Kind::REMOVED);
+  BOOST_CHECK_EQUAL(decoded.getLsaType(), Lsa::Type::ADJACENCY);
+  BOOST_CHECK_EQUAL(decoded.getOriginRouter(), "/ndn/site/%C1.Router/router1");
+  BOOST_CHECK_EQUAL(decoded.getSequenceNumber(), 42);
+
+  BOOST_CHECK(wire == decoded.wireEncode());
+}
+
+BOOST_AUTO_TEST_CASE(DecodeWrongType)
+{
+  ndn::Block wire(ndn::tlv::nlsr::LsdbStatus);
+  BOOST_CHECK_THROW(LsdbChange{wire}, LsdbChange::Error);
+}
+
+BOOST_AUTO_TEST_CASE(Print)
+{
+  nlsr::LsdbChange change{1, 7, nlsr::LsdbChange::Kind::INSTALLED, Lsa::Type::NAME, "/router1", 1};
+  LsdbChange lsdbChange(change);
+
+  std::string output = boost::lexical_cast<std::string>(lsdbChange);
+  BOOST_CHECK(output.find("INSTALLED") != std::string::npos);
+  BOOST_CHECK(output.find("/router1") != std::string::npos);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace test
+} // namespace tlv
+} // namespace nlsr
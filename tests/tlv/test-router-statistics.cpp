@@ -0,0 +1,87 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2017,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "tlv/router-statistics.hpp"
+
+#include "../boost-test.hpp"
+#include <boost/lexical_cast.hpp>
+
+namespace nlsr {
+namespace tlv {
+namespace test {
+
+BOOST_AUTO_TEST_SUITE(TlvTestRouterStatistics)
+
+BOOST_AUTO_TEST_CASE(EncodeDecode)
+{
+  RouterStatistics routerStatistics;
+  routerStatistics.addPacketCounter({Statistics::PacketType::SENT_HELLO_INTEREST, 42});
+  routerStatistics.addPacketCounter({Statistics::PacketType::RCV_LSA_DATA, 7});
+
+  RouterStatistics::DurationHistogram histogram;
+  histogram.type = Statistics::DurationType::LSA_FETCH_LATENCY;
+  histogram.count = 3;
+  histogram.total = ndn::time::microseconds(1500);
+  histogram.buckets = {0, 1, 0, 2};
+  routerStatistics.addDurationHistogram(histogram);
+
+  const ndn::Block& wire = routerStatistics.wireEncode();
+  BOOST_CHECK_EQUAL(wire.type(), ndn::tlv::nlsr::RouterStatistics);
+
+  RouterStatistics decoded(wire);
+  BOOST_REQUIRE_EQUAL(decoded.getPacketCounters().size(), 2);
+  BOOST_CHECK_EQUAL(decoded.getPacketCounters()[0].type, Statistics::PacketType::SENT_HELLO_INTEREST);
+  BOOST_CHECK_EQUAL(decoded.getPacketCounters()[0].count, 42);
+  BOOST_CHECK_EQUAL(decoded.getPacketCounters()[1].type, Statistics::PacketType::RCV_LSA_DATA);
+  BOOST_CHECK_EQUAL(decoded.getPacketCounters()[1].count, 7);
+
+  BOOST_REQUIRE_EQUAL(decoded.getDurationHistograms().size(), 1);
+  const RouterStatistics::DurationHistogram& decodedHistogram = decoded.getDurationHistograms()[0];
+  BOOST_CHECK_EQUAL(decodedHistogram.type, Statistics::DurationType::LSA_FETCH_LATENCY);
+  BOOST_CHECK_EQUAL(decodedHistogram.count, 3);
+  BOOST_CHECK_EQUAL(decodedHistogram.total, ndn::time::microseconds(1500));
+  BOOST_CHECK_EQUAL_COLLECTIONS(decodedHistogram.buckets.begin(), decodedHistogram.buckets.end(),
+                                histogram.buckets.begin(), histogram.buckets.end());
+
+  BOOST_CHECK(wire == decoded.wireEncode());
+}
+
+BOOST_AUTO_TEST_CASE(DecodeWrongType)
+{
+  ndn::Block wire(ndn::tlv::nlsr::LsdbStatus);
+  BOOST_CHECK_THROW(RouterStatistics{wire}, RouterStatistics::Error);
+}
+
+BOOST_AUTO_TEST_CASE(Print)
+{
+  RouterStatistics routerStatistics;
+  routerStatistics.addPacketCounter({Statistics::PacketType::SENT_HELLO_INTEREST, 42});
+
+  std::string output = boost::lexical_cast<std::string>(routerStatistics);
+  BOOST_CHECK(output.find("sent-hello-interest") != std::string::npos);
+  BOOST_CHECK(output.find("42") != std::string::npos);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace test
+} // namespace tlv
+} // namespace nlsr
@@ -23,6 +23,7 @@
 
 #include "version.hpp"
 #include "src/publisher/lsdb-dataset-interest-handler.hpp"
+#include "src/publisher/statistics-dataset-interest-handler.hpp"
 
 #include <ndn-cxx/face.hpp>
 #include <ndn-cxx/data.hpp>
@@ -38,13 +39,20 @@ namespace nlsrc {
 
 const ndn::Name Nlsrc::LOCALHOST_PREFIX = ndn::Name("/localhost/nlsr");
 const ndn::Name Nlsrc::LSDB_PREFIX = ndn::Name(Nlsrc::LOCALHOST_PREFIX).append("lsdb");
+const ndn::Name Nlsrc::STATISTICS_PREFIX =
+  ndn::Name(Nlsrc::LOCALHOST_PREFIX).append(nlsr::dataset::STATISTICS_COMPONENT);
 const ndn::Name Nlsrc::NAME_UPDATE_PREFIX = ndn::Name(Nlsrc::LOCALHOST_PREFIX).append("prefix-update");
 
+const ndn::time::seconds Nlsrc::WATCH_INTERVAL = ndn::time::seconds(1);
+
 const uint32_t Nlsrc::ERROR_CODE_TIMEOUT = 10060;
 const uint32_t Nlsrc::RESPONSE_CODE_SUCCESS = 200;
 
 Nlsrc::Nlsrc(ndn::Face& face)
   : m_face(face)
+  , m_scheduler(face.getIoService())
+  , m_lastEpoch(0)
+  , m_lastChange(0)
 {
 }
 
@@ -58,6 +66,10 @@ Nlsrc::printUsage()
     "   COMMAND can be one of the following:\n"
     "       status\n"
     "           display NLSR status\n"
+    "       statistics\n"
+    "           display NLSR packet counters and duration histograms\n"
+    "       watch\n"
+    "           display changes to the LSDB as they are made\n"
     "       advertise name\n"
     "           advertise a name prefix through NLSR\n"
     "       withdraw name\n"
@@ -76,6 +88,27 @@ Nlsrc::getStatus()
   runNextStep();
 }
 
+void
+Nlsrc::getStatistics()
+{
+  ndn::Interest interest(STATISTICS_PREFIX);
+
+  ndn::util::SegmentFetcher::fetch(m_face,
+                                   interest,
+                                   m_validator,
+                                   std::bind(&Nlsrc::onFetchSuccess<nlsr::tlv::RouterStatistics>,
+                                             this, _1,
+                                             std::function<void(const nlsr::tlv::RouterStatistics&)>(
+                                               std::bind(&Nlsrc::printStatistics, this, _1))),
+                                   std::bind(&Nlsrc::onTimeout, this, _1, _2));
+}
+
+void
+Nlsrc::watchLsdb()
+{
+  fetchLsdbChanges();
+}
+
 bool
 Nlsrc::dispatch(const std::string& command)
 {
@@ -103,6 +136,22 @@ Nlsrc::dispatch(const std::string& command)
     getStatus();
     return true;
   }
+  else if (command == "statistics") {
+    if (nOptions != 0) {
+      return false;
+    }
+
+    getStatistics();
+    return true;
+  }
+  else if (command == "watch") {
+    if (nOptions != 0) {
+      return false;
+    }
+
+    watchLsdb();
+    return true;
+  }
 
   return false;
 }
@@ -261,6 +310,95 @@ Nlsrc::onTimeout(uint32_t errorCode, const std::string& error)
             << ", error: " << error << ")"  << std::endl;
 }
 
+void
+Nlsrc::printStatistics(const nlsr::tlv::RouterStatistics& statistics)
+{
+  std::cout << "NLSR Statistics" << std::endl;
+  std::cout << "Packets:" << std::endl;
+
+  for (const auto& counter : statistics.getPacketCounters()) {
+    std::cout << "  " << counter.type << "=" << counter.count << std::endl;
+  }
+
+  std::cout << "Durations:" << std::endl;
+
+  for (const auto& histogram : statistics.getDurationHistograms()) {
+    std::cout << "  " << histogram.type << " count=" << histogram.count;
+    if (histogram.count > 0) {
+      std::cout << " mean=" << histogram.total / histogram.count;
+    }
+    std::cout << std::endl;
+
+    // Only the buckets that counted something
+    for (size_t i = 0; i < histogram.buckets.size(); ++i) {
+      if (histogram.buckets[i] == 0) {
+        continue;
+      }
+
+      std::cout << "    ";
+      if (i + 1 < histogram.buckets.size()) {
+        std::cout << "<" << nlsr::DurationHistogram::getBucketUpperBound(i);
+      }
+      else {
+        std::cout << ">=" << nlsr::DurationHistogram::getBucketUpperBound(i - 1);
+      }
+      std::cout << "=" << histogram.buckets[i] << std::endl;
+    }
+  }
+}
+
+void
+Nlsrc::fetchLsdbChanges()
+{
+  ndn::Name command = LSDB_PREFIX;
+  command.append(nlsr::dataset::CHANGES_COMPONENT);
+  if (m_lastChange > 0) {
+    command.appendNumber(m_lastEpoch).appendSequenceNumber(m_lastChange);
+  }
+
+  // Poll again once these changes have been printed, or the fetch has failed
+  m_fetchSteps.push_back([this] {
+      m_scheduler.scheduleEvent(WATCH_INTERVAL, std::bind(&Nlsrc::fetchLsdbChanges, this));
+    });
+
+  ndn::Interest interest(command);
+
+  ndn::util::SegmentFetcher::fetch(m_face,
+                                   interest,
+                                   m_validator,
+                                   std::bind(&Nlsrc::onFetchSuccess<nlsr::tlv::LsdbChange>,
+                                             this, _1,
+                                             std::function<void(const nlsr::tlv::LsdbChange&)>(
+                                               std::bind(&Nlsrc::printLsdbChange, this, _1))),
+                                   [this] (uint32_t errorCode, const std::string& error) {
+                                     onTimeout(errorCode, error);
+                                     runNextStep();
+                                   });
+}
+
+void
+Nlsrc::printLsdbChange(const nlsr::tlv::LsdbChange& change)
+{
+  if (m_lastChange > 0) {
+    if (change.getEpoch() != m_lastEpoch) {
+      std::cout << "(NLSR has restarted)" << std::endl;
+    }
+    else if (change.getChangeSequenceNumber() <= m_lastChange) {
+      return;
+    }
+    else if (change.getChangeSequenceNumber() > m_lastChange + 1) {
+      std::cout << "(" << change.getChangeSequenceNumber() - m_lastChange - 1
+                << " changes were missed)" << std::endl;
+    }
+  }
+  m_lastEpoch = change.getEpoch();
+  m_lastChange = change.getChangeSequenceNumber();
+
+  std::cout << change.getChangeSequenceNumber() << " " << change.getKind() << " "
+            << change.getLsaType() << " LSA of " << change.getOriginRouter()
+            << " (seq no: " << change.getSequenceNumber() << ")" << std::endl;
+}
+
 std::string
 Nlsrc::getLsaInfoString(const nlsr::tlv::LsaInfo& info)
 {
@@ -21,12 +21,15 @@
 
 #include "tlv/adjacency-lsa.hpp"
 #include "tlv/coordinate-lsa.hpp"
+#include "tlv/lsdb-change.hpp"
 #include "tlv/name-lsa.hpp"
+#include "tlv/router-statistics.hpp"
 
 #include <boost/noncopyable.hpp>
 #include <ndn-cxx/face.hpp>
 #include <ndn-cxx/security/key-chain.hpp>
 #include <ndn-cxx/security/validator-null.hpp>
+#include <ndn-cxx/util/scheduler.hpp>
 
 #include <deque>
 #include <map>
@@ -49,6 +52,14 @@ public:
   void
   getStatus();
 
+  void
+  getStatistics();
+
+  /*! \brief Prints the changes to the LSDB as they are made, until interrupted.
+   */
+  void
+  watchLsdb();
+
   bool
   dispatch(const std::string& cmd);
 
@@ -107,6 +118,18 @@ private:
   void
   onTimeout(uint32_t errorCode, const std::string& error);
 
+  void
+  printStatistics(const nlsr::tlv::RouterStatistics& statistics);
+
+  /*! \brief Fetches the changes after the last one printed, and then
+      schedules the next fetch.
+   */
+  void
+  fetchLsdbChanges();
+
+  void
+  printLsdbChange(const nlsr::tlv::LsdbChange& change);
+
 private:
   std::string
   getLsaInfoString(const nlsr::tlv::LsaInfo& info);
@@ -151,10 +174,18 @@ private:
 
   std::deque<std::function<void()>> m_fetchSteps;
 
+  ndn::Scheduler m_scheduler;
+  // The epoch and sequence number of the last LSDB change printed, or 0
+  uint64_t m_lastEpoch;
+  uint64_t m_lastChange;
+
   static const ndn::Name LOCALHOST_PREFIX;
   static const ndn::Name LSDB_PREFIX;
+  static const ndn::Name STATISTICS_PREFIX;
   static const ndn::Name NAME_UPDATE_PREFIX;
 
+  static const ndn::time::seconds WATCH_INTERVAL;
+
   static const uint32_t ERROR_CODE_TIMEOUT;
   static const uint32_t RESPONSE_CODE_SUCCESS;
 };